@@ -0,0 +1,193 @@
+// ────────────────────────────────────────────────────────────────────────
+// AddressPlan — DMX start addresses for a whole line, planned and patched
+// ────────────────────────────────────────────────────────────────────────
+#include "address_plan.h"
+#include "device_profile.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+static std::vector<uint8_t> Address(uint16_t a) {
+  return {static_cast<uint8_t>(a >> 8), static_cast<uint8_t>(a & 0xFF)};
+}
+
+bool ReadAddressFixture(const RDMGet &get, uint64_t uid,
+                        AddressFixture &out) {
+  out.uid = uid;
+  out.answered = false;
+  RDMResponse resp = get(PID_DEVICE_INFO, {});
+  DeviceInfo info;
+  if (resp.type == RDMResponseType::ACK && ParseDeviceInfo(resp.data, info)) {
+    out.answered = true;
+    out.footprint = info.footprint;
+    out.personality = info.personality;
+    out.current = info.startAddress;
+    return true;
+  }
+
+  resp = get(PID_CK_DMX_FOOTPRINT, {});
+  if (resp.type != RDMResponseType::ACK || resp.data.empty())
+    return false;
+  out.answered = true;
+  out.footprint = resp.data[0];
+  out.personality = 0;
+  out.current = DMX_NO_ADDRESS;
+  resp = get(PID_DMX_START_ADDRESS, {});
+  if (resp.type == RDMResponseType::ACK && resp.data.size() >= 2)
+    out.current = static_cast<uint16_t>((resp.data[0] << 8) | resp.data[1]);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Plan
+// ═══════════════════════════════════════════════════════════════════════
+
+AddressPlan PlanAddresses(const std::vector<AddressFixture> &fixtures,
+                          const AddressPlanOptions &opts) {
+  AddressPlan plan;
+  const int first = std::max<int>(opts.firstAddress, 1);
+  const int last = std::min<int>(opts.lastAddress, 512);
+  // owner[a]: slot index holding DMX address a, -1 when free
+  std::vector<int> owner(513, -1);
+
+  auto slotFor = [](const AddressFixture &f) {
+    AddressSlot s;
+    s.uid = f.uid;
+    s.footprint = f.footprint;
+    s.current = f.current;
+    s.fixed = f.fixed;
+    return s;
+  };
+  auto take = [&](int index, int start, int footprint) {
+    for (int a = start; a < start + footprint && a <= 512; ++a) {
+      int held = owner[a];
+      if (held >= 0 && held != index) {
+        plan.slots[held].overlaps = plan.slots[index].overlaps = true;
+        continue;
+      }
+      owner[a] = index;
+    }
+  };
+
+  // Fixed fixtures first: they hold their slots whatever the rest needs
+  std::vector<const AddressFixture *> loose;
+  for (const AddressFixture &f : fixtures) {
+    bool pinned = f.fixed && f.answered && f.current >= 1 &&
+                  f.current <= 512;
+    if (!pinned) {
+      loose.push_back(&f);
+      continue;
+    }
+    plan.slots.push_back(slotFor(f));
+    int index = static_cast<int>(plan.slots.size()) - 1;
+    plan.slots[index].planned = f.current;
+    take(index, f.current, f.footprint);
+  }
+  std::sort(loose.begin(), loose.end(),
+            [](const AddressFixture *a, const AddressFixture *b) {
+              return a->uid < b->uid;
+            });
+
+  for (const AddressFixture *f : loose) {
+    plan.slots.push_back(slotFor(*f));
+    int index = static_cast<int>(plan.slots.size()) - 1;
+    AddressSlot &s = plan.slots[index];
+    s.fixed = false; // a fixed fixture without an address is placed
+    if (f->answered && f->footprint == 0)
+      continue; // no footprint, nothing to address
+    int start = -1;
+    for (int a = first; f->answered && a + f->footprint - 1 <= last; ++a) {
+      int end = a + f->footprint;
+      auto busy = std::find_if(owner.begin() + a, owner.begin() + end,
+                               [](int o) { return o >= 0; });
+      if (busy == owner.begin() + end) {
+        start = a;
+        break;
+      }
+      a = static_cast<int>(busy - owner.begin()); // skip past the holder
+    }
+    if (start < 0) {
+      ++plan.unplaced;
+      continue;
+    }
+    s.planned = static_cast<uint16_t>(start);
+    take(index, start, f->footprint);
+  }
+
+  for (const AddressSlot &s : plan.slots) {
+    plan.moves += s.Moves() ? 1 : 0;
+    plan.overlaps += s.overlaps ? 1 : 0;
+    if (s.planned != DMX_NO_ADDRESS && s.footprint > 0)
+      plan.lastUsed = std::max<uint16_t>(
+          plan.lastUsed,
+          static_cast<uint16_t>(std::min(s.planned + s.footprint - 1, 512)));
+  }
+  TRACE_DEBUG("[Address] %d fixture(s): %d to move, %d unplaced, "
+              "%d overlapping, up to slot %u\n",
+              static_cast<int>(plan.slots.size()), plan.moves, plan.unplaced,
+              plan.overlaps, plan.lastUsed);
+  return plan;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Patch
+// ═══════════════════════════════════════════════════════════════════════
+
+std::vector<AddressPatch> PatchAddresses(const std::vector<PushTarget> &port,
+                                         const AddressPlan &plan,
+                                         bool verify) {
+  std::unordered_map<uint64_t, const AddressSlot *> byUID;
+  for (const AddressSlot &s : plan.slots)
+    byUID[s.uid] = &s;
+
+  // 1. SET every move on the port
+  std::vector<AddressPatch> patches;
+  std::vector<const PushTarget *> sent;
+  std::vector<int64_t> readyUs; // ACK_TIMER commit time, 0 when none
+  for (const PushTarget &fx : port) {
+    auto it = byUID.find(fx.uid);
+    if (it == byUID.end() || !it->second->Moves())
+      continue;
+    AddressPatch p;
+    p.uid = fx.uid;
+    p.from = it->second->current;
+    p.to = it->second->planned;
+    RDMResponse resp = fx.set(PID_DMX_START_ADDRESS, Address(p.to));
+    p.nackReason = resp.nackReason;
+    bool accepted = resp.type == RDMResponseType::ACK ||
+                    resp.type == RDMResponseType::ACK_TIMER;
+    p.outcome = accepted ? PushOutcome::SET : PushOutcome::FAILED;
+    int64_t waitUs = AckTimerUs(resp);
+    patches.push_back(p);
+    sent.push_back(&fx);
+    readyUs.push_back(waitUs ? RdmNowUs() + waitUs : 0);
+  }
+
+  // 2. Read back what was accepted
+  for (size_t i = 0; i < patches.size() && verify; ++i) {
+    AddressPatch &p = patches[i];
+    if (p.outcome != PushOutcome::SET)
+      continue;
+    int64_t waitUs = readyUs[i] - RdmNowUs();
+    if (waitUs > 0)
+      std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+    RDMResponse resp = sent[i]->get(PID_DMX_START_ADDRESS, {});
+    if (resp.type == RDMResponseType::ACK &&
+        ConfigMatches(PID_DMX_START_ADDRESS, resp.data, Address(p.to)))
+      continue;
+    if (resp.type == RDMResponseType::ACK_TIMER) {
+      p.outcome = PushOutcome::PENDING;
+      continue;
+    }
+    p.outcome = PushOutcome::MISMATCH;
+    p.readBack = resp.type == RDMResponseType::ACK && resp.data.size() >= 2
+                     ? static_cast<uint16_t>((resp.data[0] << 8) |
+                                             resp.data[1])
+                     : DMX_NO_ADDRESS;
+  }
+  return patches;
+}
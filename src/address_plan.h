@@ -0,0 +1,85 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// AddressPlan — DMX start addresses for a whole line, planned and patched
+// ────────────────────────────────────────────────────────────────────────
+#ifndef ADDRESS_PLAN_H
+#define ADDRESS_PLAN_H
+
+#include "config_push.h"
+#include "validator.h"
+
+#include <cstdint>
+#include <vector>
+
+// CK OP_CODE_DMX_FOOTPRINT: channel count, for fixtures without DEVICE_INFO
+constexpr uint16_t PID_CK_DMX_FOOTPRINT = 0x860F;
+
+constexpr uint16_t DMX_NO_ADDRESS = 0xFFFF; // E1.20: no DMX footprint
+
+// What the plan needs to know about one fixture
+struct AddressFixture {
+  uint64_t uid = 0;
+  bool answered = false;  // footprint read (DEVICE_INFO or 0x860F)
+  uint16_t footprint = 0; // of the current personality
+  uint8_t personality = 0;
+  uint16_t current = DMX_NO_ADDRESS;
+  bool fixed = false; // keep `current`; the plan works around it
+};
+
+// GET DEVICE_INFO, or 0x860F and DMX_START_ADDRESS when the fixture does
+// not answer it.  `out.fixed` is left as it was.
+bool ReadAddressFixture(const RDMGet &get, uint64_t uid, AddressFixture &out);
+
+struct AddressPlanOptions {
+  uint16_t firstAddress = 1;
+  uint16_t lastAddress = 512; // last slot any footprint may use
+};
+
+struct AddressSlot {
+  uint64_t uid = 0;
+  uint16_t footprint = 0;
+  uint16_t current = DMX_NO_ADDRESS;
+  uint16_t planned = DMX_NO_ADDRESS; // none: no footprint, or no room
+  bool fixed = false;
+  bool overlaps = false; // fixed, and sharing slots with another fixed one
+
+  bool Moves() const {
+    return planned != DMX_NO_ADDRESS && planned != current;
+  }
+};
+
+struct AddressPlan {
+  std::vector<AddressSlot> slots; // fixed first, then in placement order
+  int moves = 0;    // start addresses the patch will SET
+  int unplaced = 0; // footprints that did not fit, or never answered
+  int overlaps = 0; // fixed fixtures sharing slots
+  uint16_t lastUsed = 0; // highest slot taken, 0 when none
+};
+
+// One line (universe) at a time: fixed fixtures keep their addresses and
+// the rest are packed lowest-UID-first into the lowest free run that fits
+// their footprint, so the plan is gap-free apart from what fixed fixtures
+// leave, and the same line always gets the same plan — patching an
+// already patched line moves nothing.
+AddressPlan PlanAddresses(const std::vector<AddressFixture> &fixtures,
+                          const AddressPlanOptions &opts = {});
+
+struct AddressPatch {
+  uint64_t uid = 0;
+  uint16_t from = DMX_NO_ADDRESS;
+  uint16_t to = DMX_NO_ADDRESS;
+  PushOutcome outcome = PushOutcome::SET;
+  uint16_t nackReason = 0;
+  uint16_t readBack = DMX_NO_ADDRESS; // MISMATCH
+};
+
+// SETs DMX_START_ADDRESS on every fixture of one port the plan moves,
+// then reads them all back, as ConfigPusher does: each fixture has had
+// the rest of the port's SETs worth of time before it is read, and an
+// ACK_TIMER SET is not read before its estimate has passed.  Fixtures
+// of `port` not in the plan, or not moving, are left alone.
+std::vector<AddressPatch> PatchAddresses(const std::vector<PushTarget> &port,
+                                         const AddressPlan &plan,
+                                         bool verify = true);
+
+#endif // ADDRESS_PLAN_H
@@ -0,0 +1,52 @@
+// ────────────────────────────────────────────────────────────────────────
+// BroadcastSet — one SET frame for a whole line, spot-checked afterwards
+// ────────────────────────────────────────────────────────────────────────
+#include "broadcast_set.h"
+#include "config_push.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+std::vector<uint64_t> PickSample(const std::vector<uint64_t> &known,
+                                 uint64_t dest, int count, uint32_t seed) {
+  std::vector<uint64_t> pool;
+  for (uint64_t uid : known)
+    if (RDMAddresses(dest, uid))
+      pool.push_back(uid);
+  if (count <= 0)
+    return {};
+  size_t n = std::min(pool.size(), static_cast<size_t>(count));
+  std::mt19937 rng(seed ? seed : std::random_device()());
+  // Partial Fisher-Yates: the first `n` entries are the sample
+  for (size_t i = 0; i < n; ++i) {
+    std::uniform_int_distribution<size_t> pick(i, pool.size() - 1);
+    std::swap(pool[i], pool[pick(rng)]);
+  }
+  pool.resize(n);
+  return pool;
+}
+
+void VerifySample(BroadcastResult &r,
+                  const std::function<RDMGet(uint64_t uid)> &getFor,
+                  uint16_t pid, const std::vector<uint8_t> &value,
+                  const std::vector<uint64_t> &sample) {
+  for (uint64_t uid : sample) {
+    RDMResponse resp = getFor(uid)(pid, {});
+    ++r.sampled;
+    if (resp.type == RDMResponseType::ACK &&
+        ConfigMatches(pid, resp.data, value)) {
+      ++r.confirmed;
+      continue;
+    }
+    if (resp.type == RDMResponseType::ACK)
+      ++r.mismatched;
+    else
+      ++r.unconfirmed;
+    r.failed.push_back(uid);
+  }
+  TRACE_DEBUG("[Broadcast] PID 0x%04X: %d/%d sampled confirmed, "
+              "%d mismatched, %d unanswered\n",
+              pid, r.confirmed, r.sampled, r.mismatched, r.unconfirmed);
+}
@@ -0,0 +1,75 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// BroadcastSet — one SET frame for a whole line, spot-checked afterwards
+// ────────────────────────────────────────────────────────────────────────
+#ifndef BROADCAST_SET_H
+#define BROADCAST_SET_H
+
+#include "rdm_timing.h"
+#include "validation_planner.h"
+#include "validator.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct BroadcastOptions {
+  // Fixtures re-read after the SET; 0 = none (RESET_DEVICE and other
+  // PIDs without a GET), more than addressed = all of them
+  int verifySamples = 0;
+  uint32_t seed = 0; // sample choice; 0 = a new one every call
+};
+
+struct BroadcastResult {
+  uint64_t dest = 0;
+  bool sent = false;
+  int addressed = 0; // known UIDs the destination reaches
+  int sampled = 0;
+  int confirmed = 0;   // read back the value
+  int mismatched = 0;  // answered with another value
+  int unconfirmed = 0; // NACK, timeout or invalid reply
+  std::vector<uint64_t> failed; // sampled UIDs not confirmed
+  int64_t elapsedUs = 0;        // the SET and the read-backs
+};
+
+// `count` UIDs of `known` that `dest` addresses, drawn without repetition
+std::vector<uint64_t> PickSample(const std::vector<uint64_t> &known,
+                                 uint64_t dest, int count, uint32_t seed);
+
+// Re-reads `pid` on each UID of `sample` and tallies the answers against
+// `value` with ConfigMatches
+void VerifySample(BroadcastResult &r,
+                  const std::function<RDMGet(uint64_t uid)> &getFor,
+                  uint16_t pid, const std::vector<uint8_t> &value,
+                  const std::vector<uint64_t> &sample);
+
+// Sends `value` to every responder `dest` (RDM_BROADCAST_UID or a
+// RDMVendorcastUID) reaches on the line in a single frame, instead of a
+// SET and its ACK per fixture, then re-reads a random sample of the UIDs
+// in `known` to confirm it was applied.  No responder answers a broadcast,
+// so without a sample nothing is known beyond the frame having gone out.
+template <typename Driver>
+BroadcastResult BroadcastSet(Driver &bus, uint64_t srcUID, uint64_t dest,
+                             uint16_t pid, const std::vector<uint8_t> &value,
+                             const std::vector<uint64_t> &known,
+                             const BroadcastOptions &opts = {}) {
+  BroadcastResult r;
+  r.dest = dest;
+  for (uint64_t uid : known)
+    r.addressed += RDMAddresses(dest, uid) ? 1 : 0;
+  int64_t t0 = RdmNowUs();
+  r.sent = RDMBroadcastSet(bus, srcUID, dest, pid,
+                           value.empty() ? nullptr : value.data(),
+                           static_cast<uint8_t>(value.size()));
+  if (r.sent && opts.verifySamples > 0) {
+    auto getFor = [&bus, srcUID](uint64_t uid) {
+      return PlannerGet(bus, srcUID, uid);
+    };
+    VerifySample(r, getFor, pid, value,
+                 PickSample(known, dest, opts.verifySamples, opts.seed));
+  }
+  r.elapsedUs = RdmNowUs() - t0;
+  return r;
+}
+
+#endif // BROADCAST_SET_H
@@ -0,0 +1,323 @@
+// ────────────────────────────────────────────────────────────────────────
+// Capture analyzer — offline per-fixture / per-PID statistics
+// ────────────────────────────────────────────────────────────────────────
+#include "capture_analyzer.h"
+#include "enttec_pro.h"
+#include "rdm.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <unordered_set>
+
+static constexpr int kMinRdmPacket = 26; // 24-byte header + checksum
+
+CaptureAnalyzer::CaptureAnalyzer() {
+  m_batch.reserve(kBatch);
+  m_packets.reserve(kBatch);
+  m_lens.reserve(kBatch);
+  m_ok.resize(kBatch);
+  m_headers.resize(kBatch);
+}
+
+void CaptureAnalyzer::Reset() {
+  m_batch.clear();
+  m_packets.clear();
+  m_lens.clear();
+  for (auto &p : m_pending)
+    p = Pending{};
+  m_stats.clear();
+  m_totals = AnalyzerTotals{};
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Classification
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Complete RDM packet: start code, sub-start code and a message length
+// that fits the frame.  Returns the packet length (trailing slots of a
+// received frame are ignored), 0 if malformed.
+static int RdmPacketLength(const uint8_t *p, int len) {
+  if (len < kMinRdmPacket || p[0] != RDM_START_CODE || p[1] != RDM_SUB_START)
+    return 0;
+  int packetLen = p[2] + 2;
+  if (p[2] < 24 || packetLen > len)
+    return 0;
+  return packetLen;
+}
+
+void CaptureAnalyzer::Add(const CaptureFrameView &frame) {
+  AnalyzerTotals &t = m_totals;
+  if (t.frames == 0)
+    t.firstUs = frame.timestampUs;
+  t.lastUs = frame.timestampUs;
+  ++t.frames;
+  t.bytes += frame.length;
+
+  bool tx = frame.direction == CaptureDirection::TX;
+  const uint8_t *data = frame.payload;
+  int len = frame.length;
+
+  // Unwrap Enttec labels to the slots that were on the line
+  if (frame.label != CAPTURE_LABEL_RAW) {
+    if (tx && frame.label == LABEL_TX_DMX) {
+      ++t.dmxFrames;
+      return;
+    }
+    bool rdmTx = tx && (frame.label == LABEL_TX_RDM ||
+                        frame.label == LABEL_TX_RDM_DISCOVERY);
+    bool rdmRx = !tx && frame.label == LABEL_RX_DMX_PACKET && len >= 1;
+    if (!rdmTx && !rdmRx) {
+      ++t.skipped;
+      return;
+    }
+    if (rdmRx) {
+      ++data; // widget status byte
+      --len;
+    }
+  }
+  if (len <= 0) {
+    ++t.malformed;
+    return;
+  }
+
+  Item item{frame.timestampUs, data, len, frame.port, Kind::REQUEST};
+  if (data[0] == RDM_START_CODE) {
+    item.len = RdmPacketLength(data, len);
+    if (item.len == 0) {
+      ++t.malformed;
+      return;
+    }
+    item.kind = tx ? Kind::REQUEST : Kind::RESPONSE;
+    m_packets.push_back(data);
+    m_lens.push_back(item.len);
+  } else if (!tx && (data[0] == 0xFE || data[0] == 0xAA)) {
+    item.kind = Kind::DUB_REPLY;
+  } else {
+    ++t.dmxFrames; // other start codes: DMX (0x00) or alternate
+    return;
+  }
+  m_batch.push_back(item);
+  if (static_cast<int>(m_batch.size()) == kBatch)
+    Flush();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Batch processing
+// ═══════════════════════════════════════════════════════════════════════════
+
+void CaptureAnalyzer::Flush() {
+  int n = static_cast<int>(m_packets.size());
+  if (n > 0) {
+    VerifyRDMChecksums(m_packets.data(), m_lens.data(), n, m_ok.data());
+    ExtractRDMHeaders(m_packets.data(), n, m_headers.data());
+  }
+  int packet = 0;
+  for (const Item &item : m_batch) {
+    switch (item.kind) {
+    case Kind::REQUEST:
+      OnRequest(item, m_headers[packet], m_ok[packet] != 0);
+      ++packet;
+      break;
+    case Kind::RESPONSE:
+      OnResponse(item, m_headers[packet], m_ok[packet] != 0);
+      ++packet;
+      break;
+    case Kind::DUB_REPLY:
+      OnDubReply(item);
+      break;
+    }
+  }
+  m_batch.clear();
+  m_packets.clear();
+  m_lens.clear();
+}
+
+AnalyzerPidStats &CaptureAnalyzer::StatsFor(const LatencyKey &key) {
+  AnalyzerPidStats &s = m_stats[key];
+  s.key = key;
+  return s;
+}
+
+void CaptureAnalyzer::Expire(Pending &p) {
+  if (p.active && !p.discovery)
+    ++StatsFor(p.key).outcomes[static_cast<int>(LatencyOutcome::TIMEOUT)];
+  p.active = false;
+}
+
+static bool IsBroadcast(uint64_t uid) {
+  return (uid & 0xFFFFFFFFULL) == 0xFFFFFFFFULL; // all or one manufacturer
+}
+
+void CaptureAnalyzer::OnRequest(const Item &item, const RdmHeaderFields &h,
+                                bool checksumOk) {
+  ++m_totals.rdmRequests;
+  if (!checksumOk)
+    ++m_totals.checksumErrors;
+  Pending &p = m_pending[item.port];
+  Expire(p);
+
+  if (h.commandClass == RDM_CC_DISCOVERY && h.pid == PID_DISC_UNIQUE_BRANCH) {
+    ++m_totals.dubRequests;
+    p.active = true;
+    p.discovery = true;
+    p.timestampUs = item.timestampUs;
+    return;
+  }
+  if (IsBroadcast(h.destUID)) {
+    ++m_totals.broadcasts; // no response expected
+    return;
+  }
+  p.active = true;
+  p.discovery = false;
+  p.key = {h.destUID, h.pid, h.commandClass};
+  p.transNum = h.transNum;
+  p.timestampUs = item.timestampUs;
+  ++StatsFor(p.key).requests;
+}
+
+void CaptureAnalyzer::OnResponse(const Item &item, const RdmHeaderFields &h,
+                                 bool checksumOk) {
+  ++m_totals.rdmResponses;
+  if (!checksumOk)
+    ++m_totals.checksumErrors;
+  Pending &p = m_pending[item.port];
+  if (!p.active || p.discovery || h.srcUID != p.key.uid ||
+      h.transNum != p.transNum) {
+    ++m_totals.unmatched;
+    return;
+  }
+
+  LatencyOutcome outcome;
+  if (!checksumOk)
+    outcome = LatencyOutcome::CHECKSUM_ERR;
+  else if (h.commandClass != p.key.commandClass + 1 || h.pid != p.key.pid)
+    outcome = LatencyOutcome::INVALID;
+  else if (h.portOrResponse == 0x00 || h.portOrResponse == 0x03)
+    outcome = LatencyOutcome::ACK; // ACK, ACK_OVERFLOW
+  else if (h.portOrResponse == 0x01)
+    outcome = LatencyOutcome::ACK_TIMER;
+  else if (h.portOrResponse == 0x02)
+    outcome = LatencyOutcome::NACK;
+  else
+    outcome = LatencyOutcome::INVALID;
+
+  AnalyzerPidStats &s = StatsFor(p.key);
+  ++s.outcomes[static_cast<int>(outcome)];
+  s.turnaround.Record(item.timestampUs - p.timestampUs);
+  p.active = false;
+}
+
+void CaptureAnalyzer::OnDubReply(const Item &item) {
+  Pending &p = m_pending[item.port];
+  uint64_t uid = 0;
+  bool checksumOk = false;
+  if (!DecodeDubReply(item.data, item.len, &uid, &checksumOk) ||
+      !checksumOk) {
+    ++m_totals.dubCollisions;
+  } else {
+    ++m_totals.dubReplies;
+    if (p.active && p.discovery) {
+      AnalyzerPidStats &s =
+          StatsFor({uid, PID_DISC_UNIQUE_BRANCH, RDM_CC_DISCOVERY});
+      ++s.requests;
+      ++s.outcomes[static_cast<int>(LatencyOutcome::ACK)];
+      s.turnaround.Record(item.timestampUs - p.timestampUs);
+    }
+  }
+  if (p.discovery)
+    p.active = false;
+}
+
+void CaptureAnalyzer::Finish() {
+  Flush();
+  for (auto &p : m_pending)
+    Expire(p);
+  std::unordered_set<uint64_t> uids;
+  for (const auto &kv : m_stats)
+    uids.insert(kv.first.uid);
+  m_totals.fixtures = uids.size();
+}
+
+void CaptureAnalyzer::Analyze(CaptureReader &reader) {
+  CaptureFrameView v;
+  while (reader.Next(v))
+    Add(v);
+  Finish();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Reports
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::vector<const AnalyzerPidStats *> CaptureAnalyzer::Stats() const {
+  std::vector<const AnalyzerPidStats *> out;
+  out.reserve(m_stats.size());
+  for (const auto &kv : m_stats)
+    out.push_back(&kv.second);
+  std::sort(out.begin(), out.end(),
+            [](const AnalyzerPidStats *a, const AnalyzerPidStats *b) {
+              if (a->key.uid != b->key.uid)
+                return a->key.uid < b->key.uid;
+              if (a->key.pid != b->key.pid)
+                return a->key.pid < b->key.pid;
+              return a->key.commandClass < b->key.commandClass;
+            });
+  return out;
+}
+
+std::string CaptureAnalyzer::RenderCsv() const {
+  std::string out = "uid,pid,command_class,requests,ack,ack_timer,nack,"
+                    "timeout,checksum_err,invalid,turnaround_min_us,"
+                    "turnaround_p50_us,turnaround_p99_us,turnaround_max_us\n";
+  char line[256];
+  for (const AnalyzerPidStats *s : Stats()) {
+    const LatencyHistogram &h = s->turnaround;
+    snprintf(line, sizeof(line),
+             "%04X:%08X,0x%04X,0x%02X,%llu,%llu,%llu,%llu,%llu,%llu,%llu,"
+             "%lld,%lld,%lld,%lld\n",
+             static_cast<unsigned>(s->key.uid >> 32),
+             static_cast<unsigned>(s->key.uid & 0xFFFFFFFF), s->key.pid,
+             s->key.commandClass,
+             static_cast<unsigned long long>(s->requests),
+             static_cast<unsigned long long>(s->outcomes[0]),
+             static_cast<unsigned long long>(s->outcomes[1]),
+             static_cast<unsigned long long>(s->outcomes[2]),
+             static_cast<unsigned long long>(s->outcomes[3]),
+             static_cast<unsigned long long>(s->outcomes[4]),
+             static_cast<unsigned long long>(s->outcomes[5]),
+             static_cast<long long>(h.Min()),
+             static_cast<long long>(h.ValueAtPercentile(50)),
+             static_cast<long long>(h.ValueAtPercentile(99)),
+             static_cast<long long>(h.Max()));
+    out += line;
+  }
+  return out;
+}
+
+std::string CaptureAnalyzer::RenderSummary() const {
+  const AnalyzerTotals &t = m_totals;
+  char buf[768];
+  snprintf(buf, sizeof(buf),
+           "frames          %llu (%.1f s of traffic)\n"
+           "rdm requests    %llu (%llu broadcast)\n"
+           "rdm responses   %llu (%llu unmatched)\n"
+           "checksum errors %llu\n"
+           "malformed       %llu\n"
+           "dub requests    %llu, replies %llu, collisions %llu\n"
+           "dmx frames      %llu\n"
+           "fixtures        %llu\n",
+           static_cast<unsigned long long>(t.frames),
+           (t.lastUs - t.firstUs) / 1e6,
+           static_cast<unsigned long long>(t.rdmRequests),
+           static_cast<unsigned long long>(t.broadcasts),
+           static_cast<unsigned long long>(t.rdmResponses),
+           static_cast<unsigned long long>(t.unmatched),
+           static_cast<unsigned long long>(t.checksumErrors),
+           static_cast<unsigned long long>(t.malformed),
+           static_cast<unsigned long long>(t.dubRequests),
+           static_cast<unsigned long long>(t.dubReplies),
+           static_cast<unsigned long long>(t.dubCollisions),
+           static_cast<unsigned long long>(t.dmxFrames),
+           static_cast<unsigned long long>(t.fixtures));
+  return buf;
+}
@@ -0,0 +1,110 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Capture analyzer — offline per-fixture / per-PID statistics
+// ────────────────────────────────────────────────────────────────────────
+#ifndef CAPTURE_ANALYZER_H
+#define CAPTURE_ANALYZER_H
+
+#include "capture_file.h"
+#include "latency_stats.h"
+#include "rdm_simd.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One (responder UID, PID, command class) of the capture.  Outcomes use
+// the RDX_STATUS_* order; TIMEOUT counts requests the capture holds no
+// response for.  `turnaround` is request TX to response RX, as recorded.
+struct AnalyzerPidStats {
+  LatencyKey key;
+  uint64_t requests = 0;
+  uint64_t outcomes[static_cast<int>(LatencyOutcome::COUNT_)] = {};
+  LatencyHistogram turnaround;
+};
+
+struct AnalyzerTotals {
+  uint64_t frames = 0;
+  uint64_t bytes = 0; // payload bytes
+  uint64_t rdmRequests = 0;
+  uint64_t rdmResponses = 0;
+  uint64_t broadcasts = 0;      // requests to a (vendor) broadcast UID
+  uint64_t unmatched = 0;       // responses without a pending request
+  uint64_t checksumErrors = 0;  // RDM packets, either direction
+  uint64_t malformed = 0;       // bad start code / message length
+  uint64_t dubRequests = 0;
+  uint64_t dubReplies = 0;      // decodable DISC_UNIQUE_BRANCH replies
+  uint64_t dubCollisions = 0;   // garbled reply or bad EUID checksum
+  uint64_t dmxFrames = 0;       // DMX output / input, not analysed
+  uint64_t skipped = 0;         // widget housekeeping
+  uint64_t fixtures = 0;        // distinct responder UIDs
+  int64_t firstUs = 0;
+  int64_t lastUs = 0;
+};
+
+// ── CaptureAnalyzer ─────────────────────────────────────────────────────
+//    Frames are classified as they are added and RDM packets collected
+//    into batches of kBatch; each batch has its checksums verified and
+//    headers extracted by the rdm_simd kernels in one call before the
+//    request / response pairing runs over it in capture order.  Requests
+//    pair with the next response of the same port carrying the same
+//    transaction number from the addressed UID.
+class CaptureAnalyzer {
+public:
+  static constexpr int kBatch = 256;
+  static constexpr int kMaxPorts = 256;
+
+  CaptureAnalyzer();
+
+  // Payloads must stay valid until the next Flush() (Analyze() and a
+  // CaptureReader's mapping guarantee that).
+  void Add(const CaptureFrameView &frame);
+  void Finish(); // flush, count requests still pending as timeouts
+  void Analyze(CaptureReader &reader); // Add() every frame, then Finish()
+  void Reset();
+
+  const AnalyzerTotals &Totals() const { return m_totals; }
+  // Sorted by UID, PID, command class
+  std::vector<const AnalyzerPidStats *> Stats() const;
+
+  // uid,pid,command_class,requests,ack,...,turnaround percentiles
+  std::string RenderCsv() const;
+  std::string RenderSummary() const;
+
+private:
+  enum class Kind : uint8_t { REQUEST, RESPONSE, DUB_REPLY };
+  struct Item {
+    int64_t timestampUs;
+    const uint8_t *data;
+    int len;
+    uint8_t port;
+    Kind kind;
+  };
+  struct Pending {
+    bool active = false;
+    bool discovery = false; // DISC_UNIQUE_BRANCH, answered by anyone
+    LatencyKey key;
+    uint8_t transNum = 0;
+    int64_t timestampUs = 0;
+  };
+
+  void Flush();
+  void OnRequest(const Item &item, const RdmHeaderFields &h, bool checksumOk);
+  void OnResponse(const Item &item, const RdmHeaderFields &h,
+                  bool checksumOk);
+  void OnDubReply(const Item &item);
+  void Expire(Pending &p); // pending request never answered
+  AnalyzerPidStats &StatsFor(const LatencyKey &key);
+
+  std::vector<Item> m_batch;
+  std::vector<const uint8_t *> m_packets; // RDM items of the batch
+  std::vector<int> m_lens;
+  std::vector<uint8_t> m_ok;
+  std::vector<RdmHeaderFields> m_headers;
+
+  Pending m_pending[kMaxPorts];
+  std::unordered_map<LatencyKey, AnalyzerPidStats, LatencyKeyHash> m_stats;
+  AnalyzerTotals m_totals;
+};
+
+#endif // CAPTURE_ANALYZER_H
@@ -0,0 +1,406 @@
+// ────────────────────────────────────────────────────────────────────────
+// Capture file — binary frame log with index, memory-mapped writer
+// ────────────────────────────────────────────────────────────────────────
+#include "capture_file.h"
+#include "rdm_timing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <windows.h>
+
+static uint64_t PadTo8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Memory-mapped file (writer thread only)
+// ═══════════════════════════════════════════════════════════════════════════
+
+class CaptureWriter::MappedFile {
+public:
+  ~MappedFile() { Close(m_size); }
+
+  bool Create(const std::string &path, uint64_t size) {
+    m_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                         FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+      return false;
+    return Map(size);
+  }
+
+  // Grows the file and remaps when `size` bytes do not fit the view
+  bool Ensure(uint64_t size) {
+    if (size <= m_size)
+      return true;
+    uint64_t grown = m_size;
+    while (grown < size)
+      grown += kGrowBytes;
+    Unmap();
+    return Map(grown);
+  }
+
+  uint8_t *Data() { return m_view; }
+
+  // Unmaps and trims the file to `finalSize`
+  void Close(uint64_t finalSize) {
+    if (m_file == INVALID_HANDLE_VALUE)
+      return;
+    if (m_view)
+      FlushViewOfFile(m_view, 0);
+    Unmap();
+    SetSize(finalSize);
+    CloseHandle(m_file);
+    m_file = INVALID_HANDLE_VALUE;
+  }
+
+private:
+  bool SetSize(uint64_t size) {
+    LARGE_INTEGER pos;
+    pos.QuadPart = static_cast<long long>(size);
+    return SetFilePointerEx(m_file, pos, nullptr, FILE_BEGIN) &&
+           SetEndOfFile(m_file);
+  }
+
+  bool Map(uint64_t size) {
+    if (!SetSize(size))
+      return false;
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE,
+                                   static_cast<DWORD>(size >> 32),
+                                   static_cast<DWORD>(size & 0xFFFFFFFF),
+                                   nullptr);
+    if (!m_mapping)
+      return false;
+    m_view = static_cast<uint8_t *>(
+        MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, 0));
+    if (!m_view) {
+      CloseHandle(m_mapping);
+      m_mapping = nullptr;
+      return false;
+    }
+    m_size = size;
+    return true;
+  }
+
+  void Unmap() {
+    if (m_view)
+      UnmapViewOfFile(m_view);
+    if (m_mapping)
+      CloseHandle(m_mapping);
+    m_view = nullptr;
+    m_mapping = nullptr;
+  }
+
+  HANDLE m_file = INVALID_HANDLE_VALUE;
+  HANDLE m_mapping = nullptr;
+  uint8_t *m_view = nullptr;
+  uint64_t m_size = 0;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CaptureWriter
+// ═══════════════════════════════════════════════════════════════════════════
+
+CaptureWriter::CaptureWriter() = default;
+CaptureWriter::~CaptureWriter() { Close(); }
+
+bool CaptureWriter::Open(const std::string &path) {
+  Close();
+  auto file = std::make_unique<MappedFile>();
+  if (!file->Create(path, kGrowBytes))
+    return false;
+
+  CaptureFileHeader h = {};
+  memcpy(h.magic, kCaptureMagic, sizeof(h.magic));
+  h.version = kCaptureVersion;
+  h.headerSize = sizeof(CaptureFileHeader);
+  h.startUs = RdmNowUs();
+  h.wallClockUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+  memcpy(file->Data(), &h, sizeof(h));
+
+  if (!m_queue)
+    m_queue = std::make_unique<MpscRing<Pending, kQueueFrames>>();
+  // Discard frames that raced the previous Close()
+  while (m_queue->Consume([](const Pending &) {})) {
+  }
+  m_file = std::move(file);
+  m_offset = sizeof(CaptureFileHeader);
+  m_written = 0;
+  m_index.clear();
+  m_frames = 0;
+  m_dropped = 0;
+  m_bytes = m_offset;
+
+  m_running = true;
+  m_thread = std::thread(&CaptureWriter::WriterLoop, this);
+  return true;
+}
+
+bool CaptureWriter::Append(int64_t timestampUs, CaptureDirection dir,
+                           uint8_t port, uint8_t label, uint8_t flags,
+                           const uint8_t *data, int len) {
+  if (!IsOpen() || !data || len <= 0)
+    return false;
+  if (len > kCaptureMaxPayload)
+    len = kCaptureMaxPayload;
+  bool ok = m_queue->Emplace([&](Pending &p) {
+    p.header.timestampUs = timestampUs;
+    p.header.length = static_cast<uint16_t>(len);
+    p.header.direction = static_cast<uint8_t>(dir);
+    p.header.port = port;
+    p.header.label = label;
+    p.header.flags = flags;
+    p.header.reserved = 0;
+    memcpy(p.payload, data, len);
+  });
+  if (!ok)
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+  return ok;
+}
+
+// Writer thread.  On a mapping failure the capture stops growing and
+// further frames are counted as dropped.
+bool CaptureWriter::WriteRecord(const Pending &p) {
+  uint64_t size = sizeof(CaptureRecordHeader) + PadTo8(p.header.length);
+  if (!m_file->Ensure(m_offset + size)) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (m_written % kCaptureIndexStride == 0)
+    m_index.push_back({m_written, m_offset, p.header.timestampUs});
+
+  uint8_t *dst = m_file->Data() + m_offset;
+  memcpy(dst, &p.header, sizeof(CaptureRecordHeader));
+  memcpy(dst + sizeof(CaptureRecordHeader), p.payload, p.header.length);
+  // Padding is already zero: the mapping grows over a zero-filled file
+
+  m_offset += size;
+  ++m_written;
+  m_frames.store(m_written, std::memory_order_relaxed);
+  m_bytes.store(m_offset, std::memory_order_relaxed);
+  return true;
+}
+
+void CaptureWriter::WriterLoop() {
+  auto write = [this](const Pending &p) { WriteRecord(p); };
+  while (m_running.load(std::memory_order_acquire)) {
+    int n = 0;
+    while (n < 256 && m_queue->Consume(write))
+      ++n;
+    if (n == 0)
+      Sleep(1);
+  }
+}
+
+void CaptureWriter::Close() {
+  if (!m_file)
+    return;
+  m_running = false;
+  if (m_thread.joinable())
+    m_thread.join();
+
+  // Frames queued after the writer's last pass
+  while (m_queue->Consume([this](const Pending &p) { WriteRecord(p); })) {
+  }
+
+  // Index + footer
+  uint64_t indexBytes = m_index.size() * sizeof(CaptureIndexEntry);
+  uint64_t total = m_offset + indexBytes + sizeof(CaptureFooter);
+  if (m_file->Ensure(total)) {
+    uint8_t *dst = m_file->Data() + m_offset;
+    if (indexBytes)
+      memcpy(dst, m_index.data(), indexBytes);
+    CaptureFooter f = {};
+    memcpy(f.magic, kCaptureIndexMagic, sizeof(f.magic));
+    f.indexOffset = m_offset;
+    f.indexCount = m_index.size();
+    f.frameCount = m_written;
+    f.dropped = m_dropped.load(std::memory_order_relaxed);
+    memcpy(dst + indexBytes, &f, sizeof(f));
+  } else {
+    total = m_offset; // readable without a footer
+  }
+  m_file->Close(total);
+  m_file.reset();
+  m_bytes = total;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CaptureReader
+// ═══════════════════════════════════════════════════════════════════════════
+
+CaptureReader::~CaptureReader() { Unmap(); }
+
+void CaptureReader::Unmap() {
+  if (m_view)
+    UnmapViewOfFile(m_view);
+  if (m_mapping)
+    CloseHandle(m_mapping);
+  if (m_file)
+    CloseHandle(m_file);
+  m_view = m_mapping = m_file = nullptr;
+}
+
+// Maps the file read-only; the OS pages records in as the reader walks
+// them, so opening a multi-GB capture costs only the index.
+bool CaptureReader::Open(const std::string &path) {
+  Unmap();
+  m_owned.clear();
+  // Share-write: a capture that is still being recorded can be read
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  m_file = file;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    return false;
+  m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_mapping)
+    return false;
+  m_view = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!m_view)
+    return false;
+  return Attach(static_cast<const uint8_t *>(m_view),
+                static_cast<uint64_t>(size.QuadPart));
+}
+
+bool CaptureReader::Load(std::vector<uint8_t> bytes) {
+  Unmap();
+  m_owned = std::move(bytes);
+  return Attach(m_owned.data(), m_owned.size());
+}
+
+bool CaptureReader::Attach(const uint8_t *data, uint64_t size) {
+  m_data = data;
+  m_size = size;
+  m_index.clear();
+  m_frameCount = 0;
+  m_dropped = 0;
+  m_hadFooter = false;
+  m_cursor = 0;
+  m_frame = 0;
+
+  if (m_size < sizeof(CaptureFileHeader))
+    return false;
+  memcpy(&m_header, m_data, sizeof(m_header));
+  if (memcmp(m_header.magic, kCaptureMagic, sizeof(kCaptureMagic)) != 0 ||
+      m_header.version != kCaptureVersion ||
+      m_header.headerSize < sizeof(CaptureFileHeader) ||
+      m_header.headerSize > m_size)
+    return false;
+
+  // Footer + index, if the writer closed cleanly
+  if (m_size >= m_header.headerSize + sizeof(CaptureFooter)) {
+    CaptureFooter f;
+    memcpy(&f, m_data + m_size - sizeof(f), sizeof(f));
+    uint64_t footerAt = m_size - sizeof(f);
+    if (memcmp(f.magic, kCaptureIndexMagic, sizeof(f.magic)) == 0 &&
+        f.indexOffset >= m_header.headerSize && f.indexOffset <= footerAt &&
+        f.indexCount <=
+            (footerAt - f.indexOffset) / sizeof(CaptureIndexEntry)) {
+      m_index.resize(f.indexCount);
+      if (f.indexCount)
+        memcpy(m_index.data(), m_data + f.indexOffset,
+               f.indexCount * sizeof(CaptureIndexEntry));
+      m_end = f.indexOffset;
+      m_frameCount = f.frameCount;
+      m_dropped = f.dropped;
+      m_hadFooter = true;
+    }
+  }
+  if (!m_hadFooter) {
+    m_end = m_size;
+    Scan();
+  }
+  return Seek(0);
+}
+
+// Rebuilds the index of a capture without a footer
+void CaptureReader::Scan() {
+  uint64_t offset = m_header.headerSize, next = 0;
+  CaptureFrameView v;
+  while (ReadAt(offset, v, &next)) {
+    if (m_frameCount % kCaptureIndexStride == 0)
+      m_index.push_back({m_frameCount, offset, v.timestampUs});
+    ++m_frameCount;
+    offset = next;
+  }
+  m_end = offset;
+}
+
+bool CaptureReader::ReadAt(uint64_t offset, CaptureFrameView &out,
+                           uint64_t *next) const {
+  if (offset + sizeof(CaptureRecordHeader) > m_end)
+    return false;
+  CaptureRecordHeader h;
+  memcpy(&h, m_data + offset, sizeof(h));
+  if (h.length == 0 || h.length > kCaptureMaxPayload)
+    return false; // zero tail of an unclosed file, or corruption
+  uint64_t payloadAt = offset + sizeof(CaptureRecordHeader);
+  if (payloadAt + h.length > m_end)
+    return false;
+
+  out.timestampUs = h.timestampUs;
+  out.direction = static_cast<CaptureDirection>(h.direction);
+  out.port = h.port;
+  out.label = h.label;
+  out.flags = h.flags;
+  out.length = h.length;
+  out.payload = m_data + payloadAt;
+  if (next)
+    *next = payloadAt + PadTo8(h.length);
+  return true;
+}
+
+bool CaptureReader::Seek(uint64_t frame) {
+  if (frame > m_frameCount)
+    return false;
+  if (frame == m_frameCount || m_index.empty()) {
+    m_cursor = m_end;
+    m_frame = m_frameCount;
+    return true;
+  }
+  const CaptureIndexEntry &e = m_index[frame / kCaptureIndexStride];
+  m_cursor = e.offset;
+  m_frame = e.frame;
+  CaptureFrameView v;
+  while (m_frame < frame)
+    if (!Next(v))
+      return false;
+  return true;
+}
+
+bool CaptureReader::SeekTime(int64_t timestampUs) {
+  // Last indexed frame at or before the time, then walk forward
+  auto it = std::upper_bound(
+      m_index.begin(), m_index.end(), timestampUs,
+      [](int64_t t, const CaptureIndexEntry &e) { return t < e.timestampUs; });
+  if (!Seek(it == m_index.begin() ? 0 : (it - 1)->frame))
+    return false;
+  uint64_t cursor = m_cursor, frame = m_frame;
+  CaptureFrameView v;
+  while (Next(v)) {
+    if (v.timestampUs >= timestampUs)
+      break;
+    cursor = m_cursor;
+    frame = m_frame;
+  }
+  m_cursor = cursor;
+  m_frame = frame;
+  return m_frame < m_frameCount;
+}
+
+bool CaptureReader::Next(CaptureFrameView &out) {
+  if (m_frame >= m_frameCount)
+    return false;
+  uint64_t next = 0;
+  if (!ReadAt(m_cursor, out, &next))
+    return false;
+  m_cursor = next;
+  ++m_frame;
+  return true;
+}
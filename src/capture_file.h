@@ -0,0 +1,195 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Capture file — binary frame log with index, memory-mapped writer
+// ────────────────────────────────────────────────────────────────────────
+#ifndef CAPTURE_FILE_H
+#define CAPTURE_FILE_H
+
+#include "mpsc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ── On-disk layout (little-endian) ──────────────────────────────────────
+//    CaptureFileHeader
+//    { CaptureRecordHeader, payload, zero padding to 8 bytes } ...
+//    CaptureIndexEntry ...   (one per kCaptureIndexStride frames)
+//    CaptureFooter
+//    A file without a footer (writer killed) is still readable: records
+//    are self-delimiting and the unwritten tail of the file is zeros.
+constexpr char kCaptureMagic[8] = {'R', 'D', 'X', 'C', 'A', 'P', '0', '1'};
+constexpr char kCaptureIndexMagic[8] = {'R', 'D', 'X', 'I', 'D', 'X', '0', '1'};
+constexpr uint32_t kCaptureVersion = 1;
+constexpr int kCaptureIndexStride = 256;
+constexpr int kCaptureMaxPayload = 600; // largest Enttec packet payload
+
+enum class CaptureDirection : uint8_t { TX = 0, RX = 1 };
+
+// `label`: Enttec widget label for Enttec frames (payload excludes the
+// 0x7E / label / length / 0xE7 framing), CAPTURE_LABEL_RAW for raw line
+// slots (Peperoni: start code first).
+constexpr uint8_t CAPTURE_LABEL_RAW = 0;
+
+#pragma pack(push, 1)
+struct CaptureFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  int64_t startUs;     // RdmNowUs() when the capture started
+  int64_t wallClockUs; // UTC microseconds since 1970 at the same moment
+  uint64_t reserved;
+};
+
+struct CaptureRecordHeader {
+  int64_t timestampUs; // RdmNowUs clock
+  uint16_t length;     // payload bytes
+  uint8_t direction;   // CaptureDirection
+  uint8_t port;
+  uint8_t label;
+  uint8_t flags;
+  uint16_t reserved;
+};
+
+struct CaptureIndexEntry {
+  uint64_t frame;  // frame number (multiple of kCaptureIndexStride)
+  uint64_t offset; // file offset of its record header
+  int64_t timestampUs;
+};
+
+struct CaptureFooter {
+  char magic[8];
+  uint64_t indexOffset;
+  uint64_t indexCount;
+  uint64_t frameCount;
+  uint64_t dropped; // frames lost to a full writer queue
+};
+#pragma pack(pop)
+
+static_assert(sizeof(CaptureFileHeader) == 40, "capture header layout");
+static_assert(sizeof(CaptureRecordHeader) == 16, "capture record layout");
+static_assert(sizeof(CaptureIndexEntry) == 24, "capture index layout");
+static_assert(sizeof(CaptureFooter) == 40, "capture footer layout");
+
+// One frame as read back (payload points into the reader's buffer)
+struct CaptureFrameView {
+  int64_t timestampUs = 0;
+  CaptureDirection direction = CaptureDirection::TX;
+  uint8_t port = 0;
+  uint8_t label = 0;
+  uint8_t flags = 0;
+  uint16_t length = 0;
+  const uint8_t *payload = nullptr;
+};
+
+// ── CaptureWriter ───────────────────────────────────────────────────────
+//    Append() copies the frame into a lock-free queue and returns; it
+//    never touches the file, so it cannot stall the I/O thread (a full
+//    queue drops the frame and counts it).  A writer thread appends
+//    queued frames into a memory-mapped view of the file, growing the
+//    mapping in kGrowBytes steps.  Close() drains the queue, writes the
+//    index and footer and trims the file to its final size.
+class CaptureWriter {
+public:
+  static constexpr size_t kQueueFrames = 2048;
+  static constexpr uint64_t kGrowBytes = 16ull << 20;
+
+  CaptureWriter();
+  ~CaptureWriter();
+  CaptureWriter(const CaptureWriter &) = delete;
+  CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+  bool Open(const std::string &path);
+  void Close();
+  bool IsOpen() const { return m_running.load(std::memory_order_acquire); }
+
+  // Any thread.  Payloads longer than kCaptureMaxPayload are truncated.
+  bool Append(int64_t timestampUs, CaptureDirection dir, uint8_t port,
+              uint8_t label, uint8_t flags, const uint8_t *data, int len);
+
+  uint64_t Frames() const { return m_frames.load(std::memory_order_relaxed); }
+  uint64_t Dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+  uint64_t Bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+
+private:
+  struct Pending {
+    CaptureRecordHeader header;
+    uint8_t payload[kCaptureMaxPayload];
+  };
+  class MappedFile; // platform mapping (capture_file.cpp)
+
+  void WriterLoop();
+  bool WriteRecord(const Pending &p);
+
+  std::unique_ptr<MpscRing<Pending, kQueueFrames>> m_queue;
+  std::unique_ptr<MappedFile> m_file;
+  std::thread m_thread;
+  std::atomic<bool> m_running{false};
+
+  // Writer-thread state
+  uint64_t m_offset = 0;
+  uint64_t m_written = 0;
+  std::vector<CaptureIndexEntry> m_index;
+
+  std::atomic<uint64_t> m_frames{0};
+  std::atomic<uint64_t> m_dropped{0};
+  std::atomic<uint64_t> m_bytes{0};
+};
+
+// ── CaptureReader ───────────────────────────────────────────────────────
+//    Maps a capture read-only (or takes one from memory).  Uses the footer
+//    index when present, otherwise rebuilds it with one scan.  Sequential
+//    access via Next(); Seek() / SeekTime() jump through the index.  Frame
+//    payloads point into the mapping and stay valid until the reader is
+//    reopened or destroyed.
+class CaptureReader {
+public:
+  CaptureReader() = default;
+  ~CaptureReader();
+  CaptureReader(const CaptureReader &) = delete;
+  CaptureReader &operator=(const CaptureReader &) = delete;
+
+  bool Open(const std::string &path);
+  bool Load(std::vector<uint8_t> bytes); // same, from memory
+
+  const CaptureFileHeader &Header() const { return m_header; }
+  uint64_t FrameCount() const { return m_frameCount; }
+  uint64_t Dropped() const { return m_dropped; }
+  bool HadFooter() const { return m_hadFooter; } // writer closed cleanly
+  uint64_t Size() const { return m_size; }       // bytes
+
+  bool Seek(uint64_t frame);
+  bool SeekTime(int64_t timestampUs); // first frame at or after
+  bool Next(CaptureFrameView &out);
+  uint64_t Position() const { return m_frame; }
+
+private:
+  bool Attach(const uint8_t *data, uint64_t size);
+  void Unmap();
+  bool ReadAt(uint64_t offset, CaptureFrameView &out,
+              uint64_t *next) const;
+  void Scan();
+
+  const uint8_t *m_data = nullptr;
+  uint64_t m_size = 0;
+  std::vector<uint8_t> m_owned; // Load()
+  void *m_file = nullptr;       // Open(): file, mapping and view handles
+  void *m_mapping = nullptr;
+  void *m_view = nullptr;
+
+  CaptureFileHeader m_header = {};
+  std::vector<CaptureIndexEntry> m_index;
+  uint64_t m_end = 0; // end of the record area
+  uint64_t m_frameCount = 0;
+  uint64_t m_dropped = 0;
+  bool m_hadFooter = false;
+
+  uint64_t m_cursor = 0; // file offset of the next record
+  uint64_t m_frame = 0;  // its frame number
+};
+
+#endif // CAPTURE_FILE_H
@@ -0,0 +1,236 @@
+// ────────────────────────────────────────────────────────────────────────
+// ConfigPusher — applies a map settings column to whole ports of fixtures
+// ────────────────────────────────────────────────────────────────────────
+#include "config_push.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
+std::vector<ConfigSet> ConfigFromMap(const std::vector<RDMParameterRow> &rows,
+                                     ConfigColumn column) {
+  auto cell = [column](const RDMParameterRow &row) -> const std::string & {
+    switch (column) {
+    case ConfigColumn::FW_DEFAULTS:
+      return row.fwDefault;
+    case ConfigColumn::TEST:
+      return row.testValue;
+    default:
+      return row.shippingValue;
+    }
+  };
+
+  std::vector<ConfigSet> config;
+  std::set<uint16_t> seen, settable;
+  for (const RDMParameterRow &row : rows) {
+    if (row.commandClass == RDM_CC_SET && row.pid != PID_IDENTIFY_DEVICE)
+      settable.insert(row.pid);
+    std::vector<uint8_t> value;
+    if (seen.count(row.pid) || !ParseHexBytes(cell(row), value))
+      continue;
+    seen.insert(row.pid);
+    ConfigSet c;
+    c.pid = row.pid;
+    c.name = row.name;
+    c.value = std::move(value);
+    config.push_back(std::move(c));
+  }
+  config.erase(std::remove_if(config.begin(), config.end(),
+                              [&settable](const ConfigSet &c) {
+                                return !settable.count(c.pid);
+                              }),
+               config.end());
+  return config;
+}
+
+// GET answers "current, count"; SET takes the current selection only
+static bool GetAppendsCount(uint16_t pid) {
+  return pid == PID_DMX_PERSONALITY || pid == PID_CURVE ||
+         pid == PID_OUTPUT_RESPONSE_TIME || pid == PID_MODULATION_FREQUENCY;
+}
+
+bool ConfigMatches(uint16_t pid, const std::vector<uint8_t> &current,
+                   const std::vector<uint8_t> &value) {
+  if (!GetAppendsCount(pid))
+    return current == value;
+  return current.size() >= value.size() &&
+         std::equal(value.begin(), value.end(), current.begin());
+}
+
+int64_t AckTimerUs(const RDMResponse &resp) {
+  if (resp.type != RDMResponseType::ACK_TIMER || resp.data.size() < 2)
+    return 0;
+  return ((resp.data[0] << 8) | resp.data[1]) * 100000LL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Known values
+// ═══════════════════════════════════════════════════════════════════════
+
+bool ConfigPusher::Known(uint64_t uid, uint16_t pid,
+                         std::vector<uint8_t> &out) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto fx = m_known.find(uid);
+  if (fx == m_known.end())
+    return false;
+  auto it = fx->second.find(pid);
+  if (it == fx->second.end())
+    return false;
+  out = it->second;
+  return true;
+}
+
+void ConfigPusher::Remember(uint64_t uid, uint16_t pid,
+                            const std::vector<uint8_t> &v) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_known[uid][pid] = v;
+}
+
+void ConfigPusher::Drop(uint64_t uid, uint16_t pid) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto fx = m_known.find(uid);
+  if (fx != m_known.end())
+    fx->second.erase(pid);
+}
+
+void ConfigPusher::Forget(uint64_t uid) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_known.erase(uid);
+}
+
+void ConfigPusher::Clear() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_known.clear();
+}
+
+size_t ConfigPusher::KnownCount() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  size_t n = 0;
+  for (const auto &fx : m_known)
+    n += fx.second.size();
+  return n;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Push
+// ═══════════════════════════════════════════════════════════════════════
+
+std::vector<PushResult> ConfigPusher::Push(
+    const std::vector<PushTarget> &port, const std::vector<ConfigSet> &config,
+    const PushOptions &opts) {
+  std::vector<PushResult> results(port.size());
+  std::vector<int64_t> startUs(port.size(), 0);
+  // pending[i][j]: config[j] still has to be sent to port[i]
+  std::vector<std::vector<bool>> pending(
+      port.size(), std::vector<bool>(config.size(), true));
+  // readyUs[i][j]: ACK_TIMER commit time of config[j] on port[i]
+  std::vector<std::vector<int64_t>> readyUs(
+      port.size(), std::vector<int64_t>(config.size(), 0));
+  auto touch = [&](size_t i) {
+    int64_t now = RdmNowUs();
+    if (!startUs[i])
+      startUs[i] = now;
+    results[i].elapsedUs = now - startUs[i];
+  };
+
+  for (size_t i = 0; i < port.size(); ++i) {
+    results[i].uid = port[i].uid;
+    results[i].items.resize(config.size());
+    for (size_t j = 0; j < config.size(); ++j)
+      results[i].items[j].pid = config[j].pid;
+  }
+
+  // 1. Compare: leave out what the fixture already holds
+  for (size_t i = 0; i < port.size() && opts.skipMatching; ++i) {
+    const PushTarget &fx = port[i];
+    PushResult &r = results[i];
+    for (size_t j = 0; j < config.size(); ++j) {
+      const ConfigSet &c = config[j];
+      std::vector<uint8_t> current;
+      bool matches = false;
+      if (opts.useKnown && Known(fx.uid, c.pid, current)) {
+        ++r.known;
+        matches = ConfigMatches(c.pid, current, c.value);
+      } else {
+        touch(i);
+        RDMResponse resp = fx.get(c.pid, {});
+        ++r.gets;
+        touch(i);
+        matches = resp.type == RDMResponseType::ACK &&
+                  ConfigMatches(c.pid, resp.data, c.value);
+        if (matches)
+          Remember(fx.uid, c.pid, c.value);
+      }
+      if (matches) {
+        pending[i][j] = false;
+        ++r.skipped;
+      }
+    }
+  }
+
+  // 2. SET what differs, fixture after fixture
+  for (size_t i = 0; i < port.size(); ++i) {
+    PushResult &r = results[i];
+    for (size_t j = 0; j < config.size(); ++j) {
+      if (!pending[i][j])
+        continue;
+      PushItem &item = r.items[j];
+      Drop(port[i].uid, config[j].pid); // known again once read back
+      touch(i);
+      RDMResponse resp = port[i].set(config[j].pid, config[j].value);
+      ++r.sets;
+      touch(i);
+      item.setResponse = resp.type;
+      item.nackReason = resp.nackReason;
+      if (int64_t waitUs = AckTimerUs(resp))
+        readyUs[i][j] = RdmNowUs() + waitUs;
+      bool accepted = resp.type == RDMResponseType::ACK ||
+                      resp.type == RDMResponseType::ACK_TIMER;
+      item.outcome = accepted ? PushOutcome::SET : PushOutcome::FAILED;
+      if (!accepted) {
+        ++r.failed;
+        pending[i][j] = false;
+      }
+    }
+  }
+
+  // 3. Read back, once every fixture of the port has had its SETs
+  for (size_t i = 0; i < port.size() && opts.verify; ++i) {
+    PushResult &r = results[i];
+    for (size_t j = 0; j < config.size(); ++j) {
+      if (!pending[i][j])
+        continue;
+      int64_t waitUs = readyUs[i][j] - RdmNowUs();
+      if (waitUs > 0)
+        std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+      touch(i);
+      RDMResponse resp = port[i].get(config[j].pid, {});
+      ++r.verifies;
+      touch(i);
+      if (resp.type == RDMResponseType::ACK &&
+          ConfigMatches(config[j].pid, resp.data, config[j].value)) {
+        Remember(port[i].uid, config[j].pid, config[j].value);
+        continue;
+      }
+      PushItem &item = r.items[j];
+      if (resp.type == RDMResponseType::ACK_TIMER) {
+        item.outcome = PushOutcome::PENDING;
+        ++r.pending;
+        continue;
+      }
+      item.outcome = PushOutcome::MISMATCH;
+      item.readBack = std::move(resp.data);
+      ++r.mismatched;
+    }
+  }
+
+  for (const PushResult &r : results)
+    TRACE_DEBUG("[Push] %012llX: %d set, %d failed, %d mismatched, "
+                "%d pending in %lld us\n",
+                (unsigned long long)r.uid, r.sets - r.failed, r.failed,
+                r.mismatched, r.pending, (long long)r.elapsedUs);
+  return results;
+}
@@ -0,0 +1,140 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// ConfigPusher — applies a map settings column to whole ports of fixtures
+// ────────────────────────────────────────────────────────────────────────
+#ifndef CONFIG_PUSH_H
+#define CONFIG_PUSH_H
+
+#include "parameter_loader.h"
+#include "validator.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The map's Settings columns
+enum class ConfigColumn : uint8_t {
+  FW_DEFAULTS,
+  TEST,
+  SHIPPING,
+};
+
+struct ConfigSet {
+  uint16_t pid = 0;
+  std::string name;
+  std::vector<uint8_t> value; // SET payload, big-endian
+};
+
+// Every settable PID (a SET row, identify excluded) with a hex literal in
+// `column` on any of its rows — the map puts some values on the GET row.
+// Map order; PIDs whose cell is empty or prose are left out.
+std::vector<ConfigSet> ConfigFromMap(const std::vector<RDMParameterRow> &rows,
+                                     ConfigColumn column);
+
+// A GET answer of `pid` shows the SET payload `value` when it is the same
+// bytes.  A few GETs return the setting followed by more than the SET
+// takes (DMX_PERSONALITY, CURVE, OUTPUT_RESPONSE_TIME, MODULATION_FREQUENCY:
+// current, count); for those the answer only has to start with `value`.
+bool ConfigMatches(uint16_t pid, const std::vector<uint8_t> &current,
+                   const std::vector<uint8_t> &value);
+
+// One SET to the fixture being configured, same shape as RDMGet
+using RDMSet = RDMGet;
+
+enum class PushOutcome : uint8_t {
+  SKIPPED,  // already held the value
+  SET,      // SET accepted (and read back, when verifying)
+  FAILED,   // SET not accepted: NACK, timeout, invalid reply
+  MISMATCH, // SET accepted, the read-back shows another value
+  PENDING,  // SET answered ACK_TIMER and not committed by the read-back
+};
+
+// The wait an ACK_TIMER reply asks for (E1.20: 100 ms units); 0 for any
+// other reply
+int64_t AckTimerUs(const RDMResponse &resp);
+
+struct PushItem {
+  uint16_t pid = 0;
+  PushOutcome outcome = PushOutcome::SKIPPED;
+  RDMResponseType setResponse = RDMResponseType::TIMEOUT; // when sent
+  uint16_t nackReason = 0;
+  std::vector<uint8_t> readBack; // verify GET data (MISMATCH)
+};
+
+struct PushResult {
+  uint64_t uid = 0;
+  std::vector<PushItem> items; // config order
+  int gets = 0;    // compare GETs
+  int sets = 0;
+  int verifies = 0; // read-back GETs
+  int known = 0;   // compares answered from values pushed before
+  int skipped = 0;
+  int failed = 0;
+  int mismatched = 0;
+  int pending = 0;
+  int64_t elapsedUs = 0; // first to last transaction of this fixture
+
+  bool Ok() const { return failed == 0 && mismatched == 0; }
+  int Transactions() const { return gets + sets + verifies; }
+};
+
+struct PushOptions {
+  bool skipMatching = true; // GET first, SET only what differs
+  bool verify = true;       // read every SET back
+  // Trust the values this pusher set and verified before instead of a
+  // compare GET.  Off when something else may have changed them.
+  bool useKnown = false;
+};
+
+// A fixture of a port and how to reach it
+struct PushTarget {
+  uint64_t uid = 0;
+  RDMGet get;
+  RDMSet set;
+};
+
+// Pushes a configuration to every fixture of one port in three passes —
+// compare GETs, SETs, read-back GETs — each across all the fixtures, so a
+// fixture has had the other fixtures' SETs worth of time to commit its
+// values before it is read back.  A SET answered with ACK_TIMER is read
+// back no earlier than the fixture asked for; if the read-back is deferred
+// again the item is PENDING rather than a mismatch.  Ports are independent
+// and may be pushed from their own threads at the same time.
+//
+// Values read back (or found matching) are remembered per UID for
+// PushOptions::useKnown.  Thread-safe.
+class ConfigPusher {
+public:
+  std::vector<PushResult> Push(const std::vector<PushTarget> &port,
+                               const std::vector<ConfigSet> &config,
+                               const PushOptions &opts = {});
+
+  void Forget(uint64_t uid);
+  void Clear();
+  size_t KnownCount() const; // (UID, PID) values remembered
+
+private:
+  bool Known(uint64_t uid, uint16_t pid, std::vector<uint8_t> &out) const;
+  void Remember(uint64_t uid, uint16_t pid, const std::vector<uint8_t> &v);
+  void Drop(uint64_t uid, uint16_t pid);
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<uint64_t, std::map<uint16_t, std::vector<uint8_t>>>
+      m_known;
+};
+
+// Binds RDMSetCommand on a driver for one fixture
+template <typename Driver>
+RDMSet PushSet(Driver &bus, uint64_t srcUID, uint64_t destUID) {
+  return [&bus, srcUID, destUID](uint16_t pid,
+                                 const std::vector<uint8_t> &pd) {
+    return RDMSetCommand(bus, srcUID, destUID, pid,
+                         pd.empty() ? nullptr : pd.data(),
+                         static_cast<uint8_t>(pd.size()));
+  };
+}
+
+#endif // CONFIG_PUSH_H
@@ -0,0 +1,296 @@
+// ────────────────────────────────────────────────────────────────────────
+// DescriptorCache — descriptive PIDs read once per model and firmware
+// ────────────────────────────────────────────────────────────────────────
+#include "descriptor_cache.h"
+#include "trace_ring.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+bool ParseModelKey(uint64_t uid, const std::vector<uint8_t> &deviceInfo,
+                   ModelKey &out) {
+  // protocol(2) | model(2) | category(2) | software version(4) | ...
+  if (deviceInfo.size() < 10)
+    return false;
+  const uint8_t *d = deviceInfo.data();
+  out.manufacturer = static_cast<uint16_t>(uid >> 32);
+  out.model = static_cast<uint16_t>((d[2] << 8) | d[3]);
+  out.softwareVersion = (static_cast<uint32_t>(d[6]) << 24) |
+                        (static_cast<uint32_t>(d[7]) << 16) |
+                        (static_cast<uint32_t>(d[8]) << 8) | d[9];
+  return true;
+}
+
+bool IsDescriptorPid(uint16_t pid) {
+  switch (pid) {
+  case PID_PARAMETER_DESCRIPTION:
+  case PID_DEVICE_MODEL_DESCRIPTION:
+  case PID_MANUFACTURER_LABEL:
+  case PID_SOFTWARE_VERSION_LABEL:
+  case PID_DMX_PERSONALITY_DESCRIPTION:
+  case PID_SENSOR_DEFINITION:
+  case PID_CURVE_DESCRIPTION:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Answers the model gives every time.  A NACK for a busy or faulty unit
+// says nothing about the model.
+static bool Cacheable(const RDMResponse &r) {
+  if (r.type == RDMResponseType::ACK)
+    return true;
+  if (r.type != RDMResponseType::NACK)
+    return false;
+  switch (r.nackReason) {
+  case NR_UNKNOWN_PID:
+  case NR_FORMAT_ERROR:
+  case NR_UNSUPPORTED_COMMAND_CLASS:
+  case NR_DATA_OUT_OF_RANGE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Lookup
+// ═══════════════════════════════════════════════════════════════════════
+
+RDMGet DescriptorCache::Wrap(RDMGet get, uint64_t uid, int *served) {
+  // DEVICE_INFO as read for the key, handed out once if asked for
+  struct Fixture {
+    bool probed = false;
+    bool infoUsed = false;
+    RDMResponse info;
+    bool valid = false;
+    ModelKey key;
+  };
+  auto fx = std::make_shared<Fixture>();
+  auto setInfo = [fx, uid](const RDMResponse &info) {
+    fx->probed = true;
+    fx->info = info;
+    fx->valid = info.type == RDMResponseType::ACK &&
+                ParseModelKey(uid, info.data, fx->key);
+  };
+
+  return [this, fx, get, served, setInfo](uint16_t pid,
+                                          const std::vector<uint8_t> &pd) {
+    if (pid == PID_DEVICE_INFO && pd.empty()) {
+      if (fx->probed && !fx->infoUsed) {
+        fx->infoUsed = true;
+        RDMResponse r = fx->info;
+        r.cached = true;
+        return r;
+      }
+      RDMResponse r = get(pid, pd);
+      if (!fx->probed) {
+        setInfo(r);
+        fx->infoUsed = true;
+      }
+      return r;
+    }
+    if (!IsDescriptorPid(pid))
+      return get(pid, pd);
+
+    if (!fx->probed)
+      setInfo(get(PID_DEVICE_INFO, {}));
+    RDMResponse r;
+    if (fx->valid && Find(fx->key, pid, pd, r)) {
+      if (served)
+        ++*served;
+      r.cached = true;
+      return r;
+    }
+    r = get(pid, pd);
+    if (fx->valid)
+      Store(fx->key, pid, pd, r);
+    return r;
+  };
+}
+
+bool DescriptorCache::Find(const ModelKey &key, uint16_t pid,
+                           const std::vector<uint8_t> &pd,
+                           RDMResponse &out) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto model = m_models.find(key);
+  if (model != m_models.end()) {
+    auto it = model->second.find(Key(pid, pd));
+    if (it != model->second.end()) {
+      out.type = it->second.type;
+      out.nackReason = it->second.nackReason;
+      out.data = it->second.data;
+      ++m_hits;
+      return true;
+    }
+  }
+  ++m_misses;
+  return false;
+}
+
+void DescriptorCache::Store(const ModelKey &key, uint16_t pid,
+                            const std::vector<uint8_t> &pd,
+                            const RDMResponse &resp) {
+  if (!Cacheable(resp))
+    return;
+  Entry e;
+  e.type = resp.type;
+  e.nackReason = resp.nackReason;
+  e.data = resp.data;
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_models[key][Key(pid, pd)] = std::move(e);
+}
+
+void DescriptorCache::Clear() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_models.clear();
+  m_hits = m_misses = 0;
+}
+
+DescriptorStats DescriptorCache::Stats() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  DescriptorStats s;
+  s.hits = m_hits;
+  s.misses = m_misses;
+  s.models = m_models.size();
+  for (const auto &m : m_models)
+    s.entries += m.second.size();
+  return s;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// File
+// ═══════════════════════════════════════════════════════════════════════
+
+// manufacturer model software pid param-data A|N nack data check; "-" =
+// empty.  `check` is FNV-1a over the rest of the line, so a line that was
+// cut short or edited is dropped instead of being served to every fixture
+// of the model.  Files of another version are not read at all.
+static const char *kHeader = "# RDM-X descriptor cache v2";
+
+static uint32_t LineCheck(const std::string &s) {
+  uint32_t h = 2166136261u;
+  for (char c : s) {
+    h ^= static_cast<uint8_t>(c);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static void PutHex(std::string &out, const std::vector<uint8_t> &v) {
+  if (v.empty())
+    out += '-';
+  char buf[3];
+  for (uint8_t b : v) {
+    snprintf(buf, sizeof(buf), "%02X", b);
+    out += buf;
+  }
+}
+
+static bool GetHex(const char *s, std::vector<uint8_t> &out) {
+  out.clear();
+  if (strcmp(s, "-") == 0)
+    return true;
+  size_t n = strlen(s);
+  if (n % 2)
+    return false;
+  for (size_t i = 0; i < n; i += 2) {
+    unsigned b;
+    if (sscanf(s + i, "%2x", &b) != 1)
+      return false;
+    out.push_back(static_cast<uint8_t>(b));
+  }
+  return true;
+}
+
+bool DescriptorCache::Save(const std::string &path) const {
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f)
+    return false;
+  fprintf(f, "%s\n", kHeader);
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (const auto &m : m_models) {
+      for (const auto &e : m.second) {
+        char head[64];
+        snprintf(head, sizeof(head), "%04X %04X %08X %04X ",
+                 m.first.manufacturer, m.first.model,
+                 m.first.softwareVersion, e.first.first);
+        std::string line = head;
+        PutHex(line, e.first.second);
+        snprintf(head, sizeof(head), " %c %04X ",
+                 e.second.type == RDMResponseType::ACK ? 'A' : 'N',
+                 e.second.nackReason);
+        line += head;
+        PutHex(line, e.second.data);
+        fprintf(f, "%s %08X\n", line.c_str(), LineCheck(line));
+      }
+    }
+  }
+  return fclose(f) == 0;
+}
+
+int DescriptorCache::Load(const std::string &path) {
+  FILE *f = fopen(path.c_str(), "r");
+  if (!f)
+    return -1;
+  char line[1200];
+  if (!fgets(line, sizeof(line), f) ||
+      strncmp(line, kHeader, strlen(kHeader)) != 0 ||
+      (line[strlen(kHeader)] != '\n' && line[strlen(kHeader)] != '\0')) {
+    fclose(f);
+    TRACE_ERROR("[Descriptors] %s is not a v2 descriptor cache, ignored\n",
+                path.c_str());
+    return -1;
+  }
+  int count = 0, corrupt = 0;
+  char pd[520], data[520];
+  while (fgets(line, sizeof(line), f)) {
+    if (line[0] == '#')
+      continue;
+    // The check is the last field; everything before it is hashed
+    std::string text(line);
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+      text.pop_back();
+    size_t space = text.rfind(' ');
+    unsigned check = 0;
+    if (space == std::string::npos ||
+        sscanf(text.c_str() + space + 1, "%x", &check) != 1 ||
+        LineCheck(text.substr(0, space)) != check) {
+      ++corrupt;
+      continue;
+    }
+    unsigned manufacturer, model, software, pid, nack;
+    char type;
+    if (sscanf(line, "%x %x %x %x %519s %c %x %519s", &manufacturer, &model,
+               &software, &pid, pd, &type, &nack, data) != 8 ||
+        (type != 'A' && type != 'N')) {
+      ++corrupt;
+      continue;
+    }
+    ModelKey key;
+    key.manufacturer = static_cast<uint16_t>(manufacturer);
+    key.model = static_cast<uint16_t>(model);
+    key.softwareVersion = software;
+    std::vector<uint8_t> param;
+    RDMResponse resp;
+    resp.type = type == 'A' ? RDMResponseType::ACK : RDMResponseType::NACK;
+    resp.nackReason = static_cast<uint16_t>(nack);
+    if (!GetHex(pd, param) || !GetHex(data, resp.data)) {
+      ++corrupt;
+      continue;
+    }
+    Store(key, static_cast<uint16_t>(pid), param, resp);
+    ++count;
+  }
+  fclose(f);
+  if (corrupt)
+    TRACE_ERROR("[Descriptors] %d damaged line(s) in %s skipped\n", corrupt,
+                path.c_str());
+  TRACE_INFO("[Descriptors] %d response(s) loaded from %s\n", count,
+             path.c_str());
+  return count;
+}
@@ -0,0 +1,92 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// DescriptorCache — descriptive PIDs read once per model and firmware
+// ────────────────────────────────────────────────────────────────────────
+#ifndef DESCRIPTOR_CACHE_H
+#define DESCRIPTOR_CACHE_H
+
+#include "validator.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// What makes two fixtures answer descriptive PIDs the same way
+struct ModelKey {
+  uint16_t manufacturer = 0;    // UID, upper 16 bits
+  uint16_t model = 0;           // DEVICE_INFO device model ID
+  uint32_t softwareVersion = 0; // DEVICE_INFO software version ID
+
+  bool operator<(const ModelKey &o) const {
+    if (manufacturer != o.manufacturer)
+      return manufacturer < o.manufacturer;
+    if (model != o.model)
+      return model < o.model;
+    return softwareVersion < o.softwareVersion;
+  }
+};
+
+// From a DEVICE_INFO response (at least the first 10 bytes)
+bool ParseModelKey(uint64_t uid, const std::vector<uint8_t> &deviceInfo,
+                   ModelKey &out);
+
+// PARAMETER_DESCRIPTION, DEVICE_MODEL_DESCRIPTION, MANUFACTURER_LABEL,
+// SOFTWARE_VERSION_LABEL, DMX_PERSONALITY_DESCRIPTION, SENSOR_DEFINITION
+// and CURVE_DESCRIPTION: fixed by the model and its firmware
+bool IsDescriptorPid(uint16_t pid);
+
+struct DescriptorStats {
+  uint64_t hits = 0;   // GETs answered from the cache
+  uint64_t misses = 0; // descriptor GETs sent
+  size_t models = 0;
+  size_t entries = 0;
+};
+
+// Descriptor responses (ACK or NACK; never a timeout) stored once per
+// (manufacturer, model, software version) and served to every other
+// fixture of that key.  Wrap() puts the cache in front of a fixture's GET
+// function; the first descriptor GET of a fixture reads its DEVICE_INFO
+// (reused when DEVICE_INFO itself is asked for), everything else passes
+// straight through.
+//
+// Save() / Load() keep the cache between runs in a versioned text file,
+// one response per line, each line with its own check.  Only responses
+// the command layer accepted (checksum, source UID, transaction, PID
+// matching the request) reach Store().  Thread-safe.
+class DescriptorCache {
+public:
+  // `served`, when given, counts the GETs this fixture was spared
+  RDMGet Wrap(RDMGet get, uint64_t uid, int *served = nullptr);
+
+  // Counts a hit or a miss
+  bool Find(const ModelKey &key, uint16_t pid,
+            const std::vector<uint8_t> &pd, RDMResponse &out) const;
+  void Store(const ModelKey &key, uint16_t pid,
+             const std::vector<uint8_t> &pd, const RDMResponse &resp);
+
+  bool Save(const std::string &path) const;
+  // Merges the file into the cache; returns the entries read, -1 when the
+  // file cannot be read or is of another version.  Damaged lines are
+  // skipped.
+  int Load(const std::string &path);
+  void Clear();
+
+  DescriptorStats Stats() const;
+
+private:
+  struct Entry {
+    RDMResponseType type = RDMResponseType::ACK;
+    uint16_t nackReason = 0;
+    std::vector<uint8_t> data;
+  };
+  using Key = std::pair<uint16_t, std::vector<uint8_t>>; // PID, param data
+
+  mutable std::mutex m_mutex;
+  std::map<ModelKey, std::map<Key, Entry>> m_models;
+  mutable uint64_t m_hits = 0; // counted by Find()
+  mutable uint64_t m_misses = 0;
+};
+
+#endif // DESCRIPTOR_CACHE_H
@@ -0,0 +1,161 @@
+// ────────────────────────────────────────────────────────────────────────
+// DeviceProfile — every indexed descriptor of a fixture in one pass
+// ────────────────────────────────────────────────────────────────────────
+#include "device_profile.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+
+static uint16_t Get16(const uint8_t *d) {
+  return static_cast<uint16_t>((d[0] << 8) | d[1]);
+}
+
+static uint32_t Get32(const uint8_t *d) {
+  return (static_cast<uint32_t>(d[0]) << 24) |
+         (static_cast<uint32_t>(d[1]) << 16) |
+         (static_cast<uint32_t>(d[2]) << 8) | d[3];
+}
+
+// Up to 32 ASCII characters after `from`, NUL padding dropped
+static std::string Label(const std::vector<uint8_t> &data, size_t from) {
+  if (data.size() <= from)
+    return std::string();
+  size_t n = std::min<size_t>(data.size() - from, 32);
+  std::string s(data.begin() + from, data.begin() + from + n);
+  s.erase(s.find_last_not_of('\0') + 1);
+  return s;
+}
+
+bool ParseDeviceInfo(const std::vector<uint8_t> &data, DeviceInfo &out) {
+  if (data.size() < 19)
+    return false;
+  const uint8_t *d = data.data();
+  out.protocol = Get16(d);
+  out.model = Get16(d + 2);
+  out.category = Get16(d + 4);
+  out.softwareVersion = Get32(d + 6);
+  out.footprint = Get16(d + 10);
+  out.personality = d[12];
+  out.personalityCount = d[13];
+  out.startAddress = Get16(d + 14);
+  out.subDevices = Get16(d + 16);
+  out.sensorCount = d[18];
+  return true;
+}
+
+bool ParsePersonalityDesc(const std::vector<uint8_t> &data,
+                          PersonalityDesc &out) {
+  if (data.size() < 3)
+    return false;
+  out.number = data[0];
+  out.footprint = Get16(&data[1]);
+  out.description = Label(data, 3);
+  return true;
+}
+
+bool ParseSensorDef(const std::vector<uint8_t> &data, SensorDef &out) {
+  if (data.size() < 13)
+    return false;
+  const uint8_t *d = data.data();
+  out.number = d[0];
+  out.type = d[1];
+  out.unit = d[2];
+  out.prefix = d[3];
+  out.rangeMin = static_cast<int16_t>(Get16(d + 4));
+  out.rangeMax = static_cast<int16_t>(Get16(d + 6));
+  out.normalMin = static_cast<int16_t>(Get16(d + 8));
+  out.normalMax = static_cast<int16_t>(Get16(d + 10));
+  out.recordedSupport = d[12];
+  out.description = Label(data, 13);
+  return true;
+}
+
+bool ParseParameterDesc(const std::vector<uint8_t> &data, ParameterDesc &out) {
+  if (data.size() < 20)
+    return false;
+  const uint8_t *d = data.data();
+  out.pid = Get16(d);
+  out.pdlSize = d[2];
+  out.dataType = d[3];
+  out.commandClass = d[4];
+  out.type = d[5];
+  out.unit = d[6];
+  out.prefix = d[7];
+  out.minValue = Get32(d + 8);
+  out.maxValue = Get32(d + 12);
+  out.defaultValue = Get32(d + 16);
+  out.description = Label(data, 20);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Enumeration
+// ═══════════════════════════════════════════════════════════════════════
+
+DeviceProfile ReadDeviceProfile(const RDMGet &get, uint64_t uid) {
+  DeviceProfile p;
+  p.uid = uid;
+  int64_t t0 = RdmNowUs();
+  auto ask = [&](uint16_t pid, const std::vector<uint8_t> &pd) {
+    ++p.requests;
+    return get(pid, pd);
+  };
+
+  RDMResponse info = ask(PID_DEVICE_INFO, {});
+  p.haveInfo = info.type == RDMResponseType::ACK &&
+               ParseDeviceInfo(info.data, p.info);
+  RDMResponse supported = ask(PID_SUPPORTED_PARAMS, {});
+  if (supported.type == RDMResponseType::ACK) {
+    p.haveSupported = true;
+    for (size_t i = 0; i + 1 < supported.data.size(); i += 2)
+      p.supported.push_back(Get16(&supported.data[i]));
+  }
+
+  // Everything the counts call for, decided before the first indexed GET
+  struct Indexed {
+    uint16_t pid;
+    std::vector<uint8_t> pd;
+  };
+  std::vector<Indexed> batch;
+  for (int i = 1; i <= p.info.personalityCount; ++i)
+    batch.push_back({PID_DMX_PERSONALITY_DESCRIPTION,
+                     {static_cast<uint8_t>(i)}});
+  for (int i = 0; i < p.info.sensorCount; ++i)
+    batch.push_back({PID_SENSOR_DEFINITION, {static_cast<uint8_t>(i)}});
+  for (uint16_t pid : p.supported)
+    if (pid >= 0x8000)
+      batch.push_back({PID_PARAMETER_DESCRIPTION,
+                       {static_cast<uint8_t>(pid >> 8),
+                        static_cast<uint8_t>(pid)}});
+
+  for (const Indexed &g : batch) {
+    RDMResponse r = ask(g.pid, g.pd);
+    bool ok = r.type == RDMResponseType::ACK;
+    if (ok && g.pid == PID_DMX_PERSONALITY_DESCRIPTION) {
+      PersonalityDesc d;
+      ok = ParsePersonalityDesc(r.data, d);
+      if (ok)
+        p.personalities.push_back(std::move(d));
+    } else if (ok && g.pid == PID_SENSOR_DEFINITION) {
+      SensorDef d;
+      ok = ParseSensorDef(r.data, d);
+      if (ok)
+        p.sensors.push_back(std::move(d));
+    } else if (ok) {
+      ParameterDesc d;
+      ok = ParseParameterDesc(r.data, d);
+      if (ok)
+        p.parameters.push_back(std::move(d));
+    }
+    if (!ok)
+      ++p.failed;
+  }
+  p.elapsedUs = RdmNowUs() - t0;
+
+  TRACE_DEBUG("[Profile] %012llX: %d personalities, %d sensors, %d PIDs, "
+              "%d failed\n",
+              (unsigned long long)uid, (int)p.personalities.size(),
+              (int)p.sensors.size(), (int)p.parameters.size(), p.failed);
+  return p;
+}
@@ -0,0 +1,95 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// DeviceProfile — every indexed descriptor of a fixture in one pass
+// ────────────────────────────────────────────────────────────────────────
+#ifndef DEVICE_PROFILE_H
+#define DEVICE_PROFILE_H
+
+#include "validator.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// DEVICE_INFO (0x0060), 19 bytes
+struct DeviceInfo {
+  uint16_t protocol = 0;
+  uint16_t model = 0;
+  uint16_t category = 0;
+  uint32_t softwareVersion = 0;
+  uint16_t footprint = 0;
+  uint8_t personality = 0; // current, 1-based
+  uint8_t personalityCount = 0;
+  uint16_t startAddress = 0; // 0xFFFF: no footprint
+  uint16_t subDevices = 0;
+  uint8_t sensorCount = 0;
+};
+
+// DMX_PERSONALITY_DESCRIPTION (0x00E1)
+struct PersonalityDesc {
+  uint8_t number = 0;
+  uint16_t footprint = 0;
+  std::string description;
+};
+
+// SENSOR_DEFINITION (0x0200)
+struct SensorDef {
+  uint8_t number = 0;
+  uint8_t type = 0;
+  uint8_t unit = 0;
+  uint8_t prefix = 0;
+  int16_t rangeMin = 0;
+  int16_t rangeMax = 0;
+  int16_t normalMin = 0;
+  int16_t normalMax = 0;
+  uint8_t recordedSupport = 0; // bit 0 recorded value, bit 1 lowest/highest
+  std::string description;
+};
+
+// PARAMETER_DESCRIPTION (0x0051) of a manufacturer PID
+struct ParameterDesc {
+  uint16_t pid = 0;
+  uint8_t pdlSize = 0;
+  uint8_t dataType = 0;
+  uint8_t commandClass = 0; // 1 GET, 2 SET, 3 GET_SET
+  uint8_t type = 0;
+  uint8_t unit = 0;
+  uint8_t prefix = 0;
+  uint32_t minValue = 0;
+  uint32_t maxValue = 0;
+  uint32_t defaultValue = 0;
+  std::string description;
+};
+
+// Big-endian, as on the wire; false when the data is too short
+bool ParseDeviceInfo(const std::vector<uint8_t> &data, DeviceInfo &out);
+bool ParsePersonalityDesc(const std::vector<uint8_t> &data,
+                          PersonalityDesc &out);
+bool ParseSensorDef(const std::vector<uint8_t> &data, SensorDef &out);
+bool ParseParameterDesc(const std::vector<uint8_t> &data, ParameterDesc &out);
+
+struct DeviceProfile {
+  uint64_t uid = 0;
+  bool haveInfo = false;      // DEVICE_INFO answered
+  bool haveSupported = false; // SUPPORTED_PARAMETERS answered
+  DeviceInfo info;
+  std::vector<uint16_t> supported; // as listed
+  // In index order; an index that did not answer is left out
+  std::vector<PersonalityDesc> personalities;
+  std::vector<SensorDef> sensors;
+  std::vector<ParameterDesc> parameters;
+  int requests = 0; // GETs sent
+  int failed = 0;   // indexed GETs not answered with a usable ACK
+  int64_t elapsedUs = 0;
+};
+
+// Reads DEVICE_INFO and SUPPORTED_PARAMETERS, then every indexed GET they
+// call for, back to back: DMX_PERSONALITY_DESCRIPTION for 1..personality
+// count, SENSOR_DEFINITION for 0..sensor count-1 and PARAMETER_DESCRIPTION
+// for each listed PID >= 0x8000.  Without DEVICE_INFO only the parameter
+// descriptions are read.  Through PlannerGet each GET costs one exchange
+// on the line; nothing waits a fixed time.  Put a DescriptorCache in front
+// of `get` to profile a fleet of one model at the cost of one fixture.
+DeviceProfile ReadDeviceProfile(const RDMGet &get, uint64_t uid);
+
+#endif // DEVICE_PROFILE_H
@@ -0,0 +1,215 @@
+// ────────────────────────────────────────────────────────────────────────
+// DMX input — Implementation
+// ────────────────────────────────────────────────────────────────────────
+#include "dmx_input.h"
+#include "enttec_pro.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+static int64_t SteadyNowUs() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DmxUniverseBuffer
+// ═══════════════════════════════════════════════════════════════════════════
+
+DmxUniverseBuffer::DmxUniverseBuffer() = default;
+
+void DmxUniverseBuffer::Reset() {
+  for (auto &s : m_slots) {
+    s.seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.frameNum = 0;
+    s.len = 0;
+    memset(s.data, 0, sizeof(s.data));
+    memset(s.lastChange, 0, sizeof(s.lastChange));
+    s.stats = {};
+    s.seq.fetch_add(1, std::memory_order_release);
+  }
+  memset(m_data, 0, sizeof(m_data));
+  memset(m_lastChange, 0, sizeof(m_lastChange));
+  m_len = 0;
+  m_frameNum = 0;
+  m_lastTimestampUs = -1;
+  m_intervalCount = 0;
+  m_intervalHead = 0;
+  m_errorFrames = 0;
+}
+
+void DmxUniverseBuffer::Publish(const uint8_t *frame, int len,
+                                int64_t timestampUs, uint8_t status) {
+  if (!frame || len <= 0)
+    return;
+  if (len > DMX_MAX_FRAME)
+    len = DMX_MAX_FRAME;
+
+  uint32_t num = static_cast<uint32_t>(++m_frameNum);
+
+  // Change detection against the previous frame.  A slot that appears or
+  // disappears (length change) counts as changed.
+  int common = (len < m_len) ? len : m_len;
+  for (int i = 0; i < common; ++i) {
+    if (frame[i] != m_data[i])
+      m_lastChange[i] = num;
+  }
+  for (int i = common; i < len; ++i)
+    m_lastChange[i] = num;
+  for (int i = common; i < m_len; ++i) {
+    m_lastChange[i] = num;
+    m_data[i] = 0;
+  }
+  memcpy(m_data, frame, len);
+  m_len = len;
+
+  if (status & 0x03)
+    m_errorFrames++;
+
+  // Inter-frame interval window
+  if (m_lastTimestampUs >= 0) {
+    m_intervals[m_intervalHead] =
+        static_cast<double>(timestampUs - m_lastTimestampUs);
+    m_intervalHead = (m_intervalHead + 1) % DMX_STATS_WINDOW;
+    if (m_intervalCount < DMX_STATS_WINDOW)
+      m_intervalCount++;
+  }
+  m_lastTimestampUs = timestampUs;
+
+  DmxInputStats st;
+  st.frames = m_frameNum;
+  st.errorFrames = m_errorFrames;
+  st.slotCount = len - 1;
+  st.startCode = frame[0];
+  if (m_intervalCount > 0) {
+    double sum = 0.0, mn = m_intervals[0], mx = m_intervals[0];
+    for (int i = 0; i < m_intervalCount; ++i) {
+      double v = m_intervals[i];
+      sum += v;
+      if (v < mn)
+        mn = v;
+      if (v > mx)
+        mx = v;
+    }
+    double mean = sum / m_intervalCount;
+    double var = 0.0;
+    for (int i = 0; i < m_intervalCount; ++i) {
+      double d = m_intervals[i] - mean;
+      var += d * d;
+    }
+    st.intervalUs = mean;
+    st.jitterUs = std::sqrt(var / m_intervalCount);
+    st.minIntervalUs = mn;
+    st.maxIntervalUs = mx;
+    st.refreshHz = (mean > 0.0) ? 1e6 / mean : 0.0;
+  }
+
+  // Fill the back buffer, then flip
+  int back = m_front.load(std::memory_order_relaxed) ^ 1;
+  Slot &s = m_slots[back];
+  s.seq.fetch_add(1, std::memory_order_relaxed); // -> odd
+  std::atomic_thread_fence(std::memory_order_release);
+  s.frameNum = m_frameNum;
+  s.len = len;
+  memcpy(s.data, m_data, sizeof(s.data));
+  memcpy(s.lastChange, m_lastChange, sizeof(s.lastChange));
+  s.stats = st;
+  s.seq.fetch_add(1, std::memory_order_release); // -> even
+  m_front.store(back, std::memory_order_release);
+}
+
+int DmxUniverseBuffer::Snapshot(uint8_t *slots, int maxLen, uint8_t *changed,
+                                uint64_t sinceFrame,
+                                uint64_t *frameNum) const {
+  for (;;) {
+    const Slot &s = m_slots[m_front.load(std::memory_order_acquire)];
+    uint32_t seq1 = s.seq.load(std::memory_order_acquire);
+    if (seq1 & 1)
+      continue; // writer lapped us and is refilling this slot
+
+    int len = s.len;
+    uint64_t num = s.frameNum;
+    if (slots && maxLen > 0)
+      memcpy(slots, s.data, (len < maxLen) ? len : maxLen);
+    if (changed) {
+      memset(changed, 0, DMX_CHANGE_BYTES);
+      uint32_t since = static_cast<uint32_t>(sinceFrame);
+      for (int i = 1; i < DMX_MAX_FRAME; ++i) {
+        if (s.lastChange[i] > since)
+          changed[(i - 1) >> 3] |= static_cast<uint8_t>(1u << ((i - 1) & 7));
+      }
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(std::memory_order_relaxed) != seq1)
+      continue;
+
+    if (frameNum)
+      *frameNum = num;
+    return (len < maxLen || !slots) ? len : maxLen;
+  }
+}
+
+DmxInputStats DmxUniverseBuffer::GetStats() const {
+  for (;;) {
+    const Slot &s = m_slots[m_front.load(std::memory_order_acquire)];
+    uint32_t seq1 = s.seq.load(std::memory_order_acquire);
+    if (seq1 & 1)
+      continue;
+    DmxInputStats st = s.stats;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(std::memory_order_relaxed) == seq1)
+      return st;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DmxInputMonitor
+// ═══════════════════════════════════════════════════════════════════════════
+
+DmxInputMonitor::~DmxInputMonitor() { Stop(); }
+
+bool DmxInputMonitor::Start(EnttecPro &pro) {
+  Stop();
+  if (!pro.IsOpen())
+    return false;
+  if (!pro.SetReceiveMode(false)) // send-always: every frame is timed
+    return false;
+
+  m_pro = &pro;
+  m_buffer.Reset();
+  m_running = true;
+  m_thread = std::thread(&DmxInputMonitor::Run, this);
+  return true;
+}
+
+void DmxInputMonitor::Stop() {
+  m_running = false;
+  if (m_thread.joinable())
+    m_thread.join();
+  if (m_pro) {
+    // Back to on-change mode, or the widget keeps streaming Label 5
+    // frames that the next ReceiveRDM would read instead of its reply
+    m_pro->SetReceiveMode(true);
+    m_pro->Purge(); // drop frames queued after the last read
+    m_pro = nullptr;
+  }
+}
+
+// The read blocks in FT_Read for at most the driver read timeout, so the
+// stop flag is observed within one timeout.  Frames are read into stack
+// buffers (only an installed USB log callback copies them) and no lock is
+// shared with readers, so a 44 Hz universe is never throttled by whoever
+// is polling the buffer.
+void DmxInputMonitor::Run() {
+  uint8_t frame[DMX_MAX_FRAME];
+  while (m_running.load(std::memory_order_relaxed)) {
+    uint8_t status = 0;
+    int len = m_pro->ReceiveDMX(frame, sizeof(frame), status);
+    if (len <= 0)
+      continue;
+    m_buffer.Publish(frame, len, SteadyNowUs(), status);
+  }
+}
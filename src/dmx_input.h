@@ -0,0 +1,115 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// DMX input — receive-mode capture, double-buffered universe + analysis
+// ────────────────────────────────────────────────────────────────────────
+#ifndef DMX_INPUT_H
+#define DMX_INPUT_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+class EnttecPro; // forward
+
+constexpr int DMX_MAX_FRAME = 513;  // start code + 512 slots
+constexpr int DMX_CHANGE_BYTES = 64; // 512-bit change bitmap
+constexpr int DMX_STATS_WINDOW = 64; // intervals used for rate / jitter
+
+// ── Receive statistics ──────────────────────────────────────────────────
+struct DmxInputStats {
+  uint64_t frames = 0;       // frames published since Reset()
+  uint64_t errorFrames = 0;  // widget reported overflow / overrun
+  int slotCount = 0;         // slots in the last frame (excl. start code)
+  uint8_t startCode = 0;     // start code of the last frame
+  double refreshHz = 0.0;    // 1 / mean inter-frame interval
+  double intervalUs = 0.0;   // mean inter-frame interval (window)
+  double jitterUs = 0.0;     // std deviation of the interval (window)
+  double minIntervalUs = 0.0;
+  double maxIntervalUs = 0.0;
+};
+
+// ── Double-buffered universe ────────────────────────────────────────────
+//    One writer (the capture thread), any number of readers.  Publish()
+//    never blocks: it fills the back buffer and flips the front index.
+//    Readers copy the front buffer and retry if the writer lapped them.
+//
+//    Change tracking is by frame number rather than a cleared-on-read
+//    bitmap, so a slow reader never loses a change: Snapshot(since)
+//    reports every slot whose value changed after frame `since`.
+class DmxUniverseBuffer {
+public:
+  DmxUniverseBuffer();
+
+  // Writer side.  `frame[0]` is the start code; `len` includes it.
+  // `status` is the widget status byte (bit 0 = queue overflow,
+  // bit 1 = receive overrun).
+  void Publish(const uint8_t *frame, int len, int64_t timestampUs,
+               uint8_t status);
+
+  // Reader side.  Copies the latest frame into `slots` (up to `maxLen`
+  // bytes, start code first) and, when `changed` is non-null, fills a
+  // DMX_CHANGE_BYTES bitmap (bit n = slot n+1) of slots that changed
+  // after frame number `sinceFrame`.  Returns the frame length (0 if
+  // nothing has been received) and writes the frame number to `frameNum`.
+  int Snapshot(uint8_t *slots, int maxLen, uint8_t *changed,
+               uint64_t sinceFrame, uint64_t *frameNum) const;
+
+  DmxInputStats GetStats() const;
+
+  // Writer side — clears history.  Must not race with Publish().
+  void Reset();
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq{0}; // odd while being written
+    uint64_t frameNum = 0;
+    int len = 0;
+    uint8_t data[DMX_MAX_FRAME] = {};
+    uint32_t lastChange[DMX_MAX_FRAME] = {}; // frame number of last change
+    DmxInputStats stats;
+  };
+
+  Slot m_slots[2];
+  std::atomic<int> m_front{0};
+
+  // Writer-private history (copied into the back slot on each Publish)
+  uint8_t m_data[DMX_MAX_FRAME] = {};
+  uint32_t m_lastChange[DMX_MAX_FRAME] = {};
+  int m_len = 0;
+  uint64_t m_frameNum = 0;
+  int64_t m_lastTimestampUs = -1;
+  double m_intervals[DMX_STATS_WINDOW] = {};
+  int m_intervalCount = 0;
+  int m_intervalHead = 0;
+  uint64_t m_errorFrames = 0;
+};
+
+// ── Capture thread ──────────────────────────────────────────────────────
+//    Puts an Enttec PRO into receive mode (Label 8, send-always so every
+//    frame is timed) and publishes each Label 5 frame into a
+//    DmxUniverseBuffer.  While running it owns the widget's RX path:
+//    do not issue RDM transactions until Stop() has returned.
+class DmxInputMonitor {
+public:
+  DmxInputMonitor() = default;
+  ~DmxInputMonitor();
+
+  DmxInputMonitor(const DmxInputMonitor &) = delete;
+  DmxInputMonitor &operator=(const DmxInputMonitor &) = delete;
+
+  bool Start(EnttecPro &pro);
+  void Stop();
+  bool IsRunning() const { return m_running.load(); }
+
+  const DmxUniverseBuffer &Buffer() const { return m_buffer; }
+
+private:
+  void Run();
+
+  EnttecPro *m_pro = nullptr;
+  DmxUniverseBuffer m_buffer;
+  std::atomic<bool> m_running{false};
+  std::thread m_thread;
+};
+
+#endif // DMX_INPUT_H
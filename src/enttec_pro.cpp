@@ -2,6 +2,9 @@
 // EnttecPro — Implementation
 // ────────────────────────────────────────────────────────────────────────
 #include "enttec_pro.h"
+#include "metrics.h"
+#include "perf_trace.h"
+#include "rdm_timing.h"
 #include <cstdio>
 #include <cstring>
 
@@ -36,6 +39,7 @@ bool EnttecPro::Open(int deviceIndex) {
 
     // Reload the FTDI driver for standard VID/PID (clears stale handles)
     FT_Reload(0x0403, 0x6001);
+    GlobalMetrics().Add(m_metricsPort, Metric::RECOVERIES);
     Sleep(2000); // give USB subsystem time to re-enumerate
 
     // Retry up to 3 times after the reload
@@ -54,6 +58,7 @@ bool EnttecPro::Open(int deviceIndex) {
     return false;
   }
   OutputDebugStringA("[EnttecPro] FT_Open succeeded\n");
+  GlobalMetrics().Add(m_metricsPort, Metric::DEVICE_OPENS);
 
   // ── Complete FTDI initialization (matches Enttec reference code) ──
   FT_SetBaudRate(m_handle, 57600);
@@ -128,6 +133,7 @@ std::string EnttecPro::GetFirmwareString() const {
 bool EnttecPro::SendPacket(uint8_t label, const uint8_t *data, int length) {
   if (!m_handle)
     return false;
+  PERF_SCOPE_ARG("usb", "FT_Write", "label", label);
 
   DWORD written = 0;
 
@@ -140,21 +146,27 @@ bool EnttecPro::SendPacket(uint8_t label, const uint8_t *data, int length) {
 
   FT_STATUS res;
   res = FT_Write(m_handle, header, PRO_HEADER_LENGTH, &written);
-  if (written != PRO_HEADER_LENGTH)
+  if (written != PRO_HEADER_LENGTH) {
+    GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
     return false;
+  }
 
   // Payload
   if (length > 0 && data) {
     res = FT_Write(m_handle, const_cast<uint8_t *>(data), length, &written);
-    if (static_cast<int>(written) != length)
+    if (static_cast<int>(written) != length) {
+      GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
       return false;
+    }
   }
 
   // End code
   uint8_t endCode = PRO_END_CODE;
   res = FT_Write(m_handle, &endCode, 1, &written);
-  if (written != 1)
+  if (written != 1) {
+    GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
     return false;
+  }
 
   // Log TX
   if (m_logCb) {
@@ -175,6 +187,7 @@ bool EnttecPro::SendPacket(uint8_t label, const uint8_t *data, int length) {
 int EnttecPro::ReceivePacket(uint8_t label, uint8_t *data, int maxLen) {
   if (!m_handle)
     return -1;
+  PERF_SCOPE_ARG("usb", "FT_Read", "label", label);
 
   FT_STATUS res;
   DWORD bytesRead = 0;
@@ -221,10 +234,10 @@ int EnttecPro::ReceivePacket(uint8_t label, uint8_t *data, int maxLen) {
   if (length > PRO_MAX_PACKET || length < 0)
     return -1;
 
-  // Read payload
-  std::vector<uint8_t> buffer(length);
+  // Read payload (stack buffer: DMX input reads this 44 times a second)
+  uint8_t buffer[PRO_MAX_PACKET];
   if (length > 0) {
-    res = FT_Read(m_handle, buffer.data(), length, &bytesRead);
+    res = FT_Read(m_handle, buffer, length, &bytesRead);
     if (static_cast<int>(bytesRead) != length)
       return -1;
   }
@@ -237,7 +250,7 @@ int EnttecPro::ReceivePacket(uint8_t label, uint8_t *data, int maxLen) {
   // Copy to caller
   int toCopy = (length < maxLen) ? length : maxLen;
   if (toCopy > 0 && data)
-    memcpy(data, buffer.data(), toCopy);
+    memcpy(data, buffer, toCopy);
 
   // Log RX
   if (m_logCb) {
@@ -247,7 +260,7 @@ int EnttecPro::ReceivePacket(uint8_t label, uint8_t *data, int maxLen) {
     frame[2] = lenBytes[0];
     frame[3] = lenBytes[1];
     if (length > 0)
-      memcpy(frame.data() + 4, buffer.data(), length);
+      memcpy(frame.data() + 4, buffer, length);
     frame.back() = PRO_END_CODE;
     Log(false, frame.data(), static_cast<int>(frame.size()));
   }
@@ -258,7 +271,10 @@ int EnttecPro::ReceivePacket(uint8_t label, uint8_t *data, int maxLen) {
 // ── DMX output ──────────────────────────────────────────────────────────
 bool EnttecPro::SendDMX(const uint8_t *data, int len) {
   std::lock_guard<std::mutex> lk(m_mutex);
-  return SendPacket(LABEL_TX_DMX, data, len);
+  if (!SendPacket(LABEL_TX_DMX, data, len))
+    return false;
+  GlobalMetrics().Add(m_metricsPort, Metric::DMX_FRAMES_TX);
+  return true;
 }
 
 // ── RDM TX ──────────────────────────────────────────────────────────────
@@ -267,14 +283,20 @@ bool EnttecPro::SendDMX(const uint8_t *data, int len) {
 //    internal RDM state machine. Caller handles purging if needed.
 bool EnttecPro::SendRDM(const uint8_t *data, int len) {
   std::lock_guard<std::mutex> lk(m_mutex);
-  return SendPacket(LABEL_TX_RDM, data, len);
+  if (!SendPacket(LABEL_TX_RDM, data, len))
+    return false;
+  GlobalMetrics().Add(m_metricsPort, Metric::RDM_REQUESTS_TX);
+  return true;
 }
 
 // ── RDM Discovery TX (Label 11 — no break) ─────────────────────────────
 bool EnttecPro::SendRDMDiscovery(const uint8_t *data, int len) {
   std::lock_guard<std::mutex> lk(m_mutex);
   PurgeInternal();
-  return SendPacket(LABEL_TX_RDM_DISCOVERY, data, len);
+  if (!SendPacket(LABEL_TX_RDM_DISCOVERY, data, len))
+    return false;
+  GlobalMetrics().Add(m_metricsPort, Metric::RDM_REQUESTS_TX);
+  return true;
 }
 
 // ── RDM RX ──────────────────────────────────────────────────────────────
@@ -288,6 +310,8 @@ int EnttecPro::ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte) {
   }
 
   statusByte = buf[0];
+  if (statusByte & 0x03) // widget queue overflow / receive overrun
+    GlobalMetrics().Add(m_metricsPort, Metric::RX_FRAME_ERRORS);
   int rdmLen = got - 1;
   if (rdmLen > maxLen)
     rdmLen = maxLen;
@@ -296,6 +320,38 @@ int EnttecPro::ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte) {
   return rdmLen;
 }
 
+// ── RX readiness ────────────────────────────────────────────────────────
+//    Replaces a fixed sleep before ReceiveRDM: returns on the first byte,
+//    so the caller can time-stamp the arrival.  The FTDI latency timer
+//    (2 ms, set in Open) bounds how late the first byte can show up.
+bool EnttecPro::WaitForData(int timeoutMs) {
+  PERF_SCOPE("usb", "WaitForData");
+  int64_t deadline = RdmNowUs() + timeoutMs * 1000LL;
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      if (!m_handle)
+        return false;
+      DWORD queued = 0;
+      if (FT_GetQueueStatus(m_handle, &queued) == FT_OK && queued > 0) {
+        GlobalMetrics().Set(m_metricsPort, Gauge::RX_QUEUE_BYTES, queued);
+        return true;
+      }
+    }
+    if (RdmNowUs() >= deadline)
+      return false;
+    Sleep(0);
+  }
+}
+
+// ── DMX input mode (Label 8) ────────────────────────────────────────────
+bool EnttecPro::SetReceiveMode(bool onChangeOnly) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  PurgeInternal();
+  uint8_t mode = onChangeOnly ? 1 : 0;
+  return SendPacket(LABEL_RX_DMX_ON_CHANGE, &mode, 1);
+}
+
 // ── Purge (public) ──────────────────────────────────────────────────────
 void EnttecPro::Purge() {
   std::lock_guard<std::mutex> lk(m_mutex);
@@ -305,6 +361,8 @@ void EnttecPro::Purge() {
 // ── Purge (internal, caller holds mutex) ────────────────────────────────
 void EnttecPro::PurgeInternal() {
   if (m_handle) {
+    PERF_SCOPE("usb", "FT_Purge");
+    GlobalMetrics().Add(m_metricsPort, Metric::PURGES);
     FT_Purge(m_handle, FT_PURGE_TX);
     FT_Purge(m_handle, FT_PURGE_RX);
   }
@@ -4,6 +4,7 @@
 #define ENTTEC_PRO_H
 
 #include "FTD2XX.H"
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -22,6 +23,7 @@ constexpr uint8_t LABEL_GET_WIDGET_PARAMS = 3;
 constexpr uint8_t LABEL_SET_WIDGET_PARAMS = 4;
 constexpr uint8_t LABEL_RX_DMX_ON_CHANGE = 8;
 constexpr uint8_t LABEL_RX_DMX_PACKET = 5; // also used for RDM RX
+constexpr uint8_t LABEL_RX_DMX_COS = 9;    // change-of-state packet
 constexpr uint8_t LABEL_TX_DMX = 6;
 constexpr uint8_t LABEL_TX_RDM = 7;
 constexpr uint8_t LABEL_GET_WIDGET_SN = 10;
@@ -81,6 +83,24 @@ public:
   // timeout / error.  `statusByte` receives the widget status.
   int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte);
 
+  // Polls the FTDI RX queue until data arrives or `timeoutMs` passes.
+  // Returns true as soon as at least one byte is waiting.
+  bool WaitForData(int timeoutMs);
+
+  // DMX input
+  // Sets the widget receiver mode via Label 8: false = forward every
+  // received frame as Label 5, true = forward only changes as Label 9.
+  bool SetReceiveMode(bool onChangeOnly);
+
+  // Receives the next DMX frame forwarded by the widget (Label 5).
+  // `out` receives the start code followed by the slots.  Returns the
+  // byte count, or -1 on timeout.  `statusByte` bit 0 = widget queue
+  // overflow, bit 1 = receive overrun.  Label 5 carries RDM replies too,
+  // so this is the same read as ReceiveRDM().
+  int ReceiveDMX(uint8_t *out, int maxLen, uint8_t &statusByte) {
+    return ReceiveRDM(out, maxLen, statusByte);
+  }
+
   // Low-level (exposed for advanced use)
   bool SendPacket(uint8_t label, const uint8_t *data, int length);
   int ReceivePacket(uint8_t label, uint8_t *data, int maxLen);
@@ -88,6 +108,13 @@ public:
   // Purge buffers
   void Purge();
 
+  // RDM transaction number for this bus
+  uint8_t NextTransNum() { return m_transNum++; }
+
+  // Port index this bus reports under in GlobalMetrics() (default 0)
+  void SetMetricsPort(int port) { m_metricsPort = port; }
+  int MetricsPort() const { return m_metricsPort; }
+
   // Logging
   void SetLogCallback(LogCallback cb);
 
@@ -100,6 +127,8 @@ private:
   uint32_t m_serialNumber = 0;
   LogCallback m_logCb;
   std::mutex m_mutex;
+  std::atomic<uint8_t> m_transNum{0};
+  int m_metricsPort = 0;
 
   void Log(bool tx, const uint8_t *data, int len);
 };
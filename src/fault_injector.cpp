@@ -0,0 +1,240 @@
+// ────────────────────────────────────────────────────────────────────────
+// FaultInjector — seeded bus faults in front of any RDM driver
+// ────────────────────────────────────────────────────────────────────────
+#include "fault_injector.h"
+#include "trace_ring.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+void FaultInjector::Detach() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_ops = Ops{};
+  m_attached = false;
+  ResetLocked();
+}
+
+void FaultInjector::ResetLocked() {
+  m_rng.seed(m_profile.seed);
+  m_discovery = false;
+  m_late = false;
+  m_collected = true; // nothing to collect before the first exchange
+  m_last.clear();
+  m_lateResp.clear();
+  m_rx.clear();
+}
+
+void FaultInjector::SetProfile(const FaultProfile &profile) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_profile = profile;
+  ResetLocked();
+  TRACE_INFO("[Fault] drop %.3f flip %.3f trunc %.3f coll %.3f stale %.3f\n",
+             profile.drop, profile.bitFlip, profile.truncate,
+             profile.collision, profile.stale);
+  TRACE_INFO("[Fault] latency %d+%d us (late > %d us), seed %u\n",
+             profile.latencyUs, profile.jitterUs, profile.lateAfterUs,
+             profile.seed);
+}
+
+FaultProfile FaultInjector::Profile() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_profile;
+}
+
+FaultCounters FaultInjector::Counters() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_counters;
+}
+
+void FaultInjector::ResetCounters() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_counters = FaultCounters{};
+}
+
+bool FaultInjector::Roll(double p) {
+  if (p <= 0)
+    return false;
+  return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < p;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Pass-through
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool FaultInjector::IsOpen() const {
+  return m_attached && m_ops.isOpen();
+}
+
+std::string FaultInjector::GetFirmwareString() const {
+  return m_attached ? m_ops.firmware() + " (faults)" : "";
+}
+
+uint32_t FaultInjector::GetSerialNumber() const {
+  return m_attached ? m_ops.serial() : 0;
+}
+
+bool FaultInjector::SendDMX(const uint8_t *data, int len) {
+  return m_attached && m_ops.sendDMX(data, len);
+}
+
+uint8_t FaultInjector::NextTransNum() {
+  return m_attached ? m_ops.nextTransNum() : 0;
+}
+
+int FaultInjector::MetricsPort() const {
+  return m_attached ? m_ops.metricsPort() : 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Exchange
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool FaultInjector::SendRDM(const uint8_t *data, int len) {
+  return Exchange(m_ops.sendRDM, data, len, false);
+}
+
+bool FaultInjector::SendRDMDiscovery(const uint8_t *data, int len) {
+  return Exchange(m_ops.sendDiscovery, data, len, true);
+}
+
+// The delay runs after the wrapped send: the Peperoni completes the whole
+// exchange inside SendRDM, and on the Enttec the response is then already
+// queued, so the caller sees a slower bus either way.
+bool FaultInjector::Exchange(
+    const std::function<bool(const uint8_t *, int)> &send,
+    const uint8_t *data, int len, bool discovery) {
+  int delayUs = 0;
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_attached)
+      return false;
+    ++m_counters.exchanges;
+    // A late response from the previous exchange lands in the buffer now
+    if (!m_lateResp.empty()) {
+      m_rx.push_back(std::move(m_lateResp));
+      m_lateResp.clear();
+    }
+    m_discovery = discovery;
+    m_collected = false;
+    delayUs = m_profile.latencyUs;
+    if (m_profile.jitterUs > 0)
+      delayUs +=
+          std::uniform_int_distribution<int>(0, m_profile.jitterUs)(m_rng);
+    m_late = m_profile.lateAfterUs > 0 && delayUs > m_profile.lateAfterUs;
+  }
+  if (!send(data, len))
+    return false;
+  if (delayUs > 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+  return true;
+}
+
+void FaultInjector::Collect() {
+  if (m_collected)
+    return;
+  m_collected = true;
+
+  // The previous response still in the buffer is read before this one
+  if (m_rx.empty() && !m_last.empty() && Roll(m_profile.stale)) {
+    ++m_counters.stale;
+    m_rx.push_back(m_last);
+  }
+
+  std::vector<uint8_t> resp(513);
+  uint8_t status = 0;
+  int n = m_ops.receive(resp.data(), static_cast<int>(resp.size()), status);
+  if (n > 0) {
+    ++m_counters.responses;
+    resp.resize(n);
+    m_last = resp;
+    if (Roll(m_profile.drop)) {
+      ++m_counters.dropped;
+      resp.clear();
+    }
+  } else {
+    resp.clear();
+    if (m_discovery && Roll(m_profile.collision)) {
+      // Noise on a branch nobody answers: a few bytes of garbage
+      ++m_counters.noise;
+      resp.resize(std::uniform_int_distribution<int>(1, 24)(m_rng));
+      for (auto &b : resp)
+        b = static_cast<uint8_t>(m_rng());
+    }
+  }
+
+  if (!resp.empty()) {
+    int size = static_cast<int>(resp.size());
+    if (Roll(m_profile.collision)) {
+      // A second talker: XOR a random span with its bits
+      ++m_counters.collisions;
+      int from = std::uniform_int_distribution<int>(0, size - 1)(m_rng);
+      for (int i = from; i < size; ++i)
+        resp[i] ^= static_cast<uint8_t>(m_rng() | 1);
+    }
+    if (Roll(m_profile.bitFlip)) {
+      ++m_counters.bitFlips;
+      int bit = std::uniform_int_distribution<int>(0, size * 8 - 1)(m_rng);
+      resp[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+    }
+    if (size > 1 && Roll(m_profile.truncate)) {
+      ++m_counters.truncated;
+      resp.resize(std::uniform_int_distribution<int>(1, size - 1)(m_rng));
+    }
+  }
+
+  if (resp.empty())
+    return;
+  if (m_late) {
+    ++m_counters.late;
+    m_lateResp = std::move(resp);
+  } else {
+    m_rx.push_back(std::move(resp));
+  }
+}
+
+int FaultInjector::ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  statusByte = 0;
+  if (!m_attached || !out || maxLen <= 0)
+    return -1;
+  Collect();
+  if (m_rx.empty())
+    return 0;
+  std::vector<uint8_t> resp = std::move(m_rx.front());
+  m_rx.pop_front();
+  int n = static_cast<int>(resp.size());
+  if (n > maxLen)
+    n = maxLen;
+  memcpy(out, resp.data(), n);
+  return n;
+}
+
+bool FaultInjector::WaitForData(int timeoutMs) {
+  std::function<bool(int)> wait;
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_attached)
+      return false;
+    if (!m_rx.empty())
+      return true;
+    if (m_collected)
+      return false;
+    wait = m_ops.waitForData;
+  }
+  if (wait && !wait(timeoutMs))
+    return false;
+  std::lock_guard<std::mutex> lk(m_mutex);
+  Collect();
+  return !m_rx.empty();
+}
+
+void FaultInjector::Purge() {
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_rx.clear();
+    m_lateResp.clear();
+  }
+  if (m_attached)
+    m_ops.purge();
+}
@@ -0,0 +1,148 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// FaultInjector — seeded bus faults in front of any RDM driver
+// ────────────────────────────────────────────────────────────────────────
+#ifndef FAULT_INJECTOR_H
+#define FAULT_INJECTOR_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+// Per-response probabilities (0..1), drawn independently from one seeded
+// generator, so a profile and seed reproduce the same fault sequence for
+// the same traffic.
+struct FaultProfile {
+  double drop = 0;      // response lost
+  double bitFlip = 0;   // one random bit of the response inverted
+  double truncate = 0;  // response cut to a random shorter length
+  double collision = 0; // response overlaid with a second talker; on a
+                        // silent discovery branch: line noise
+  double stale = 0;     // the previous response is still in the RX buffer
+                        // and is read ahead of this one
+  int latencyUs = 0;    // added to every exchange
+  int jitterUs = 0;     // plus 0..jitterUs, uniform
+  // A response delayed beyond this is missed by the exchange and arrives
+  // as a leftover for the next one (0 = never late)
+  int lateAfterUs = 0;
+  uint32_t seed = 1;
+};
+
+struct FaultCounters {
+  uint64_t exchanges = 0; // SendRDM / SendRDMDiscovery calls
+  uint64_t responses = 0; // responses the wrapped driver delivered
+  uint64_t dropped = 0;
+  uint64_t bitFlips = 0;
+  uint64_t truncated = 0;
+  uint64_t collisions = 0;
+  uint64_t noise = 0; // collisions injected on a silent line
+  uint64_t stale = 0; // leftovers read ahead of the real response
+  uint64_t late = 0;
+};
+
+// Duck-typed like EnttecPro / PeperoniRodin / ReplayDriver, so
+// RDMDiscovery and RDMGetCommand run unchanged on top of it.  Attach()
+// binds any of those (or a test double with the same members); faults are
+// applied to what the wrapped driver's ReceiveRDM returns.  Purge() clears
+// leftovers, as it does on the real widget.
+class FaultInjector {
+public:
+  template <typename Driver> void Attach(Driver &inner) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_ops.isOpen = [&inner] { return inner.IsOpen(); };
+    m_ops.firmware = [&inner] { return inner.GetFirmwareString(); };
+    m_ops.serial = [&inner] { return inner.GetSerialNumber(); };
+    m_ops.sendDMX = [&inner](const uint8_t *d, int n) {
+      return inner.SendDMX(d, n);
+    };
+    m_ops.sendRDM = [&inner](const uint8_t *d, int n) {
+      return inner.SendRDM(d, n);
+    };
+    m_ops.sendDiscovery = [&inner](const uint8_t *d, int n) {
+      return inner.SendRDMDiscovery(d, n);
+    };
+    m_ops.receive = [&inner](uint8_t *o, int n, uint8_t &st) {
+      return inner.ReceiveRDM(o, n, st);
+    };
+    m_ops.waitForData = WaitOp(inner, 0);
+    m_ops.purge = [&inner] { inner.Purge(); };
+    m_ops.nextTransNum = [&inner] { return inner.NextTransNum(); };
+    m_ops.metricsPort = [&inner] { return inner.MetricsPort(); };
+    m_attached = true;
+    ResetLocked();
+  }
+  void Detach();
+
+  // Replaces the profile and restarts the generator from its seed
+  void SetProfile(const FaultProfile &profile);
+  FaultProfile Profile() const;
+  FaultCounters Counters() const;
+  void ResetCounters();
+
+  // ── Driver interface ──
+  bool IsOpen() const;
+  std::string GetFirmwareString() const;
+  uint32_t GetSerialNumber() const;
+  bool SendDMX(const uint8_t *data, int len);
+  bool SendRDM(const uint8_t *data, int len);
+  bool SendRDMDiscovery(const uint8_t *data, int len);
+  int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte);
+  bool WaitForData(int timeoutMs);
+  void Purge();
+  uint8_t NextTransNum();
+  int MetricsPort() const;
+
+private:
+  // EnttecPro polls for the first RX byte; the Peperoni has the response
+  // by the time SendRDM returns and has no WaitForData
+  template <typename Driver>
+  static auto WaitOp(Driver &inner, int)
+      -> decltype(inner.WaitForData(0), std::function<bool(int)>()) {
+    return [&inner](int ms) { return inner.WaitForData(ms); };
+  }
+  template <typename Driver>
+  static std::function<bool(int)> WaitOp(Driver &, long) {
+    return nullptr;
+  }
+
+  struct Ops {
+    std::function<bool()> isOpen;
+    std::function<std::string()> firmware;
+    std::function<uint32_t()> serial;
+    std::function<bool(const uint8_t *, int)> sendDMX;
+    std::function<bool(const uint8_t *, int)> sendRDM;
+    std::function<bool(const uint8_t *, int)> sendDiscovery;
+    std::function<int(uint8_t *, int, uint8_t &)> receive;
+    std::function<bool(int)> waitForData; // may be empty
+    std::function<void()> purge;
+    std::function<uint8_t()> nextTransNum;
+    std::function<int()> metricsPort;
+  };
+
+  bool Exchange(const std::function<bool(const uint8_t *, int)> &send,
+                const uint8_t *data, int len, bool discovery);
+  // Reads the wrapped driver's response and queues it, faulted
+  void Collect(); // caller holds m_mutex
+  bool Roll(double p); // caller holds m_mutex
+  void ResetLocked();
+
+  mutable std::mutex m_mutex;
+  Ops m_ops;
+  bool m_attached = false;
+  FaultProfile m_profile;
+  std::mt19937 m_rng{1};
+  FaultCounters m_counters;
+
+  bool m_discovery = false; // current exchange is DISC_UNIQUE_BRANCH
+  bool m_late = false;      // current response misses its exchange
+  bool m_collected = false; // current response already read from inner
+  std::vector<uint8_t> m_last;     // last real response (stale source)
+  std::vector<uint8_t> m_lateResp; // lands after the current read
+  std::deque<std::vector<uint8_t>> m_rx; // what ReceiveRDM returns next
+};
+
+#endif // FAULT_INJECTOR_H
@@ -0,0 +1,117 @@
+// ────────────────────────────────────────────────────────────────────────
+// FixtureLocator — finds fixtures on the rig by halving identify groups
+// ────────────────────────────────────────────────────────────────────────
+#include "fixture_locator.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <iterator>
+
+// The half of a candidate set that is identified: the larger one when odd
+static size_t LitHalf(const std::vector<uint64_t> &cell) {
+  return (cell.size() + 1) / 2;
+}
+
+void FixtureLocator::Start(const std::vector<uint64_t> &candidates,
+                           int targets) {
+  m_cells.assign(std::max(targets, 1), candidates);
+  m_steps = 0;
+  Relight();
+}
+
+void FixtureLocator::Stop() {
+  m_cells.clear();
+  m_lit.clear();
+  m_steps = 0;
+}
+
+bool FixtureLocator::Done() const {
+  if (m_cells.empty())
+    return false;
+  for (const auto &cell : m_cells)
+    if (cell.size() > 1)
+      return false;
+  return true;
+}
+
+int FixtureLocator::StepsLeft() const {
+  int left = 0;
+  for (const auto &cell : m_cells) {
+    int steps = 0;
+    for (size_t n = cell.size(); n > 1; n = (n + 1) / 2) // larger half
+      ++steps;
+    left = std::max(left, steps);
+  }
+  return left;
+}
+
+const std::vector<uint64_t> &FixtureLocator::Candidates(int target) const {
+  static const std::vector<uint64_t> kNone;
+  if (target < 0 || target >= Targets())
+    return kNone;
+  return m_cells[target];
+}
+
+bool FixtureLocator::Answer(const std::vector<bool> &lit) {
+  if (!Active() || Done() || lit.size() != m_cells.size())
+    return false;
+  for (size_t t = 0; t < m_cells.size(); ++t) {
+    std::vector<uint64_t> &cell = m_cells[t];
+    if (cell.size() < 2)
+      continue;
+    size_t half = LitHalf(cell);
+    if (lit[t])
+      cell.resize(half);
+    else
+      cell.erase(cell.begin(), cell.begin() + half);
+  }
+  ++m_steps;
+  Relight();
+  TRACE_DEBUG("[Locate] step %d: %d lit, %d step(s) left\n", m_steps,
+              static_cast<int>(m_lit.size()), StepsLeft());
+  return true;
+}
+
+void FixtureLocator::Relight() {
+  m_lit.clear();
+  bool done = Done();
+  std::vector<uint64_t> firsts; // one entry per distinct candidate set
+  for (const auto &cell : m_cells) {
+    if (cell.empty() || (!done && cell.size() < 2))
+      continue;
+    if (std::find(firsts.begin(), firsts.end(), cell.front()) != firsts.end())
+      continue;
+    firsts.push_back(cell.front());
+    size_t n = done ? cell.size() : LitHalf(cell);
+    m_lit.insert(m_lit.end(), cell.begin(), cell.begin() + n);
+  }
+  std::sort(m_lit.begin(), m_lit.end());
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Identify
+// ═══════════════════════════════════════════════════════════════════════
+
+IdentifyStep PlanIdentifyStep(const std::vector<uint64_t> &litNow,
+                              const std::vector<uint64_t> &litNext) {
+  std::vector<uint64_t> now = litNow, next = litNext;
+  std::sort(now.begin(), now.end());
+  std::sort(next.begin(), next.end());
+  std::vector<uint64_t> staying;
+  std::set_intersection(now.begin(), now.end(), next.begin(), next.end(),
+                        std::back_inserter(staying));
+
+  IdentifyStep step;
+  std::set_difference(now.begin(), now.end(), next.begin(), next.end(),
+                      std::back_inserter(step.off));
+  // Broadcast off + the whole next group on, against the changes alone
+  if (step.off.size() > staying.size() + 1) {
+    step.allOff = true;
+    step.off.clear();
+    step.on = std::move(next);
+    return step;
+  }
+  std::set_difference(next.begin(), next.end(), now.begin(), now.end(),
+                      std::back_inserter(step.on));
+  return step;
+}
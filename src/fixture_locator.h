@@ -0,0 +1,96 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// FixtureLocator — finds fixtures on the rig by halving identify groups
+// ────────────────────────────────────────────────────────────────────────
+#ifndef FIXTURE_LOCATOR_H
+#define FIXTURE_LOCATOR_H
+
+#include "rdm.h"
+
+#include <cstdint>
+#include <vector>
+
+// Binary search over a UID list with the operator as the comparison.  Each
+// step identifies half of the candidates; the operator says, for each
+// fixture being looked for (a target), whether it is lit, and that
+// target's candidates shrink to the half it was in.  One fixture of 512
+// takes 9 answers.
+//
+// Several targets are located at once: every target starts with the whole
+// list and each step lights half of every distinct candidate set, so the
+// number of steps does not grow with the number of targets.  Candidate
+// sets of two targets are always either equal or disjoint, which is what
+// lets one lit group halve all of them.
+class FixtureLocator {
+public:
+  void Start(const std::vector<uint64_t> &candidates, int targets = 1);
+  void Stop();
+
+  bool Active() const { return !m_cells.empty(); }
+  // Every target is down to one UID
+  bool Done() const;
+  int Targets() const { return static_cast<int>(m_cells.size()); }
+  int Steps() const { return m_steps; }
+  int StepsLeft() const; // answers still needed
+  // UIDs to identify now, sorted; the found UIDs once Done()
+  const std::vector<uint64_t> &Lit() const { return m_lit; }
+  const std::vector<uint64_t> &Candidates(int target) const;
+
+  // `lit[t]`: target t is among the identifying fixtures.  False when
+  // not active, already done, or the answer count is wrong.
+  bool Answer(const std::vector<bool> &lit);
+  bool Answer(bool lit) { return Answer(std::vector<bool>{lit}); }
+
+private:
+  void Relight();
+
+  std::vector<std::vector<uint64_t>> m_cells; // per target
+  std::vector<uint64_t> m_lit;
+  int m_steps = 0;
+};
+
+// What moving from one lit group to the next takes on one line
+struct IdentifyStep {
+  bool allOff = false;        // broadcast IDENTIFY off first
+  std::vector<uint64_t> off;  // then these off
+  std::vector<uint64_t> on;   // and these on
+  int Transactions() const {
+    return (allOff ? 1 : 0) + static_cast<int>(off.size() + on.size());
+  }
+};
+
+// Only fixtures that change are sent a SET.  When more fixtures go dark
+// than stay lit, one broadcast turns them all off and the ones staying lit
+// are switched back on, which is fewer frames on the line.
+IdentifyStep PlanIdentifyStep(const std::vector<uint64_t> &litNow,
+                              const std::vector<uint64_t> &litNext);
+
+// Sends a step; returns the UIDs that did not acknowledge their SET.
+// Each SET waits for its own reply rather than a fixed slot, so a step
+// costs Transactions() exchanges of about 3-5 ms each on a USB widget:
+// the first step on a line of 512 lights 256 and takes about 1-1.3 s,
+// and every later step sends at most half as many.  Lines run in
+// parallel.
+template <typename Driver>
+std::vector<uint64_t> SendIdentifyStep(Driver &bus, uint64_t srcUID,
+                                       const IdentifyStep &step) {
+  static const uint8_t kOff = 0x00, kOn = 0x01;
+  std::vector<uint64_t> failed;
+  if (step.allOff)
+    RDMBroadcastSet(bus, srcUID, RDM_BROADCAST_UID, PID_IDENTIFY_DEVICE,
+                    &kOff, 1);
+  auto send = [&](uint64_t uid, const uint8_t *state) {
+    RDMResponse r =
+        RDMSetCommand(bus, srcUID, uid, PID_IDENTIFY_DEVICE, state, 1);
+    if (r.type != RDMResponseType::ACK &&
+        r.type != RDMResponseType::ACK_TIMER)
+      failed.push_back(uid);
+  };
+  for (uint64_t uid : step.off)
+    send(uid, &kOff);
+  for (uint64_t uid : step.on)
+    send(uid, &kOn);
+  return failed;
+}
+
+#endif // FIXTURE_LOCATOR_H
@@ -0,0 +1,275 @@
+// ────────────────────────────────────────────────────────────────────────
+// FleetValidator — validates every discovered fixture on every open port
+// ────────────────────────────────────────────────────────────────────────
+#include "fleet_validator.h"
+#include "perf_trace.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+FleetValidator::~FleetValidator() { Stop(); }
+
+int FleetValidator::AddPort(Sweep sweep, const std::vector<uint64_t> &uids) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (m_active.load() > 0 || !sweep)
+    return -1;
+  int port = static_cast<int>(m_ports.size());
+  m_ports.emplace_back();
+  m_ports.back().sweep = std::move(sweep);
+  for (uint64_t uid : uids) {
+    auto it = m_index.find(uid);
+    if (it == m_index.end()) {
+      it = m_index.emplace(uid, m_fixtures.size()).first;
+      m_fixtures.emplace_back();
+      m_fixtures.back().uid = uid;
+    }
+    auto &ports = m_fixtures[it->second].ports;
+    if (ports.empty() || ports.back() != port)
+      ports.push_back(port);
+  }
+  return port;
+}
+
+void FleetValidator::Clear() {
+  Stop();
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_ports.clear();
+  m_fixtures.clear();
+  m_index.clear();
+  m_completed = 0;
+  m_stolen = 0;
+  m_startUs = m_endUs = 0;
+  std::lock_guard<std::mutex> rlk(m_resultsMutex);
+  m_results.Clear();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Run control
+// ═══════════════════════════════════════════════════════════════════════
+
+void FleetValidator::SetFailFast(bool on) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_failFast = on;
+}
+
+void FleetValidator::SetStoreResults(bool on) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_storeResults = on;
+}
+
+bool FleetValidator::Start(ResultFn onResult, RowFn onRow) {
+  if (IsRunning())
+    return false;
+  Wait(); // join the workers of the finished run
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (m_ports.empty() || m_fixtures.empty())
+    return false;
+
+  // Discovery order, each fixture on the emptiest port that reaches it
+  for (auto &p : m_ports) {
+    p.queue.clear();
+    p.completed = 0;
+  }
+  for (size_t i = 0; i < m_fixtures.size(); ++i) {
+    Fixture &f = m_fixtures[i];
+    f.home = f.ports.front();
+    for (int p : f.ports)
+      if (m_ports[p].queue.size() < m_ports[f.home].queue.size())
+        f.home = p;
+    m_ports[f.home].queue.push_back(i);
+  }
+
+  {
+    std::lock_guard<std::mutex> rlk(m_resultsMutex);
+    m_results.Clear();
+  }
+  m_onResult = std::move(onResult);
+  m_onRow = std::move(onRow);
+  m_cancel = false;
+  m_completed = 0;
+  m_stolen = 0;
+  m_startUs = RdmNowUs();
+  m_endUs = 0;
+  m_active = static_cast<int>(m_ports.size());
+  TRACE_INFO("[Fleet] validating %d fixture(s) on %d port(s)\n",
+             (int)m_fixtures.size(), (int)m_ports.size());
+  for (int p = 0; p < static_cast<int>(m_ports.size()); ++p)
+    m_threads.emplace_back(&FleetValidator::Worker, this, p);
+  return true;
+}
+
+void FleetValidator::Cancel() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_cancel = true;
+}
+
+void FleetValidator::Wait() {
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    threads.swap(m_threads);
+  }
+  for (auto &t : threads)
+    t.join();
+}
+
+FleetProgress FleetValidator::Progress() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  FleetProgress pr;
+  pr.fixtures = static_cast<int>(m_fixtures.size());
+  pr.completed = m_completed;
+  pr.stolen = m_stolen;
+  pr.running = m_active.load() > 0;
+  pr.startUs = m_startUs;
+  if (m_startUs)
+    pr.elapsedUs = (m_endUs ? m_endUs : RdmNowUs()) - m_startUs;
+  for (const auto &p : m_ports)
+    pr.perPort.push_back(p.completed);
+  return pr;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Workers
+// ═══════════════════════════════════════════════════════════════════════
+
+// Own queue first (front, discovery order), then the back of the longest
+// queue holding a fixture this port reaches.  Called with m_mutex held.
+bool FleetValidator::Take(int port, size_t &fixture, bool &stolen) {
+  if (m_cancel)
+    return false;
+  auto &own = m_ports[port].queue;
+  if (!own.empty()) {
+    fixture = own.front();
+    own.pop_front();
+    stolen = false;
+    return true;
+  }
+
+  auto reaches = [&](size_t f) {
+    for (int p : m_fixtures[f].ports)
+      if (p == port)
+        return true;
+    return false;
+  };
+  int victim = -1;
+  size_t longest = 0;
+  for (int p = 0; p < static_cast<int>(m_ports.size()); ++p) {
+    const auto &q = m_ports[p].queue;
+    if (p == port || q.size() <= longest)
+      continue;
+    for (size_t f : q) {
+      if (reaches(f)) {
+        victim = p;
+        longest = q.size();
+        break;
+      }
+    }
+  }
+  if (victim < 0)
+    return false;
+  auto &q = m_ports[victim].queue;
+  for (auto it = q.end(); it != q.begin();) {
+    --it;
+    if (reaches(*it)) {
+      fixture = *it;
+      q.erase(it);
+      stolen = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+void FleetValidator::Worker(int port) {
+  PERF_THREAD_NAME(("fleet " + std::to_string(port)).c_str());
+  ResultStore rows; // this fixture's rows, reused sweep to sweep
+  std::vector<size_t> order;
+  for (;;) {
+    size_t index = 0;
+    bool stolen = false;
+    Sweep sweep;
+    ResultFn deliver;
+    RowFn row;
+    ValidationOptions opts;
+    FleetFixtureResult r;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      if (!Take(port, index, stolen))
+        break;
+      sweep = m_ports[port].sweep;
+      deliver = m_onResult;
+      row = m_onRow;
+      opts.failFast = m_failFast;
+      opts.keepResults = !m_storeResults;
+      r.uid = m_fixtures[index].uid;
+    }
+
+    r.port = port;
+    r.stolen = stolen;
+    r.startUs = RdmNowUs();
+    rows.Clear();
+    opts.samples = [&r, &row, &rows](const ValidationSample &sample) {
+      if (!r.firstResultUs)
+        r.firstResultUs = RdmNowUs() - r.startUs;
+      size_t i = rows.Append(r.uid, sample);
+      if (row)
+        row(r, rows, i);
+      return true;
+    };
+    {
+      PERF_SCOPE_ARG("fleet", "ValidateFixture", "port", port);
+      sweep(r.uid, opts, r);
+    }
+    r.endUs = RdmNowUs();
+    auto count = [&r](ValidationStatus status) {
+      if (status == ValidationStatus::GREEN)
+        ++r.green;
+      else if (status == ValidationStatus::YELLOW)
+        ++r.yellow;
+      else
+        ++r.red;
+    };
+    if (opts.keepResults) {
+      for (const auto &vr : r.results)
+        count(vr.status);
+    } else {
+      // Into the shared store in parameter order, as `results` would be
+      order.resize(rows.Size());
+      std::iota(order.begin(), order.end(), size_t(0));
+      std::sort(order.begin(), order.end(), [&rows](size_t a, size_t b) {
+        return rows.Index(a) < rows.Index(b);
+      });
+      std::lock_guard<std::mutex> lk(m_resultsMutex);
+      r.firstRow = m_results.Size();
+      r.rowCount = rows.Size();
+      for (size_t i : order) {
+        count(rows.Status(i));
+        m_results.Append(rows, i);
+      }
+    }
+    TRACE_DEBUG("[Fleet] port %d: %012llX %d/%d/%d in %lld us\n", port,
+                (unsigned long long)r.uid, r.green, r.yellow, r.red,
+                (long long)(r.endUs - r.startUs));
+
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      ++m_ports[port].completed;
+      ++m_completed;
+      if (stolen)
+        ++m_stolen;
+    }
+    if (deliver)
+      deliver(std::move(r));
+  }
+
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (--m_active == 0) {
+    m_endUs = RdmNowUs();
+    TRACE_INFO("[Fleet] %d fixture(s) done in %lld ms, %d stolen\n",
+               m_completed, (long long)(m_endUs - m_startUs) / 1000,
+               m_stolen);
+  }
+}
@@ -0,0 +1,205 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// FleetValidator — validates every discovered fixture on every open port
+// ────────────────────────────────────────────────────────────────────────
+#ifndef FLEET_VALIDATOR_H
+#define FLEET_VALIDATOR_H
+
+#include "descriptor_cache.h"
+#include "result_store.h"
+#include "snapshot_cache.h"
+#include "validation_planner.h"
+#include "validator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// One fixture's sweep, delivered as soon as it completes
+struct FleetFixtureResult {
+  uint64_t uid = 0;
+  int port = 0;           // port that ran the sweep
+  bool stolen = false;    // taken from another port's queue
+  int64_t startUs = 0;    // RdmNowUs clock
+  int64_t endUs = 0;
+  int64_t firstResultUs = 0; // sweep start to its first row
+  bool aborted = false;      // fail-fast skipped rows after a RED one
+  int green = 0;
+  int yellow = 0;
+  int red = 0;
+  std::vector<ValidationResult> results; // ValidateFixture order
+  // With SetStoreResults(true) `results` stays empty; the rows are
+  // [firstRow, firstRow + rowCount) of ReadResults(), in the same order
+  size_t firstRow = 0;
+  size_t rowCount = 0;
+  // Planned sweeps only (see ValidationPlanner)
+  int missing = 0;         // classified from the supported-parameter list
+  int64_t predictedUs = 0; // the plan's estimate for its GETs
+  int cached = 0;          // rows reused from a SnapshotCache
+  int shared = 0;          // descriptor GETs answered by a DescriptorCache
+};
+
+struct FleetProgress {
+  int fixtures = 0;  // queued by Start()
+  int completed = 0; // results delivered
+  int stolen = 0;    // completed on a port other than their home port
+  bool running = false;
+  int64_t startUs = 0;   // RdmNowUs clock
+  int64_t elapsedUs = 0; // since Start(), frozen once all workers exit
+  std::vector<int> perPort; // fixtures completed by each port
+};
+
+// One worker thread per bus, each running whole-fixture sweeps back to
+// back; the buses themselves are the only serial resource, so N ports
+// finish an evenly spread installation in about 1/N of the time.
+//
+// Every fixture is queued on one port that reaches it (the least loaded
+// one when it was discovered on several).  A port whose queue runs dry
+// steals from the back of the longest queue it can serve — a fixture
+// is only ever swept on a bus it was discovered on.
+//
+// Rows are streamed as they complete through the optional row callback;
+// the whole fixture follows once its sweep is done.  For large fleets,
+// SetStoreResults(true) keeps every row in one ResultStore instead of a
+// ValidationResult vector per fixture.
+//
+// The sweep is any callable that reports its rows through the options'
+// sample sink (and fills in `results` when keepResults is set), honours
+// failFast and sets `aborted` when that left rows unswept.
+// AddPort(Driver&, ...) binds ValidateFixture on a driver object, or a
+// ValidationPlanner sweep when a planner is given, gated by a
+// SnapshotCache when one is given; a DescriptorCache answers the
+// descriptor GETs of models it has seen.  A port must not be used for
+// anything else between Start() and the end of the run.
+class FleetValidator {
+public:
+  using Sweep = std::function<void(uint64_t uid, const ValidationOptions &,
+                                   FleetFixtureResult &out)>;
+  // Called on the worker thread that finished the fixture
+  using ResultFn = std::function<void(FleetFixtureResult &&)>;
+  // Called on the worker thread for every row; `fixture` has the UID,
+  // port and start time filled in, `rows` holds the fixture's rows so far
+  // (completion order)
+  using RowFn = std::function<void(const FleetFixtureResult &fixture,
+                                   const ResultStore &rows, size_t row)>;
+
+  ~FleetValidator();
+
+  // Adds a bus with the UIDs discovered on it; returns its port index.
+  // Ignored (-1) while a run is in progress.
+  int AddPort(Sweep sweep, const std::vector<uint64_t> &uids);
+
+  template <typename Driver>
+  int AddPort(Driver &bus, uint64_t srcUID,
+              const std::vector<RDMParameter> &params,
+              const std::vector<uint64_t> &uids,
+              ValidationPlanner *planner = nullptr,
+              SnapshotCache *snapshots = nullptr,
+              DescriptorCache *descriptors = nullptr) {
+    auto shared = std::make_shared<const std::vector<RDMParameter>>(params);
+    return AddPort(
+        [&bus, srcUID, shared, planner, snapshots, descriptors](
+            uint64_t uid, const ValidationOptions &opts,
+            FleetFixtureResult &r) {
+          RDMGet get = PlannerGet(bus, srcUID, uid);
+          if (descriptors)
+            get = descriptors->Wrap(std::move(get), uid, &r.shared);
+          // Every path publishes one row per parameter unless it stopped
+          size_t rows = 0;
+          ValidationOptions counted = opts;
+          counted.samples = [&rows, &opts](const ValidationSample &s) {
+            ++rows;
+            return !opts.samples || opts.samples(s);
+          };
+          if (snapshots) {
+            SnapshotStats st;
+            r.results = snapshots->Validate(get, uid, *shared, planner,
+                                            counted, &st);
+            r.cached = st.cached;
+          } else if (!planner) {
+            r.results = ValidateFixture(get, *shared, counted);
+          } else {
+            ValidationPlan plan;
+            r.results = planner->Validate(get, uid, *shared, &plan, counted);
+            r.missing = static_cast<int>(plan.missing.size());
+            r.predictedUs = plan.predictedUs;
+          }
+          r.aborted = opts.failFast && rows < shared->size();
+        },
+        uids);
+  }
+
+  // Forgets all ports and fixtures (stops a run first)
+  void Clear();
+
+  // Pass / fail stations: each sweep stops at its first RED row.
+  // Takes effect at the next Start().
+  void SetFailFast(bool on);
+  // Rows go to the shared store rather than each fixture's `results`.
+  // Takes effect at the next Start(), which empties the store.
+  void SetStoreResults(bool on);
+
+  // Runs `fn(const ResultStore &)` with the shared store locked; fixtures
+  // are appended to it as they complete
+  template <typename Fn> void ReadResults(Fn &&fn) const {
+    std::lock_guard<std::mutex> lk(m_resultsMutex);
+    fn(static_cast<const ResultStore &>(m_results));
+  }
+
+  // Starts one worker per port.  False if already running or nothing to
+  // validate.
+  bool Start(ResultFn onResult, RowFn onRow = nullptr);
+  // No further fixtures are handed out; sweeps in progress complete and
+  // are still delivered.  Wait() joins the workers.
+  void Cancel();
+  void Wait();
+  void Stop() {
+    Cancel();
+    Wait();
+  }
+  bool IsRunning() const { return m_active.load() > 0; }
+
+  FleetProgress Progress() const;
+
+private:
+  struct Port {
+    Sweep sweep;
+    std::deque<size_t> queue; // indices into m_fixtures
+    int completed = 0;
+  };
+  struct Fixture {
+    uint64_t uid = 0;
+    int home = 0;           // port it was queued on by Start()
+    std::vector<int> ports; // every port it was discovered on
+  };
+
+  bool Take(int port, size_t &fixture, bool &stolen);
+  void Worker(int port);
+
+  mutable std::mutex m_mutex; // guards everything below except m_active
+  std::vector<Port> m_ports;
+  std::vector<Fixture> m_fixtures;
+  std::unordered_map<uint64_t, size_t> m_index; // UID -> m_fixtures
+  std::vector<std::thread> m_threads;
+  ResultFn m_onResult;
+  RowFn m_onRow;
+  bool m_failFast = false;
+  bool m_storeResults = false;
+  bool m_cancel = false;
+  int m_completed = 0;
+  int m_stolen = 0;
+  int64_t m_startUs = 0;
+  int64_t m_endUs = 0;
+  std::atomic<int> m_active{0};
+
+  mutable std::mutex m_resultsMutex; // guards m_results only
+  ResultStore m_results;
+};
+
+#endif // FLEET_VALIDATOR_H
@@ -0,0 +1,239 @@
+// ────────────────────────────────────────────────────────────────────────
+// Latency statistics — HDR-style histograms per (UID, PID, command class)
+// ────────────────────────────────────────────────────────────────────────
+#include "latency_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LatencyHistogram
+// ═══════════════════════════════════════════════════════════════════════════
+
+int LatencyHistogram::BucketIndex(int64_t valueUs) {
+  if (valueUs < 0)
+    valueUs = 0;
+  if (valueUs > kMaxValue)
+    valueUs = kMaxValue;
+  if (valueUs < kLinear)
+    return static_cast<int>(valueUs);
+
+  int msb = 0;
+  for (uint64_t v = static_cast<uint64_t>(valueUs) >> 1; v; v >>= 1)
+    ++msb;
+  int shift = msb - kSubBits;
+  int sub = static_cast<int>(valueUs >> shift) - kSubBuckets;
+  return kLinear + (msb - kSubBits - 1) * kSubBuckets + sub;
+}
+
+int64_t LatencyHistogram::BucketUpper(int index) {
+  if (index < kLinear)
+    return index;
+  int octave = (index - kLinear) / kSubBuckets;
+  int sub = (index - kLinear) % kSubBuckets;
+  int shift = octave + 1;
+  int64_t lower = static_cast<int64_t>(kSubBuckets + sub) << shift;
+  return lower + (1LL << shift) - 1;
+}
+
+void LatencyHistogram::Record(int64_t valueUs) {
+  if (valueUs < 0)
+    valueUs = 0;
+  ++m_counts[BucketIndex(valueUs)];
+  if (m_count == 0 || valueUs < m_min)
+    m_min = valueUs;
+  if (m_count == 0 || valueUs > m_max)
+    m_max = valueUs;
+  ++m_count;
+  m_sum += valueUs;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other) {
+  if (other.m_count == 0)
+    return;
+  for (int i = 0; i < kBuckets; ++i)
+    m_counts[i] += other.m_counts[i];
+  if (m_count == 0 || other.m_min < m_min)
+    m_min = other.m_min;
+  if (m_count == 0 || other.m_max > m_max)
+    m_max = other.m_max;
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void LatencyHistogram::Reset() { *this = LatencyHistogram(); }
+
+double LatencyHistogram::Mean() const {
+  return m_count ? static_cast<double>(m_sum) / m_count : 0.0;
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (m_count == 0)
+    return 0;
+  percentile = std::min(100.0, std::max(0.0, percentile));
+  uint64_t target =
+      static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+  if (target == 0)
+    target = 1;
+
+  uint64_t seen = 0;
+  for (int i = 0; i < kBuckets; ++i) {
+    seen += m_counts[i];
+    if (seen >= target)
+      return std::min(BucketUpper(i), m_max);
+  }
+  return m_max;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LatencyRecorder
+// ═══════════════════════════════════════════════════════════════════════════
+
+void LatencyRecorder::Bucket::Add(LatencyOutcome o, int64_t latencyUs) {
+  ++outcomes[static_cast<int>(o)];
+  if (latencyUs >= 0)
+    hist.Record(latencyUs);
+}
+
+void LatencyRecorder::Bucket::Merge(const Bucket &b) {
+  hist.Merge(b.hist);
+  for (int i = 0; i < static_cast<int>(LatencyOutcome::COUNT_); ++i)
+    outcomes[i] += b.outcomes[i];
+}
+
+void LatencyRecorder::Bucket::Reset() { *this = Bucket(); }
+
+void LatencyRecorder::Rotate(Entry &e, int64_t epoch) {
+  if (epoch == e.epoch)
+    return;
+  if (epoch == e.epoch + 1)
+    e.previous = e.current;
+  else
+    e.previous.Reset();
+  e.current.Reset();
+  e.epoch = epoch;
+}
+
+LatencyRecorder::Bucket LatencyRecorder::WindowOf(const Entry &e,
+                                                  int64_t epoch) {
+  Bucket b;
+  if (epoch == e.epoch) {
+    b = e.previous;
+    b.Merge(e.current);
+  } else if (epoch == e.epoch + 1) {
+    b = e.current;
+  }
+  return b;
+}
+
+void LatencyRecorder::Record(const LatencyKey &key, LatencyOutcome outcome,
+                             int64_t latencyUs, int64_t nowUs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry *e;
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    e = m_entries[it->second].get();
+  } else {
+    if (static_cast<int>(m_entries.size()) >= kMaxEntries) {
+      ++m_dropped;
+      return;
+    }
+    m_entries.push_back(std::make_unique<Entry>());
+    e = m_entries.back().get();
+    e->key = key;
+    e->epoch = nowUs / m_windowUs;
+    m_index.emplace(key, m_entries.size() - 1);
+  }
+
+  Rotate(*e, nowUs / m_windowUs);
+  e->lifetime.Add(outcome, latencyUs);
+  e->current.Add(outcome, latencyUs);
+}
+
+void LatencyRecorder::Summarize(const Bucket &b, const LatencyKey &key,
+                                LatencySummary &out) {
+  out.key = key;
+  for (int i = 0; i < static_cast<int>(LatencyOutcome::COUNT_); ++i)
+    out.outcomes[i] = b.outcomes[i];
+  out.samples = b.hist.Count();
+  out.minUs = b.hist.Min();
+  out.p50Us = b.hist.ValueAtPercentile(50.0);
+  out.p90Us = b.hist.ValueAtPercentile(90.0);
+  out.p99Us = b.hist.ValueAtPercentile(99.0);
+  out.maxUs = b.hist.Max();
+  out.meanUs = b.hist.Mean();
+}
+
+int LatencyRecorder::Snapshot(LatencySummary *out, int max, bool windowed,
+                              int64_t nowUs) const {
+  if (!out || max <= 0)
+    return 0;
+
+  std::vector<LatencySummary> all;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int64_t epoch = nowUs / m_windowUs;
+    all.reserve(m_entries.size());
+    for (const auto &e : m_entries) {
+      LatencySummary s;
+      if (windowed)
+        Summarize(WindowOf(*e, epoch), e->key, s);
+      else
+        Summarize(e->lifetime, e->key, s);
+      all.push_back(s);
+    }
+  }
+
+  // Slowest first so outliers lead the list
+  std::sort(all.begin(), all.end(),
+            [](const LatencySummary &a, const LatencySummary &b) {
+              if (a.p99Us != b.p99Us)
+                return a.p99Us > b.p99Us;
+              return a.maxUs > b.maxUs;
+            });
+
+  int n = std::min(max, static_cast<int>(all.size()));
+  std::copy(all.begin(), all.begin() + n, out);
+  return n;
+}
+
+LatencySummary LatencyRecorder::Fleet(bool windowed, int64_t nowUs) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  int64_t epoch = nowUs / m_windowUs;
+  Bucket total;
+  for (const auto &e : m_entries)
+    total.Merge(windowed ? WindowOf(*e, epoch) : e->lifetime);
+  LatencySummary s;
+  Summarize(total, LatencyKey{}, s);
+  return s;
+}
+
+int LatencyRecorder::EntryCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<int>(m_entries.size());
+}
+
+uint64_t LatencyRecorder::EntriesDropped() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_dropped;
+}
+
+void LatencyRecorder::SetWindow(int64_t windowUs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (windowUs <= 0 || windowUs == m_windowUs)
+    return;
+  // Window boundaries move; start every window afresh
+  m_windowUs = windowUs;
+  for (auto &e : m_entries) {
+    e->current.Reset();
+    e->previous.Reset();
+    e->epoch = 0;
+  }
+}
+
+void LatencyRecorder::Reset() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_dropped = 0;
+}
@@ -0,0 +1,155 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Latency statistics — HDR-style histograms per (UID, PID, command class)
+// ────────────────────────────────────────────────────────────────────────
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// ── Log-linear histogram ────────────────────────────────────────────────
+//    Values below 32 us get their own bucket; above that every power of
+//    two is split into 16 linear sub-buckets, so any recorded value is
+//    reported within 1/16 (~6 %) of its true value.  Fixed 1.8 KB,
+//    recording is a couple of shifts and an increment.  Values are
+//    clamped to LatencyHistogram::kMaxValue (~35 min).
+class LatencyHistogram {
+public:
+  static constexpr int kSubBits = 4;
+  static constexpr int kSubBuckets = 1 << kSubBits;
+  static constexpr int kLinear = 2 * kSubBuckets;
+  static constexpr int kMaxBit = 30;
+  static constexpr int kBuckets = kLinear + (kMaxBit - kSubBits) * kSubBuckets;
+  static constexpr int64_t kMaxValue = (1LL << (kMaxBit + 1)) - 1;
+
+  void Record(int64_t valueUs);
+  void Merge(const LatencyHistogram &other);
+  void Reset();
+
+  uint64_t Count() const { return m_count; }
+  int64_t Min() const { return m_count ? m_min : 0; }
+  int64_t Max() const { return m_count ? m_max : 0; }
+  double Mean() const;
+
+  // Smallest value v such that `percentile` % of samples are <= v
+  // (reported as the top of the bucket, capped at Max()).
+  int64_t ValueAtPercentile(double percentile) const;
+
+  static int BucketIndex(int64_t valueUs);
+  static int64_t BucketUpper(int index);
+
+private:
+  uint32_t m_counts[kBuckets] = {};
+  uint64_t m_count = 0;
+  int64_t m_min = 0;
+  int64_t m_max = 0;
+  int64_t m_sum = 0;
+};
+
+// ── Per-transaction outcome (same order as RDX_STATUS_*) ────────────────
+enum class LatencyOutcome : uint8_t {
+  ACK,
+  ACK_TIMER,
+  NACK,
+  TIMEOUT,
+  CHECKSUM_ERR,
+  INVALID,
+  COUNT_
+};
+
+struct LatencyKey {
+  uint64_t uid = 0;
+  uint16_t pid = 0;
+  uint8_t commandClass = 0;
+
+  bool operator==(const LatencyKey &o) const {
+    return uid == o.uid && pid == o.pid && commandClass == o.commandClass;
+  }
+};
+
+struct LatencyKeyHash {
+  size_t operator()(const LatencyKey &k) const {
+    uint64_t h = k.uid ^ (uint64_t(k.pid) << 48) ^ (uint64_t(k.commandClass)
+                                                    << 40);
+    return static_cast<size_t>(h * 0x9E3779B97F4A7C15ULL);
+  }
+};
+
+// Flattened view of one key, ready for the API
+struct LatencySummary {
+  LatencyKey key;
+  uint32_t outcomes[static_cast<int>(LatencyOutcome::COUNT_)] = {};
+  uint64_t samples = 0; // latency samples (responses only)
+  int64_t minUs = 0;
+  int64_t p50Us = 0;
+  int64_t p90Us = 0;
+  int64_t p99Us = 0;
+  int64_t maxUs = 0;
+  double meanUs = 0.0;
+};
+
+// ── Recorder ────────────────────────────────────────────────────────────
+//    One entry per (UID, PID, command class), holding a lifetime
+//    histogram plus a rolling window made of the current and previous
+//    interval (so a windowed view covers 1-2 intervals).  Outcome counts
+//    are kept for both.  Thread-safe; Record() is a hash lookup plus the
+//    histogram increment under one short lock.
+class LatencyRecorder {
+public:
+  static constexpr int kMaxEntries = 4096;
+
+  explicit LatencyRecorder(int64_t windowUs = 60000000)
+      : m_windowUs(windowUs) {}
+
+  // `latencyUs` < 0 means "no sample" (timeouts); the outcome still counts.
+  void Record(const LatencyKey &key, LatencyOutcome outcome,
+              int64_t latencyUs, int64_t nowUs);
+
+  // Copies up to `max` summaries, slowest p99 first.  `windowed` selects
+  // the rolling window instead of the lifetime histogram.  Returns the
+  // number written.
+  int Snapshot(LatencySummary *out, int max, bool windowed,
+               int64_t nowUs) const;
+
+  // All keys merged into one summary (key.uid == 0)
+  LatencySummary Fleet(bool windowed, int64_t nowUs) const;
+
+  int EntryCount() const;
+  uint64_t EntriesDropped() const;
+  void SetWindow(int64_t windowUs);
+  void Reset();
+
+private:
+  struct Bucket {
+    LatencyHistogram hist;
+    uint32_t outcomes[static_cast<int>(LatencyOutcome::COUNT_)] = {};
+    void Add(LatencyOutcome o, int64_t latencyUs);
+    void Merge(const Bucket &b);
+    void Reset();
+  };
+  struct Entry {
+    LatencyKey key;
+    Bucket lifetime;
+    Bucket current;
+    Bucket previous;
+    int64_t epoch = 0; // window index of `current`
+  };
+
+  static void Rotate(Entry &e, int64_t epoch);
+  static void Summarize(const Bucket &b, const LatencyKey &key,
+                        LatencySummary &out);
+  // Window view of `e` at `epoch` without mutating it
+  static Bucket WindowOf(const Entry &e, int64_t epoch);
+
+  int64_t m_windowUs;
+  mutable std::mutex m_mutex;
+  std::unordered_map<LatencyKey, size_t, LatencyKeyHash> m_index;
+  std::vector<std::unique_ptr<Entry>> m_entries;
+  uint64_t m_dropped = 0;
+};
+
+#endif // LATENCY_STATS_H
@@ -21,6 +21,7 @@
 #include "enttec_pro.h"
 #include "parameter_loader.h"
 #include "rdm.h"
+#include "trace_ring.h"
 #include "validator.h"
 
 // ── DirectX 11 globals ──────────────────────────────────────────────────
@@ -62,7 +63,9 @@ static EnttecPro g_pro;
 static std::vector<RDMParameter> g_params;
 static std::vector<uint64_t> g_discoveredUIDs;
 static int g_selectedUID = -1;
+// Filled row by row by the validation worker; read by the UI thread
 static std::vector<ValidationResult> g_validationResults;
+static std::mutex g_resultsMutex;
 static bool g_isConnected = false;
 static bool g_discovering = false;
 static bool g_validating = false;
@@ -79,17 +82,28 @@ struct LogEntry {
   bool isTX; // true=TX (cyan), false=RX (green)
   std::string text;
 };
-static std::mutex g_logMutex;
+// Owned by the UI thread.  Worker and driver threads record into the
+// trace ring; DrainTrace() formats and appends once per frame.
 static std::deque<LogEntry> g_logEntries;
 static const int kMaxLogEntries = 500;
 
 static void AddLog(bool tx, const std::string &text) {
-  std::lock_guard<std::mutex> lk(g_logMutex);
   if (g_logEntries.size() >= kMaxLogEntries)
     g_logEntries.pop_front();
   g_logEntries.push_back({tx, text});
 }
 
+static void DrainTrace() {
+  GlobalTracer().Drain([](const TraceEvent &e) {
+    if (e.kind == TraceKind::TEXT) {
+      AddLog(false, Tracer::Format(e));
+      return;
+    }
+    bool tx = e.kind == TraceKind::FRAME_TX;
+    AddLog(tx, (tx ? "TX: " : "RX: ") + Tracer::Format(e, 64));
+  });
+}
+
 // ── Worker thread helpers ───────────────────────────────────────────────
 static std::thread g_workerThread;
 static std::atomic<bool> g_workerBusy{false};
@@ -97,25 +111,33 @@ static std::atomic<bool> g_workerBusy{false};
 static void WorkerDiscovery() {
   g_workerBusy = true;
   g_discovering = true;
-  AddLog(true, "--- Starting RDM Discovery ---");
-  AddLog(true, "    (DMX output paused during discovery)");
+  TRACE_INFO("--- Starting RDM Discovery ---");
+  TRACE_INFO("    (DMX output paused during discovery)");
   auto uids = RDMDiscovery(g_pro, kControllerUID);
   g_discoveredUIDs = uids;
-  char buf[64];
-  snprintf(buf, sizeof(buf), "--- Discovery complete: %d device(s) found ---",
-           static_cast<int>(uids.size()));
-  AddLog(false, buf);
+  TRACE_INFO("--- Discovery complete: %d device(s) found ---",
+             static_cast<int>(uids.size()));
   g_discovering = false;
   g_workerBusy = false;
 }
 
+static void ClearResults() {
+  std::lock_guard<std::mutex> lk(g_resultsMutex);
+  g_validationResults.clear();
+}
+
 static void WorkerValidate(uint64_t uid) {
   g_workerBusy = true;
   g_validating = true;
-  AddLog(true, "--- Validating " + UIDToString(uid) + " ---");
-  auto results = ValidateFixture(g_pro, kControllerUID, uid, g_params);
-  g_validationResults = results;
-  AddLog(false, "--- Validation complete ---");
+  TRACE_INFO("--- Validating %04X:%08X ---", TRACE_UID(uid));
+  ValidationOptions opts;
+  opts.sink = [](size_t, const ValidationResult &vr) {
+    std::lock_guard<std::mutex> lk(g_resultsMutex);
+    g_validationResults.push_back(vr);
+    return true;
+  };
+  ValidateFixture(g_pro, kControllerUID, uid, g_params, opts);
+  TRACE_INFO("--- Validation complete ---");
   g_validating = false;
   g_workerBusy = false;
 }
@@ -235,17 +257,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
 
   // Wire up the log callback
   g_pro.SetLogCallback([](bool tx, const uint8_t *data, int len) {
-    std::string hex;
-    hex.reserve(len * 3 + 8);
-    hex = tx ? "TX: " : "RX: ";
-    for (int i = 0; i < len && i < 64; ++i) {
-      char buf[4];
-      snprintf(buf, sizeof(buf), "%02X ", data[i]);
-      hex += buf;
-    }
-    if (len > 64)
-      hex += "...";
-    AddLog(tx, hex);
+    TRACE_FRAME(tx, data, len);
   });
 
   AddLog(false, "RDM_X started. Loaded " + std::to_string(g_params.size()) +
@@ -343,7 +355,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
           g_pro.Close();
           g_isConnected = false;
           g_discoveredUIDs.clear();
-          g_validationResults.clear();
+          ClearResults();
           g_selectedUID = -1;
           AddLog(false, "Disconnected.");
         }
@@ -356,7 +368,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
       if (g_isConnected && !busy) {
         if (ImGui::Button("Discover Devices", ImVec2(-1, 0))) {
           g_discoveredUIDs.clear();
-          g_validationResults.clear();
+          ClearResults();
           g_selectedUID = -1;
           if (g_workerThread.joinable())
             g_workerThread.join();
@@ -380,7 +392,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
             g_selectedUID = i;
             // Auto-validate on selection
             if (!g_workerBusy.load()) {
-              g_validationResults.clear();
+              ClearResults();
               if (g_workerThread.joinable())
                 g_workerThread.join();
               uint64_t uid = g_discoveredUIDs[i];
@@ -408,9 +420,16 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
         ImGui::Separator();
       }
 
+      // Rows arrive while the worker runs; draw from a snapshot
+      std::vector<ValidationResult> results;
+      {
+        std::lock_guard<std::mutex> lk(g_resultsMutex);
+        results = g_validationResults;
+      }
+
       // Summary counters
       int greenCount = 0, yellowCount = 0, redCount = 0;
-      for (auto &vr : g_validationResults) {
+      for (auto &vr : results) {
         switch (vr.status) {
         case ValidationStatus::GREEN:
           greenCount++;
@@ -423,7 +442,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
           break;
         }
       }
-      if (!g_validationResults.empty()) {
+      if (!results.empty()) {
         ImGui::TextColored(ImVec4(0.1f, 0.8f, 0.1f, 1), "PASS: %d", greenCount);
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(0.9f, 0.8f, 0.1f, 1), "  WARN: %d",
@@ -449,7 +468,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
         ImGui::TableSetupScrollFreeze(0, 1);
         ImGui::TableHeadersRow();
 
-        for (const auto &vr : g_validationResults) {
+        for (const auto &vr : results) {
           ImGui::TableNextRow();
 
           // PID
@@ -489,16 +508,14 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     // ══════════════════════════════════════════════════════════════════
     ImGui::Begin("Protocol Log", nullptr, ImGuiWindowFlags_NoCollapse);
     {
-      if (ImGui::Button("Clear Log")) {
-        std::lock_guard<std::mutex> lk(g_logMutex);
+      DrainTrace();
+      if (ImGui::Button("Clear Log"))
         g_logEntries.clear();
-      }
       ImGui::Separator();
 
       ImGui::BeginChild("##logscroll", ImVec2(0, 0), ImGuiChildFlags_None,
                         ImGuiWindowFlags_HorizontalScrollbar);
       {
-        std::lock_guard<std::mutex> lk(g_logMutex);
         for (const auto &entry : g_logEntries) {
           ImVec4 color = entry.isTX
                              ? ImVec4(0.3f, 0.85f, 1.0f, 1.0f) // cyan for TX
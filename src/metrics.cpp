@@ -0,0 +1,149 @@
+// ────────────────────────────────────────────────────────────────────────
+// Metrics — per-port counters and gauges, Prometheus text rendering
+// ────────────────────────────────────────────────────────────────────────
+#include "metrics.h"
+
+#include <cstdio>
+
+MetricsRegistry &GlobalMetrics() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+namespace {
+struct MetricInfo {
+  const char *name;
+  const char *help;
+};
+
+// Indexed by Metric
+const MetricInfo kMetricInfo[] = {
+    {"rdx_dmx_frames_tx_total", "DMX frames written to the interface"},
+    {"rdx_rdm_requests_tx_total", "RDM and discovery requests written"},
+    {"rdx_rdm_responses_total", "RDM ACK, ACK_TIMER and NACK responses"},
+    {"rdx_rdm_nacks_total", "RDM NACK responses received"},
+    {"rdx_rdm_timeouts_total", "RDM requests that got no response"},
+    {"rdx_rdm_checksum_errors_total", "RDM responses with a bad checksum"},
+    {"rdx_rdm_invalid_responses_total", "RDM responses with a bad header"},
+    {"rdx_rx_frame_errors_total", "Receive framing errors / overruns"},
+    {"rdx_dub_collisions_total", "DISC_UNIQUE_BRANCH collisions"},
+    {"rdx_uids_discovered_total", "UIDs found by discovery"},
+    {"rdx_purges_total", "Interface buffer purges"},
+    {"rdx_device_opens_total", "Successful interface opens"},
+    {"rdx_recoveries_total", "Driver reloads after a failed open"},
+    {"rdx_usb_errors_total", "Short writes and failed USB transfers"},
+};
+static_assert(sizeof(kMetricInfo) / sizeof(kMetricInfo[0]) == kMetricCount,
+              "kMetricInfo must list every Metric");
+
+const MetricInfo kGaugeInfo[] = {
+    {"rdx_rx_queue_bytes", "Bytes in the interface RX queue at last poll"},
+};
+static_assert(sizeof(kGaugeInfo) / sizeof(kGaugeInfo[0]) == kGaugeCount,
+              "kGaugeInfo must list every Gauge");
+
+constexpr int64_t kRateIntervalUs = 1000000;
+} // namespace
+
+const char *MetricsRegistry::Name(Metric m) {
+  return kMetricInfo[static_cast<int>(m)].name;
+}
+
+// Caller holds m_rateMutex
+double MetricsRegistry::SampleDmxRate(int port, uint64_t frames,
+                                      int64_t nowUs) {
+  RateSample &s = m_rates[port];
+  if (s.us == 0 || frames < s.frames) { // first sample, or after Reset()
+    s.frames = frames;
+    s.us = nowUs;
+    s.hz = 0;
+  } else if (nowUs - s.us >= kRateIntervalUs) {
+    s.hz = static_cast<double>(frames - s.frames) * 1e6 /
+           static_cast<double>(nowUs - s.us);
+    s.frames = frames;
+    s.us = nowUs;
+  }
+  return s.hz;
+}
+
+MetricsSnapshot MetricsRegistry::Snapshot(int port, int64_t nowUs) {
+  MetricsSnapshot snap;
+  int first = port, last = port;
+  if (port < 0) {
+    first = 0;
+    last = kMaxPorts - 1;
+  } else if (port >= kMaxPorts) {
+    return snap;
+  }
+
+  std::lock_guard<std::mutex> lk(m_rateMutex);
+  for (int p = first; p <= last; ++p) {
+    const PortBlock &b = m_ports[p];
+    for (int i = 0; i < kMetricCount; ++i)
+      snap.counters[i] += b.counters[i].load(std::memory_order_relaxed);
+    for (int i = 0; i < kGaugeCount; ++i)
+      snap.gauges[i] += b.gauges[i].load(std::memory_order_relaxed);
+    uint64_t frames =
+        b.counters[static_cast<int>(Metric::DMX_FRAMES_TX)].load(
+            std::memory_order_relaxed);
+    snap.dmxRateHz += SampleDmxRate(p, frames, nowUs);
+  }
+  return snap;
+}
+
+std::string MetricsRegistry::RenderPrometheus(int portCount, int64_t nowUs) {
+  if (portCount < 1)
+    portCount = 1;
+  if (portCount > kMaxPorts)
+    portCount = kMaxPorts;
+
+  MetricsSnapshot snaps[kMaxPorts];
+  for (int p = 0; p < portCount; ++p)
+    snaps[p] = Snapshot(p, nowUs);
+
+  std::string out;
+  char line[160];
+  auto header = [&](const MetricInfo &info, const char *type) {
+    snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s %s\n", info.name,
+             info.help, info.name, type);
+    out += line;
+  };
+
+  for (int i = 0; i < kMetricCount; ++i) {
+    header(kMetricInfo[i], "counter");
+    for (int p = 0; p < portCount; ++p) {
+      snprintf(line, sizeof(line), "%s{port=\"%d\"} %llu\n",
+               kMetricInfo[i].name, p,
+               static_cast<unsigned long long>(snaps[p].counters[i]));
+      out += line;
+    }
+  }
+  for (int i = 0; i < kGaugeCount; ++i) {
+    header(kGaugeInfo[i], "gauge");
+    for (int p = 0; p < portCount; ++p) {
+      snprintf(line, sizeof(line), "%s{port=\"%d\"} %lld\n",
+               kGaugeInfo[i].name, p,
+               static_cast<long long>(snaps[p].gauges[i]));
+      out += line;
+    }
+  }
+  header({"rdx_dmx_rate_hz", "Achieved DMX output rate"}, "gauge");
+  for (int p = 0; p < portCount; ++p) {
+    snprintf(line, sizeof(line), "rdx_dmx_rate_hz{port=\"%d\"} %.2f\n", p,
+             snaps[p].dmxRateHz);
+    out += line;
+  }
+  return out;
+}
+
+void MetricsRegistry::Reset() {
+  for (auto &b : m_ports) {
+    for (auto &c : b.counters)
+      c.store(0, std::memory_order_relaxed);
+    for (auto &g : b.gauges)
+      g.store(0, std::memory_order_relaxed);
+  }
+  std::lock_guard<std::mutex> lk(m_rateMutex);
+  for (auto &r : m_rates)
+    r = RateSample{};
+}
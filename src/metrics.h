@@ -0,0 +1,106 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Metrics — per-port counters and gauges, Prometheus text rendering
+// ────────────────────────────────────────────────────────────────────────
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Monotonic counters.  Keep kMetricInfo (metrics.cpp) in the same order.
+enum class Metric : uint8_t {
+  DMX_FRAMES_TX,     // DMX frames written to the interface
+  RDM_REQUESTS_TX,   // RDM / discovery requests written
+  RDM_RESPONSES,     // ACK, ACK_TIMER and NACK responses
+  RDM_NACKS,         // subset of RDM_RESPONSES
+  RDM_TIMEOUTS,      // no response to a request that expected one
+  CHECKSUM_ERRORS,   // response with a bad checksum
+  INVALID_RESPONSES, // response with a bad start code / header
+  RX_FRAME_ERRORS,   // framing error / overrun reported by the interface
+  DUB_COLLISIONS,    // DISC_UNIQUE_BRANCH answered by several responders
+  UIDS_DISCOVERED,
+  PURGES,       // RX / TX buffer purges
+  DEVICE_OPENS, // successful opens (a rising count = reconnects)
+  RECOVERIES,   // driver reload after a failed open
+  USB_ERRORS,   // short writes / failed bulk transfers
+  COUNT
+};
+
+enum class Gauge : uint8_t {
+  RX_QUEUE_BYTES, // bytes waiting in the interface RX queue at last poll
+  COUNT
+};
+
+constexpr int kMetricCount = static_cast<int>(Metric::COUNT);
+constexpr int kGaugeCount = static_cast<int>(Gauge::COUNT);
+
+// Point-in-time copy of one port (or the sum over all ports)
+struct MetricsSnapshot {
+  uint64_t counters[kMetricCount] = {};
+  int64_t gauges[kGaugeCount] = {};
+  double dmxRateHz = 0; // achieved DMX output rate, see Snapshot()
+
+  uint64_t operator[](Metric m) const {
+    return counters[static_cast<int>(m)];
+  }
+};
+
+// ── MetricsRegistry ─────────────────────────────────────────────────────
+//    Writers (any thread) pay one relaxed atomic add / store; each port's
+//    block sits on its own cache lines.  Derived values (the DMX rate) are
+//    computed on the read side, so the hot path never does arithmetic or
+//    takes a lock.  Ports outside [0, kMaxPorts) are ignored.
+class MetricsRegistry {
+public:
+  static constexpr int kMaxPorts = 16;
+
+  void Add(int port, Metric m, uint64_t n = 1) {
+    if (static_cast<unsigned>(port) < kMaxPorts)
+      m_ports[port].counters[static_cast<int>(m)].fetch_add(
+          n, std::memory_order_relaxed);
+  }
+  void Set(int port, Gauge g, int64_t value) {
+    if (static_cast<unsigned>(port) < kMaxPorts)
+      m_ports[port].gauges[static_cast<int>(g)].store(
+          value, std::memory_order_relaxed);
+  }
+
+  // `port` -1 sums every port.  The DMX rate is the frame count delta over
+  // the last sampling interval (>= 1 s, advanced by calls to Snapshot), so
+  // it needs two calls at least a second apart before it reads non-zero.
+  MetricsSnapshot Snapshot(int port, int64_t nowUs);
+
+  // Prometheus text exposition format (version 0.0.4) for ports
+  // [0, portCount), one labelled sample per port.
+  std::string RenderPrometheus(int portCount, int64_t nowUs);
+
+  void Reset();
+
+  static const char *Name(Metric m); // e.g. "rdx_dmx_frames_tx_total"
+
+private:
+  struct alignas(64) PortBlock {
+    std::atomic<uint64_t> counters[kMetricCount] = {};
+    std::atomic<int64_t> gauges[kGaugeCount] = {};
+  };
+  struct RateSample {
+    uint64_t frames = 0;
+    int64_t us = 0; // 0 = no baseline yet
+    double hz = 0;
+  };
+
+  double SampleDmxRate(int port, uint64_t frames, int64_t nowUs);
+
+  PortBlock m_ports[kMaxPorts];
+
+  std::mutex m_rateMutex; // read side only
+  RateSample m_rates[kMaxPorts];
+};
+
+// Process-wide registry shared by the drivers, the RDM core and the API
+MetricsRegistry &GlobalMetrics();
+
+#endif // METRICS_H
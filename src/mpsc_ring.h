@@ -0,0 +1,84 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// MpscRing — bounded lock-free multi-producer / single-consumer queue
+// ────────────────────────────────────────────────────────────────────────
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Same contract as SpscRing (fixed capacity, producers never block, full
+// means drop) for rings fed from several I/O threads at once.  Each cell
+// carries a sequence number: producers claim a cell with one CAS on the
+// enqueue index, fill it in place and publish it by bumping the cell's
+// sequence, so a slow producer never exposes a half-written item.
+// `Capacity` must be a power of two.
+template <typename T, size_t Capacity> class MpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "MpscRing capacity must be a power of two");
+
+public:
+  MpscRing() {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MpscRing(const MpscRing &) = delete;
+  MpscRing &operator=(const MpscRing &) = delete;
+
+  // Producer side (any thread).  `fill(T&)` writes the claimed cell.
+  // Returns false without calling `fill` when the ring is full.
+  template <typename Fill> bool Emplace(Fill &&fill) {
+    size_t pos = m_enqueue.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell &c = m_cells[pos & (Capacity - 1)];
+      size_t seq = c.seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_enqueue.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          fill(c.item);
+          c.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // full
+      } else {
+        pos = m_enqueue.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer side (one thread).  `use(const T&)` reads the item in place.
+  template <typename Use> bool Consume(Use &&use) {
+    size_t pos = m_dequeue.load(std::memory_order_relaxed);
+    Cell &c = m_cells[pos & (Capacity - 1)];
+    if (c.seq.load(std::memory_order_acquire) != pos + 1)
+      return false; // empty, or the producer is still writing
+    use(c.item);
+    c.seq.store(pos + Capacity, std::memory_order_release);
+    m_dequeue.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Approximate when called concurrently
+  size_t Size() const {
+    return m_enqueue.load(std::memory_order_acquire) -
+           m_dequeue.load(std::memory_order_acquire);
+  }
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T item;
+  };
+
+  alignas(64) std::atomic<size_t> m_enqueue{0};
+  alignas(64) std::atomic<size_t> m_dequeue{0};
+  Cell m_cells[Capacity];
+};
+
+#endif // MPSC_RING_H
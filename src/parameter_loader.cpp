@@ -6,6 +6,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
 
 // ── Trim whitespace ─────────────────────────────────────────────────────
 static std::string Trim(const std::string& s)
@@ -59,35 +60,39 @@ static uint16_t ParseHexPID(const std::string& s)
 //   Col F (5): Payload Length
 //   Col G (6): Description (may span multiple "lines" inside quotes)
 //
-std::vector<RDMParameter> LoadParameters(const std::string& csvPath)
+// ── Read a CSV file as logical records ──────────────────────────────────
+// A record ends at a newline that is NOT inside a quoted field, so
+// multi-line descriptions stay in one record.
+static std::vector<std::string> ReadRecords(const std::string& csvPath)
 {
-    std::vector<RDMParameter> params;
+    std::vector<std::string> records;
 
     std::ifstream file(csvPath);
-    if (!file.is_open()) return params;
+    if (!file.is_open()) return records;
 
-    // Read the entire file into a string to handle multi-line quoted fields
     std::string content((std::istreambuf_iterator<char>(file)),
                          std::istreambuf_iterator<char>());
     file.close();
 
-    // We need to split into logical CSV records. A record ends at a newline
-    // that is NOT inside a quoted field.
-    std::vector<std::string> records;
-    {
-        std::string rec;
-        bool inQ = false;
-        for (char c : content) {
-            if (c == '"') inQ = !inQ;
-            if (c == '\n' && !inQ) {
-                records.push_back(rec);
-                rec.clear();
-            } else {
-                rec += c;
-            }
+    std::string rec;
+    bool inQ = false;
+    for (char c : content) {
+        if (c == '"') inQ = !inQ;
+        if (c == '\n' && !inQ) {
+            records.push_back(rec);
+            rec.clear();
+        } else {
+            rec += c;
         }
-        if (!rec.empty()) records.push_back(rec);
     }
+    if (!rec.empty()) records.push_back(rec);
+    return records;
+}
+
+std::vector<RDMParameter> LoadParameters(const std::string& csvPath)
+{
+    std::vector<RDMParameter> params;
+    std::vector<std::string> records = ReadRecords(csvPath);
 
     // Skip the first two rows (headers)
     for (size_t r = 2; r < records.size(); ++r) {
@@ -116,3 +121,114 @@ std::vector<RDMParameter> LoadParameters(const std::string& csvPath)
 
     return params;
 }
+
+// ── Load every row of the map ───────────────────────────────────────────
+//
+// Columns beyond the ones LoadParameters() reads:
+//   Col H (7):  Mfg. Locked (Operation) — "O" if available when locked
+//   Col K (10): Valid Range minimum    Col L (11): maximum
+//   Col M (12): FW Defaults            Col N (13): Test Values
+//   Col O (14): Shipping/ Stock Values
+//   Col Q (16): Included in SUPPORTED_PARAMETERS?
+//
+std::vector<RDMParameterRow> LoadParameterMap(const std::string& csvPath)
+{
+    std::vector<RDMParameterRow> rows;
+    std::vector<std::string> records = ReadRecords(csvPath);
+
+    for (size_t r = 2; r < records.size(); ++r) {
+        auto fields = SplitCSVLine(records[r]);
+        if (fields.size() < 5) continue;
+        fields.resize(17);
+
+        uint16_t pid = ParseHexPID(fields[3]);
+        if (pid == 0) continue;
+
+        RDMParameterRow row;
+        row.pid = pid;
+        const std::string& cc = fields[2];
+        if (cc.find("DISCOVERY_COMMAND") != std::string::npos)
+            row.commandClass = 0x10;
+        else if (cc.find("GET_COMMAND") != std::string::npos)
+            row.commandClass = 0x20;
+        else if (cc.find("SET_COMMAND") != std::string::npos)
+            row.commandClass = 0x30;
+        else
+            continue;
+
+        row.name              = fields[4];
+        row.isMandatory       = (fields[1] == "Y");
+        row.payloadLength     = fields[5];
+        row.lockedAccess      = (fields[7] == "O");
+        row.minValue          = fields[10];
+        row.maxValue          = fields[11];
+        row.fwDefault         = fields[12];
+        row.testValue         = fields[13];
+        row.shippingValue     = fields[14];
+        row.inSupportedParams = fields[16];
+        rows.push_back(std::move(row));
+    }
+
+    return rows;
+}
+
+// ── Load PIDAttributes.csv ──────────────────────────────────────────────
+//
+//   PID, Name, Type, Access, Device, Size
+//   0x803A, OP_CODE_SETTINGS_HASH, OPCODE_TYPE_1_DI, ACCESS_TYPE_GO, ..., 8
+//
+std::vector<PIDAttribute> LoadPIDAttributes(const std::string& csvPath)
+{
+    std::vector<PIDAttribute> attrs;
+    std::vector<std::string> records = ReadRecords(csvPath);
+
+    for (size_t r = 1; r < records.size(); ++r) {
+        auto fields = SplitCSVLine(records[r]);
+        if (fields.size() < 6) continue;
+
+        PIDAttribute a;
+        a.pid = ParseHexPID(fields[0]);
+        if (a.pid == 0) continue;
+        a.name    = fields[1];
+        a.type    = fields[2];
+        a.canGet  = (fields[3] == "ACCESS_TYPE_GS" || fields[3] == "ACCESS_TYPE_GO");
+        a.canSet  = (fields[3] == "ACCESS_TYPE_GS" || fields[3] == "ACCESS_TYPE_SO");
+        a.devices = fields[4];
+        a.size    = atoi(fields[5].c_str());
+        attrs.push_back(std::move(a));
+    }
+
+    return attrs;
+}
+
+// ── Payload length / hex value helpers ──────────────────────────────────
+int ParsePayloadLength(const std::string& text)
+{
+    std::string t = Trim(text);
+    std::transform(t.begin(), t.end(), t.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    if (t == "none") return 0;
+    if (t.empty() || !isdigit(static_cast<unsigned char>(t[0]))) return -1;
+    size_t digits = 0;
+    int n = std::stoi(t, &digits);
+    std::string unit = Trim(t.substr(digits));
+    if (unit.compare(0, 4, "byte") != 0) return -1;
+    return n;
+}
+
+bool ParseHexBytes(const std::string& text, std::vector<uint8_t>& out)
+{
+    std::string t = Trim(text);
+    if (t.size() < 3 || t[0] != '0' || (t[1] != 'x' && t[1] != 'X'))
+        return false;
+    std::string digits = t.substr(2);
+    for (char c : digits)
+        if (!isxdigit(static_cast<unsigned char>(c))) return false;
+    if (digits.size() % 2) digits.insert(digits.begin(), '0');
+
+    out.clear();
+    for (size_t i = 0; i < digits.size(); i += 2)
+        out.push_back(static_cast<uint8_t>(
+            strtoul(digits.substr(i, 2).c_str(), nullptr, 16)));
+    return true;
+}
@@ -21,4 +21,45 @@ struct RDMParameter {
 // `csvPath` is the filesystem path to Vaya_RDM_map.csv.
 std::vector<RDMParameter> LoadParameters(const std::string& csvPath);
 
+// One row of the map, any command class, with the range and settings
+// columns kept as written ("0x0001", "See RDM standard", "").
+struct RDMParameterRow {
+    uint16_t    pid           = 0;
+    uint8_t     commandClass  = 0;      // 0x10 / 0x20 / 0x30
+    std::string name;
+    bool        isMandatory   = false;
+    std::string payloadLength;          // "2 byte", "Variable, ...", "none"
+    bool        lockedAccess  = false;  // "O" in Mfg. Locked (Operation)
+    std::string minValue;
+    std::string maxValue;
+    std::string fwDefault;              // Settings: FW Defaults
+    std::string testValue;              // Settings: Test Values
+    std::string shippingValue;          // Settings: Shipping/ Stock Values
+    std::string inSupportedParams;      // "Yes", "No", "No per RDM standard"
+};
+
+// Load every PID row of the map (reserved PID 0000 skipped)
+std::vector<RDMParameterRow> LoadParameterMap(const std::string& csvPath);
+
+// One row of PIDAttributes.csv (firmware opcode table)
+struct PIDAttribute {
+    uint16_t    pid    = 0;
+    std::string name;            // OP_CODE_...
+    std::string type;            // OPCODE_TYPE_...
+    bool        canGet = false;  // ACCESS_TYPE_GS / _GO
+    bool        canSet = false;  // ACCESS_TYPE_GS / _SO
+    std::string devices;         // OPCODE_DEVICE_... | ...
+    int         size   = 0;      // payload bytes
+};
+
+std::vector<PIDAttribute> LoadPIDAttributes(const std::string& csvPath);
+
+// "19 bytes" / "2 byte" / "1 byte signed" -> byte count, "none" -> 0,
+// anything else (variable, empty, prose) -> -1
+int ParsePayloadLength(const std::string& text);
+
+// "0x0001" -> {0x00, 0x01}: big-endian, two hex digits per byte.
+// False when `text` is not a 0x-prefixed hex literal.
+bool ParseHexBytes(const std::string& text, std::vector<uint8_t>& out);
+
 #endif // PARAMETER_LOADER_H
@@ -3,6 +3,9 @@
 // ────────────────────────────────────────────────────────────────────────
 #define WIN32_LEAN_AND_MEAN
 #include "peperoni_rodin.h"
+#include "metrics.h"
+#include "perf_trace.h"
+#include "rdm_timing.h"
 
 #include <algorithm>
 #include <cstdio>
@@ -28,6 +31,20 @@ static constexpr float TxBreak = 300e-6f;
 static constexpr float TxMab = 50e-6f;
 static constexpr float RxSlotTimeout = 2.5e-3f;
 
+// Receive window for an RDM response.  vusbdmx_rx returns as soon as the
+// inter-slot timeout ends the frame, so the window only bounds the "no
+// response" case: E1.20 responder turnaround (2.8 ms incl. controller
+// margin) + the longest response at nominal slot time (break, MAB,
+// 257 slots x 44 us) + USB scheduling slack.
+static constexpr float RdmTurnaroundMax = 2.8e-3f;
+static constexpr float RdmBreakMab = 176e-6f + 12e-6f;
+static constexpr float RdmSlotTime = 44e-6f;
+static constexpr int RdmMaxResponseSlots = 257;
+static constexpr float RxUsbSlack = 2e-3f;
+static constexpr float RdmRxWindow = RdmTurnaroundMax + RdmBreakMab +
+                                     RdmMaxResponseSlots * RdmSlotTime +
+                                     RxUsbSlack;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Constructor / Destructor
 // ═══════════════════════════════════════════════════════════════════════════
@@ -44,8 +61,8 @@ PeperoniRodin::~PeperoniRodin() {
 // ═══════════════════════════════════════════════════════════════════════════
 
 bool PeperoniRodin::LoadDLL() {
-  if (m_dll)
-    return true; // already loaded
+  if (m_fnOpen)
+    return true; // already loaded (or a table installed with LoadApi)
 
   // Try loading from app directory first, then system search path
   m_dll = LoadLibraryA("vusbdmx.dll");
@@ -55,21 +72,26 @@ bool PeperoniRodin::LoadDLL() {
   }
 
   // Resolve all function pointers
-  m_fnVersion = (fn_version)GetProcAddress(m_dll, "vusbdmx_version");
-  m_fnOpen = (fn_open)GetProcAddress(m_dll, "vusbdmx_open");
-  m_fnClose = (fn_close)GetProcAddress(m_dll, "vusbdmx_close");
-  m_fnDeviceId = (fn_device_id)GetProcAddress(m_dll, "vusbdmx_device_id");
-  m_fnIsRodin1 = (fn_is_rodin1)GetProcAddress(m_dll, "vusbdmx_is_rodin1");
-  m_fnProductGet = (fn_product_get)GetProcAddress(m_dll, "vusbdmx_product_get");
-  m_fnSerialNumberGet =
-      (fn_serial_number_get)GetProcAddress(m_dll, "vusbdmx_serial_number_get");
-  m_fnDeviceVersion =
-      (fn_device_version)GetProcAddress(m_dll, "vusbdmx_device_version");
-  m_fnTx = (fn_tx)GetProcAddress(m_dll, "vusbdmx_tx");
-  m_fnRx = (fn_rx)GetProcAddress(m_dll, "vusbdmx_rx");
+  PeperoniApi api;
+  api.version = (PeperoniApi::fn_version)GetProcAddress(m_dll,
+                                                        "vusbdmx_version");
+  api.open = (PeperoniApi::fn_open)GetProcAddress(m_dll, "vusbdmx_open");
+  api.close = (PeperoniApi::fn_close)GetProcAddress(m_dll, "vusbdmx_close");
+  api.deviceId =
+      (PeperoniApi::fn_device_id)GetProcAddress(m_dll, "vusbdmx_device_id");
+  api.isRodin1 =
+      (PeperoniApi::fn_is_rodin1)GetProcAddress(m_dll, "vusbdmx_is_rodin1");
+  api.productGet = (PeperoniApi::fn_product_get)GetProcAddress(
+      m_dll, "vusbdmx_product_get");
+  api.serialNumberGet = (PeperoniApi::fn_serial_number_get)GetProcAddress(
+      m_dll, "vusbdmx_serial_number_get");
+  api.deviceVersion = (PeperoniApi::fn_device_version)GetProcAddress(
+      m_dll, "vusbdmx_device_version");
+  api.tx = (PeperoniApi::fn_tx)GetProcAddress(m_dll, "vusbdmx_tx");
+  api.rx = (PeperoniApi::fn_rx)GetProcAddress(m_dll, "vusbdmx_rx");
 
   // Verify critical functions loaded
-  if (!m_fnOpen || !m_fnClose || !m_fnTx || !m_fnRx) {
+  if (!LoadApi(api)) {
     OutputDebugStringA(
         "[Peperoni] vusbdmx.dll loaded but missing required functions\n");
     UnloadDLL();
@@ -86,7 +108,24 @@ bool PeperoniRodin::LoadDLL() {
   return true;
 }
 
+bool PeperoniRodin::LoadApi(const PeperoniApi &api) {
+  if (!api.open || !api.close || !api.tx || !api.rx)
+    return false;
+  m_fnVersion = api.version;
+  m_fnOpen = api.open;
+  m_fnClose = api.close;
+  m_fnDeviceId = api.deviceId;
+  m_fnIsRodin1 = api.isRodin1;
+  m_fnProductGet = api.productGet;
+  m_fnSerialNumberGet = api.serialNumberGet;
+  m_fnDeviceVersion = api.deviceVersion;
+  m_fnTx = api.tx;
+  m_fnRx = api.rx;
+  return true;
+}
+
 void PeperoniRodin::UnloadDLL() {
+  ReleaseDevices();
   if (m_dll) {
     FreeLibrary(m_dll);
     m_dll = nullptr;
@@ -107,98 +146,280 @@ void PeperoniRodin::UnloadDLL() {
 // Device enumeration
 // ═══════════════════════════════════════════════════════════════════════════
 
-int PeperoniRodin::ListDevices() {
-  if (!LoadDLL())
-    return 0;
+// Reads product / serial / hardware version from an open handle
+bool PeperoniRodin::ReadDeviceInfo(HANDLE h, PeperoniDeviceInfo &info) {
+  bool ok = true;
+  if (m_fnProductGet) {
+    WCHAR wbuf[128] = {};
+    if (m_fnProductGet(h, wbuf, 128)) {
+      char mbuf[256] = {};
+      WideCharToMultiByte(CP_UTF8, 0, wbuf, -1, mbuf, 256, nullptr, nullptr);
+      info.product = mbuf;
+    } else {
+      ok = false;
+    }
+  }
+  if (m_fnSerialNumberGet) {
+    WCHAR wbuf[128] = {};
+    if (m_fnSerialNumberGet(h, wbuf, 128)) {
+      char mbuf[256] = {};
+      WideCharToMultiByte(CP_UTF8, 0, wbuf, -1, mbuf, 256, nullptr, nullptr);
+      info.serial = mbuf;
+    } else {
+      ok = false;
+    }
+  }
+  if (m_fnDeviceVersion) {
+    USHORT ver = 0;
+    if (m_fnDeviceVersion(h, &ver))
+      info.hwVersion = ver;
+    else
+      ok = false;
+  }
+  return ok;
+}
+
+// Incremental refresh.  Pooled idle handles are checked with one cheap
+// control request and dropped if the device is gone; handles lent to an
+// open instance are trusted.  Only device numbers no live entry claims are
+// opened, and the scan does not stop at the first gap.
+void PeperoniRodin::RescanDevices() {
+  constexpr USHORT kMaxDevices = 16;
+
+  for (auto it = m_devices.begin(); it != m_devices.end();) {
+    USHORT ver = 0;
+    if (!it->inUse && m_fnDeviceVersion &&
+        !m_fnDeviceVersion(it->handle, &ver)) {
+      m_fnClose(it->handle);
+      it = m_devices.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  for (USHORT i = 0; i < kMaxDevices; ++i) {
+    bool known = std::any_of(
+        m_devices.begin(), m_devices.end(),
+        [i](const CachedDevice &d) { return d.info.index == i; });
+    if (known)
+      continue;
 
-  // Try opening devices until one fails
-  int count = 0;
-  for (USHORT i = 0; i < 16; ++i) {
     HANDLE h = INVALID_HANDLE_VALUE;
-    if (m_fnOpen(i, &h) && h != INVALID_HANDLE_VALUE) {
+    if (!m_fnOpen(i, &h) || h == INVALID_HANDLE_VALUE)
+      continue;
+
+    CachedDevice dev;
+    dev.info.index = i;
+    dev.handle = h;
+    ReadDeviceInfo(h, dev.info);
+
+    // Device numbers shift on unplug; a serial we already hold means the
+    // same device answered under a new number.
+    auto dup = std::find_if(m_devices.begin(), m_devices.end(),
+                            [&](const CachedDevice &d) {
+                              return !dev.info.serial.empty() &&
+                                     d.info.serial == dev.info.serial;
+                            });
+    if (dup != m_devices.end()) {
+      dup->info.index = i;
       m_fnClose(h);
-      count++;
-    } else {
-      break;
+      continue;
     }
+    m_devices.push_back(std::move(dev));
   }
-  return count;
+
+  std::sort(m_devices.begin(), m_devices.end(),
+            [](const CachedDevice &a, const CachedDevice &b) {
+              return a.info.index < b.info.index;
+            });
+  m_devicesValid = true;
+}
+
+void PeperoniRodin::ReleaseDevices() {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  for (auto &d : m_devices) {
+    if (!d.inUse && m_fnClose)
+      m_fnClose(d.handle);
+  }
+  // Handles still lent out are closed by CloseInternal (m_pooled falls
+  // back to a plain close once the entry is gone).
+  m_devices.clear();
+  m_devicesValid = false;
+}
+
+int PeperoniRodin::ListDevices(bool rescan) {
+  if (!LoadDLL())
+    return 0;
+
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  if (rescan || !m_devicesValid)
+    RescanDevices();
+  return static_cast<int>(m_devices.size());
+}
+
+bool PeperoniRodin::GetDeviceInfo(int listIndex,
+                                  PeperoniDeviceInfo &info) const {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  if (listIndex < 0 || listIndex >= static_cast<int>(m_devices.size()))
+    return false;
+  info = m_devices[listIndex].info;
+  return true;
+}
+
+int PeperoniRodin::FindDevice(const std::string &serial) {
+  if (!LoadDLL() || serial.empty())
+    return -1;
+
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  for (int pass = 0; pass < 2; ++pass) {
+    if (pass == 1 || !m_devicesValid)
+      RescanDevices();
+    for (const auto &d : m_devices) {
+      if (d.info.serial == serial)
+        return d.info.index;
+    }
+  }
+  return -1;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // Open / Close
 // ═══════════════════════════════════════════════════════════════════════════
 
-bool PeperoniRodin::Open(int deviceIndex) {
+bool PeperoniRodin::Open(int listIndex, int universe) {
+  if (listIndex < 0 || listIndex >= ListDevices())
+    return false;
+  PeperoniDeviceInfo info;
+  if (!GetDeviceInfo(listIndex, info))
+    return false;
+  return OpenDevice(info.index, universe);
+}
+
+bool PeperoniRodin::OpenDevice(int deviceNumber, int universe) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
   if (!LoadDLL())
     return false;
 
   if (m_devOpen)
-    Close();
+    CloseInternal();
 
+  // Borrow the pooled handle if this device was enumerated and is idle
   HANDLE h = INVALID_HANDLE_VALUE;
-  if (!m_fnOpen(static_cast<USHORT>(deviceIndex), &h) ||
-      h == INVALID_HANDLE_VALUE) {
-    OutputDebugStringA("[Peperoni] Failed to open device\n");
-    return false;
-  }
-
-  m_handle = h;
-  m_devOpen = true;
-
-  // Read product string
-  if (m_fnProductGet) {
-    WCHAR wbuf[128] = {};
-    if (m_fnProductGet(m_handle, wbuf, 128)) {
-      char mbuf[256] = {};
-      WideCharToMultiByte(CP_UTF8, 0, wbuf, -1, mbuf, 256, nullptr, nullptr);
-      m_product = mbuf;
+  PeperoniDeviceInfo info;
+  {
+    std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+    for (auto &d : m_devices) {
+      if (d.info.index == deviceNumber && !d.inUse) {
+        d.inUse = true;
+        h = d.handle;
+        info = d.info;
+        break;
+      }
     }
   }
+  m_pooled = (h != INVALID_HANDLE_VALUE);
 
-  // Read serial number
-  if (m_fnSerialNumberGet) {
-    WCHAR wbuf[128] = {};
-    if (m_fnSerialNumberGet(m_handle, wbuf, 128)) {
-      char mbuf[256] = {};
-      WideCharToMultiByte(CP_UTF8, 0, wbuf, -1, mbuf, 256, nullptr, nullptr);
-      m_serial = mbuf;
-      // Hash serial into uint32_t for compatibility
-      m_serialHash = 0;
-      for (char c : m_serial)
-        m_serialHash = m_serialHash * 31 + static_cast<uint8_t>(c);
+  if (!m_pooled) {
+    if (!m_fnOpen(static_cast<USHORT>(deviceNumber), &h) ||
+        h == INVALID_HANDLE_VALUE) {
+      OutputDebugStringA("[Peperoni] Failed to open device\n");
+      return false;
     }
+    info.index = deviceNumber;
+    ReadDeviceInfo(h, info);
   }
 
-  // Read device version
-  if (m_fnDeviceVersion) {
-    m_fnDeviceVersion(m_handle, &m_deviceVersion);
-  }
+  m_handle = h;
+  m_devOpen = true;
+  m_deviceIndex = deviceNumber;
+  m_universe = static_cast<UCHAR>(universe);
+  SetDeviceInfo(info);
+  GlobalMetrics().Add(m_metricsPort, Metric::DEVICE_OPENS);
 
   char buf[256];
-  snprintf(buf, sizeof(buf), "[Peperoni] Opened: %s (SN: %s, HW: 0x%04X)\n",
-           m_product.c_str(), m_serial.c_str(), m_deviceVersion);
+  snprintf(buf, sizeof(buf),
+           "[Peperoni] Opened: %s (SN: %s, HW: 0x%04X, universe %d%s)\n",
+           m_product.c_str(), m_serial.c_str(), m_deviceVersion, universe,
+           m_pooled ? ", pooled" : "");
   OutputDebugStringA(buf);
 
   return true;
 }
 
+bool PeperoniRodin::OpenBySerial(const std::string &serial, int universe) {
+  int index = FindDevice(serial);
+  if (index < 0)
+    return false;
+  return OpenDevice(index, universe);
+}
+
+void PeperoniRodin::SetDeviceInfo(const PeperoniDeviceInfo &info) {
+  m_product = info.product;
+  m_serial = info.serial;
+  m_deviceVersion = info.hwVersion;
+  // Hash serial into uint32_t for compatibility
+  m_serialHash = 0;
+  for (char c : m_serial)
+    m_serialHash = m_serialHash * 31 + static_cast<uint8_t>(c);
+}
+
 void PeperoniRodin::Close() {
   std::lock_guard<std::mutex> lock(m_mutex);
+  CloseInternal();
+}
 
-  if (m_devOpen && m_fnClose) {
-    m_fnClose(m_handle);
+void PeperoniRodin::CloseInternal() {
+  if (m_devOpen) {
+    // Pooled handles go back to the pool instead of being closed
+    bool returned = false;
+    if (m_pooled) {
+      std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+      for (auto &d : m_devices) {
+        if (d.inUse && d.handle == m_handle) {
+          d.inUse = false;
+          returned = true;
+          break;
+        }
+      }
+    }
+    if (!returned && m_fnClose)
+      m_fnClose(m_handle);
   }
   m_handle = INVALID_HANDLE_VALUE;
+  m_pooled = false;
   m_devOpen = false;
   m_product.clear();
   m_serial.clear();
   m_serialHash = 0;
+  m_deviceIndex = -1;
+  m_universe = 0;
   m_rxReady = false;
 }
 
+int PeperoniRodin::ProbeUniverseCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_devOpen || !m_fnRx)
+    return 0;
+
+  // A zero-timeout read on a valid universe returns OK / TIMEOUT; past the
+  // last line the device answers UNIVERSE_WRONG.  Universe 0 always exists.
+  constexpr int kMaxUniverses = 16;
+  int count = 1;
+  for (int u = 1; u < kMaxUniverses; ++u) {
+    UCHAR buf[1];
+    USHORT slots = 0, timestamp = 0;
+    UCHAR status = 0;
+    if (!m_fnRx(m_handle, static_cast<UCHAR>(u), 1, buf, 0, RxSlotTimeout,
+                &slots, &timestamp, &status))
+      break;
+    if (status == VUSBDMX_BULK_STATUS_UNIVERSE_WRONG)
+      break;
+    count = u + 1;
+  }
+  return count;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Device info
 // ═══════════════════════════════════════════════════════════════════════════
@@ -226,83 +447,90 @@ bool PeperoniRodin::SendDMX(const uint8_t *data, int len) {
   if (!m_devOpen || !m_fnTx)
     return false;
 
+  PERF_SCOPE_ARG("usb", "vusbdmx_tx", "slots", len);
   USHORT timestamp = 0;
   UCHAR status = 0;
 
   // data[0] is start code (0x00), len includes start code
-  if (!m_fnTx(m_handle, 0 /*universe*/, static_cast<USHORT>(len),
+  if (!m_fnTx(m_handle, m_universe, static_cast<USHORT>(len),
               const_cast<PUCHAR>(data), 0 /*config: no block, no delay*/,
               0 /*time*/, 200e-6f /*break*/, 20e-6f /*mab*/, &timestamp,
-              &status)) {
+              &status) ||
+      status != VUSBDMX_BULK_STATUS_OK) {
+    GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
     return false;
   }
-
-  return (status == VUSBDMX_BULK_STATUS_OK);
+  GlobalMetrics().Add(m_metricsPort, Metric::DMX_FRAMES_TX);
+  return true;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // RDM  (compatible with EnttecPro's interface)
 // ═══════════════════════════════════════════════════════════════════════════
 
-void PeperoniRodin::Log(bool tx, const uint8_t *data, int len) {
-  if (m_logCb)
-    m_logCb(tx, data, len);
-}
-
 void PeperoniRodin::Purge() {
   // No-op for peperoni — RX is consumed per-transaction via vusbdmx_rx
   m_rxReady = false;
+  GlobalMetrics().Add(m_metricsPort, Metric::PURGES);
 }
 
 void PeperoniRodin::SetLogCallback(PepLogCallback cb) { m_logCb = cb; }
 
-// Internal: send an RDM frame via vusbdmx_tx (with break for normal RDM)
+// Internal: send an RDM frame via vusbdmx_tx (with break for normal RDM).
+// `txEndMs` receives the device timestamp of the transmitted frame.
 int PeperoniRodin::TxRdmFrame(UCHAR universe, const uint8_t *rdmPkt,
-                              int pktLen) {
-  USHORT timestamp = 0;
+                              int pktLen, USHORT &txEndMs) {
+  PERF_SCOPE_ARG("usb", "vusbdmx_tx", "slots", pktLen);
   UCHAR status = 1;
 
   // Retry up to 3 times on TX failures
   for (int attempt = 3; attempt > 0; --attempt) {
     if (!m_fnTx(m_handle, universe, static_cast<USHORT>(pktLen),
                 const_cast<PUCHAR>(rdmPkt), TxConfig, TxTimeout, TxBreak, TxMab,
-                &timestamp, &status)) {
+                &txEndMs, &status)) {
+      GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
       return -1;
     }
-    if (status == VUSBDMX_BULK_STATUS_OK)
+    if (status == VUSBDMX_BULK_STATUS_OK) {
+      GlobalMetrics().Add(m_metricsPort, Metric::RDM_REQUESTS_TX);
       return pktLen;
+    }
 
     if (status == VUSBDMX_BULK_STATUS_UNIVERSE_WRONG)
       return -2;
+    GlobalMetrics().Add(m_metricsPort, Metric::USB_ERRORS);
 
     // Clear any stale RX data before retrying
-    USHORT rxSlots = 0;
+    USHORT rxSlots = 0, rxTs = 0;
     UCHAR rxBuf[257] = {};
-    m_fnRx(m_handle, universe, 257, rxBuf, 0, 100e-6f, &rxSlots, &timestamp,
+    m_fnRx(m_handle, universe, 257, rxBuf, 0, 100e-6f, &rxSlots, &rxTs,
            &status);
   }
 
   return pktLen;
 }
 
-// Internal: receive an RDM frame via vusbdmx_rx
+// Internal: receive an RDM frame via vusbdmx_rx.  `rxStartMs` receives the
+// device timestamp of the start of the received frame.
 int PeperoniRodin::RxRdmFrame(UCHAR universe, float timeout, bool needBreak,
-                              std::vector<uint8_t> &out) {
+                              std::vector<uint8_t> &out, USHORT &rxStartMs) {
+  PERF_SCOPE("usb", "vusbdmx_rx");
   USHORT slots = 0;
   UCHAR status = 0;
-  USHORT timestamp = 0;
 
   out.resize(257);
   if (!m_fnRx(m_handle, universe, static_cast<USHORT>(out.size()), out.data(),
-              timeout, RxSlotTimeout, &slots, &timestamp, &status)) {
+              timeout, RxSlotTimeout, &slots, &rxStartMs, &status)) {
     return -1;
   }
 
   if (status != VUSBDMX_BULK_STATUS_OK) {
     if (status == VUSBDMX_BULK_STATUS_TIMEOUT)
       return -2; // timeout
-    if (status & VUSBDMX_BULK_STATUS_RX_FRAMEERROR)
+    if (status & VUSBDMX_BULK_STATUS_RX_FRAMEERROR) {
+      GlobalMetrics().Add(m_metricsPort, Metric::RX_FRAME_ERRORS);
       return -3; // frame error / collision
+    }
     if ((status & VUSBDMX_BULK_STATUS_RX_NO_BREAK) && needBreak)
       return -4; // no break
   }
@@ -311,85 +539,106 @@ int PeperoniRodin::RxRdmFrame(UCHAR universe, float timeout, bool needBreak,
   return static_cast<int>(slots);
 }
 
-// SendRDM — send an already-formed RDM packet (with 0xCC start code)
-// The Peperoni sends AND receives in one transaction, so we store the
-// response internally for ReceiveRDM to return.
-bool PeperoniRodin::SendRDM(const uint8_t *data, int len) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  if (!m_devOpen || !m_fnTx || !m_fnRx)
-    return false;
-
+// One TX + RX transaction on the wire.  Only the USB transfers run here;
+// logging is done by the caller once the transfer is complete, so a slow
+// log callback never sits between the request and the response window.
+bool PeperoniRodin::Transact(const uint8_t *data, int len, bool discovery) {
   m_rxReady = false;
-  m_lastWasDiscovery = false;
-
-  Log(true, data, len);
+  m_rxLen = 0;
+  m_lastWasDiscovery = discovery;
+  m_timing = PepRdmTiming{};
 
-  // TX the RDM frame
-  int txResult = TxRdmFrame(0, data, len);
-  if (txResult < 0)
+  USHORT txEnd = 0, rxStart = 0;
+  if (TxRdmFrame(m_universe, data, len, txEnd) < 0)
     return false;
+  m_timing.txReturnUs = RdmNowUs();
+  m_timing.txEndMs = txEnd;
 
-  // RX the response
-  // Timeout: break + mab + tx time + turnaround + max response
-  float rxTimeout = TxBreak + TxMab + len * 48e-6f + 2e-3f + 255 * 144e-6f;
-
+  // Discovery responses may lack a break; everything else needs one
+  float window = discovery ? 10e-3f : RdmRxWindow;
   m_rxBuffer.clear();
-  int rxResult = RxRdmFrame(0, rxTimeout, true, m_rxBuffer);
-
+  int rxResult = RxRdmFrame(m_universe, window, !discovery, m_rxBuffer,
+                            rxStart);
+  m_timing.rxReturnUs = RdmNowUs();
   if (rxResult > 0) {
-    // Strip the vusbdmx framing (SC + sub-SC + length prefix)
-    // The peperoni returns raw RDM data starting with 0xCC
     m_rxLen = rxResult;
     m_rxReady = true;
-    Log(false, m_rxBuffer.data(), m_rxLen);
-  } else {
-    m_rxLen = 0;
-    m_rxReady = false;
+    m_timing.rxStartMs = rxStart;
+    m_timing.turnaroundMs = static_cast<uint16_t>(rxStart - txEnd);
+    m_timing.hasResponse = true;
   }
+  // rxResult == -2: timeout, no device (in this branch)
+  // rxResult == -3: frame error / collision
+  return true;
+}
 
+// SendRDM — send an already-formed RDM packet (with 0xCC start code)
+// The Peperoni sends AND receives in one transaction, so we store the
+// response internally for ReceiveRDM to return.
+bool PeperoniRodin::SendRDM(const uint8_t *data, int len) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_devOpen || !m_fnTx || !m_fnRx)
+    return false;
+  if (!Transact(data, len, false))
+    return false;
+  LogTransaction(lock, data, len);
   return true;
 }
 
 // SendRDMDiscovery — send a discovery request (response may lack break)
 bool PeperoniRodin::SendRDMDiscovery(const uint8_t *data, int len) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
+  std::unique_lock<std::mutex> lock(m_mutex);
   if (!m_devOpen || !m_fnTx || !m_fnRx)
     return false;
-
-  m_rxReady = false;
-  m_lastWasDiscovery = true;
-
-  Log(true, data, len);
-
-  // TX the discovery frame
-  int txResult = TxRdmFrame(0, data, len);
-  if (txResult < 0)
+  if (!Transact(data, len, true))
     return false;
+  LogTransaction(lock, data, len);
+  return true;
+}
+
+// Runs the log callback for the finished transaction outside the lock, so
+// hex formatting never delays the transfer itself and DMX output on this
+// bus (UI timer thread) can proceed while the log is written.
+void PeperoniRodin::LogTransaction(std::unique_lock<std::mutex> &lock,
+                                   const uint8_t *tx, int txLen) {
+  if (!m_logCb)
+    return;
+  uint8_t rx[257];
+  int rxLen = m_rxReady ? m_rxLen : 0;
+  if (rxLen > 0)
+    memcpy(rx, m_rxBuffer.data(), rxLen);
+  PepLogCallback cb = m_logCb;
+  lock.unlock();
+  cb(true, tx, txLen);
+  if (rxLen > 0)
+    cb(false, rx, rxLen);
+}
 
-  // RX with relaxed rules (no break required for discovery responses)
-  float rxTimeout = 10e-3f;
+PepRdmTiming PeperoniRodin::GetLastRdmTiming() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_timing;
+}
 
-  m_rxBuffer.clear();
-  int rxResult = RxRdmFrame(0, rxTimeout, false, m_rxBuffer);
+// ReceiveFrame — passive capture of whatever is on the line
+int PeperoniRodin::ReceiveFrame(uint8_t *out, int maxLen, float timeout,
+                                uint8_t &statusByte) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  statusByte = 0;
+  if (!m_devOpen || !m_fnRx || maxLen <= 0)
+    return -1;
 
-  if (rxResult > 0) {
-    m_rxLen = rxResult;
-    m_rxReady = true;
-    Log(false, m_rxBuffer.data(), m_rxLen);
-  } else if (rxResult == -2) {
-    // Timeout — no device in this branch
-    m_rxLen = 0;
-    m_rxReady = false;
-  } else {
-    // Frame error / collision
-    m_rxLen = 0;
-    m_rxReady = false;
-    // Return -3 for collision via status byte
-  }
+  USHORT slots = 0;
+  USHORT timestamp = 0;
+  UCHAR status = 0;
+  USHORT want = static_cast<USHORT>((maxLen > 513) ? 513 : maxLen);
+  if (!m_fnRx(m_handle, m_universe, want, out, timeout, RxSlotTimeout, &slots,
+              &timestamp, &status))
+    return -1;
 
-  return true;
+  statusByte = status;
+  if (status == VUSBDMX_BULK_STATUS_TIMEOUT || slots == 0)
+    return 0;
+  return static_cast<int>(slots);
 }
 
 // ReceiveRDM — return the response that was already captured during Send
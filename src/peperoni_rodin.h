@@ -5,6 +5,7 @@
 #ifndef PEPERONI_RODIN_H
 #define PEPERONI_RODIN_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -16,6 +17,61 @@
 using PepLogCallback =
     std::function<void(bool direction, const uint8_t *data, int len)>;
 
+// One enumerated device, as recorded by the enumeration cache
+struct PeperoniDeviceInfo {
+  int index = -1; // vusbdmx device number
+  std::string product;
+  std::string serial;
+  uint16_t hwVersion = 0;
+};
+
+// Device timestamps of the last RDM transaction.  vusbdmx reports a 16-bit
+// millisecond counter for the end of the transmitted frame and the start
+// of the received one; differences are taken modulo 2^16.
+// The host times (RdmNowUs clock) mark when vusbdmx_tx / vusbdmx_rx
+// returned.
+struct PepRdmTiming {
+  uint16_t txEndMs = 0;
+  uint16_t rxStartMs = 0;
+  uint16_t turnaroundMs = 0; // rxStart - txEnd
+  bool hasResponse = false;
+  int64_t txReturnUs = 0;
+  int64_t rxReturnUs = 0;
+};
+
+// The vusbdmx.dll entry points.  LoadDLL() resolves them from the DLL;
+// LoadApi() installs a table directly (tests, hosts with their own loader).
+struct PeperoniApi {
+  using fn_version = USHORT(__stdcall *)();
+  using fn_open = BOOL(__stdcall *)(USHORT device, PHANDLE h);
+  using fn_close = BOOL(__stdcall *)(HANDLE h);
+  using fn_device_id = BOOL(__stdcall *)(HANDLE h, PUSHORT pid);
+  using fn_is_rodin1 = BOOL(__stdcall *)(HANDLE h);
+  using fn_product_get = BOOL(__stdcall *)(HANDLE h, PWCHAR str, USHORT size);
+  using fn_serial_number_get = BOOL(__stdcall *)(HANDLE h, PWCHAR str,
+                                                 USHORT size);
+  using fn_device_version = BOOL(__stdcall *)(HANDLE h, PUSHORT pversion);
+  using fn_tx = BOOL(__stdcall *)(HANDLE h, UCHAR universe, USHORT slots,
+                                  PUCHAR buffer, UCHAR config, FLOAT time,
+                                  FLOAT time_break, FLOAT time_mab,
+                                  PUSHORT ptimestamp, PUCHAR pstatus);
+  using fn_rx = BOOL(__stdcall *)(HANDLE h, UCHAR universe, USHORT slots_set,
+                                  PUCHAR buffer, FLOAT timeout,
+                                  FLOAT timeout_rx, PUSHORT pslots_get,
+                                  PUSHORT ptimestamp, PUCHAR pstatus);
+
+  fn_version version = nullptr;
+  fn_open open = nullptr; // required
+  fn_close close = nullptr; // required
+  fn_device_id deviceId = nullptr;
+  fn_is_rodin1 isRodin1 = nullptr;
+  fn_product_get productGet = nullptr;
+  fn_serial_number_get serialNumberGet = nullptr;
+  fn_device_version deviceVersion = nullptr;
+  fn_tx tx = nullptr; // required
+  fn_rx rx = nullptr; // required
+};
+
 class PeperoniRodin {
 public:
   PeperoniRodin();
@@ -23,16 +79,49 @@ public:
 
   // Load/unload the vusbdmx.dll at runtime
   bool LoadDLL();
+  bool LoadApi(const PeperoniApi &api);
   void UnloadDLL();
-  bool IsDLLLoaded() const { return m_dll != nullptr; }
-
-  // Enumerate available peperoni devices (returns count)
-  int ListDevices();
+  bool IsDLLLoaded() const { return m_fnOpen != nullptr; }
+
+  // Enumerate available peperoni devices (returns count).  Devices are
+  // addressed by their position in this list (`listIndex`), which is not
+  // the vusbdmx device number once the numbers have gaps.  Served from the
+  // enumeration cache; the first call, or `rescan`, walks all device
+  // numbers.  A rescan is incremental: pooled handles are only re-checked,
+  // and only unclaimed device numbers are opened.  Enumerated devices stay
+  // open in a handle pool so a later Open() of a known device is instant.
+  int ListDevices(bool rescan = false);
+  bool GetDeviceInfo(int listIndex, PeperoniDeviceInfo &info) const;
+
+  // Returns the device number of the device with this serial, or -1.
+  // Rescans once if the serial is not in the cache.
+  int FindDevice(const std::string &serial);
 
   // Open / close
-  bool Open(int deviceIndex);
+  // `universe` selects the DMX line this instance drives.  A device may be
+  // opened once per universe (vusbdmx allows multiple handles), giving
+  // each line its own handle, mutex and RDM state so lines run in parallel.
+  // Open() takes a ListDevices() position, OpenDevice() a vusbdmx device
+  // number (FindDevice, GetDeviceIndex).
+  bool Open(int listIndex, int universe = 0);
+  bool OpenDevice(int deviceNumber, int universe = 0);
+  bool OpenBySerial(const std::string &serial, int universe = 0);
   void Close();
   bool IsOpen() const { return m_devOpen; }
+  int GetDeviceIndex() const { return m_deviceIndex; } // device number
+  int GetUniverse() const { return m_universe; }
+
+  // Number of universes the open device accepts (probed with zero-timeout
+  // reads until the device reports "universe wrong").  Returns >= 1 when
+  // open, 0 otherwise.
+  int ProbeUniverseCount();
+
+  // RDM transaction number for this bus (each line keeps its own)
+  uint8_t NextTransNum() { return m_transNum++; }
+
+  // Port index this bus reports under in GlobalMetrics() (default 0)
+  void SetMetricsPort(int port) { m_metricsPort = port; }
+  int MetricsPort() const { return m_metricsPort; }
 
   // Device info
   std::string GetProductString() const;
@@ -47,6 +136,14 @@ public:
   bool SendRDM(const uint8_t *data, int len);
   bool SendRDMDiscovery(const uint8_t *data, int len);
   int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte);
+  PepRdmTiming GetLastRdmTiming();
+
+  // Passive receive (sniffer / input): waits up to `timeout` seconds for
+  // one frame on this instance's universe.  Returns the slot count (start code first),
+  // 0 on timeout, -1 on error.  `statusByte` is the raw vusbdmx_rx status
+  // (0x40 = received without break, 0x80 = frame error).
+  int ReceiveFrame(uint8_t *out, int maxLen, float timeout,
+                   uint8_t &statusByte);
 
   // Purge (no-op for peperoni, RX is handled per-transaction)
   void Purge();
@@ -58,39 +155,40 @@ private:
   // ── DLL module + function pointers ──
   HMODULE m_dll = nullptr;
 
-  // vusbdmx.dll function signatures
-  using fn_version = USHORT(__stdcall *)();
-  using fn_open = BOOL(__stdcall *)(USHORT device, PHANDLE h);
-  using fn_close = BOOL(__stdcall *)(HANDLE h);
-  using fn_device_id = BOOL(__stdcall *)(HANDLE h, PUSHORT pid);
-  using fn_is_rodin1 = BOOL(__stdcall *)(HANDLE h);
-  using fn_product_get = BOOL(__stdcall *)(HANDLE h, PWCHAR str, USHORT size);
-  using fn_serial_number_get = BOOL(__stdcall *)(HANDLE h, PWCHAR str,
-                                                 USHORT size);
-  using fn_device_version = BOOL(__stdcall *)(HANDLE h, PUSHORT pversion);
-  using fn_tx = BOOL(__stdcall *)(HANDLE h, UCHAR universe, USHORT slots,
-                                  PUCHAR buffer, UCHAR config, FLOAT time,
-                                  FLOAT time_break, FLOAT time_mab,
-                                  PUSHORT ptimestamp, PUCHAR pstatus);
-  using fn_rx = BOOL(__stdcall *)(HANDLE h, UCHAR universe, USHORT slots_set,
-                                  PUCHAR buffer, FLOAT timeout,
-                                  FLOAT timeout_rx, PUSHORT pslots_get,
-                                  PUSHORT ptimestamp, PUCHAR pstatus);
-
-  fn_version m_fnVersion = nullptr;
-  fn_open m_fnOpen = nullptr;
-  fn_close m_fnClose = nullptr;
-  fn_device_id m_fnDeviceId = nullptr;
-  fn_is_rodin1 m_fnIsRodin1 = nullptr;
-  fn_product_get m_fnProductGet = nullptr;
-  fn_serial_number_get m_fnSerialNumberGet = nullptr;
-  fn_device_version m_fnDeviceVersion = nullptr;
-  fn_tx m_fnTx = nullptr;
-  fn_rx m_fnRx = nullptr;
+  PeperoniApi::fn_version m_fnVersion = nullptr;
+  PeperoniApi::fn_open m_fnOpen = nullptr;
+  PeperoniApi::fn_close m_fnClose = nullptr;
+  PeperoniApi::fn_device_id m_fnDeviceId = nullptr;
+  PeperoniApi::fn_is_rodin1 m_fnIsRodin1 = nullptr;
+  PeperoniApi::fn_product_get m_fnProductGet = nullptr;
+  PeperoniApi::fn_serial_number_get m_fnSerialNumberGet = nullptr;
+  PeperoniApi::fn_device_version m_fnDeviceVersion = nullptr;
+  PeperoniApi::fn_tx m_fnTx = nullptr;
+  PeperoniApi::fn_rx m_fnRx = nullptr;
+
+  // ── Enumeration cache + handle pool ──
+  struct CachedDevice {
+    PeperoniDeviceInfo info;
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    bool inUse = false; // handle lent to Open()
+  };
+  std::vector<CachedDevice> m_devices; // sorted by info.index
+  bool m_devicesValid = false;
+  mutable std::mutex m_cacheMutex; // lock order: m_mutex, then m_cacheMutex
+
+  void RescanDevices();   // caller must hold m_cacheMutex
+  void ReleaseDevices();  // closes idle pooled handles
+  bool ReadDeviceInfo(HANDLE h, PeperoniDeviceInfo &info);
+  void SetDeviceInfo(const PeperoniDeviceInfo &info);
 
   // ── Device state ──
   HANDLE m_handle = INVALID_HANDLE_VALUE;
+  bool m_pooled = false; // m_handle is borrowed from m_devices
   bool m_devOpen = false;
+  int m_deviceIndex = -1;
+  UCHAR m_universe = 0;
+  std::atomic<uint8_t> m_transNum{0};
+  int m_metricsPort = 0;
   uint32_t m_serialHash = 0;
   std::string m_product;
   std::string m_serial;
@@ -103,15 +201,20 @@ private:
   int m_rxLen = 0;
   bool m_rxReady = false;
   bool m_lastWasDiscovery = false;
+  PepRdmTiming m_timing;
 
   std::mutex m_mutex;
   PepLogCallback m_logCb;
-  void Log(bool tx, const uint8_t *data, int len);
+  void CloseInternal(); // caller must hold m_mutex
 
   // Internal RDM helpers
-  int TxRdmFrame(UCHAR universe, const uint8_t *rdmPkt, int pktLen);
+  int TxRdmFrame(UCHAR universe, const uint8_t *rdmPkt, int pktLen,
+                 USHORT &txEndMs);
   int RxRdmFrame(UCHAR universe, float timeout, bool needBreak,
-                 std::vector<uint8_t> &out);
+                 std::vector<uint8_t> &out, USHORT &rxStartMs);
+  bool Transact(const uint8_t *data, int len, bool discovery);
+  void LogTransaction(std::unique_lock<std::mutex> &lock, const uint8_t *tx,
+                      int txLen);
 };
 
 #endif // PEPERONI_RODIN_H
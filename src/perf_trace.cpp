@@ -0,0 +1,253 @@
+// ────────────────────────────────────────────────────────────────────────
+// Perf trace — scoped timing spans, exported as Chrome trace JSON
+// ────────────────────────────────────────────────────────────────────────
+#include "perf_trace.h"
+#include "rdm_timing.h"
+
+#include <algorithm>
+#include <cstdio>
+
+PerfTrace &GlobalPerfTrace() {
+  static PerfTrace trace;
+  return trace;
+}
+
+// Last buffer the calling thread used, and the instance it belongs to.
+// Instances are told apart by id, not address, so a new tracer at a
+// recycled address never picks up a stale buffer.
+namespace {
+struct LocalCache {
+  uint32_t owner = 0;
+  void *buffer = nullptr;
+};
+thread_local LocalCache t_cache;
+thread_local std::string t_threadName;
+
+// Cleared when the thread exits, so its buffer can be handed on
+struct ThreadLife {
+  std::shared_ptr<std::atomic<bool>> alive =
+      std::make_shared<std::atomic<bool>>(true);
+  ~ThreadLife() { alive->store(false, std::memory_order_release); }
+};
+thread_local ThreadLife t_life;
+std::atomic<uint32_t> g_nextInstance{1};
+} // namespace
+
+PerfTrace::PerfTrace() : m_id(g_nextInstance.fetch_add(1)) {}
+PerfTrace::~PerfTrace() = default;
+
+void PerfTrace::Start() {
+  std::lock_guard<std::mutex> lk(m_registryMutex);
+  PerfEvent discard;
+  for (auto &b : m_buffers)
+    while (b->ring.Pop(discard)) {
+    }
+  m_dropped.store(0, std::memory_order_relaxed);
+  m_startUs.store(RdmNowUs(), std::memory_order_relaxed);
+  m_recording.store(true, std::memory_order_release);
+}
+
+void PerfTrace::Stop() { m_recording.store(false, std::memory_order_release); }
+
+// ── Per-thread buffer lookup ────────────────────────────────────────────
+//    Fast path: the thread-local cache.  Slow path (first event on this
+//    thread, or the thread switched instances): search / register under
+//    the mutex.  A finished thread's buffer stays until Collect() or
+//    Start() has emptied it, so its events can still be collected; then
+//    it is reused, under a new tid, by the next thread that registers.
+PerfTrace::ThreadBuffer *PerfTrace::LocalBuffer() {
+  if (t_cache.owner == m_id)
+    return static_cast<ThreadBuffer *>(t_cache.buffer);
+
+  std::lock_guard<std::mutex> lk(m_registryMutex);
+  ThreadBuffer *buf = nullptr, *spare = nullptr;
+  for (auto &b : m_buffers) {
+    if (b->owner == t_life.alive)
+      buf = b.get();
+    else if (!spare && !b->owner->load(std::memory_order_acquire) &&
+             b->ring.Empty())
+      spare = b.get();
+  }
+  if (!buf) {
+    if (spare) {
+      buf = spare;
+    } else {
+      m_buffers.push_back(std::make_unique<ThreadBuffer>());
+      buf = m_buffers.back().get();
+    }
+    buf->owner = t_life.alive;
+    buf->tid = m_nextTid++;
+    buf->name = t_threadName;
+  }
+  t_cache.owner = m_id;
+  t_cache.buffer = buf;
+  return buf;
+}
+
+void PerfTrace::Record(const PerfEvent &e) {
+  if (!LocalBuffer()->ring.Push(e))
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfTrace::SetThreadName(const char *name) {
+  t_threadName = name ? name : "";
+  if (t_cache.owner != m_id)
+    return; // applied when this thread registers its buffer
+  std::lock_guard<std::mutex> lk(m_registryMutex);
+  static_cast<ThreadBuffer *>(t_cache.buffer)->name = t_threadName;
+}
+
+size_t PerfTrace::Collect(std::vector<PerfRecord> &out) {
+  size_t first = out.size();
+  {
+    std::lock_guard<std::mutex> lk(m_registryMutex);
+    PerfRecord r;
+    for (auto &b : m_buffers) {
+      r.tid = b->tid;
+      while (b->ring.Pop(r.event))
+        out.push_back(r);
+    }
+  }
+  // Spans that begin in the same microsecond: the longer (enclosing) one
+  // first, so viewers nest them correctly
+  std::stable_sort(out.begin() + first, out.end(),
+                   [](const PerfRecord &a, const PerfRecord &b) {
+                     if (a.event.beginUs != b.event.beginUs)
+                       return a.event.beginUs < b.event.beginUs;
+                     return a.event.durUs > b.event.durUs;
+                   });
+  return out.size() - first;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Chrome trace-event JSON
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void AppendJsonString(std::string &out, const char *s) {
+  out += '"';
+  for (; s && *s; ++s) {
+    unsigned char c = static_cast<unsigned char>(*s);
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += static_cast<char>(c);
+    } else if (c < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04X", c);
+      out += buf;
+    } else {
+      out += static_cast<char>(c);
+    }
+  }
+  out += '"';
+}
+
+std::string
+PerfTrace::RenderChromeJson(const std::vector<PerfRecord> &records) {
+  std::string out;
+  out.reserve(128 + records.size() * 112);
+  out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char buf[160];
+
+  {
+    std::lock_guard<std::mutex> lk(m_registryMutex);
+    for (auto &b : m_buffers) {
+      snprintf(buf, sizeof(buf), "thread %u", b->tid);
+      std::string name = b->name.empty() ? buf : b->name;
+      if (!first)
+        out += ',';
+      first = false;
+      snprintf(buf, sizeof(buf),
+               "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+               "\"tid\":%u,\"args\":{\"name\":",
+               b->tid);
+      out += buf;
+      AppendJsonString(out, name.c_str());
+      out += "}}";
+    }
+  }
+
+  int64_t startUs = m_startUs.load(std::memory_order_relaxed);
+  for (const PerfRecord &r : records) {
+    const PerfEvent &e = r.event;
+    if (!first)
+      out += ',';
+    first = false;
+    out += "\n{\"name\":";
+    AppendJsonString(out, e.name);
+    out += ",\"cat\":";
+    AppendJsonString(out, e.category ? e.category : "");
+    if (e.durUs >= 0)
+      snprintf(buf, sizeof(buf),
+               ",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u",
+               static_cast<long long>(e.beginUs - startUs),
+               static_cast<long long>(e.durUs), r.tid);
+    else
+      snprintf(buf, sizeof(buf),
+               ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":1,\"tid\":%u",
+               static_cast<long long>(e.beginUs - startUs), r.tid);
+    out += buf;
+    if (e.argName) {
+      out += ",\"args\":{";
+      AppendJsonString(out, e.argName);
+      snprintf(buf, sizeof(buf), ":%lld}", static_cast<long long>(e.arg));
+      out += buf;
+    }
+    out += '}';
+  }
+  out += "\n]}\n";
+  return out;
+}
+
+std::string PerfTrace::ExportChromeJson() {
+  std::vector<PerfRecord> records;
+  Collect(records);
+  return RenderChromeJson(records);
+}
+
+int PerfTrace::ExportChromeJson(const std::string &path) {
+  std::vector<PerfRecord> records;
+  Collect(records);
+  std::string json = RenderChromeJson(records);
+
+  FILE *f = fopen(path.c_str(), "wb");
+  if (!f)
+    return -1;
+  bool ok = fwrite(json.data(), 1, json.size(), f) == json.size();
+  ok = (fclose(f) == 0) && ok;
+  return ok ? static_cast<int>(records.size()) : -1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PerfScope / PerfInstant
+// ═══════════════════════════════════════════════════════════════════════════
+
+PerfScope::PerfScope(PerfTrace &trace, const char *category, const char *name,
+                     const char *argName, int64_t arg)
+    : m_trace(trace.Recording() ? &trace : nullptr) {
+  if (!m_trace)
+    return;
+  m_event.name = name;
+  m_event.category = category;
+  m_event.argName = argName;
+  m_event.arg = arg;
+  m_event.beginUs = RdmNowUs();
+}
+
+PerfScope::~PerfScope() {
+  if (!m_trace)
+    return;
+  m_event.durUs = RdmNowUs() - m_event.beginUs;
+  m_trace->Record(m_event);
+}
+
+void PerfInstant(PerfTrace &trace, const char *category, const char *name,
+                 const char *argName, int64_t arg) {
+  PerfEvent e;
+  e.name = name;
+  e.category = category;
+  e.argName = argName;
+  e.arg = arg;
+  e.beginUs = RdmNowUs();
+  trace.Record(e);
+}
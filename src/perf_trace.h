@@ -0,0 +1,162 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Perf trace — scoped timing spans, exported as Chrome trace JSON
+// ────────────────────────────────────────────────────────────────────────
+#ifndef PERF_TRACE_H
+#define PERF_TRACE_H
+
+#include "spsc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Build with RDX_PERF_TRACE=1 (CMake option RDM_PERF_TRACE) to compile the
+// PERF_* instrumentation in.  Without it every PERF_* macro expands to
+// nothing; the PerfTrace class itself is always available.
+#ifndef RDX_PERF_TRACE
+#define RDX_PERF_TRACE 0
+#endif
+
+// ── One span or instant ─────────────────────────────────────────────────
+//    `name`, `category` and `argName` must be string literals (only the
+//    pointer is stored).
+struct PerfEvent {
+  const char *name = nullptr;
+  const char *category = nullptr;
+  const char *argName = nullptr; // nullptr = no argument
+  int64_t beginUs = 0;           // RdmNowUs clock
+  int64_t durUs = -1;            // -1 = instant event
+  int64_t arg = 0;
+};
+
+// An event as collected by the exporter, tagged with its thread
+struct PerfRecord {
+  PerfEvent event;
+  uint32_t tid = 0;
+};
+
+// ── PerfTrace ───────────────────────────────────────────────────────────
+//    Each recording thread owns an SPSC ring, created on its first event
+//    and registered once under a mutex; after that recording is a ring
+//    push with no shared state.  Collect() drains every ring (one
+//    exporter at a time).  A full ring drops the event and counts it.
+//    The ring of a thread that has exited is handed to the next new
+//    thread once drained, so short-lived workers do not add a ring each.
+//    While not recording, PERF_* scopes cost one relaxed atomic load.
+class PerfTrace {
+public:
+  static constexpr size_t kPerThread = 8192;
+
+  PerfTrace();
+  ~PerfTrace();
+  PerfTrace(const PerfTrace &) = delete;
+  PerfTrace &operator=(const PerfTrace &) = delete;
+
+  // Start() discards anything still buffered from a previous session
+  void Start();
+  void Stop();
+  bool Recording() const {
+    return m_recording.load(std::memory_order_relaxed);
+  }
+
+  void Record(const PerfEvent &e);
+
+  // Names the calling thread in exported traces.  `name` is copied.
+  void SetThreadName(const char *name);
+
+  // Drains all thread buffers, appends to `out` sorted by begin time
+  // (enclosing spans first) and returns the number of events added.
+  size_t Collect(std::vector<PerfRecord> &out);
+
+  // Drains and renders Chrome trace-event JSON ("traceEvents" array of
+  // complete / instant events plus thread-name metadata), loadable by
+  // chrome://tracing and ui.perfetto.dev.  Timestamps are relative to
+  // Start().  Each export contains the events since the previous one.
+  std::string ExportChromeJson();
+  // Same, written to a file.  Returns the event count, or -1 on I/O error.
+  int ExportChromeJson(const std::string &path);
+
+  uint64_t Dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct ThreadBuffer {
+    // Owner thread's liveness flag: identifies the owner, and false once
+    // it has exited
+    std::shared_ptr<const std::atomic<bool>> owner;
+    uint32_t tid = 0;
+    std::string name; // guarded by m_registryMutex
+    SpscRing<PerfEvent, kPerThread> ring;
+  };
+
+  ThreadBuffer *LocalBuffer();
+  std::string RenderChromeJson(const std::vector<PerfRecord> &records);
+
+  const uint32_t m_id; // distinguishes instances in the thread-local cache
+  std::atomic<bool> m_recording{false};
+  std::atomic<int64_t> m_startUs{0};
+  std::atomic<uint64_t> m_dropped{0};
+
+  std::mutex m_registryMutex; // registration, names and Collect()
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+  uint32_t m_nextTid = 1; // guarded by m_registryMutex
+};
+
+// Process-wide instance used by the PERF_* macros
+PerfTrace &GlobalPerfTrace();
+
+// ── RAII span ───────────────────────────────────────────────────────────
+class PerfScope {
+public:
+  PerfScope(PerfTrace &trace, const char *category, const char *name,
+            const char *argName = nullptr, int64_t arg = 0);
+  ~PerfScope();
+  PerfScope(const PerfScope &) = delete;
+  PerfScope &operator=(const PerfScope &) = delete;
+
+private:
+  PerfTrace *m_trace; // nullptr when not recording at construction
+  PerfEvent m_event;
+};
+
+#if RDX_PERF_TRACE
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_SCOPE(category, name)                                           \
+  PerfScope PERF_CONCAT(perfScope_, __LINE__)(GlobalPerfTrace(), category,   \
+                                              name)
+#define PERF_SCOPE_ARG(category, name, argName, arg)                         \
+  PerfScope PERF_CONCAT(perfScope_, __LINE__)(                               \
+      GlobalPerfTrace(), category, name, argName,                            \
+      static_cast<int64_t>(arg))
+#define PERF_INSTANT(category, name, argName, arg)                           \
+  do {                                                                       \
+    if (GlobalPerfTrace().Recording())                                       \
+      PerfInstant(GlobalPerfTrace(), category, name, argName,                \
+                  static_cast<int64_t>(arg));                                \
+  } while (0)
+#define PERF_THREAD_NAME(name) GlobalPerfTrace().SetThreadName(name)
+#else
+#define PERF_SCOPE(category, name) ((void)0)
+#define PERF_SCOPE_ARG(category, name, argName, arg) ((void)0)
+#define PERF_INSTANT(category, name, argName, arg) ((void)0)
+#define PERF_THREAD_NAME(name) ((void)0)
+#endif
+
+// Win32 Sleep() recorded as a span, so waits show up next to the I/O they
+// separate.  Expands to a plain Sleep() when instrumentation is compiled out.
+#define PERF_SLEEP(ms)                                                       \
+  do {                                                                       \
+    PERF_SCOPE_ARG("sleep", "Sleep", "ms", ms);                              \
+    Sleep(ms);                                                               \
+  } while (0)
+
+void PerfInstant(PerfTrace &trace, const char *category, const char *name,
+                 const char *argName = nullptr, int64_t arg = 0);
+
+#endif // PERF_TRACE_H
@@ -1,9 +1,14 @@
 // RDM protocol layer - Implementation
 #include "rdm.h"
 #include "enttec_pro.h"
+#include "fault_injector.h"
+#include "metrics.h"
 #include "peperoni_rodin.h"
+#include "perf_trace.h"
+#include "replay_driver.h"
+#include "responder_sim.h"
+#include "trace_ring.h"
 #include <algorithm>
-#include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <windows.h>
@@ -23,6 +28,12 @@ uint64_t StringToUID(const std::string &s) {
   return (static_cast<uint64_t>(hi) << 32) | lo;
 }
 
+bool RDMAddresses(uint64_t dest, uint64_t uid) {
+  if (dest == uid || dest == RDM_BROADCAST_UID)
+    return true;
+  return (dest & 0xFFFFFFFFULL) == 0xFFFFFFFFULL && (dest >> 32) == (uid >> 32);
+}
+
 static void PackUID(uint8_t *dst, uint64_t uid) {
   dst[0] = static_cast<uint8_t>((uid >> 40) & 0xFF);
   dst[1] = static_cast<uint8_t>((uid >> 32) & 0xFF);
@@ -86,24 +97,56 @@ std::vector<uint8_t> BuildRDMPacket(uint64_t destUID, uint64_t srcUID,
   return pkt;
 }
 
-// Send and receive a single RDM transaction
-static uint8_t s_transNum = 0;
+// Waits for the reply to a request just sent.  Enttec: poll for the first
+// byte of the Label 5 reply, at most 50 ms.  The Peperoni, the simulator
+// and replay hold the reply by the time SendRDM returns; the fault
+// injector waits the way the driver it wraps does.
+static void AwaitResponse(EnttecPro &pro) { pro.WaitForData(50); }
+static void AwaitResponse(PeperoniRodin &) {}
+static void AwaitResponse(ReplayDriver &) {}
+static void AwaitResponse(ResponderSim &) {}
+static void AwaitResponse(FaultInjector &pro) { pro.WaitForData(50); }
+
+// A reply is the answer to a request when its checksum is right and it
+// comes from the UID addressed, to us, with the request's transaction
+// number, command class and PID.  GET QUEUED_MESSAGE is answered with the
+// command class and PID of whatever was queued.
+static bool MatchesRequest(const uint8_t *rx, int rxLen, uint64_t srcUID,
+                           uint64_t destUID, uint8_t transNum,
+                           uint8_t commandClass, uint16_t pid) {
+  int msgLen = rx[2];
+  if (msgLen < 24 || msgLen + 2 > rxLen || 24 + rx[23] != msgLen)
+    return false;
+  uint16_t sum = static_cast<uint16_t>((rx[msgLen] << 8) | rx[msgLen + 1]);
+  if (RDMChecksum(rx, msgLen) != sum)
+    return false;
+  uint16_t respPid = static_cast<uint16_t>((rx[21] << 8) | rx[22]);
+  if (UnpackUID(rx + 3) != srcUID || UnpackUID(rx + 9) != destUID ||
+      rx[15] != transNum)
+    return false;
+  return pid == PID_QUEUED_MESSAGE ||
+         (rx[20] == commandClass + 1 && respPid == pid);
+}
 
-RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
-                          uint16_t pid, const uint8_t *paramData,
-                          uint8_t paramLen) {
+// Send and receive a single RDM transaction (GET or SET)
+template <typename Driver>
+static RDMResponse RDMExchangeImpl(Driver &pro, uint64_t srcUID,
+                                   uint64_t destUID, uint8_t commandClass,
+                                   uint16_t pid, const uint8_t *paramData,
+                                   uint8_t paramLen, bool *overflow) {
   RDMResponse resp;
-  auto pkt = BuildRDMPacket(destUID, srcUID, s_transNum++, 1, // port 1
+  *overflow = false;
+  uint8_t transNum = pro.NextTransNum();
+  auto pkt = BuildRDMPacket(destUID, srcUID, transNum, 1, // port 1
                             0, 0, // msg count, sub-device
-                            RDM_CC_GET, pid, paramData, paramLen);
+                            commandClass, pid, paramData, paramLen);
 
   if (!pro.SendRDM(pkt.data(), static_cast<int>(pkt.size()))) {
     resp.type = RDMResponseType::TIMEOUT;
     return resp;
   }
 
-  // Allow the fixture time to respond
-  Sleep(30);
+  AwaitResponse(pro);
 
   uint8_t rxBuf[512];
   uint8_t statusByte = 0;
@@ -125,6 +168,16 @@ RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
     return resp;
   }
 
+  // A corrupt or stray frame must not pass for the answer: callers cache
+  // responses and share them across fixtures
+  if (!MatchesRequest(rxBuf, rxLen, srcUID, destUID, transNum,
+                      commandClass, pid)) {
+    TRACE_DEBUG("[RDM] reply to PID 0x%04X from %04X:%08X rejected\n", pid,
+                TRACE_UID(destUID));
+    resp.type = RDMResponseType::INVALID;
+    return resp;
+  }
+
   uint8_t respType = rxBuf[16];
   uint8_t pdl = rxBuf[23];
 
@@ -134,14 +187,26 @@ RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
     if (pdl > 0 && 24 + pdl <= rxLen)
       resp.data.assign(rxBuf + 24, rxBuf + 24 + pdl);
     break;
-  case 0x01: // ACK_TIMER
+  case 0x01: // ACK_TIMER: data is the wait estimate, 100 ms units
     resp.type = RDMResponseType::ACK_TIMER;
+    if (pdl > 0 && 24 + pdl <= rxLen)
+      resp.data.assign(rxBuf + 24, rxBuf + 24 + pdl);
     break;
   case 0x02: // NACK
     resp.type = RDMResponseType::NACK;
     if (pdl >= 2)
       resp.nackReason = (rxBuf[24] << 8) | rxBuf[25];
     break;
+  case 0x03: // ACK_OVERFLOW: one segment; only a GET may be split
+    if (commandClass != RDM_CC_GET) {
+      resp.type = RDMResponseType::INVALID;
+      break;
+    }
+    resp.type = RDMResponseType::ACK;
+    *overflow = true;
+    if (pdl > 0 && 24 + pdl <= rxLen)
+      resp.data.assign(rxBuf + 24, rxBuf + 24 + pdl);
+    break;
   default:
     resp.type = RDMResponseType::INVALID;
     break;
@@ -150,97 +215,239 @@ RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
   return resp;
 }
 
+// ACK_OVERFLOW segments joined into one reply before it is given up on
+// (64 x 231 bytes is far more than any parameter holds)
+static const int kMaxOverflowSegments = 64;
+
+// One command.  An ACK_OVERFLOW reply is collected by sending the same GET
+// again until the final ACK; the caller sees one ACK with all the data.
+template <typename Driver>
+static RDMResponse RDMCommandImpl(Driver &pro, uint64_t srcUID,
+                                  uint64_t destUID, uint8_t commandClass,
+                                  uint16_t pid, const uint8_t *paramData,
+                                  uint8_t paramLen) {
+  std::vector<uint8_t> joined;
+  for (int segment = 0; segment < kMaxOverflowSegments; ++segment) {
+    bool overflow = false;
+    RDMResponse resp = RDMExchangeImpl(pro, srcUID, destUID, commandClass, pid,
+                                       paramData, paramLen, &overflow);
+    if (!overflow) {
+      if (segment > 0 && resp.type == RDMResponseType::ACK) {
+        joined.insert(joined.end(), resp.data.begin(), resp.data.end());
+        resp.data.swap(joined);
+      }
+      return resp;
+    }
+    joined.insert(joined.end(), resp.data.begin(), resp.data.end());
+  }
+  TRACE_ERROR("[RDM] PID 0x%04X from %04X:%08X: ACK_OVERFLOW past %d "
+              "segments\n",
+              pid, TRACE_UID(destUID), kMaxOverflowSegments);
+  RDMResponse resp;
+  resp.type = RDMResponseType::INVALID;
+  return resp;
+}
+
+RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_GET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMGetCommand(PeperoniRodin &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData, uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_GET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMGetCommand(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_GET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMGetCommand(FaultInjector &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData, uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_GET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMGetCommand(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_GET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMSetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_SET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMSetCommand(PeperoniRodin &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData, uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_SET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMSetCommand(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_SET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMSetCommand(FaultInjector &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData, uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_SET, pid, paramData,
+                        paramLen);
+}
+
+RDMResponse RDMSetCommand(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData,
+                          uint8_t paramLen) {
+  return RDMCommandImpl(pro, srcUID, destUID, RDM_CC_SET, pid, paramData,
+                        paramLen);
+}
+
+// No response comes back: the line is only held long enough for the
+// responders to take the frame in, then stale input is dropped
+template <typename Driver>
+static bool RDMBroadcastSetImpl(Driver &pro, uint64_t srcUID, uint64_t destUID,
+                                uint16_t pid, const uint8_t *paramData,
+                                uint8_t paramLen) {
+  PERF_SCOPE_ARG("rdm", "SET broadcast", "pid", pid);
+  auto pkt = BuildRDMPacket(destUID, srcUID, pro.NextTransNum(), 1, 0, 0,
+                            RDM_CC_SET, pid, paramData, paramLen);
+  bool sent = pro.SendRDM(pkt.data(), static_cast<int>(pkt.size()));
+  PERF_SLEEP(30);
+  pro.Purge();
+  return sent;
+}
+
+bool RDMBroadcastSet(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData,
+                     uint8_t paramLen) {
+  return RDMBroadcastSetImpl(pro, srcUID, destUID, pid, paramData,
+                             paramLen);
+}
+
+bool RDMBroadcastSet(PeperoniRodin &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData,
+                     uint8_t paramLen) {
+  return RDMBroadcastSetImpl(pro, srcUID, destUID, pid, paramData,
+                             paramLen);
+}
+
+bool RDMBroadcastSet(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData,
+                     uint8_t paramLen) {
+  return RDMBroadcastSetImpl(pro, srcUID, destUID, pid, paramData,
+                             paramLen);
+}
+
+bool RDMBroadcastSet(FaultInjector &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData,
+                     uint8_t paramLen) {
+  return RDMBroadcastSetImpl(pro, srcUID, destUID, pid, paramData,
+                             paramLen);
+}
+
+bool RDMBroadcastSet(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData,
+                     uint8_t paramLen) {
+  return RDMBroadcastSetImpl(pro, srcUID, destUID, pid, paramData,
+                             paramLen);
+}
+
 // ============================================================================
 // Templated Discovery helpers — work with any driver class that provides
-// SendRDM(), ReceiveRDM(), SendRDMDiscovery(), and Purge()
+// SendRDM(), ReceiveRDM(), SendRDMDiscovery(), Purge() and NextTransNum()
 // ============================================================================
 
-// Debug helper — forwards to OutputDebugStringA so DebugView can catch it.
-static void DiscLog(const char *fmt, ...) {
-  char buf[512];
-  va_list ap;
-  va_start(ap, fmt);
-  vsnprintf(buf, sizeof(buf), fmt, ap);
-  va_end(ap);
-  OutputDebugStringA(buf);
-}
-
 // Send DISC_MUTE to a specific UID.  Returns true if we got a response (ACK).
 template <typename Driver>
 static bool SendDiscMute(Driver &pro, uint64_t srcUID, uint64_t uid) {
-  DiscLog("[RDM] DISC_MUTE -> %s\n", UIDToString(uid).c_str());
-  auto pkt = BuildRDMPacket(uid, srcUID, s_transNum++, 1, 0, 0,
+  PERF_SCOPE("discovery", "DISC_MUTE");
+  TRACE_DEBUG("[RDM] DISC_MUTE -> %04X:%08X\n", TRACE_UID(uid));
+  auto pkt = BuildRDMPacket(uid, srcUID, pro.NextTransNum(), 1, 0, 0,
                             RDM_CC_DISCOVERY, PID_DISC_MUTE);
   if (!pro.SendRDM(pkt.data(), static_cast<int>(pkt.size()))) {
-    DiscLog("[RDM]   MUTE send failed\n");
+    TRACE_DEBUG("[RDM]   MUTE send failed\n");
     return false;
   }
-  Sleep(50);
+  PERF_SLEEP(50);
   uint8_t buf[256];
   uint8_t st;
   int len = pro.ReceiveRDM(buf, sizeof(buf), st);
-  DiscLog("[RDM]   MUTE rx len=%d  status=0x%02X\n", len, st);
+  TRACE_DEBUG("[RDM]   MUTE rx len=%d  status=0x%02X\n", len, st);
   return (len > 0);
 }
 
-// Send DISC_UN_MUTE broadcast.  No response expected.
+// Send DISC_UN_MUTE, broadcast unless `uid` is given.  The reply to a
+// unicast one is not needed and is purged with any stale data.
 template <typename Driver>
-static void SendDiscUnMute(Driver &pro, uint64_t srcUID) {
-  DiscLog("[RDM] DISC_UN_MUTE (broadcast)\n");
-  auto pkt = BuildRDMPacket(RDM_BROADCAST_UID, srcUID, s_transNum++, 1, 0, 0,
+static void SendDiscUnMute(Driver &pro, uint64_t srcUID,
+                           uint64_t uid = RDM_BROADCAST_UID) {
+  PERF_SCOPE("discovery", "DISC_UN_MUTE");
+  TRACE_DEBUG("[RDM] DISC_UN_MUTE -> %04X:%08X\n", TRACE_UID(uid));
+  auto pkt = BuildRDMPacket(uid, srcUID, pro.NextTransNum(), 1, 0, 0,
                             RDM_CC_DISCOVERY, PID_DISC_UN_MUTE);
   pro.SendRDM(pkt.data(), static_cast<int>(pkt.size()));
-  Sleep(100);
-  // Broadcast: no response expected; purge any stale data
+  PERF_SLEEP(uid == RDM_BROADCAST_UID ? 100 : 50);
   pro.Purge();
 }
 
 // Attempt DISC_UNIQUE_BRANCH.
 // Returns:
 //  -1 = no response (no devices in range)
-//   0 = collision (multiple devices or garbled response)
+//   0 = collision (multiple devices, garbled response, or a UID outside
+//       the branch)
 //   1 = single device, UID written to *foundUID
 template <typename Driver>
 static int TryDiscBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
                          uint64_t upper, uint64_t *foundUID) {
+  PERF_SCOPE("discovery", "DISC_UNIQUE_BRANCH");
   uint8_t pd[12];
   PackUID(pd, lower);
   PackUID(pd + 6, upper);
 
-  auto pkt = BuildRDMPacket(RDM_BROADCAST_UID, srcUID, s_transNum++, 1, 0, 0,
-                            RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH, pd, 12);
+  auto pkt =
+      BuildRDMPacket(RDM_BROADCAST_UID, srcUID, pro.NextTransNum(), 1, 0, 0,
+                     RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH, pd, 12);
 
-  DiscLog("[RDM] BRANCH [%s - %s]  pktSz=%d\n", UIDToString(lower).c_str(),
-          UIDToString(upper).c_str(), (int)pkt.size());
+  TRACE_DEBUG("[RDM] BRANCH [%04X:%08X - %04X:%08X]  pktSz=%d\n",
+              TRACE_UID(lower), TRACE_UID(upper), (int)pkt.size());
 
   if (!pro.SendRDMDiscovery(pkt.data(), static_cast<int>(pkt.size()))) {
-    DiscLog("[RDM]   BRANCH send failed!\n");
+    TRACE_DEBUG("[RDM]   BRANCH send failed!\n");
     return -1;
   }
 
   // Discovery responses need more time than normal RDM GETs.
-  Sleep(50);
+  PERF_SLEEP(50);
 
   uint8_t rxBuf[512];
   uint8_t statusByte = 0;
   int rxLen = pro.ReceiveRDM(rxBuf, sizeof(rxBuf), statusByte);
 
-  DiscLog("[RDM]   BRANCH rx: len=%d  statusByte=0x%02X\n", rxLen, statusByte);
+  TRACE_DEBUG("[RDM]   BRANCH rx: len=%d  statusByte=0x%02X\n", rxLen,
+              statusByte);
 
   if (rxLen <= 0) {
-    DiscLog("[RDM]   -> no response\n");
+    TRACE_DEBUG("[RDM]   -> no response\n");
     return -1; // no response
   }
 
-  // Dump first 32 bytes for debugging
-  {
-    char hexDump[200];
-    int pos = 0;
-    for (int i = 0; i < rxLen && i < 32; ++i) {
-      pos += snprintf(hexDump + pos, sizeof(hexDump) - pos, "%02X ", rxBuf[i]);
-    }
-    DiscLog("[RDM]   BRANCH rxdata: %s\n", hexDump);
-  }
+  // Raw bytes are traced by the driver (TraceLevel::FRAME)
 
   // The discovery response contains raw bytes from the bus.
   // Per E1.20 Section 7.5.3, the discovery response is encoded:
@@ -261,8 +468,8 @@ static int TryDiscBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
 
   int remaining = rxLen - offset;
 
-  DiscLog("[RDM]   after preamble strip: offset=%d  remaining=%d\n", offset,
-          remaining);
+  TRACE_DEBUG("[RDM]   after preamble strip: offset=%d  remaining=%d\n",
+              offset, remaining);
 
   // We need at least 12 bytes for the encoded UID (6 pairs)
   // Ideally 16 bytes (12 UID + 4 checksum) but some devices
@@ -270,10 +477,11 @@ static int TryDiscBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
   if (remaining < 12) {
     // Insufficient data: could be a collision (garbled) or short response
     if (remaining > 0) {
-      DiscLog("[RDM]   -> COLLISION (short data: %d bytes)\n", remaining);
+      TRACE_DEBUG("[RDM]   -> COLLISION (short data: %d bytes)\n", remaining);
+      GlobalMetrics().Add(pro.MetricsPort(), Metric::DUB_COLLISIONS);
       return 0; // some data = collision
     }
-    DiscLog("[RDM]   -> no data after preamble\n");
+    TRACE_DEBUG("[RDM]   -> no data after preamble\n");
     return -1; // no data after preamble
   }
 
@@ -288,36 +496,104 @@ static int TryDiscBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
   }
 
   uint64_t uid = UnpackUID(decoded);
-  DiscLog("[RDM]   -> FOUND UID: %s\n", UIDToString(uid).c_str());
+
+  // With the checksum present, a mismatch means overlapping replies that
+  // happened to keep the encoding intact: split instead of muting a
+  // phantom UID
+  if (remaining >= 16) {
+    uint16_t sum = 0;
+    for (int i = 0; i < 12; ++i)
+      sum += rxBuf[offset + i];
+    const uint8_t *ck = rxBuf + offset + 12;
+    uint16_t expected = static_cast<uint16_t>(
+        (((ck[0] & 0x55) | (ck[1] & 0xAA)) << 8) |
+        ((ck[2] & 0x55) | (ck[3] & 0xAA)));
+    if (sum != expected) {
+      TRACE_DEBUG("[RDM]   -> COLLISION (EUID checksum %04X != %04X)\n",
+                  sum, expected);
+      GlobalMetrics().Add(pro.MetricsPort(), Metric::DUB_COLLISIONS);
+      return 0;
+    }
+  }
+  // Only UIDs inside the branch may answer it: anything else is noise that
+  // happened to decode
+  if (uid < lower || uid > upper) {
+    TRACE_DEBUG("[RDM]   -> COLLISION (%04X:%08X outside the branch)\n",
+                TRACE_UID(uid));
+    GlobalMetrics().Add(pro.MetricsPort(), Metric::DUB_COLLISIONS);
+    return 0;
+  }
+  TRACE_DEBUG("[RDM]   -> FOUND UID: %04X:%08X\n", TRACE_UID(uid));
 
   if (foundUID)
     *foundUID = uid;
   return 1;
 }
 
-// Recursive binary tree discovery
+// DISC_MUTE sends per UID before its reply is given up on
+static const int kDiscMuteAttempts = 3;
+
+template <typename Driver>
+static void AddFound(Driver &pro, std::vector<uint64_t> &found, uint64_t uid) {
+  found.push_back(uid);
+  GlobalMetrics().Add(pro.MetricsPort(), Metric::UIDS_DISCOVERED);
+}
+
+// Recursive binary tree discovery.  `depth` counts splits, so 48 reach a
+// single UID; asking the same range again after a mute does not count.
 template <typename Driver>
 static void DiscoverBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
                            uint64_t upper, std::vector<uint64_t> &found,
                            int depth = 0) {
-  // Limit recursion depth to prevent stack overflow
-  if (depth >= 48)
+  if (depth > 48)
     return;
 
   uint64_t uid = 0;
   int result = TryDiscBranch(pro, srcUID, lower, upper, &uid);
 
-  if (result == -1)
-    return; // no devices in this range
-
-  if (result == 1) {
-    // Got a single UID - mute it and continue searching the same range
-    found.push_back(uid);
-    SendDiscMute(pro, srcUID, uid);
+  // A single UID: mute it and ask the same range again, until it is silent
+  // or collides.  A lost mute reply is retried first so one bad frame
+  // does not cost a split.
+  while (result == 1) {
+    bool muted = false;
+    for (int attempt = 0; attempt < kDiscMuteAttempts && !muted; ++attempt)
+      muted = SendDiscMute(pro, srcUID, uid);
+    if (muted) {
+      AddFound(pro, found, uid);
+      result = TryDiscBranch(pro, srcUID, lower, upper, &uid);
+      continue;
+    }
 
-    // Check if there are more devices in this range
-    DiscoverBranch(pro, srcUID, lower, upper, found, depth + 1);
-  } else if (result == 0) {
+    // No ACK: the fixture may have muted and only its replies were lost.
+    // A muted fixture drops out of the branch, so ask the range again.
+    uint64_t next = 0;
+    int again = TryDiscBranch(pro, srcUID, lower, upper, &next);
+    if (again == -1) {
+      TRACE_ERROR("[RDM]   -> %04X:%08X went quiet without a MUTE ACK, "
+                  "accepting\n",
+                  TRACE_UID(uid));
+      AddFound(pro, found, uid);
+      return;
+    }
+    if (again == 1 && next == uid && lower >= upper) {
+      // Nothing left to split: the checksum-valid reply came from the one
+      // UID in range
+      TRACE_ERROR("[RDM]   -> %04X:%08X did not ACK MUTE, accepting\n",
+                  TRACE_UID(uid));
+      AddFound(pro, found, uid);
+      return;
+    }
+    // Still answering, or someone else is: split.  If it did mute after
+    // all (or was an overlay of two others), the unicast un-mute puts it
+    // back in the search rather than losing it.
+    TRACE_DEBUG("[RDM]   -> %04X:%08X did not ACK MUTE, splitting\n",
+                TRACE_UID(uid));
+    GlobalMetrics().Add(pro.MetricsPort(), Metric::DUB_COLLISIONS);
+    if (again != 1 || next != uid)
+      SendDiscUnMute(pro, srcUID, uid);
+    result = 0;
+  }
+  if (result == 0) {
     // Collision - binary split the search range
     if (lower >= upper)
       return; // can't split further
@@ -331,25 +607,26 @@ static void DiscoverBranch(Driver &pro, uint64_t srcUID, uint64_t lower,
 // ── Public discovery entry points ─────────────────────────────────────────
 template <typename Driver>
 static std::vector<uint64_t> RDMDiscoveryImpl(Driver &pro, uint64_t srcUID) {
+  PERF_SCOPE("discovery", "RDMDiscovery");
   std::vector<uint64_t> found;
-  DiscLog("[RDM] ===== Starting RDM Discovery (src=%s) =====\n",
-          UIDToString(srcUID).c_str());
+  TRACE_DEBUG("[RDM] ===== Starting RDM Discovery (src=%04X:%08X) =====\n",
+              TRACE_UID(srcUID));
 
   // Un-mute all devices (send twice for reliability)
   SendDiscUnMute(pro, srcUID);
-  Sleep(100);
+  PERF_SLEEP(100);
   SendDiscUnMute(pro, srcUID);
-  Sleep(100);
+  PERF_SLEEP(100);
 
   // Search the entire UID space (0x000000000000 to 0xFFFEFFFFFFFF)
   DiscoverBranch(pro, srcUID, 0x000000000000ULL, 0xFFFEFFFFFFFFULL, found);
 
-  DiscLog("[RDM] ===== Discovery complete: found %d device(s) =====\n",
-          (int)found.size());
+  TRACE_DEBUG("[RDM] ===== Discovery complete: found %d device(s) =====\n",
+              (int)found.size());
   return found;
 }
 
-// Explicit instantiations for both driver types
+// Explicit instantiations for each driver type
 std::vector<uint64_t> RDMDiscovery(EnttecPro &pro, uint64_t srcUID) {
   return RDMDiscoveryImpl(pro, srcUID);
 }
@@ -357,3 +634,15 @@ std::vector<uint64_t> RDMDiscovery(EnttecPro &pro, uint64_t srcUID) {
 std::vector<uint64_t> RDMDiscovery(PeperoniRodin &pro, uint64_t srcUID) {
   return RDMDiscoveryImpl(pro, srcUID);
 }
+
+std::vector<uint64_t> RDMDiscovery(ReplayDriver &pro, uint64_t srcUID) {
+  return RDMDiscoveryImpl(pro, srcUID);
+}
+
+std::vector<uint64_t> RDMDiscovery(FaultInjector &pro, uint64_t srcUID) {
+  return RDMDiscoveryImpl(pro, srcUID);
+}
+
+std::vector<uint64_t> RDMDiscovery(ResponderSim &pro, uint64_t srcUID) {
+  return RDMDiscoveryImpl(pro, srcUID);
+}
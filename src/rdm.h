@@ -12,6 +12,9 @@
 
 class EnttecPro;     // forward
 class PeperoniRodin; // forward
+class ReplayDriver;  // forward
+class FaultInjector; // forward
+class ResponderSim;  // forward
 
 // ── RDM constants ───────────────────────────────────────────────────────
 constexpr uint8_t RDM_START_CODE = 0xCC;
@@ -29,12 +32,48 @@ constexpr uint8_t RDM_CC_SET_RSP = 0x31;
 constexpr uint16_t PID_DISC_UNIQUE_BRANCH = 0x0001;
 constexpr uint16_t PID_DISC_MUTE = 0x0002;
 constexpr uint16_t PID_DISC_UN_MUTE = 0x0003;
+constexpr uint16_t PID_QUEUED_MESSAGE = 0x0020;
+constexpr uint16_t PID_STATUS_MESSAGES = 0x0030;
 constexpr uint16_t PID_SUPPORTED_PARAMS = 0x0050;
+constexpr uint16_t PID_PARAMETER_DESCRIPTION = 0x0051;
 constexpr uint16_t PID_DEVICE_INFO = 0x0060;
+constexpr uint16_t PID_DEVICE_MODEL_DESCRIPTION = 0x0080;
+constexpr uint16_t PID_MANUFACTURER_LABEL = 0x0081;
+constexpr uint16_t PID_FACTORY_DEFAULTS = 0x0090;
+constexpr uint16_t PID_SOFTWARE_VERSION_LABEL = 0x00C0;
+constexpr uint16_t PID_DMX_PERSONALITY = 0x00E0;
+constexpr uint16_t PID_DMX_PERSONALITY_DESCRIPTION = 0x00E1;
+constexpr uint16_t PID_DMX_START_ADDRESS = 0x00F0;
+constexpr uint16_t PID_SENSOR_DEFINITION = 0x0200;
+constexpr uint16_t PID_CURVE = 0x0343;                // E1.37-1
+constexpr uint16_t PID_CURVE_DESCRIPTION = 0x0344;    // E1.37-1
+constexpr uint16_t PID_OUTPUT_RESPONSE_TIME = 0x0345; // E1.37-1
+constexpr uint16_t PID_MODULATION_FREQUENCY = 0x0347; // E1.37-1
 constexpr uint16_t PID_IDENTIFY_DEVICE = 0x1000;
 
+// Response types (header byte 16 of a response)
+constexpr uint8_t RDM_RESPONSE_ACK = 0x00;
+constexpr uint8_t RDM_RESPONSE_ACK_TIMER = 0x01;
+constexpr uint8_t RDM_RESPONSE_NACK = 0x02;
+constexpr uint8_t RDM_RESPONSE_ACK_OVERFLOW = 0x03;
+
+// NACK reason codes (E1.20 Table A-17)
+constexpr uint16_t NR_UNKNOWN_PID = 0x0000;
+constexpr uint16_t NR_FORMAT_ERROR = 0x0001;
+constexpr uint16_t NR_HARDWARE_FAULT = 0x0002;
+constexpr uint16_t NR_WRITE_PROTECT = 0x0004;
+constexpr uint16_t NR_UNSUPPORTED_COMMAND_CLASS = 0x0005;
+constexpr uint16_t NR_DATA_OUT_OF_RANGE = 0x0006;
+constexpr uint16_t NR_BUFFER_FULL = 0x0007;
+constexpr uint16_t NR_PACKET_SIZE_UNSUPPORTED = 0x0008;
+constexpr uint16_t NR_SUB_DEVICE_OUT_OF_RANGE = 0x0009;
+
 // Broadcast UID
 constexpr uint64_t RDM_BROADCAST_UID = 0xFFFFFFFFFFFFULL;
+// Vendorcast: every device of one manufacturer (mmmm:FFFFFFFF)
+constexpr uint64_t RDMVendorcastUID(uint16_t manufacturer) {
+  return (static_cast<uint64_t>(manufacturer) << 32) | 0xFFFFFFFFULL;
+}
 
 // ── Response types ──────────────────────────────────────────────────────
 enum class RDMResponseType {
@@ -49,12 +88,16 @@ enum class RDMResponseType {
 struct RDMResponse {
   RDMResponseType type = RDMResponseType::TIMEOUT;
   uint16_t nackReason = 0;
-  std::vector<uint8_t> data;
+  std::vector<uint8_t> data; // ACK_TIMER: the wait estimate
+  bool cached = false; // served from a local cache; nothing went on the line
 };
 
 // ── Helper to format a 48-bit UID as a string ───────────────────────────
 std::string UIDToString(uint64_t uid);
 uint64_t StringToUID(const std::string &s);
+// True when a command sent to `dest` reaches `uid`: the UID itself, the
+// broadcast UID, or the vendorcast UID of its manufacturer
+bool RDMAddresses(uint64_t dest, uint64_t uid);
 
 // ── Checksum ────────────────────────────────────────────────────────────
 uint16_t RDMChecksum(const uint8_t *data, int len);
@@ -70,13 +113,70 @@ BuildRDMPacket(uint64_t destUID, uint64_t srcUID, uint8_t transNum,
 
 // ── Discovery ───────────────────────────────────────────────────────────
 //    Performs full binary-tree RDM discovery. Returns list of found UIDs.
-//    Overloaded for both driver types.
+//    Overloaded for each driver type.
 std::vector<uint64_t> RDMDiscovery(EnttecPro &pro, uint64_t srcUID);
 std::vector<uint64_t> RDMDiscovery(PeperoniRodin &pro, uint64_t srcUID);
+std::vector<uint64_t> RDMDiscovery(ReplayDriver &pro, uint64_t srcUID);
+std::vector<uint64_t> RDMDiscovery(FaultInjector &pro, uint64_t srcUID);
+std::vector<uint64_t> RDMDiscovery(ResponderSim &pro, uint64_t srcUID);
 
 // ── GET command ─────────────────────────────────────────────────────────
+// An ACK_OVERFLOW reply is fetched segment by segment and returned as one
+// ACK carrying the joined data.
 RDMResponse RDMGetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
                           uint16_t pid, const uint8_t *paramData = nullptr,
                           uint8_t paramLen = 0);
+RDMResponse RDMGetCommand(PeperoniRodin &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMGetCommand(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMGetCommand(FaultInjector &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMGetCommand(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+
+// ── SET command ─────────────────────────────────────────────────────────
+RDMResponse RDMSetCommand(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMSetCommand(PeperoniRodin &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMSetCommand(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMSetCommand(FaultInjector &pro, uint64_t srcUID,
+                          uint64_t destUID, uint16_t pid,
+                          const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+RDMResponse RDMSetCommand(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                          uint16_t pid, const uint8_t *paramData = nullptr,
+                          uint8_t paramLen = 0);
+
+// ── Broadcast / vendorcast SET ──────────────────────────────────────────
+//    One frame, no response: every addressed responder applies it
+//    silently.  False when the frame could not be sent.
+bool RDMBroadcastSet(EnttecPro &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData = nullptr,
+                     uint8_t paramLen = 0);
+bool RDMBroadcastSet(PeperoniRodin &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData = nullptr,
+                     uint8_t paramLen = 0);
+bool RDMBroadcastSet(ReplayDriver &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData = nullptr,
+                     uint8_t paramLen = 0);
+bool RDMBroadcastSet(FaultInjector &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData = nullptr,
+                     uint8_t paramLen = 0);
+bool RDMBroadcastSet(ResponderSim &pro, uint64_t srcUID, uint64_t destUID,
+                     uint16_t pid, const uint8_t *paramData = nullptr,
+                     uint8_t paramLen = 0);
 
 #endif // RDM_H
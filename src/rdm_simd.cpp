@@ -0,0 +1,234 @@
+// ────────────────────────────────────────────────────────────────────────
+// RDM SIMD kernels — checksum, DUB decoding, header extraction
+// ────────────────────────────────────────────────────────────────────────
+#include "rdm_simd.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) ||            \
+    defined(__i386__)
+#define RDX_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RDX_TARGET_SSE2
+#else
+// GCC / Clang: compile single functions for SSE2 (not the baseline on
+// 32-bit x86); they only run after the runtime check in DetectSimdLevel().
+#define RDX_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#else
+#define RDX_SIMD_X86 0
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Dispatch
+// ═══════════════════════════════════════════════════════════════════════════
+
+SimdLevel DetectSimdLevel() {
+#if RDX_SIMD_X86
+#ifdef _MSC_VER
+  int r[4];
+  __cpuid(r, 1);
+  if (r[3] & (1 << 26))
+    return SimdLevel::SSE2;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2"))
+    return SimdLevel::SSE2;
+#endif
+#endif
+  return SimdLevel::SCALAR;
+}
+
+static std::atomic<int> g_level{-1}; // -1 = not probed yet
+
+SimdLevel ActiveSimdLevel() {
+  int level = g_level.load(std::memory_order_relaxed);
+  if (level < 0) {
+    level = static_cast<int>(DetectSimdLevel());
+    g_level.store(level, std::memory_order_relaxed);
+  }
+  return static_cast<SimdLevel>(level);
+}
+
+void SetSimdLevel(SimdLevel level) {
+  SimdLevel best = DetectSimdLevel();
+  if (level > best)
+    level = best;
+  g_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char *SimdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::SSE2:
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Checksum kernels
+// ═══════════════════════════════════════════════════════════════════════════
+
+static uint16_t ChecksumScalar(const uint8_t *data, int len) {
+  uint32_t sum = 0;
+  for (int i = 0; i < len; ++i)
+    sum += data[i];
+  return static_cast<uint16_t>(sum);
+}
+
+#if RDX_SIMD_X86
+// PSADBW against zero sums 8 bytes into each 64-bit lane: one instruction
+// per 16 bytes, no widening or horizontal adds.  A 32-byte AVX2 version
+// measured no faster: RDM frames are at most 257 bytes.
+RDX_TARGET_SSE2 static uint16_t ChecksumSse2(const uint8_t *data, int len) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  int i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+  }
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  return static_cast<uint16_t>(lanes[0] + lanes[1] +
+                               ChecksumScalar(data + i, len - i));
+}
+#endif
+
+uint16_t RDMChecksumSimd(const uint8_t *data, int len) {
+  if (!data || len <= 0)
+    return 0;
+#if RDX_SIMD_X86
+  if (ActiveSimdLevel() != SimdLevel::SCALAR)
+    return ChecksumSse2(data, len);
+#endif
+  return ChecksumScalar(data, len);
+}
+
+// Kernel as a template argument so it inlines into the batch loop
+template <uint16_t (*Kernel)(const uint8_t *, int)>
+static int VerifyWith(const uint8_t *const *frames, const int *lens, int count,
+                      uint8_t *ok) {
+  int good = 0;
+  for (int i = 0; i < count; ++i) {
+    const uint8_t *f = frames[i];
+    int body = lens[i] - 2;
+    bool match = body > 0 &&
+                 Kernel(f, body) == ((f[body] << 8) | f[body + 1]);
+    ok[i] = match ? 1 : 0;
+    good += match;
+  }
+  return good;
+}
+
+int VerifyRDMChecksums(const uint8_t *const *frames, const int *lens,
+                       int count, uint8_t *ok) {
+#if RDX_SIMD_X86
+  if (ActiveSimdLevel() != SimdLevel::SCALAR)
+    return VerifyWith<ChecksumSse2>(frames, lens, count, ok);
+#endif
+  return VerifyWith<ChecksumScalar>(frames, lens, count, ok);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DISC_UNIQUE_BRANCH decoding
+// ═══════════════════════════════════════════════════════════════════════════
+
+// decoded[0..5] = UID, decoded[6..7] = checksum; returns the sum of the 12
+// encoded UID bytes
+static uint16_t DubDecodeScalar(const uint8_t *enc, uint8_t decoded[8]) {
+  uint16_t sum = 0;
+  for (int i = 0; i < 8; ++i) {
+    decoded[i] = (enc[i * 2] & 0x55) | (enc[i * 2 + 1] & 0xAA);
+    if (i < 6)
+      sum += enc[i * 2] + enc[i * 2 + 1];
+  }
+  return sum;
+}
+
+#if RDX_SIMD_X86
+// All 16 encoded bytes in one register: mask each pair with 0x55 / 0xAA,
+// fold the high byte of every 16-bit lane onto the low one and pack the
+// eight results.  The UID sum is one PSADBW with the checksum bytes masked.
+RDX_TARGET_SSE2 static uint16_t DubDecodeSse2(const uint8_t *enc,
+                                              uint8_t decoded[8]) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(enc));
+  __m128i x = _mm_and_si128(v, _mm_set1_epi16(static_cast<short>(0xAA55)));
+  __m128i folded = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi16(0x00FF)),
+                                _mm_srli_epi16(x, 8));
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(decoded),
+                   _mm_packus_epi16(folded, folded));
+
+  __m128i uidBytes = _mm_and_si128(
+      v, _mm_setr_epi32(-1, -1, -1, 0)); // drop the 4 checksum bytes
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes),
+                   _mm_sad_epu8(uidBytes, _mm_setzero_si128()));
+  return static_cast<uint16_t>(lanes[0] + lanes[1]);
+}
+#endif
+
+bool DecodeDubReply(const uint8_t *data, int len, uint64_t *uid,
+                    bool *checksumOk) {
+  if (!data)
+    return false;
+  int offset = 0;
+  while (offset < len && data[offset] == 0xFE)
+    ++offset;
+  if (offset < len && data[offset] == 0xAA)
+    ++offset;
+  if (len - offset < 16)
+    return false;
+
+  const uint8_t *enc = data + offset;
+  uint8_t decoded[8];
+  uint16_t sum;
+#if RDX_SIMD_X86
+  if (ActiveSimdLevel() != SimdLevel::SCALAR)
+    sum = DubDecodeSse2(enc, decoded);
+  else
+#endif
+    sum = DubDecodeScalar(enc, decoded);
+
+  uint64_t value = 0;
+  for (int i = 0; i < 6; ++i)
+    value = (value << 8) | decoded[i];
+  if (uid)
+    *uid = value;
+  if (checksumOk)
+    *checksumOk = sum == ((decoded[6] << 8) | decoded[7]);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Header extraction
+// ═══════════════════════════════════════════════════════════════════════════
+
+static uint64_t LoadUID(const uint8_t *p) {
+  uint64_t v = 0;
+  for (int i = 0; i < 6; ++i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+void ExtractRDMHeaders(const uint8_t *const *frames, int count,
+                       RdmHeaderFields *out) {
+  for (int i = 0; i < count; ++i) {
+    const uint8_t *p = frames[i];
+    RdmHeaderFields &h = out[i];
+    h.destUID = LoadUID(p + 3);
+    h.srcUID = LoadUID(p + 9);
+    h.messageLength = p[2];
+    h.transNum = p[15];
+    h.portOrResponse = p[16];
+    h.messageCount = p[17];
+    h.subDevice = static_cast<uint16_t>((p[18] << 8) | p[19]);
+    h.commandClass = p[20];
+    h.pid = static_cast<uint16_t>((p[21] << 8) | p[22]);
+    h.paramLen = p[23];
+  }
+}
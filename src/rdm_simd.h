@@ -0,0 +1,57 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// RDM SIMD kernels — checksum, DUB decoding, header extraction
+// ────────────────────────────────────────────────────────────────────────
+#ifndef RDM_SIMD_H
+#define RDM_SIMD_H
+
+#include <cstdint>
+
+// Instruction set used by the kernels.  Picked once from the CPU at first
+// use (SSE2 is the x64 baseline); non-x86 builds always run the scalar
+// code.
+enum class SimdLevel : uint8_t { SCALAR, SSE2 };
+
+SimdLevel DetectSimdLevel(); // best level this CPU supports
+SimdLevel ActiveSimdLevel();
+// Forces a level (benchmarks, tests); clamped to DetectSimdLevel()
+void SetSimdLevel(SimdLevel level);
+const char *SimdLevelName(SimdLevel level);
+
+// ── Checksum ────────────────────────────────────────────────────────────
+//    Same result as RDMChecksum() (rdm.cpp): 16-bit sum of the bytes.
+uint16_t RDMChecksumSimd(const uint8_t *data, int len);
+
+// Verifies `count` packets in one call: frames[i] is a complete packet
+// (start code through checksum) of lens[i] bytes.  ok[i] = 1 when the
+// trailing checksum matches.  Returns the number of good packets.
+int VerifyRDMChecksums(const uint8_t *const *frames, const int *lens,
+                       int count, uint8_t *ok);
+
+// ── DISC_UNIQUE_BRANCH reply ────────────────────────────────────────────
+//    Strips the 0xFE preamble / 0xAA separator and decodes the 12 UID and
+//    4 checksum bytes (E1.20 7.5.3).  Returns false when fewer than 16
+//    encoded bytes follow; `checksumOk` reports the EUID checksum.
+bool DecodeDubReply(const uint8_t *data, int len, uint64_t *uid,
+                    bool *checksumOk);
+
+// ── Header fields ───────────────────────────────────────────────────────
+struct RdmHeaderFields {
+  uint64_t destUID = 0;
+  uint64_t srcUID = 0;
+  uint16_t subDevice = 0;
+  uint16_t pid = 0;
+  uint8_t messageLength = 0; // slot 2
+  uint8_t transNum = 0;
+  uint8_t portOrResponse = 0; // port ID (request) / response type
+  uint8_t messageCount = 0;
+  uint8_t commandClass = 0;
+  uint8_t paramLen = 0;
+};
+
+// Extracts the 24-byte header of `count` packets.  Callers pass only
+// packets of at least 26 bytes starting with RDM_START_CODE.
+void ExtractRDMHeaders(const uint8_t *const *frames, int count,
+                       RdmHeaderFields *out);
+
+#endif // RDM_SIMD_H
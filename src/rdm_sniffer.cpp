@@ -0,0 +1,410 @@
+// ────────────────────────────────────────────────────────────────────────
+// RDM sniffer — Implementation
+// ────────────────────────────────────────────────────────────────────────
+#include "rdm_sniffer.h"
+#include "enttec_pro.h"
+#include "peperoni_rodin.h"
+#include "rdm.h"
+#include <chrono>
+#include <cstring>
+
+static int64_t SteadyNowUs() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static uint64_t ReadUID(const uint8_t *p) {
+  return (static_cast<uint64_t>(p[0]) << 40) |
+         (static_cast<uint64_t>(p[1]) << 32) |
+         (static_cast<uint64_t>(p[2]) << 24) |
+         (static_cast<uint64_t>(p[3]) << 16) |
+         (static_cast<uint64_t>(p[4]) << 8) | static_cast<uint64_t>(p[5]);
+}
+
+// Broadcast (FFFF:FFFFFFFF) or manufacturer broadcast (mmmm:FFFFFFFF):
+// responders stay silent, so nothing is left pending.
+static bool IsBroadcastUID(uint64_t uid) {
+  return (uid & 0xFFFFFFFFULL) == 0xFFFFFFFFULL;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Classification
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool DecodeDubResponse(const uint8_t *data, int len, uint64_t *uid) {
+  int offset = 0;
+  while (offset < len && offset < 7 && data[offset] == 0xFE)
+    offset++;
+  if (offset >= len || data[offset] != 0xAA)
+    return false;
+  offset++;
+  if (len - offset < 16)
+    return false;
+
+  const uint8_t *enc = data + offset;
+  uint16_t sum = 0;
+  for (int i = 0; i < 12; ++i)
+    sum += enc[i];
+
+  uint8_t decoded[6];
+  for (int i = 0; i < 6; ++i)
+    decoded[i] = (enc[i * 2] & 0x55) | (enc[i * 2 + 1] & 0xAA);
+  uint8_t csHi = (enc[12] & 0x55) | (enc[13] & 0xAA);
+  uint8_t csLo = (enc[14] & 0x55) | (enc[15] & 0xAA);
+  if (((csHi << 8) | csLo) != sum)
+    return false;
+
+  if (uid)
+    *uid = ReadUID(decoded);
+  return true;
+}
+
+SniffFrameKind ClassifySniffFrame(const uint8_t *data, int len,
+                                  uint8_t flags) {
+  if (!data || len <= 0)
+    return SniffFrameKind::INVALID;
+
+  // DUB responses are sent without a break and start with the preamble
+  if (data[0] == 0xFE || data[0] == 0xAA) {
+    if (DecodeDubResponse(data, len, nullptr))
+      return SniffFrameKind::DUB_RESPONSE;
+  }
+  if (flags & (SNIFF_FLAG_NO_BREAK | SNIFF_FLAG_ERROR))
+    return SniffFrameKind::INVALID;
+
+  if (data[0] == 0x00)
+    return SniffFrameKind::DMX;
+  if (data[0] != RDM_START_CODE)
+    return SniffFrameKind::ALT_START;
+
+  // RDM: validate sub start code, message length, PDL and checksum
+  if (len < 26 || data[1] != RDM_SUB_START)
+    return SniffFrameKind::INVALID;
+  int msgLen = data[2];
+  if (msgLen < 24 || msgLen + 2 > len || data[23] != msgLen - 24)
+    return SniffFrameKind::INVALID;
+  uint16_t cksum = (data[msgLen] << 8) | data[msgLen + 1];
+  if (RDMChecksum(data, msgLen) != cksum)
+    return SniffFrameKind::INVALID;
+
+  switch (data[20]) {
+  case RDM_CC_DISCOVERY:
+  case RDM_CC_GET:
+  case RDM_CC_SET:
+    return SniffFrameKind::RDM_REQUEST;
+  case RDM_CC_DISCOVERY_RSP:
+  case RDM_CC_GET_RSP:
+  case RDM_CC_SET_RSP:
+    return SniffFrameKind::RDM_RESPONSE;
+  default:
+    return SniffFrameKind::INVALID;
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SniffPairer
+// ═══════════════════════════════════════════════════════════════════════════
+
+void SniffPairer::Reset() {
+  for (auto &p : m_pending)
+    p = Pending{};
+  for (auto &f : m_fixtures)
+    f = SniffFixtureStats{};
+  m_fixtureCount = 0;
+  m_fixturesDropped = 0;
+}
+
+SniffFixtureStats *SniffPairer::Fixture(uint64_t uid) {
+  if (uid == 0)
+    return nullptr;
+  size_t h = static_cast<size_t>((uid * 0x9E3779B97F4A7C15ULL) >> 32);
+  for (int probe = 0; probe < kFixtures; ++probe) {
+    SniffFixtureStats &f = m_fixtures[(h + probe) & (kFixtures - 1)];
+    if (f.uid == uid)
+      return &f;
+    if (f.uid == 0) {
+      if (m_fixtureCount >= kFixtures - 1)
+        break; // keep one hole so lookups terminate
+      f.uid = uid;
+      m_fixtureCount++;
+      return &f;
+    }
+  }
+  m_fixturesDropped++;
+  return nullptr;
+}
+
+void SniffPairer::Expire(int64_t nowUs) {
+  for (auto &p : m_pending) {
+    if (!p.used || nowUs - p.timestampUs <= m_expireUs)
+      continue;
+    // An empty discovery branch is normal; only count addressed requests
+    if (!p.discovery) {
+      if (SniffFixtureStats *f = Fixture(p.respUID))
+        f->unanswered++;
+    }
+    p.used = false;
+  }
+}
+
+void SniffPairer::Process(SniffRecord &rec) {
+  Expire(rec.timestampUs);
+
+  auto record = [&](uint64_t uid, int64_t requestTs) {
+    rec.turnaroundUs = rec.timestampUs - requestTs;
+    SniffFixtureStats *f = Fixture(uid);
+    if (!f)
+      return;
+    if (f->responses == 0 || rec.turnaroundUs < f->minTurnaroundUs)
+      f->minTurnaroundUs = rec.turnaroundUs;
+    if (rec.turnaroundUs > f->maxTurnaroundUs)
+      f->maxTurnaroundUs = rec.turnaroundUs;
+    f->sumTurnaroundUs += rec.turnaroundUs;
+    f->responses++;
+  };
+
+  switch (rec.kind) {
+  case SniffFrameKind::RDM_REQUEST: {
+    bool dub = rec.commandClass == RDM_CC_DISCOVERY &&
+               rec.pid == PID_DISC_UNIQUE_BRANCH;
+    if (!dub && IsBroadcastUID(rec.destUID))
+      return;
+
+    // Free slot, or evict the oldest (counted as unanswered)
+    Pending *slot = nullptr;
+    for (auto &p : m_pending) {
+      if (!p.used) {
+        slot = &p;
+        break;
+      }
+      if (!slot || p.timestampUs < slot->timestampUs)
+        slot = &p;
+    }
+    if (slot->used && !slot->discovery) {
+      if (SniffFixtureStats *f = Fixture(slot->respUID))
+        f->unanswered++;
+    }
+    slot->used = true;
+    slot->discovery = dub;
+    slot->ctrlUID = rec.srcUID;
+    slot->respUID = rec.destUID;
+    slot->transNum = rec.transNum;
+    slot->timestampUs = rec.timestampUs;
+    break;
+  }
+  case SniffFrameKind::RDM_RESPONSE:
+    for (auto &p : m_pending) {
+      if (p.used && !p.discovery && p.ctrlUID == rec.destUID &&
+          p.respUID == rec.srcUID && p.transNum == rec.transNum) {
+        record(rec.srcUID, p.timestampUs);
+        p.used = false;
+        break;
+      }
+    }
+    break;
+  case SniffFrameKind::DUB_RESPONSE: {
+    Pending *latest = nullptr;
+    for (auto &p : m_pending) {
+      if (p.used && p.discovery &&
+          (!latest || p.timestampUs > latest->timestampUs))
+        latest = &p;
+    }
+    if (latest) {
+      record(rec.srcUID, latest->timestampUs);
+      latest->used = false;
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+int SniffPairer::GetFixtureStats(SniffFixtureStats *out, int max) const {
+  int n = 0;
+  for (const auto &f : m_fixtures) {
+    if (n >= max)
+      break;
+    if (f.uid != 0)
+      out[n++] = f;
+  }
+  return n;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RdmSniffer
+// ═══════════════════════════════════════════════════════════════════════════
+
+RdmSniffer::RdmSniffer()
+    : m_raw(new RawRing), m_records(new RecordRing) {}
+
+RdmSniffer::~RdmSniffer() { Stop(); }
+
+bool RdmSniffer::Start(EnttecPro &pro) {
+  Stop();
+  if (!pro.IsOpen() || !pro.SetReceiveMode(false))
+    return false;
+  // Leave send-always mode on stop, or the widget keeps streaming frames
+  // into the buffer the next RDM reply is read from
+  m_onStop = [&pro] {
+    pro.SetReceiveMode(true);
+    pro.Purge();
+  };
+  // The widget forwards every received packet as Label 5; it only reports
+  // queue overflow / overrun, not whether a break preceded the frame.
+  return StartThreads([&pro](uint8_t *buf, int max, uint8_t &flags) {
+    uint8_t st = 0;
+    int n = pro.ReceiveDMX(buf, max, st);
+    flags = (st & 0x03) ? SNIFF_FLAG_ERROR : 0;
+    return n;
+  });
+}
+
+bool RdmSniffer::Start(PeperoniRodin &pro) {
+  Stop();
+  if (!pro.IsOpen())
+    return false;
+  m_onStop = nullptr;
+  return StartThreads([&pro](uint8_t *buf, int max, uint8_t &flags) {
+    uint8_t st = 0;
+    int n = pro.ReceiveFrame(buf, max, 100e-3f, st);
+    flags = 0;
+    if (st & 0x40)
+      flags |= SNIFF_FLAG_NO_BREAK;
+    if (st & 0x80)
+      flags |= SNIFF_FLAG_ERROR;
+    return n;
+  });
+}
+
+template <typename CaptureFn> bool RdmSniffer::StartThreads(CaptureFn capture) {
+  // Drain leftovers from a previous session
+  RawFrame rf;
+  while (m_raw->Pop(rf)) {
+  }
+  SniffRecord rec;
+  while (m_records->Pop(rec)) {
+  }
+  {
+    std::lock_guard<std::mutex> lk(m_pairerMutex);
+    m_pairer.Reset();
+  }
+  m_framesCaptured = 0;
+  m_dmxFrames = 0;
+  m_framesDropped = 0;
+  m_recordsDropped = 0;
+  m_invalidFrames = 0;
+
+  m_running = true;
+  m_decodeThread = std::thread(&RdmSniffer::DecodeLoop, this);
+
+  // Capture thread: read straight into the ring slot; if the decoder has
+  // fallen behind, read into scratch and count the drop.
+  m_captureThread = std::thread([this, capture] {
+    RawFrame scratch;
+    while (m_running.load(std::memory_order_relaxed)) {
+      RawFrame *slot = m_raw->Reserve();
+      RawFrame *dst = slot ? slot : &scratch;
+      uint8_t flags = 0;
+      int n = capture(dst->data, static_cast<int>(sizeof(dst->data)), flags);
+      if (n <= 0)
+        continue;
+      dst->timestampUs = SteadyNowUs();
+      dst->len = static_cast<uint16_t>(n);
+      dst->flags = flags;
+      m_framesCaptured.fetch_add(1, std::memory_order_relaxed);
+      if (slot)
+        m_raw->Commit();
+      else
+        m_framesDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  return true;
+}
+
+void RdmSniffer::Stop() {
+  m_running = false;
+  if (m_captureThread.joinable())
+    m_captureThread.join();
+  if (m_decodeThread.joinable())
+    m_decodeThread.join();
+  if (m_onStop) {
+    m_onStop();
+    m_onStop = nullptr;
+  }
+}
+
+void RdmSniffer::DecodeLoop() {
+  RawFrame rf;
+  for (;;) {
+    if (!m_raw->Pop(rf)) {
+      if (!m_running.load(std::memory_order_relaxed))
+        break; // capture has stopped and the ring is drained
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+
+    SniffRecord rec;
+    rec.kind = ClassifySniffFrame(rf.data, rf.len, rf.flags);
+    rec.timestampUs = rf.timestampUs;
+    rec.frameLen = rf.len;
+
+    if (rec.kind == SniffFrameKind::RDM_REQUEST ||
+        rec.kind == SniffFrameKind::RDM_RESPONSE) {
+      rec.destUID = ReadUID(rf.data + 3);
+      rec.srcUID = ReadUID(rf.data + 9);
+      rec.transNum = rf.data[15];
+      rec.responseType = rf.data[16];
+      rec.commandClass = rf.data[20];
+      rec.pid = static_cast<uint16_t>((rf.data[21] << 8) | rf.data[22]);
+      rec.paramLen = rf.data[23];
+    } else if (rec.kind == SniffFrameKind::DUB_RESPONSE) {
+      DecodeDubResponse(rf.data, rf.len, &rec.srcUID);
+      rec.commandClass = RDM_CC_DISCOVERY_RSP;
+      rec.pid = PID_DISC_UNIQUE_BRANCH;
+    } else if (rec.kind == SniffFrameKind::INVALID) {
+      m_invalidFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(m_pairerMutex);
+      m_pairer.Process(rec);
+    }
+
+    // DMX frames are counted but not streamed — at 44 Hz they would bury
+    // the RDM traffic the reader is after.
+    if (rec.kind == SniffFrameKind::DMX) {
+      m_dmxFrames.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (!m_records->Push(rec))
+      m_recordsDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+int RdmSniffer::Read(SniffRecord *out, int max) {
+  int n = 0;
+  while (n < max && m_records->Pop(out[n]))
+    n++;
+  return n;
+}
+
+int RdmSniffer::GetFixtureStats(SniffFixtureStats *out, int max) const {
+  std::lock_guard<std::mutex> lk(m_pairerMutex);
+  return m_pairer.GetFixtureStats(out, max);
+}
+
+SnifferCounters RdmSniffer::GetCounters() const {
+  SnifferCounters c;
+  c.framesCaptured = m_framesCaptured.load();
+  c.dmxFrames = m_dmxFrames.load();
+  c.framesDropped = m_framesDropped.load();
+  c.recordsDropped = m_recordsDropped.load();
+  c.invalidFrames = m_invalidFrames.load();
+  {
+    std::lock_guard<std::mutex> lk(m_pairerMutex);
+    c.fixturesDropped = m_pairer.FixturesDropped();
+  }
+  return c;
+}
@@ -0,0 +1,167 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// RDM sniffer — passive bus capture, frame classification and
+// request/response pairing
+// ────────────────────────────────────────────────────────────────────────
+#ifndef RDM_SNIFFER_H
+#define RDM_SNIFFER_H
+
+#include "spsc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class EnttecPro;     // forward
+class PeperoniRodin; // forward
+
+// ── Frame classification ────────────────────────────────────────────────
+enum class SniffFrameKind : uint8_t {
+  DMX,          // start code 0x00
+  RDM_REQUEST,  // 0xCC, command class DISCOVERY / GET / SET
+  RDM_RESPONSE, // 0xCC, command class *_RESPONSE
+  DUB_RESPONSE, // preamble-encoded DISC_UNIQUE_BRANCH reply (no break)
+  ALT_START,    // any other start code
+  INVALID,      // bad length / checksum / truncated
+};
+
+// Capture flags reported by the driver receive path
+constexpr uint8_t SNIFF_FLAG_NO_BREAK = 0x01; // frame arrived without break
+constexpr uint8_t SNIFF_FLAG_ERROR = 0x02;    // framing error / overrun
+
+// Classifies one captured frame.  Pure function, no allocation.
+SniffFrameKind ClassifySniffFrame(const uint8_t *data, int len, uint8_t flags);
+
+// Decodes a DUB response (preamble, separator, 12 encoded UID bytes,
+// 4 encoded checksum bytes).  Returns false if the checksum does not match.
+bool DecodeDubResponse(const uint8_t *data, int len, uint64_t *uid);
+
+// ── Decoded record (one per captured frame) ─────────────────────────────
+struct SniffRecord {
+  SniffFrameKind kind = SniffFrameKind::INVALID;
+  int64_t timestampUs = 0; // capture time of the frame
+  uint64_t srcUID = 0;
+  uint64_t destUID = 0;
+  uint8_t transNum = 0;
+  uint8_t commandClass = 0;
+  uint8_t responseType = 0; // port ID for requests
+  uint8_t paramLen = 0;
+  uint16_t pid = 0;
+  uint16_t frameLen = 0;
+  int64_t turnaroundUs = -1; // response: time since its request, else -1
+};
+
+// Per-responder turnaround summary
+struct SniffFixtureStats {
+  uint64_t uid = 0;
+  uint32_t responses = 0;   // responses paired with a request
+  uint32_t unanswered = 0;  // requests that expired without a response
+  int64_t minTurnaroundUs = 0;
+  int64_t maxTurnaroundUs = 0;
+  int64_t sumTurnaroundUs = 0;
+};
+
+struct SnifferCounters {
+  uint64_t framesCaptured = 0;
+  uint64_t dmxFrames = 0;      // counted, not streamed as records
+  uint64_t framesDropped = 0;  // capture ring full
+  uint64_t recordsDropped = 0; // output ring full (reader too slow)
+  uint64_t invalidFrames = 0;
+  uint64_t fixturesDropped = 0; // fixture table full
+};
+
+// ── Transaction pairing (decoder-thread state, fixed memory) ────────────
+//    Requests wait in a small table keyed by (controller, responder,
+//    transaction number).  A response pairs with its request and yields a
+//    turnaround; requests older than `expireUs` are counted as unanswered.
+class SniffPairer {
+public:
+  static constexpr int kPending = 64;
+  static constexpr int kFixtures = 1024;
+
+  explicit SniffPairer(int64_t expireUs = 50000) : m_expireUs(expireUs) {}
+
+  // Fills rec.turnaroundUs for responses and updates fixture stats.
+  void Process(SniffRecord &rec);
+
+  // Copies up to `max` fixture summaries, returns the number written.
+  int GetFixtureStats(SniffFixtureStats *out, int max) const;
+  uint64_t FixturesDropped() const { return m_fixturesDropped; }
+  void Reset();
+
+private:
+  struct Pending {
+    bool used = false;
+    bool discovery = false; // DUB request: any DUB response pairs with it
+    uint64_t ctrlUID = 0;
+    uint64_t respUID = 0;
+    uint8_t transNum = 0;
+    int64_t timestampUs = 0;
+  };
+
+  void Expire(int64_t nowUs);
+  SniffFixtureStats *Fixture(uint64_t uid);
+
+  int64_t m_expireUs;
+  Pending m_pending[kPending];
+  SniffFixtureStats m_fixtures[kFixtures]; // open addressing, uid 0 = empty
+  int m_fixtureCount = 0;
+  uint64_t m_fixturesDropped = 0;
+};
+
+// ── Capture + decode pipeline ───────────────────────────────────────────
+//    Capture thread: driver RX -> raw frame ring (never blocks, drops when
+//    full).  Decoder thread: classify + pair -> record ring.  The API
+//    drains the record ring with Read().  Every buffer is fixed-size, so
+//    memory stays flat over any capture length.
+class RdmSniffer {
+public:
+  RdmSniffer();
+  ~RdmSniffer();
+
+  RdmSniffer(const RdmSniffer &) = delete;
+  RdmSniffer &operator=(const RdmSniffer &) = delete;
+
+  bool Start(EnttecPro &pro);
+  bool Start(PeperoniRodin &pro);
+  void Stop();
+  bool IsRunning() const { return m_running.load(); }
+
+  int Read(SniffRecord *out, int max);
+  int GetFixtureStats(SniffFixtureStats *out, int max) const;
+  SnifferCounters GetCounters() const;
+
+private:
+  struct RawFrame {
+    int64_t timestampUs;
+    uint16_t len;
+    uint8_t flags;
+    uint8_t data[515];
+  };
+  using RawRing = SpscRing<RawFrame, 1024>;
+  using RecordRing = SpscRing<SniffRecord, 4096>;
+
+  template <typename CaptureFn> bool StartThreads(CaptureFn capture);
+  void DecodeLoop();
+
+  std::unique_ptr<RawRing> m_raw;
+  std::unique_ptr<RecordRing> m_records;
+  SniffPairer m_pairer;
+  mutable std::mutex m_pairerMutex; // decoder vs. stats readers only
+
+  std::atomic<bool> m_running{false};
+  std::thread m_captureThread;
+  std::thread m_decodeThread;
+  std::function<void()> m_onStop;
+
+  std::atomic<uint64_t> m_framesCaptured{0};
+  std::atomic<uint64_t> m_dmxFrames{0};
+  std::atomic<uint64_t> m_framesDropped{0};
+  std::atomic<uint64_t> m_recordsDropped{0};
+  std::atomic<uint64_t> m_invalidFrames{0};
+};
+
+#endif // RDM_SNIFFER_H
@@ -0,0 +1,46 @@
+// ────────────────────────────────────────────────────────────────────────
+// RDM transaction timing — per-stage timestamps and latency breakdown
+// ────────────────────────────────────────────────────────────────────────
+#include "rdm_timing.h"
+
+#include <algorithm>
+#include <chrono>
+
+int64_t RdmNowUs() {
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+RdmTimingBreakdown ComputeTimingBreakdown(const RdmStageTimes &t) {
+  RdmTimingBreakdown b;
+  b.totalUs = std::max<int64_t>(0, t.parsedUs - t.submitUs);
+  b.usbWriteUs = std::max<int64_t>(0, t.writeDoneUs - t.submitUs);
+  b.wireUs = RdmWireUs(t.requestSlots);
+
+  if (t.firstRxUs > 0) {
+    b.wireUs += RdmWireUs(t.responseSlots);
+    b.hostUs = std::max<int64_t>(0, t.parsedUs - t.firstRxUs);
+
+    if (t.deviceTurnaroundUs >= 0) {
+      b.responderUs = t.deviceTurnaroundUs;
+      b.source = TurnaroundSource::DEVICE;
+      b.resolutionUs = t.deviceResolutionUs;
+    } else {
+      // Everything between the end of the write and the first byte on the
+      // host, less the two frames on the line.  Still contains the
+      // interface's USB latency, so it is an upper bound.
+      b.responderUs =
+          std::max<int64_t>(0, t.firstRxUs - t.writeDoneUs - b.wireUs);
+      b.source = TurnaroundSource::HOST_ESTIMATE;
+    }
+  }
+
+  // Whatever remains is USB / interface latency.  Clamp the wire time
+  // first: hardware turnaround is coarse, stages may overlap slightly.
+  int64_t responder = std::max<int64_t>(0, b.responderUs);
+  int64_t attributed = b.usbWriteUs + b.hostUs + responder;
+  b.wireUs = std::min(b.wireUs, std::max<int64_t>(0, b.totalUs - attributed));
+  b.overheadUs = std::max<int64_t>(0, b.totalUs - attributed - b.wireUs);
+  return b;
+}
@@ -0,0 +1,52 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// RDM transaction timing — per-stage timestamps and latency breakdown
+// ────────────────────────────────────────────────────────────────────────
+#ifndef RDM_TIMING_H
+#define RDM_TIMING_H
+
+#include <cstdint>
+
+// Where the responder turnaround figure came from
+enum class TurnaroundSource : uint8_t {
+  NONE,          // no response
+  HOST_ESTIMATE, // host timestamps minus wire time (upper bound)
+  DEVICE,        // interface hardware timestamps
+};
+
+// Host microsecond clock (monotonic; only differences are meaningful)
+int64_t RdmNowUs();
+
+// Time an RDM frame occupies the line at 250 kbit/s: break (176 us) +
+// MAB (12 us) + 44 us per slot.  `slots` includes the start code.
+constexpr int64_t RdmWireUs(int slots) {
+  return slots > 0 ? 176 + 12 + 44LL * slots : 0;
+}
+
+// Raw timestamps of one transaction, filled in as it progresses
+struct RdmStageTimes {
+  int64_t submitUs = 0;    // request handed to the driver
+  int64_t writeDoneUs = 0; // driver returned from the USB write
+  int64_t firstRxUs = 0;   // response first visible to the host; 0 = none
+  int64_t parsedUs = 0;    // response decoded
+  int requestSlots = 0;    // incl. start code
+  int responseSlots = 0;
+  int64_t deviceTurnaroundUs = -1; // from the interface, -1 = not available
+  int deviceResolutionUs = 0;      // granularity of deviceTurnaroundUs
+};
+
+// Where the time of one transaction went.  The stages add up to totalUs.
+struct RdmTimingBreakdown {
+  int64_t totalUs = 0;        // submit -> parse complete
+  int64_t usbWriteUs = 0;     // submit -> USB write complete
+  int64_t wireUs = 0;         // request + response frames on the line
+  int64_t responderUs = -1;   // responder turnaround, -1 = no response
+  int64_t hostUs = 0;         // first RX -> parse complete
+  int64_t overheadUs = 0;     // USB / interface latency not attributed above
+  TurnaroundSource source = TurnaroundSource::NONE;
+  int resolutionUs = 0;       // granularity of responderUs (0 = host clock)
+};
+
+RdmTimingBreakdown ComputeTimingBreakdown(const RdmStageTimes &t);
+
+#endif // RDM_TIMING_H
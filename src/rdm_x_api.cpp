@@ -3,30 +3,105 @@
 // ────────────────────────────────────────────────────────────────────────
 #define WIN32_LEAN_AND_MEAN
 #include "rdm_x_api.h"
+#include "address_plan.h"
+#include "broadcast_set.h"
+#include "capture_file.h"
+#include "config_push.h"
+#include "descriptor_cache.h"
+#include "device_profile.h"
+#include "dmx_input.h"
 #include "enttec_pro.h"
+#include "fixture_locator.h"
+#include "fleet_validator.h"
+#include "latency_stats.h"
+#include "metrics.h"
+#include "mpsc_ring.h"
 #include "parameter_loader.h"
 #include "peperoni_rodin.h"
+#include "perf_trace.h"
 #include "rdm.h"
+#include "replay_driver.h"
+#include "responder_sim.h"
+#include "rdm_sniffer.h"
+#include "rdm_timing.h"
+#include "result_store.h"
+#include "snapshot_cache.h"
+#include "trace_ring.h"
+#include "validation_planner.h"
 #include "validator.h"
 #include <windows.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 // ── Globals ─────────────────────────────────────────────────────────────
 static EnttecPro g_enttec;
 static PeperoniRodin g_peperoni;
+static ReplayDriver g_replay;
+static ResponderSim g_sim;
+static DmxInputMonitor g_dmxInput;
+static RdmSniffer g_sniffer;
+static LatencyRecorder g_latency;
+static FleetValidator g_fleet;
 static int g_driverType = RDX_DRIVER_ENTTEC;
 static std::vector<RDMParameter> g_params;
+static std::vector<RDMParameterRow> g_mapRows; // same file, every row
+// Last sweep of each CK fixture, kept across runs and reconnects
+static SnapshotCache g_snapshots;
+// Descriptor responses per model, shared by every port
+static DescriptorCache g_descriptors;
 static std::vector<uint64_t> g_discoveredUIDs;
+static std::vector<uint64_t> g_simUIDs; // all simulated fixtures
+static int g_simPorts = 1;
+
+// Prometheus file writer (RDX_StartMetricsDump)
+static std::thread g_metricsThread;
+static std::mutex g_metricsMutex;
+static std::condition_variable g_metricsCv;
+static bool g_metricsStop = false;
+
+// Logical buses ("ports").  Enttec has one; a multi-universe Peperoni has
+// one per universe.  Port 0 is always the main driver object; further
+// Peperoni universes get their own PeperoniRodin (own handle, mutex, RDM
+// transaction state) so they can be driven from separate threads.  The
+// simulator likewise gives every further port its own ResponderSim.
+struct PortState {
+  std::unique_ptr<PeperoniRodin> peperoni; // universes >= 1
+  std::unique_ptr<ResponderSim> sim;       // simulated ports >= 1
+  std::vector<uint64_t> discovered;
+  std::mutex mutex; // guards discovered
+};
+static std::vector<std::unique_ptr<PortState>> g_ports;
 static std::string g_fwString;
-static LARGE_INTEGER g_perfFreq;
-static LARGE_INTEGER g_dllLoadTime;
+
+// Runs `fn` on the selected driver object
+template <typename Fn> static auto OnDriver(Fn fn) {
+  if (g_driverType == RDX_DRIVER_PEPERONI)
+    return fn(g_peperoni);
+  if (g_driverType == RDX_DRIVER_REPLAY)
+    return fn(g_replay);
+  if (g_driverType == RDX_DRIVER_SIM)
+    return fn(g_sim);
+  return fn(g_enttec);
+}
 
 // Source UID for RDM commands
 static uint64_t GetControllerUID() {
+  if (g_driverType == RDX_DRIVER_REPLAY)
+    return g_replay.ControllerUID(); // as recorded, so requests match
+  if (g_driverType == RDX_DRIVER_SIM)
+    return (0x7FF0ULL << 32) | g_sim.GetSerialNumber(); // prototype range
   if (g_driverType == RDX_DRIVER_PEPERONI) {
     uint32_t sn = g_peperoni.GetSerialNumber();
     return (0x7065ULL << 32) | sn;
@@ -35,35 +110,117 @@ static uint64_t GetControllerUID() {
   return (0x454EULL << 32) | sn;
 }
 
-// ── Timing helpers ──────────────────────────────────────────────────
-#include <cstdarg>
-static int64_t NowUs() {
-  LARGE_INTEGER now;
-  QueryPerformanceCounter(&now);
-  return (now.QuadPart - g_dllLoadTime.QuadPart) * 1000000LL /
-         g_perfFreq.QuadPart;
+// DMX input and the sniffer own the receive path; a fleet run owns every
+// port.  Nothing else may put a request on the line meanwhile.
+static bool BusBusy() {
+  return g_dmxInput.IsRunning() || g_sniffer.IsRunning() ||
+         g_fleet.IsRunning();
+}
+
+// ── Trace dispatcher ────────────────────────────────────────────────
+//    Consumer side of GlobalTracer(): formats events and hands them to
+//    OutputDebugString / the user callback on its own thread, so neither
+//    the formatting nor the callback runs on an I/O thread.
+static std::atomic<RDX_LogCallback> g_logCb{nullptr};
+static std::atomic<bool> g_traceRunning{false};
+static std::mutex g_traceMutex; // start / stop
+static std::thread g_traceThread;
+static int64_t g_traceEpochUs; // RdmNowUs() at DLL load
+
+static void DeliverTrace(const TraceEvent &e) {
+  std::string text = Tracer::Format(e);
+  if (e.kind == TraceKind::TEXT)
+    OutputDebugStringA(text.c_str());
+  RDX_LogCallback cb = g_logCb.load();
+  if (cb)
+    cb(e.kind == TraceKind::FRAME_TX, text.c_str(),
+       e.timestampUs - g_traceEpochUs);
+}
+
+static void TraceDispatchLoop() {
+  while (g_traceRunning.load()) {
+    if (GlobalTracer().Drain(DeliverTrace, 256) == 0)
+      Sleep(1);
+  }
+}
+
+// Started by the first Open or log setting; events recorded before that
+// wait in the ring.  RDX_Shutdown() stops and joins it.
+static void StartTraceDispatcher() {
+  std::lock_guard<std::mutex> lk(g_traceMutex);
+  if (g_traceThread.joinable())
+    return;
+  g_traceRunning = true;
+  g_traceThread = std::thread(TraceDispatchLoop);
+}
+
+static void StopTraceDispatcher() {
+  std::lock_guard<std::mutex> lk(g_traceMutex);
+  g_traceRunning = false;
+  if (g_traceThread.joinable())
+    g_traceThread.join();
+  GlobalTracer().Drain(DeliverTrace); // what was left in the ring
+}
+
+// ── Frame hooks ─────────────────────────────────────────────────────
+//    The driver frame callbacks feed both the log and the capture file.
+//    They are installed once (std::function is not safe to swap while an
+//    I/O thread may call it) and check per frame what is active.  Until
+//    then the drivers skip building the frame copies entirely.
+//    The writer is never destroyed: its destructor would join the writer
+//    thread during DLL unload, under the loader lock.  A capture still
+//    open at exit has no footer, which the reader handles.
+static CaptureWriter &Capture() {
+  static CaptureWriter *writer = new CaptureWriter();
+  return *writer;
+}
+static bool g_frameHooks = false; // API thread only
+
+static void CaptureFrame(int port, bool tx, uint8_t label,
+                         const uint8_t *data, int len) {
+  Capture().Append(RdmNowUs(), tx ? CaptureDirection::TX : CaptureDirection::RX,
+                   static_cast<uint8_t>(port), label, 0, data, len);
 }
 
-// Forward declaration of log callback (defined at bottom of file)
-static RDX_LogCallback g_logCb;
+// Enttec frames are whole widget messages: 7E | label | len | data | E7
+static void InstallFrameHooks(EnttecPro &bus) {
+  bus.SetLogCallback([&bus](bool tx, const uint8_t *data, int len) {
+    if (Capture().IsOpen() && len >= PRO_HEADER_LENGTH + 1)
+      CaptureFrame(bus.MetricsPort(), tx, data[1], data + PRO_HEADER_LENGTH,
+                   len - PRO_HEADER_LENGTH - 1);
+    if (!g_logCb.load())
+      return;
+    if (tx && len >= 2 && data[1] == LABEL_TX_DMX)
+      return; // DMX output (Label 6), sent every frame
+    TRACE_FRAME(tx, data, len);
+  });
+}
 
-// Debug helper — routes through OutputDebugString + log callback
-static void DiscLog(const char *fmt, ...) {
-  char buf[512];
-  va_list ap;
-  va_start(ap, fmt);
-  vsnprintf(buf, sizeof(buf), fmt, ap);
-  va_end(ap);
-  OutputDebugStringA(buf);
-  if (g_logCb)
-    g_logCb(false, buf, NowUs());
+// Peperoni frames are the raw line slots, start code first
+static void InstallFrameHooks(PeperoniRodin &bus) {
+  bus.SetLogCallback([&bus](bool tx, const uint8_t *data, int len) {
+    if (Capture().IsOpen())
+      CaptureFrame(bus.MetricsPort(), tx, CAPTURE_LABEL_RAW, data, len);
+    if (g_logCb.load())
+      TRACE_FRAME(tx, data, len);
+  });
 }
 
 // ── DLL Entry Point ─────────────────────────────────────────────────────
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID lpReserved) {
-  if (reason == DLL_PROCESS_ATTACH) {
-    QueryPerformanceFrequency(&g_perfFreq);
-    QueryPerformanceCounter(&g_dllLoadTime);
+  if (reason == DLL_PROCESS_ATTACH)
+    g_traceEpochUs = RdmNowUs();
+  else if (reason == DLL_PROCESS_DETACH) {
+    // At process exit the threads are already gone.  On FreeLibrary
+    // without RDX_Shutdown() they are still running: never join under the
+    // loader lock; signal and let them exit.
+    g_traceRunning = false;
+    if (g_traceThread.joinable())
+      g_traceThread.detach();
+    g_metricsStop = true;
+    g_metricsCv.notify_all();
+    if (g_metricsThread.joinable())
+      g_metricsThread.detach();
   }
   return TRUE;
 }
@@ -82,6 +239,10 @@ RDX_API const char *RDX_GetDriverName(int driverType) {
     return "Enttec USB DMX PRO";
   case RDX_DRIVER_PEPERONI:
     return "Peperoni Rodin 1";
+  case RDX_DRIVER_REPLAY:
+    return "Capture replay";
+  case RDX_DRIVER_SIM:
+    return "Responder simulator";
   default:
     return "Unknown";
   }
@@ -97,37 +258,128 @@ RDX_API int RDX_ListDevices() {
   return EnttecPro::ListDevices();
 }
 
-RDX_API bool RDX_Open(int deviceIndex) {
+RDX_API int RDX_RefreshDevices() {
   if (g_driverType == RDX_DRIVER_PEPERONI)
-    return g_peperoni.Open(deviceIndex);
-  return g_enttec.Open(deviceIndex);
+    return g_peperoni.ListDevices(true);
+  return EnttecPro::ListDevices();
 }
 
-RDX_API void RDX_Close() {
+RDX_API bool RDX_GetDeviceSerial(int listIndex, char *serial, int maxLen) {
+  if (g_driverType != RDX_DRIVER_PEPERONI || !serial || maxLen <= 0)
+    return false;
+  PeperoniDeviceInfo info;
+  if (!g_peperoni.GetDeviceInfo(listIndex, info))
+    return false;
+  strncpy(serial, info.serial.c_str(), maxLen - 1);
+  serial[maxLen - 1] = '\0';
+  return true;
+}
+
+static void ClosePorts() {
+  g_fleet.Clear(); // its workers hold references to the port drivers
+  for (auto &p : g_ports) {
+    if (p->peperoni)
+      p->peperoni->Close();
+    if (p->sim)
+      p->sim->Close();
+  }
+  g_ports.clear();
+}
+
+// Simulated fixtures are dealt round-robin across the simulated ports
+static std::vector<uint64_t> SimPortUIDs(int port) {
+  std::vector<uint64_t> uids;
+  for (size_t i = port; i < g_simUIDs.size(); i += g_simPorts)
+    uids.push_back(g_simUIDs[i]);
+  return uids;
+}
+
+// Port 0 is the main driver; every further Peperoni universe is opened as
+// its own PeperoniRodin on the same device.
+static void OpenPorts() {
+  StartTraceDispatcher();
+  ClosePorts();
+  int count = 1;
+  if (g_driverType == RDX_DRIVER_PEPERONI)
+    count = g_peperoni.ProbeUniverseCount();
+  else if (g_driverType == RDX_DRIVER_SIM)
+    count = g_simPorts;
+  for (int u = 0; u < count; ++u) {
+    auto port = std::make_unique<PortState>();
+    if (u > 0 && g_driverType == RDX_DRIVER_SIM) {
+      port->sim = std::make_unique<ResponderSim>();
+      port->sim->SetMetricsPort(u);
+      port->sim->Open(g_sim.Model(), SimPortUIDs(u));
+    } else if (u > 0) {
+      port->peperoni = std::make_unique<PeperoniRodin>();
+      port->peperoni->SetMetricsPort(u);
+      if (g_frameHooks)
+        InstallFrameHooks(*port->peperoni);
+      if (!port->peperoni->OpenDevice(g_peperoni.GetDeviceIndex(), u))
+        break;
+    }
+    g_ports.push_back(std::move(port));
+  }
+  TRACE_DEBUG("[RDX] %d port(s) available\n", (int)g_ports.size());
+}
+
+static void InstallAllFrameHooks() {
+  if (g_frameHooks)
+    return;
+  g_frameHooks = true;
+  InstallFrameHooks(g_enttec);
+  InstallFrameHooks(g_peperoni);
+  for (auto &p : g_ports)
+    if (p->peperoni)
+      InstallFrameHooks(*p->peperoni);
+}
+
+RDX_API bool RDX_Open(int listIndex) {
+  bool ok;
+  if (g_driverType == RDX_DRIVER_REPLAY || g_driverType == RDX_DRIVER_SIM)
+    return false; // RDX_OpenReplay / RDX_OpenSimulator
   if (g_driverType == RDX_DRIVER_PEPERONI)
-    g_peperoni.Close();
+    ok = g_peperoni.Open(listIndex);
   else
-    g_enttec.Close();
+    ok = g_enttec.Open(listIndex);
+  if (ok)
+    OpenPorts();
+  return ok;
+}
+
+RDX_API bool RDX_OpenBySerial(const char *serial) {
+  if (g_driverType != RDX_DRIVER_PEPERONI || !serial)
+    return false;
+  if (!g_peperoni.OpenBySerial(serial))
+    return false;
+  OpenPorts();
+  return true;
+}
+
+RDX_API void RDX_Close() {
+  g_dmxInput.Stop();
+  g_sniffer.Stop();
+  ClosePorts();
+  OnDriver([](auto &bus) { bus.Close(); });
+}
+
+RDX_API void RDX_Shutdown() {
+  RDX_Close();
+  RDX_StopMetricsDump();
+  StopTraceDispatcher();
 }
 
 RDX_API bool RDX_IsOpen() {
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    return g_peperoni.IsOpen();
-  return g_enttec.IsOpen();
+  return OnDriver([](auto &bus) { return bus.IsOpen(); });
 }
 
 RDX_API const char *RDX_FirmwareString() {
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    g_fwString = g_peperoni.GetFirmwareString();
-  else
-    g_fwString = g_enttec.GetFirmwareString();
+  g_fwString = OnDriver([](auto &bus) { return bus.GetFirmwareString(); });
   return g_fwString.c_str();
 }
 
 RDX_API uint32_t RDX_SerialNumber() {
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    return g_peperoni.GetSerialNumber();
-  return g_enttec.GetSerialNumber();
+  return OnDriver([](auto &bus) { return bus.GetSerialNumber(); });
 }
 
 // ═══════════════════════════════════════════════════════════════════════
@@ -135,9 +387,117 @@ RDX_API uint32_t RDX_SerialNumber() {
 // ═══════════════════════════════════════════════════════════════════════
 
 RDX_API bool RDX_SendDMX(const uint8_t *data, int len) {
+  PERF_SCOPE_ARG("dmx", "SendDMX", "slots", len);
+  return OnDriver([&](auto &bus) { return bus.SendDMX(data, len); });
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// DMX input
+// ═══════════════════════════════════════════════════════════════════════
+
+RDX_API bool RDX_StartDmxInput() {
+  if (g_driverType != RDX_DRIVER_ENTTEC || !g_enttec.IsOpen())
+    return false;
+  if (g_sniffer.IsRunning() || g_fleet.IsRunning())
+    return false; // both own the widget's receive path
+  return g_dmxInput.Start(g_enttec);
+}
+
+RDX_API void RDX_StopDmxInput() { g_dmxInput.Stop(); }
+
+RDX_API bool RDX_IsDmxInputRunning() { return g_dmxInput.IsRunning(); }
+
+RDX_API int RDX_GetDmxInput(uint8_t *slots, int maxLen, uint8_t *changedBits,
+                            uint64_t *frameNum) {
+  uint64_t since = frameNum ? *frameNum : 0;
+  return g_dmxInput.Buffer().Snapshot(slots, maxLen, changedBits, since,
+                                      frameNum);
+}
+
+RDX_API bool RDX_GetDmxInputStats(RDX_DmxInputStats *stats) {
+  if (!stats)
+    return false;
+  DmxInputStats st = g_dmxInput.Buffer().GetStats();
+  stats->frames = st.frames;
+  stats->errorFrames = st.errorFrames;
+  stats->slotCount = st.slotCount;
+  stats->startCode = st.startCode;
+  stats->refreshHz = st.refreshHz;
+  stats->intervalUs = st.intervalUs;
+  stats->jitterUs = st.jitterUs;
+  stats->minIntervalUs = st.minIntervalUs;
+  stats->maxIntervalUs = st.maxIntervalUs;
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Sniffer
+// ═══════════════════════════════════════════════════════════════════════
+
+RDX_API bool RDX_StartSniffer() {
+  if (g_dmxInput.IsRunning() || g_fleet.IsRunning())
+    return false;
   if (g_driverType == RDX_DRIVER_PEPERONI)
-    return g_peperoni.SendDMX(data, len);
-  return g_enttec.SendDMX(data, len);
+    return g_sniffer.Start(g_peperoni);
+  return g_sniffer.Start(g_enttec);
+}
+
+RDX_API void RDX_StopSniffer() { g_sniffer.Stop(); }
+
+RDX_API bool RDX_IsSnifferRunning() { return g_sniffer.IsRunning(); }
+
+RDX_API int RDX_ReadSniffRecords(RDX_SniffRecord *out, int maxRecords) {
+  if (!out || maxRecords <= 0)
+    return 0;
+  int n = 0;
+  SniffRecord rec;
+  while (n < maxRecords && g_sniffer.Read(&rec, 1) == 1) {
+    RDX_SniffRecord &r = out[n++];
+    r.kind = static_cast<int>(rec.kind);
+    r.timestampUs = rec.timestampUs;
+    r.srcUID = rec.srcUID;
+    r.destUID = rec.destUID;
+    r.transNum = rec.transNum;
+    r.commandClass = rec.commandClass;
+    r.responseType = rec.responseType;
+    r.pid = rec.pid;
+    r.paramLen = rec.paramLen;
+    r.frameLen = rec.frameLen;
+    r.turnaroundUs = rec.turnaroundUs;
+  }
+  return n;
+}
+
+RDX_API int RDX_GetSniffFixtureStats(RDX_SniffFixtureStats *out,
+                                     int maxFixtures) {
+  if (!out || maxFixtures <= 0)
+    return 0;
+  std::vector<SniffFixtureStats> stats(maxFixtures);
+  int n = g_sniffer.GetFixtureStats(stats.data(), maxFixtures);
+  for (int i = 0; i < n; ++i) {
+    const auto &f = stats[i];
+    out[i].uid = f.uid;
+    out[i].responses = f.responses;
+    out[i].unanswered = f.unanswered;
+    out[i].minTurnaroundUs = f.minTurnaroundUs;
+    out[i].maxTurnaroundUs = f.maxTurnaroundUs;
+    out[i].meanTurnaroundUs =
+        f.responses ? f.sumTurnaroundUs / f.responses : 0;
+  }
+  return n;
+}
+
+RDX_API bool RDX_GetSnifferCounters(RDX_SnifferCounters *counters) {
+  if (!counters)
+    return false;
+  SnifferCounters c = g_sniffer.GetCounters();
+  counters->framesCaptured = c.framesCaptured;
+  counters->dmxFrames = c.dmxFrames;
+  counters->framesDropped = c.framesDropped;
+  counters->recordsDropped = c.recordsDropped;
+  counters->invalidFrames = c.invalidFrames;
+  counters->fixturesDropped = c.fixturesDropped;
+  return true;
 }
 
 // ═══════════════════════════════════════════════════════════════════════
@@ -145,10 +505,12 @@ RDX_API bool RDX_SendDMX(const uint8_t *data, int len) {
 // ═══════════════════════════════════════════════════════════════════════
 
 RDX_API int RDX_Discover() {
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    g_discoveredUIDs = RDMDiscovery(g_peperoni, GetControllerUID());
-  else
-    g_discoveredUIDs = RDMDiscovery(g_enttec, GetControllerUID());
+  if (BusBusy())
+    return 0;
+  PERF_SCOPE("api", "RDX_Discover");
+  uint64_t srcUID = GetControllerUID();
+  g_discoveredUIDs =
+      OnDriver([srcUID](auto &bus) { return RDMDiscovery(bus, srcUID); });
   return static_cast<int>(g_discoveredUIDs.size());
 }
 
@@ -164,95 +526,147 @@ RDX_API bool RDX_GetDiscoveredUID(int index, uint64_t *uid) {
 // RDM Commands with timing
 // ═══════════════════════════════════════════════════════════════════════
 
-static uint8_t s_transNum = 0;
+static void ParseCommandResponse(const uint8_t *rxBuf, int rxLen,
+                                 RDX_Response *out);
 
-static bool SendRDMCommand(uint64_t destUID, uint16_t pid, uint8_t commandClass,
-                           const uint8_t *paramData, int paramLen,
-                           RDX_Response *out) {
-  if (!out)
-    return false;
-  memset(out, 0, sizeof(RDX_Response));
+// Per-driver response wait + stage timestamps.  Enttec: poll for the first
+// byte of the Label 5 reply (was a fixed 50 ms sleep).  Peperoni: the
+// exchange already happened inside SendRDM; take its host and hardware
+// timestamps.
+static void WaitForResponse(EnttecPro &bus, RdmStageTimes &st) {
+  if (bus.WaitForData(50))
+    st.firstRxUs = RdmNowUs();
+}
+static void WaitForResponse(PeperoniRodin &bus, RdmStageTimes &st) {
+  PepRdmTiming t = bus.GetLastRdmTiming();
+  st.writeDoneUs = t.txReturnUs;
+  if (t.hasResponse) {
+    st.firstRxUs = t.rxReturnUs;
+    st.deviceTurnaroundUs = t.turnaroundMs * 1000LL;
+    st.deviceResolutionUs = 1000; // vusbdmx timestamps are milliseconds
+  }
+}
+static void WaitForResponse(ReplayDriver &bus, RdmStageTimes &st) {
+  if (bus.WaitForData(0))
+    st.firstRxUs = RdmNowUs();
+}
+static void WaitForResponse(ResponderSim &bus, RdmStageTimes &st) {
+  if (bus.WaitForData(0))
+    st.firstRxUs = RdmNowUs();
+}
+
+static void FillTiming(const RdmStageTimes &st, RDX_Response *out) {
+  RdmTimingBreakdown b = ComputeTimingBreakdown(st);
+  out->latencyUs = b.totalUs;
+  out->timing.totalUs = b.totalUs;
+  out->timing.usbWriteUs = b.usbWriteUs;
+  out->timing.wireUs = b.wireUs;
+  out->timing.responderUs = b.responderUs;
+  out->timing.hostUs = b.hostUs;
+  out->timing.overheadUs = b.overheadUs;
+  out->timing.responderSource = static_cast<int>(b.source);
+  out->timing.resolutionUs = b.resolutionUs;
+}
 
-  bool devOpen = (g_driverType == RDX_DRIVER_PEPERONI) ? g_peperoni.IsOpen()
-                                                       : g_enttec.IsOpen();
-  if (!devOpen) {
+static void CountOutcome(int port, int status) {
+  MetricsRegistry &m = GlobalMetrics();
+  switch (status) {
+  case RDX_STATUS_NACK:
+    m.Add(port, Metric::RDM_NACKS);
+    m.Add(port, Metric::RDM_RESPONSES);
+    break;
+  case RDX_STATUS_ACK:
+  case RDX_STATUS_ACK_TIMER:
+    m.Add(port, Metric::RDM_RESPONSES);
+    break;
+  case RDX_STATUS_TIMEOUT:
+    m.Add(port, Metric::RDM_TIMEOUTS);
+    break;
+  case RDX_STATUS_CHECKSUM_ERR:
+    m.Add(port, Metric::CHECKSUM_ERRORS);
+    break;
+  default:
+    m.Add(port, Metric::INVALID_RESPONSES);
+    break;
+  }
+}
+
+template <typename Driver>
+static bool SendRDMCommandOn(Driver &bus, uint64_t destUID, uint16_t pid,
+                             uint8_t commandClass, const uint8_t *paramData,
+                             int paramLen, RDX_Response *out) {
+  if (!bus.IsOpen()) {
     out->status = RDX_STATUS_TIMEOUT;
-    DiscLog("[RDM CMD] ERROR: device not open\n");
+    TRACE_ERROR("[RDM CMD] ERROR: device not open\n");
     return false;
   }
 
+  PERF_SCOPE_ARG("rdm", commandClass == 0x20 ? "GET" : "SET", "pid", pid);
+
   // Build the RDM packet
-  auto pkt = BuildRDMPacket(destUID, GetControllerUID(), s_transNum++, 1, 0, 0,
-                            commandClass, pid, paramData,
+  auto pkt = BuildRDMPacket(destUID, GetControllerUID(), bus.NextTransNum(),
+                            1, 0, 0, commandClass, pid, paramData,
                             static_cast<uint8_t>(paramLen));
 
-  DiscLog("[RDM CMD] Sending %s PID 0x%04X to %04X:%08X (%d bytes)\n",
-          commandClass == 0x20 ? "GET" : "SET", pid,
-          (unsigned)((destUID >> 32) & 0xFFFF),
-          (unsigned)(destUID & 0xFFFFFFFF), (int)pkt.size());
+  TRACE_DEBUG("[RDM CMD] Sending %s PID 0x%04X to %04X:%08X (%d bytes)\n",
+              commandClass == 0x20 ? "GET" : "SET", pid, TRACE_UID(destUID),
+              (int)pkt.size());
 
   // ── Quiet period: purge RX buffer (via mutex-guarded Purge) ──
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    g_peperoni.Purge();
-  else
-    g_enttec.Purge();
-  Sleep(20);
+  bus.Purge();
+  PERF_SLEEP(20);
 
-  // Measure TX→RX latency with high-precision timer
-  LARGE_INTEGER txTime, rxTime;
-  QueryPerformanceCounter(&txTime);
+  // Per-stage timestamps: submit -> write done -> first RX -> parsed
+  RdmStageTimes st;
+  st.requestSlots = static_cast<int>(pkt.size());
+  st.submitUs = RdmNowUs();
 
-  // Send via the active driver
-  bool sendOk;
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    sendOk = g_peperoni.SendRDM(pkt.data(), static_cast<int>(pkt.size()));
-  else
-    sendOk = g_enttec.SendRDM(pkt.data(), static_cast<int>(pkt.size()));
-
-  if (!sendOk) {
+  if (!bus.SendRDM(pkt.data(), static_cast<int>(pkt.size()))) {
     out->status = RDX_STATUS_TIMEOUT;
-    DiscLog("[RDM CMD] SendRDM FAILED\n");
+    TRACE_ERROR("[RDM CMD] SendRDM FAILED\n");
     return false;
   }
+  st.writeDoneUs = RdmNowUs();
 
-  DiscLog("[RDM CMD] Sent, waiting for Label 5 response...\n");
+  TRACE_DEBUG("[RDM CMD] Sent, waiting for Label 5 response...\n");
 
-  // Wait for widget to process (shorter for Peperoni since it blocks)
-  if (g_driverType != RDX_DRIVER_PEPERONI)
-    Sleep(50);
+  WaitForResponse(bus, st);
 
   // Read response
   uint8_t rxBuf[512];
   uint8_t statusByte = 0;
-  int rxLen;
-  if (g_driverType == RDX_DRIVER_PEPERONI)
-    rxLen = g_peperoni.ReceiveRDM(rxBuf, sizeof(rxBuf), statusByte);
-  else
-    rxLen = g_enttec.ReceiveRDM(rxBuf, sizeof(rxBuf), statusByte);
+  int rxLen = bus.ReceiveRDM(rxBuf, sizeof(rxBuf), statusByte);
+  if (rxLen > 0) {
+    st.responseSlots = rxLen;
+    if (st.firstRxUs == 0)
+      st.firstRxUs = RdmNowUs();
+  }
 
-  QueryPerformanceCounter(&rxTime);
+  ParseCommandResponse(rxBuf, rxLen, out);
+  st.parsedUs = RdmNowUs();
+  FillTiming(st, out);
 
-  // Calculate latency in microseconds
-  out->latencyUs =
-      (rxTime.QuadPart - txTime.QuadPart) * 1000000LL / g_perfFreq.QuadPart;
+  static_assert(RDX_STATUS_INVALID ==
+                    static_cast<int>(LatencyOutcome::INVALID),
+                "LatencyOutcome must follow RDX_STATUS_* order");
+  g_latency.Record({destUID, pid, commandClass},
+                   static_cast<LatencyOutcome>(out->status),
+                   out->timing.responderUs, st.parsedUs);
+  CountOutcome(bus.MetricsPort(), out->status);
 
-  DiscLog("[RDM CMD] ReceiveRDM returned %d bytes, statusByte=0x%02X, "
-          "latency=%lldus\n",
-          rxLen, statusByte, out->latencyUs);
+  TRACE_DEBUG("[RDM CMD] ReceiveRDM returned %d bytes, statusByte=0x%02X, "
+              "latency=%lldus (responder %lldus)\n",
+              rxLen, statusByte, out->latencyUs, out->timing.responderUs);
+  return true;
+}
 
+// Decodes a GET/SET response into `out` (status, NACK reason, data)
+static void ParseCommandResponse(const uint8_t *rxBuf, int rxLen,
+                                 RDX_Response *out) {
   if (rxLen <= 0) {
     out->status = RDX_STATUS_TIMEOUT;
-    DiscLog("[RDM CMD] TIMEOUT - no response\n");
-    return true; // function succeeded, but fixture didn't respond
-  }
-
-  // Log first few bytes of response
-  {
-    char hexDump[128] = {};
-    int dumpLen = (rxLen < 30) ? rxLen : 30;
-    for (int i = 0; i < dumpLen; ++i)
-      snprintf(hexDump + i * 3, 4, "%02X ", rxBuf[i]);
-    DiscLog("[RDM CMD] RX data: %s\n", hexDump);
+    TRACE_DEBUG("[RDM CMD] TIMEOUT - no response\n");
+    return; // function succeeded, but fixture didn't respond
   }
 
   // Validate RDM checksum (last 2 bytes of response)
@@ -267,7 +681,7 @@ static bool SendRDMCommand(uint64_t destUID, uint16_t pid, uint8_t commandClass,
       int copyLen = (rxLen > 231) ? 231 : rxLen;
       memcpy(out->data, rxBuf, copyLen);
       out->dataLen = copyLen;
-      return true;
+      return;
     }
   } else {
     out->checksumValid = false;
@@ -276,25 +690,25 @@ static bool SendRDMCommand(uint64_t destUID, uint16_t pid, uint8_t commandClass,
   // Parse the RDM response
   if (rxLen < 24) {
     out->status = RDX_STATUS_INVALID;
-    return true;
+    return;
   }
 
   // Check start code
   if (rxBuf[0] != 0xCC) { // RDM_START_CODE
-    DiscLog("[RDM CMD] INVALID: start code is 0x%02X (expected 0xCC)\n",
-            rxBuf[0]);
+    TRACE_DEBUG("[RDM CMD] INVALID: start code is 0x%02X (expected 0xCC)\n",
+                rxBuf[0]);
     out->status = RDX_STATUS_INVALID;
-    return true;
+    return;
   }
 
   uint8_t respType = rxBuf[16];
   uint8_t pdl = rxBuf[23];
-  DiscLog("[RDM CMD] respType=0x%02X pdl=%d\n", respType, pdl);
+  TRACE_DEBUG("[RDM CMD] respType=0x%02X pdl=%d\n", respType, pdl);
 
   switch (respType) {
   case 0x00: // ACK
     out->status = RDX_STATUS_ACK;
-    DiscLog("[RDM CMD] ACK with %d bytes param data\n", pdl);
+    TRACE_DEBUG("[RDM CMD] ACK with %d bytes param data\n", pdl);
     if (pdl > 0 && 24 + pdl <= rxLen) {
       int copyLen = (pdl > 231) ? 231 : pdl;
       memcpy(out->data, rxBuf + 24, copyLen);
@@ -303,21 +717,38 @@ static bool SendRDMCommand(uint64_t destUID, uint16_t pid, uint8_t commandClass,
     break;
   case 0x01: // ACK_TIMER
     out->status = RDX_STATUS_ACK_TIMER;
-    DiscLog("[RDM CMD] ACK_TIMER\n");
+    TRACE_DEBUG("[RDM CMD] ACK_TIMER\n");
     break;
   case 0x02: // NACK
     out->status = RDX_STATUS_NACK;
     if (pdl >= 2)
       out->nackReason = (rxBuf[24] << 8) | rxBuf[25];
-    DiscLog("[RDM CMD] NACK reason=0x%04X\n", out->nackReason);
+    TRACE_DEBUG("[RDM CMD] NACK reason=0x%04X\n", out->nackReason);
     break;
   default:
     out->status = RDX_STATUS_INVALID;
-    DiscLog("[RDM CMD] Unknown response type 0x%02X\n", respType);
+    TRACE_DEBUG("[RDM CMD] Unknown response type 0x%02X\n", respType);
     break;
   }
+}
 
-  return true;
+static bool SendRDMCommand(uint64_t destUID, uint16_t pid, uint8_t commandClass,
+                           const uint8_t *paramData, int paramLen,
+                           RDX_Response *out) {
+  if (!out)
+    return false;
+  memset(out, 0, sizeof(RDX_Response));
+
+  if (BusBusy()) {
+    out->status = RDX_STATUS_BUSY;
+    TRACE_ERROR("[RDM CMD] Not sent: DMX input / sniffer / fleet is running\n");
+    return false;
+  }
+
+  return OnDriver([&](auto &bus) {
+    return SendRDMCommandOn(bus, destUID, pid, commandClass, paramData,
+                            paramLen, out);
+  });
 }
 
 RDX_API bool RDX_SendGET(uint64_t destUID, uint16_t pid,
@@ -332,12 +763,185 @@ RDX_API bool RDX_SendSET(uint64_t destUID, uint16_t pid,
   return SendRDMCommand(destUID, pid, 0x30, paramData, paramLen, response);
 }
 
+// ═══════════════════════════════════════════════════════════════════════
+// Ports (multi-universe)
+// ═══════════════════════════════════════════════════════════════════════
+
+// Runs `fn` on the driver behind `port`; returns `fail` for a bad port.
+template <typename R, typename Fn> static R OnPort(int port, R fail, Fn fn) {
+  if (port < 0 || port >= static_cast<int>(g_ports.size()))
+    return fail;
+  if (g_driverType == RDX_DRIVER_REPLAY)
+    return fn(g_replay);
+  PortState &ps = *g_ports[port];
+  if (g_driverType == RDX_DRIVER_SIM)
+    return fn(ps.sim ? *ps.sim : g_sim);
+  if (g_driverType != RDX_DRIVER_PEPERONI)
+    return fn(g_enttec);
+  return fn(ps.peperoni ? *ps.peperoni : g_peperoni);
+}
+
+// One I/O thread per port, each working its own line; returns once every
+// port is done.  `fn(i)` may write slot i of a per-port result vector.
+template <typename Fn> static void ForEachPort(Fn fn) {
+  std::vector<std::thread> workers;
+  for (int i = 0; i < static_cast<int>(g_ports.size()); ++i) {
+    workers.emplace_back([i, &fn] {
+      PERF_THREAD_NAME(("port " + std::to_string(i)).c_str());
+      fn(i);
+    });
+  }
+  for (auto &t : workers)
+    t.join();
+}
+
+// Copy of a port's discovered UIDs
+static std::vector<uint64_t> PortUIDs(int port) {
+  std::lock_guard<std::mutex> lk(g_ports[port]->mutex);
+  return g_ports[port]->discovered;
+}
+
+RDX_API int RDX_GetPortCount() { return static_cast<int>(g_ports.size()); }
+
+RDX_API int RDX_DiscoverPorts() {
+  if (BusBusy())
+    return 0;
+
+  // One I/O thread per universe; each runs a full discovery on its own line
+  uint64_t srcUID = GetControllerUID();
+  ForEachPort([srcUID](int i) {
+    auto uids = OnPort(i, std::vector<uint64_t>(), [srcUID](auto &bus) {
+      return RDMDiscovery(bus, srcUID);
+    });
+    std::lock_guard<std::mutex> lk(g_ports[i]->mutex);
+    g_ports[i]->discovered = std::move(uids);
+  });
+
+  // Keep the flat list in sync for RDX_GetDiscoveredUID
+  g_discoveredUIDs.clear();
+  for (auto &p : g_ports) {
+    std::lock_guard<std::mutex> lk(p->mutex);
+    g_discoveredUIDs.insert(g_discoveredUIDs.end(), p->discovered.begin(),
+                            p->discovered.end());
+  }
+  return static_cast<int>(g_discoveredUIDs.size());
+}
+
+RDX_API int RDX_GetPortUIDCount(int port) {
+  if (port < 0 || port >= static_cast<int>(g_ports.size()))
+    return 0;
+  std::lock_guard<std::mutex> lk(g_ports[port]->mutex);
+  return static_cast<int>(g_ports[port]->discovered.size());
+}
+
+RDX_API bool RDX_GetPortDiscoveredUID(int port, int index, uint64_t *uid) {
+  if (port < 0 || port >= static_cast<int>(g_ports.size()))
+    return false;
+  PortState &ps = *g_ports[port];
+  std::lock_guard<std::mutex> lk(ps.mutex);
+  if (index < 0 || index >= static_cast<int>(ps.discovered.size()))
+    return false;
+  if (uid)
+    *uid = ps.discovered[index];
+  return true;
+}
+
+RDX_API bool RDX_SendPortDMX(int port, const uint8_t *data, int len) {
+  if (port < 0 || port >= static_cast<int>(g_ports.size()) || !data ||
+      len <= 0 || len > 513)
+    return false;
+  PERF_SCOPE_ARG("dmx", "SendPortDMX", "port", port);
+  return OnPort(port, false,
+                [&](auto &bus) { return bus.SendDMX(data, len); });
+}
+
+static bool SendPortCommand(int port, uint64_t destUID, uint16_t pid,
+                            uint8_t commandClass, const uint8_t *paramData,
+                            int paramLen, RDX_Response *out) {
+  if (!out)
+    return false;
+  memset(out, 0, sizeof(RDX_Response));
+  if (BusBusy()) {
+    out->status = RDX_STATUS_BUSY;
+    TRACE_ERROR("[RDM CMD] Not sent: DMX input / sniffer / fleet is running\n");
+    return false;
+  }
+  return OnPort(port, false, [&](auto &bus) {
+    return SendRDMCommandOn(bus, destUID, pid, commandClass, paramData,
+                            paramLen, out);
+  });
+}
+
+RDX_API bool RDX_SendPortGET(int port, uint64_t destUID, uint16_t pid,
+                             const uint8_t *paramData, int paramLen,
+                             RDX_Response *response) {
+  return SendPortCommand(port, destUID, pid, 0x20, paramData, paramLen,
+                         response);
+}
+
+RDX_API bool RDX_SendPortSET(int port, uint64_t destUID, uint16_t pid,
+                             const uint8_t *paramData, int paramLen,
+                             RDX_Response *response) {
+  return SendPortCommand(port, destUID, pid, 0x30, paramData, paramLen,
+                         response);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Latency statistics
+// ═══════════════════════════════════════════════════════════════════════
+
+static void ToApi(const LatencySummary &s, RDX_LatencyStats *out) {
+  memset(out, 0, sizeof(RDX_LatencyStats));
+  out->uid = s.key.uid;
+  out->pid = s.key.pid;
+  out->commandClass = s.key.commandClass;
+  for (int i = 0; i < 6; ++i)
+    out->statusCounts[i] = s.outcomes[i];
+  out->samples = s.samples;
+  out->minUs = s.minUs;
+  out->p50Us = s.p50Us;
+  out->p90Us = s.p90Us;
+  out->p99Us = s.p99Us;
+  out->maxUs = s.maxUs;
+  out->meanUs = s.meanUs;
+}
+
+RDX_API int RDX_GetLatencyStatCount() { return g_latency.EntryCount(); }
+
+RDX_API int RDX_GetLatencyStats(RDX_LatencyStats *out, int max,
+                                bool windowed) {
+  if (!out || max <= 0)
+    return 0;
+  std::vector<LatencySummary> tmp(max);
+  int n = g_latency.Snapshot(tmp.data(), max, windowed, RdmNowUs());
+  for (int i = 0; i < n; ++i)
+    ToApi(tmp[i], &out[i]);
+  return n;
+}
+
+RDX_API bool RDX_GetFleetLatency(RDX_LatencyStats *out, bool windowed) {
+  if (!out)
+    return false;
+  ToApi(g_latency.Fleet(windowed, RdmNowUs()), out);
+  return true;
+}
+
+RDX_API void RDX_SetLatencyWindow(int seconds) {
+  if (seconds > 0)
+    g_latency.SetWindow(seconds * 1000000LL);
+}
+
+RDX_API void RDX_ResetLatencyStats() { g_latency.Reset(); }
+
 // ═══════════════════════════════════════════════════════════════════════
 // Parameter database
 // ═══════════════════════════════════════════════════════════════════════
 
 RDX_API int RDX_LoadParameters(const char *csvPath) {
   g_params = LoadParameters(csvPath ? csvPath : "");
+  g_mapRows = LoadParameterMap(csvPath ? csvPath : "");
+  g_snapshots.SetDatabases(SettingsDatabases(g_mapRows));
+  g_snapshots.Clear();
   return static_cast<int>(g_params.size());
 }
 
@@ -364,43 +968,1065 @@ RDX_API bool RDX_GetParameterInfo(int index, uint16_t *pid, char *name,
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// Logging
+// Fleet validation
 // ═══════════════════════════════════════════════════════════════════════
 
-RDX_API void RDX_SetLogCallback(RDX_LogCallback cb) {
-  g_logCb = cb;
+static std::mutex g_fleetMutex; // guards the two below
+static std::deque<FleetFixtureResult> g_fleetDone;
+static FleetFixtureResult g_fleetCurrent; // last RDX_NextFleetResult
+static ValidationPlanner g_planner; // costs learned across runs
+static bool g_planning = true;
+static bool g_fleetFailFast = false;
+static bool g_snapshotting = false;
+static bool g_descriptorCaching = false;
+// Rows from every port worker; read by RDX_ReadFleetRows
+static MpscRing<RDX_StreamRow, 4096> g_fleetRows;
+static std::atomic<uint64_t> g_fleetRowsDropped{0};
 
-  // Set log callback on Enttec
-  g_enttec.SetLogCallback([](bool tx, const uint8_t *data, int len) {
-    if (!g_logCb)
-      return;
-    if (tx && len >= 2 && data[1] == 0x06)
-      return;
-    std::string hex;
-    hex.reserve(len * 3 + 8);
-    for (int i = 0; i < len && i < 128; ++i) {
-      char buf[4];
-      snprintf(buf, sizeof(buf), "%02X ", data[i]);
-      hex += buf;
+static int32_t ToApiStatus(RDMResponseType t) {
+  switch (t) {
+  case RDMResponseType::ACK:
+    return RDX_STATUS_ACK;
+  case RDMResponseType::ACK_TIMER:
+    return RDX_STATUS_ACK_TIMER;
+  case RDMResponseType::NACK:
+    return RDX_STATUS_NACK;
+  case RDMResponseType::TIMEOUT:
+    return RDX_STATUS_TIMEOUT;
+  default:
+    return RDX_STATUS_INVALID;
+  }
+}
+
+static void ToApi(const ResultStore &rows, size_t i, RDX_ValidationRow *row) {
+  memset(row, 0, sizeof(RDX_ValidationRow));
+  row->pid = rows.Pid(i);
+  row->status = static_cast<uint8_t>(rows.Status(i));
+  row->isMandatory = rows.IsMandatory(i) ? 1 : 0;
+  row->response = ToApiStatus(rows.Response(i));
+  strncpy(row->value, rows.Value(i).c_str(), sizeof(row->value) - 1);
+}
+
+RDX_API bool RDX_PlanValidation(uint64_t uid, RDX_ValidationPlan *plan) {
+  if (!plan || g_params.empty())
+    return false;
+  if (BusBusy())
+    return false;
+  uint64_t srcUID = GetControllerUID();
+  ValidationPlan vp = OnDriver([&](auto &bus) {
+    return g_planner.Plan(PlannerGet(bus, srcUID, uid), uid, g_params);
+  });
+  memset(plan, 0, sizeof(RDX_ValidationPlan));
+  plan->supported = static_cast<int32_t>(vp.supported.size());
+  plan->gets = static_cast<int32_t>(vp.gets.size());
+  plan->missing = static_cast<int32_t>(vp.missing.size());
+  plan->haveSupported = vp.haveSupported ? 1 : 0;
+  plan->probeUs = vp.probeUs;
+  plan->predictedUs = vp.predictedUs;
+  return true;
+}
+
+RDX_API void RDX_SetValidationPlanning(bool enable) { g_planning = enable; }
+
+RDX_API void RDX_SetSnapshotValidation(bool enable) {
+  g_snapshotting = enable;
+}
+
+RDX_API void RDX_ClearSnapshots() { g_snapshots.Clear(); }
+
+RDX_API void RDX_SetDescriptorCaching(bool enable) {
+  g_descriptorCaching = enable;
+}
+
+RDX_API int RDX_LoadDescriptorCache(const char *path) {
+  if (!path)
+    return -1;
+  return g_descriptors.Load(path);
+}
+
+RDX_API bool RDX_SaveDescriptorCache(const char *path) {
+  if (!path)
+    return false;
+  return g_descriptors.Save(path);
+}
+
+RDX_API void RDX_ClearDescriptorCache() { g_descriptors.Clear(); }
+
+RDX_API bool RDX_GetDescriptorCacheStats(RDX_DescriptorStats *stats) {
+  if (!stats)
+    return false;
+  DescriptorStats s = g_descriptors.Stats();
+  memset(stats, 0, sizeof(RDX_DescriptorStats));
+  stats->hits = s.hits;
+  stats->misses = s.misses;
+  stats->models = static_cast<int32_t>(s.models);
+  stats->entries = static_cast<int32_t>(s.entries);
+  return true;
+}
+
+RDX_API void RDX_SetFleetFailFast(bool enable) { g_fleetFailFast = enable; }
+
+RDX_API int RDX_StartFleetValidation() {
+  if (BusBusy())
+    return -1;
+  if (g_params.empty())
+    return -1;
+  g_fleet.Clear();
+  {
+    std::lock_guard<std::mutex> lk(g_fleetMutex);
+    g_fleetDone.clear();
+    g_fleetCurrent = FleetFixtureResult{};
+  }
+  while (g_fleetRows.Consume([](const RDX_StreamRow &) {}))
+    ; // rows of the previous run nobody read
+  g_fleetRowsDropped = 0;
+
+  uint64_t srcUID = GetControllerUID();
+  for (int i = 0; i < static_cast<int>(g_ports.size()); ++i) {
+    std::vector<uint64_t> uids;
+    {
+      std::lock_guard<std::mutex> lk(g_ports[i]->mutex);
+      uids = g_ports[i]->discovered;
     }
-    if (len > 128)
-      hex += "...";
-    g_logCb(tx, hex.c_str(), NowUs());
+    OnPort(i, -1, [&](auto &bus) {
+      return g_fleet.AddPort(bus, srcUID, g_params, uids,
+                             g_planning ? &g_planner : nullptr,
+                             g_snapshotting ? &g_snapshots : nullptr,
+                             g_descriptorCaching ? &g_descriptors : nullptr);
+    });
+  }
+  g_fleet.SetFailFast(g_fleetFailFast);
+  g_fleet.SetStoreResults(true);
+  int64_t startUs = RdmNowUs();
+  auto onRow = [startUs](const FleetFixtureResult &fx,
+                         const ResultStore &rows, size_t i) {
+    bool queued = g_fleetRows.Emplace([&](RDX_StreamRow &sr) {
+      sr.uid = fx.uid;
+      sr.port = fx.port;
+      sr.index = rows.Index(i);
+      sr.timeUs = RdmNowUs() - startUs;
+      ToApi(rows, i, &sr.row);
+    });
+    if (!queued)
+      g_fleetRowsDropped.fetch_add(1, std::memory_order_relaxed);
+  };
+  auto onFixture = [](FleetFixtureResult &&r) {
+    std::lock_guard<std::mutex> lk(g_fleetMutex);
+    g_fleetDone.push_back(std::move(r));
+  };
+  if (!g_fleet.Start(onFixture, onRow))
+    return -1;
+  return g_fleet.Progress().fixtures;
+}
+
+RDX_API int RDX_ReadFleetRows(RDX_StreamRow *out, int max) {
+  if (!out || max <= 0)
+    return 0;
+  int n = 0;
+  while (n < max &&
+         g_fleetRows.Consume([&](const RDX_StreamRow &r) { out[n] = r; }))
+    ++n;
+  return n;
+}
+
+RDX_API uint64_t RDX_GetFleetRowsDropped() {
+  return g_fleetRowsDropped.load(std::memory_order_relaxed);
+}
+
+RDX_API bool RDX_NextFleetResult(RDX_FleetFixture *out) {
+  if (!out)
+    return false;
+  int64_t startUs = g_fleet.Progress().startUs;
+  std::lock_guard<std::mutex> lk(g_fleetMutex);
+  if (g_fleetDone.empty())
+    return false;
+  g_fleetCurrent = std::move(g_fleetDone.front());
+  g_fleetDone.pop_front();
+  const FleetFixtureResult &r = g_fleetCurrent;
+  memset(out, 0, sizeof(RDX_FleetFixture));
+  out->uid = r.uid;
+  out->port = r.port;
+  out->stolen = r.stolen ? 1 : 0;
+  out->rowCount = static_cast<int32_t>(r.rowCount);
+  out->green = r.green;
+  out->yellow = r.yellow;
+  out->red = r.red;
+  out->sweepUs = r.endUs - r.startUs;
+  out->completedUs = r.endUs - startUs;
+  out->missing = r.missing;
+  out->predictedUs = r.predictedUs;
+  out->aborted = r.aborted ? 1 : 0;
+  out->firstResultUs = r.firstResultUs;
+  out->cached = r.cached;
+  out->shared = r.shared;
+  return true;
+}
+
+RDX_API bool RDX_GetFleetResultRow(int index, RDX_ValidationRow *row) {
+  size_t first = 0;
+  {
+    std::lock_guard<std::mutex> lk(g_fleetMutex);
+    if (!row || index < 0 ||
+        index >= static_cast<int>(g_fleetCurrent.rowCount))
+      return false;
+    first = g_fleetCurrent.firstRow;
+  }
+  bool ok = false;
+  g_fleet.ReadResults([&](const ResultStore &rows) {
+    if (first + index < rows.Size()) {
+      ToApi(rows, first + index, row);
+      ok = true;
+    }
+  });
+  return ok;
+}
+
+RDX_API uint64_t RDX_GetFleetResultBytes() {
+  uint64_t bytes = 0;
+  g_fleet.ReadResults(
+      [&](const ResultStore &rows) { bytes = rows.MemoryBytes(); });
+  return bytes;
+}
+
+RDX_API bool RDX_GetFleetProgress(RDX_FleetProgress *progress) {
+  if (!progress)
+    return false;
+  FleetProgress pr = g_fleet.Progress();
+  memset(progress, 0, sizeof(RDX_FleetProgress));
+  progress->fixtures = pr.fixtures;
+  progress->completed = pr.completed;
+  progress->stolen = pr.stolen;
+  progress->running = pr.running ? 1 : 0;
+  progress->elapsedUs = pr.elapsedUs;
+  return true;
+}
+
+RDX_API int RDX_GetFleetPortCompleted(int port) {
+  FleetProgress pr = g_fleet.Progress();
+  if (port < 0 || port >= static_cast<int>(pr.perPort.size()))
+    return 0;
+  return pr.perPort[port];
+}
+
+RDX_API void RDX_CancelFleetValidation() { g_fleet.Stop(); }
+
+// ═══════════════════════════════════════════════════════════════════════
+// Device profile
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::mutex g_profileMutex;
+static DeviceProfile g_profile; // last RDX_ReadDeviceProfile
+
+static void CopyLabel(char (&dst)[33], const std::string &src) {
+  memset(dst, 0, sizeof(dst));
+  strncpy(dst, src.c_str(), sizeof(dst) - 1);
+}
+
+RDX_API bool RDX_ReadDeviceProfile(uint64_t uid, RDX_DeviceProfile *out) {
+  if (!out)
+    return false;
+  if (BusBusy())
+    return false;
+  uint64_t srcUID = GetControllerUID();
+  DeviceProfile p = OnDriver([&](auto &bus) {
+    RDMGet get = PlannerGet(bus, srcUID, uid);
+    if (g_descriptorCaching)
+      get = g_descriptors.Wrap(std::move(get), uid);
+    return ReadDeviceProfile(get, uid);
+  });
+
+  memset(out, 0, sizeof(RDX_DeviceProfile));
+  out->haveInfo = p.haveInfo ? 1 : 0;
+  out->haveSupported = p.haveSupported ? 1 : 0;
+  out->protocol = p.info.protocol;
+  out->model = p.info.model;
+  out->category = p.info.category;
+  out->softwareVersion = p.info.softwareVersion;
+  out->footprint = p.info.footprint;
+  out->personality = p.info.personality;
+  out->personalityCount = p.info.personalityCount;
+  out->startAddress = p.info.startAddress;
+  out->subDevices = p.info.subDevices;
+  out->sensorCount = p.info.sensorCount;
+  out->supported = static_cast<int32_t>(p.supported.size());
+  out->personalities = static_cast<int32_t>(p.personalities.size());
+  out->sensors = static_cast<int32_t>(p.sensors.size());
+  out->parameters = static_cast<int32_t>(p.parameters.size());
+  out->requests = p.requests;
+  out->failed = p.failed;
+  out->elapsedUs = p.elapsedUs;
+  bool ok = p.haveInfo || p.haveSupported;
+  std::lock_guard<std::mutex> lk(g_profileMutex);
+  g_profile = std::move(p);
+  return ok;
+}
+
+RDX_API int RDX_GetProfileSupported(uint16_t *pids, int max) {
+  std::lock_guard<std::mutex> lk(g_profileMutex);
+  int n = static_cast<int>(g_profile.supported.size());
+  if (!pids || max <= 0)
+    return n;
+  n = std::min(n, max);
+  memcpy(pids, g_profile.supported.data(), n * sizeof(uint16_t));
+  return n;
+}
+
+RDX_API bool RDX_GetProfilePersonality(int index, RDX_PersonalityDesc *out) {
+  std::lock_guard<std::mutex> lk(g_profileMutex);
+  if (!out || index < 0 ||
+      index >= static_cast<int>(g_profile.personalities.size()))
+    return false;
+  const PersonalityDesc &d = g_profile.personalities[index];
+  out->number = d.number;
+  out->footprint = d.footprint;
+  CopyLabel(out->description, d.description);
+  return true;
+}
+
+RDX_API bool RDX_GetProfileSensor(int index, RDX_SensorDef *out) {
+  std::lock_guard<std::mutex> lk(g_profileMutex);
+  if (!out || index < 0 ||
+      index >= static_cast<int>(g_profile.sensors.size()))
+    return false;
+  const SensorDef &d = g_profile.sensors[index];
+  out->number = d.number;
+  out->type = d.type;
+  out->unit = d.unit;
+  out->prefix = d.prefix;
+  out->rangeMin = d.rangeMin;
+  out->rangeMax = d.rangeMax;
+  out->normalMin = d.normalMin;
+  out->normalMax = d.normalMax;
+  out->recordedSupport = d.recordedSupport;
+  CopyLabel(out->description, d.description);
+  return true;
+}
+
+RDX_API bool RDX_GetProfileParameter(int index, RDX_ParameterDesc *out) {
+  std::lock_guard<std::mutex> lk(g_profileMutex);
+  if (!out || index < 0 ||
+      index >= static_cast<int>(g_profile.parameters.size()))
+    return false;
+  const ParameterDesc &d = g_profile.parameters[index];
+  out->pid = d.pid;
+  out->pdlSize = d.pdlSize;
+  out->dataType = d.dataType;
+  out->commandClass = d.commandClass;
+  out->type = d.type;
+  out->unit = d.unit;
+  out->prefix = d.prefix;
+  out->minValue = d.minValue;
+  out->maxValue = d.maxValue;
+  out->defaultValue = d.defaultValue;
+  CopyLabel(out->description, d.description);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Configuration push
+// ═══════════════════════════════════════════════════════════════════════
+
+static ConfigPusher g_pusher; // values verified on each UID, across pushes
+static std::mutex g_pushMutex;
+static std::vector<RDX_PushFixture> g_pushFixtures; // last RDX_PushConfig
+
+static bool ToColumn(int column, ConfigColumn &out) {
+  switch (column) {
+  case RDX_CONFIG_FW_DEFAULTS:
+    out = ConfigColumn::FW_DEFAULTS;
+    return true;
+  case RDX_CONFIG_TEST:
+    out = ConfigColumn::TEST;
+    return true;
+  case RDX_CONFIG_SHIPPING:
+    out = ConfigColumn::SHIPPING;
+    return true;
+  default:
+    return false;
+  }
+}
+
+RDX_API int RDX_GetConfigCount(int column) {
+  ConfigColumn col;
+  if (!ToColumn(column, col))
+    return -1;
+  return static_cast<int>(ConfigFromMap(g_mapRows, col).size());
+}
+
+RDX_API bool RDX_PushConfig(int column, int flags, RDX_PushSummary *summary) {
+  ConfigColumn col;
+  if (!ToColumn(column, col))
+    return false;
+  if (BusBusy())
+    return false;
+  std::vector<ConfigSet> config = ConfigFromMap(g_mapRows, col);
+  PushOptions opts;
+  opts.verify = (flags & RDX_PUSH_VERIFY) != 0;
+  opts.skipMatching = (flags & RDX_PUSH_SKIP_MATCHING) != 0;
+  opts.useKnown = (flags & RDX_PUSH_USE_KNOWN) != 0;
+
+  // One thread per port, as RDX_DiscoverPorts
+  uint64_t srcUID = GetControllerUID();
+  int ports = static_cast<int>(g_ports.size());
+  std::vector<std::vector<PushResult>> byPort(ports);
+  int64_t t0 = RdmNowUs();
+  ForEachPort([&](int i) {
+    std::vector<uint64_t> uids = PortUIDs(i);
+    byPort[i] = OnPort(i, std::vector<PushResult>(), [&](auto &bus) {
+      std::vector<PushTarget> targets;
+      for (uint64_t uid : uids)
+        targets.push_back({uid, PlannerGet(bus, srcUID, uid),
+                           PushSet(bus, srcUID, uid)});
+      return g_pusher.Push(targets, config, opts);
+    });
+  });
+
+  RDX_PushSummary sum;
+  memset(&sum, 0, sizeof(sum));
+  sum.configSets = static_cast<int32_t>(config.size());
+  std::vector<RDX_PushFixture> fixtures;
+  for (int port = 0; port < ports; ++port) {
+    for (const PushResult &r : byPort[port]) {
+      RDX_PushFixture f;
+      memset(&f, 0, sizeof(f));
+      f.uid = r.uid;
+      f.port = port;
+      f.gets = r.gets;
+      f.sets = r.sets;
+      f.verifies = r.verifies;
+      f.skipped = r.skipped;
+      f.failed = r.failed;
+      f.mismatched = r.mismatched;
+      f.pending = r.pending;
+      f.elapsedUs = r.elapsedUs;
+      fixtures.push_back(f);
+      ++sum.fixtures;
+      sum.okFixtures += r.Ok() ? 1 : 0;
+      sum.transactions += r.Transactions();
+      sum.sent += r.sets;
+      sum.skipped += r.skipped;
+      sum.failed += r.failed;
+      sum.mismatched += r.mismatched;
+      sum.pending += r.pending;
+    }
+  }
+  sum.elapsedUs = RdmNowUs() - t0;
+  TRACE_INFO("[Push] %d fixture(s), %d transaction(s), %d SET(s) in %lld "
+             "ms\n",
+             sum.fixtures, sum.transactions, sum.sent,
+             (long long)(sum.elapsedUs / 1000));
+  {
+    std::lock_guard<std::mutex> lk(g_pushMutex);
+    g_pushFixtures = std::move(fixtures);
+  }
+  if (summary)
+    *summary = sum;
+  return true;
+}
+
+RDX_API bool RDX_GetPushFixture(int index, RDX_PushFixture *out) {
+  std::lock_guard<std::mutex> lk(g_pushMutex);
+  if (!out || index < 0 || index >= static_cast<int>(g_pushFixtures.size()))
+    return false;
+  *out = g_pushFixtures[index];
+  return true;
+}
+
+RDX_API void RDX_ClearPushedValues() { g_pusher.Clear(); }
+
+// ═══════════════════════════════════════════════════════════════════════
+// Broadcast SET
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::mutex g_broadcastMutex;
+static std::vector<uint64_t> g_broadcastFailed; // last RDX_SendBroadcastSET
+
+RDX_API bool RDX_SendBroadcastSET(uint64_t destUID, uint16_t pid,
+                                  const uint8_t *paramData, int paramLen,
+                                  int verifySamples,
+                                  RDX_BroadcastResult *result) {
+  if ((destUID & 0xFFFFFFFFULL) != 0xFFFFFFFFULL)
+    return false; // not a broadcast or vendorcast address
+  if (paramLen < 0 || paramLen > 231 || (paramLen && !paramData))
+    return false;
+  if (BusBusy())
+    return false;
+  std::vector<uint8_t> value(paramData, paramData + paramLen);
+  BroadcastOptions opts;
+  opts.verifySamples = verifySamples;
+
+  // Every line gets the frame; the sample is spread over the ports
+  uint64_t srcUID = GetControllerUID();
+  int ports = static_cast<int>(g_ports.size());
+  std::vector<BroadcastResult> byPort(ports);
+  int64_t t0 = RdmNowUs();
+  ForEachPort([&](int i) {
+    std::vector<uint64_t> uids = PortUIDs(i);
+    byPort[i] = OnPort(i, BroadcastResult(), [&](auto &bus) {
+      return BroadcastSet(bus, srcUID, destUID, pid, value, uids, opts);
+    });
+  });
+
+  RDX_BroadcastResult sum;
+  memset(&sum, 0, sizeof(sum));
+  std::vector<uint64_t> failed;
+  for (const BroadcastResult &r : byPort) {
+    ++sum.ports;
+    sum.sent += r.sent ? 1 : 0;
+    sum.addressed += r.addressed;
+    sum.sampled += r.sampled;
+    sum.confirmed += r.confirmed;
+    sum.mismatched += r.mismatched;
+    sum.unconfirmed += r.unconfirmed;
+    failed.insert(failed.end(), r.failed.begin(), r.failed.end());
+  }
+  sum.elapsedUs = RdmNowUs() - t0;
+  TRACE_INFO("[Broadcast] SET PID 0x%04X to %04X:%08X on %d port(s), "
+             "%d/%d sampled confirmed\n",
+             pid, TRACE_UID(destUID), sum.sent, sum.confirmed, sum.sampled);
+  {
+    std::lock_guard<std::mutex> lk(g_broadcastMutex);
+    g_broadcastFailed = std::move(failed);
+  }
+  if (result)
+    *result = sum;
+  return sum.sent == sum.ports && sum.ports > 0;
+}
+
+RDX_API bool RDX_GetBroadcastFailedUID(int index, uint64_t *uid) {
+  std::lock_guard<std::mutex> lk(g_broadcastMutex);
+  if (!uid || index < 0 ||
+      index >= static_cast<int>(g_broadcastFailed.size()))
+    return false;
+  *uid = g_broadcastFailed[index];
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// DMX address plan
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::mutex g_addressMutex;
+static std::set<uint64_t> g_fixedAddresses;  // RDX_SetAddressFixed
+static std::vector<AddressPlan> g_addressPlans; // per port, last plan
+static std::vector<RDX_AddressPatch> g_addressPatches; // last apply
+
+RDX_API void RDX_SetAddressFixed(uint64_t uid, bool fixed) {
+  std::lock_guard<std::mutex> lk(g_addressMutex);
+  if (fixed)
+    g_fixedAddresses.insert(uid);
+  else
+    g_fixedAddresses.erase(uid);
+}
+
+RDX_API void RDX_ClearFixedAddresses() {
+  std::lock_guard<std::mutex> lk(g_addressMutex);
+  g_fixedAddresses.clear();
+}
+
+static void SumPlan(const std::vector<AddressPlan> &plans,
+                    RDX_AddressSummary &sum) {
+  for (const AddressPlan &plan : plans) {
+    ++sum.ports;
+    sum.fixtures += static_cast<int32_t>(plan.slots.size());
+    sum.moves += plan.moves;
+    sum.unplaced += plan.unplaced;
+    sum.overlaps += plan.overlaps;
+  }
+}
+
+RDX_API bool RDX_PlanAddresses(int firstAddress, RDX_AddressSummary *summary) {
+  if (firstAddress < 1 || firstAddress > 512)
+    return false;
+  if (BusBusy())
+    return false;
+  std::set<uint64_t> fixed;
+  {
+    std::lock_guard<std::mutex> lk(g_addressMutex);
+    fixed = g_fixedAddresses;
+  }
+  AddressPlanOptions opts;
+  opts.firstAddress = static_cast<uint16_t>(firstAddress);
+
+  // Each port is its own DMX line: read and plan them side by side
+  uint64_t srcUID = GetControllerUID();
+  int ports = static_cast<int>(g_ports.size());
+  std::vector<AddressPlan> plans(ports);
+  int64_t t0 = RdmNowUs();
+  ForEachPort([&](int i) {
+    std::vector<uint64_t> uids = PortUIDs(i);
+    std::vector<AddressFixture> line(uids.size());
+    OnPort(i, false, [&](auto &bus) {
+      for (size_t f = 0; f < uids.size(); ++f) {
+        line[f].fixed = fixed.count(uids[f]) != 0;
+        ReadAddressFixture(PlannerGet(bus, srcUID, uids[f]), uids[f],
+                           line[f]);
+      }
+      return true;
+    });
+    plans[i] = PlanAddresses(line, opts);
+  });
+
+  RDX_AddressSummary sum;
+  memset(&sum, 0, sizeof(sum));
+  SumPlan(plans, sum);
+  sum.elapsedUs = RdmNowUs() - t0;
+  TRACE_INFO("[Address] planned %d fixture(s) on %d port(s): %d to move, "
+             "%d unplaced\n",
+             sum.fixtures, sum.ports, sum.moves, sum.unplaced);
+  {
+    std::lock_guard<std::mutex> lk(g_addressMutex);
+    g_addressPlans = std::move(plans);
+  }
+  if (summary)
+    *summary = sum;
+  return true;
+}
+
+RDX_API bool RDX_GetAddressSlot(int index, RDX_AddressSlot *out) {
+  std::lock_guard<std::mutex> lk(g_addressMutex);
+  if (!out || index < 0)
+    return false;
+  for (size_t port = 0; port < g_addressPlans.size(); ++port) {
+    const std::vector<AddressSlot> &slots = g_addressPlans[port].slots;
+    if (index >= static_cast<int>(slots.size())) {
+      index -= static_cast<int>(slots.size());
+      continue;
+    }
+    const AddressSlot &s = slots[index];
+    memset(out, 0, sizeof(*out));
+    out->uid = s.uid;
+    out->port = static_cast<int32_t>(port);
+    out->footprint = s.footprint;
+    out->current = s.current;
+    out->planned = s.planned;
+    out->fixed = s.fixed ? 1 : 0;
+    out->overlaps = s.overlaps ? 1 : 0;
+    return true;
+  }
+  return false;
+}
+
+RDX_API bool RDX_ApplyAddressPlan(bool verify, RDX_AddressSummary *summary) {
+  if (BusBusy())
+    return false;
+  std::vector<AddressPlan> plans;
+  {
+    std::lock_guard<std::mutex> lk(g_addressMutex);
+    plans = g_addressPlans;
+  }
+  if (plans.size() != g_ports.size())
+    return false; // no plan, or the ports changed since
+
+  uint64_t srcUID = GetControllerUID();
+  int ports = static_cast<int>(plans.size());
+  std::vector<std::vector<AddressPatch>> byPort(ports);
+  int64_t t0 = RdmNowUs();
+  ForEachPort([&](int i) {
+    byPort[i] = OnPort(i, std::vector<AddressPatch>(), [&](auto &bus) {
+      std::vector<PushTarget> targets;
+      for (const AddressSlot &s : plans[i].slots)
+        if (s.Moves())
+          targets.push_back({s.uid, PlannerGet(bus, srcUID, s.uid),
+                             PushSet(bus, srcUID, s.uid)});
+      return PatchAddresses(targets, plans[i], verify);
+    });
   });
 
-  // Set log callback on Peperoni
-  g_peperoni.SetLogCallback([](bool tx, const uint8_t *data, int len) {
-    if (!g_logCb)
+  RDX_AddressSummary sum;
+  memset(&sum, 0, sizeof(sum));
+  SumPlan(plans, sum);
+  std::vector<RDX_AddressPatch> patches;
+  for (int port = 0; port < ports; ++port) {
+    std::unordered_map<uint64_t, uint16_t> moved;
+    for (const AddressPatch &p : byPort[port]) {
+      RDX_AddressPatch out;
+      memset(&out, 0, sizeof(out));
+      out.uid = p.uid;
+      out.port = port;
+      out.from = p.from;
+      out.to = p.to;
+      out.outcome = static_cast<int32_t>(p.outcome);
+      out.nackReason = p.nackReason;
+      out.readBack = p.readBack;
+      patches.push_back(out);
+      ++sum.sent;
+      sum.failed += p.outcome == PushOutcome::FAILED ? 1 : 0;
+      sum.mismatched += p.outcome == PushOutcome::MISMATCH ? 1 : 0;
+      if (p.outcome == PushOutcome::SET)
+        moved[p.uid] = p.to;
+    }
+    // Applied moves are the fixture's address now: applying again is a
+    // no-op, and a failed move is retried
+    for (AddressSlot &s : plans[port].slots) {
+      auto it = moved.find(s.uid);
+      if (it != moved.end())
+        s.current = it->second;
+    }
+    plans[port].moves = 0;
+    for (const AddressSlot &s : plans[port].slots)
+      plans[port].moves += s.Moves() ? 1 : 0;
+  }
+  sum.elapsedUs = RdmNowUs() - t0;
+  TRACE_INFO("[Address] %d SET(s) on %d port(s): %d failed, %d mismatched "
+             "in %lld ms\n",
+             sum.sent, sum.ports, sum.failed, sum.mismatched,
+             (long long)(sum.elapsedUs / 1000));
+  {
+    std::lock_guard<std::mutex> lk(g_addressMutex);
+    g_addressPlans = std::move(plans);
+    g_addressPatches = std::move(patches);
+  }
+  if (summary)
+    *summary = sum;
+  return sum.failed == 0 && sum.mismatched == 0;
+}
+
+RDX_API bool RDX_GetAddressPatch(int index, RDX_AddressPatch *out) {
+  std::lock_guard<std::mutex> lk(g_addressMutex);
+  if (!out || index < 0 ||
+      index >= static_cast<int>(g_addressPatches.size()))
+    return false;
+  *out = g_addressPatches[index];
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Fixture locator
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::mutex g_locateMutex; // held for a whole locator call
+static FixtureLocator g_locator;
+static std::unordered_map<uint64_t, int> g_locatePort; // UID -> port
+static std::vector<uint64_t> g_locateLit; // identifying right now
+static RDX_LocateState g_locateState;
+
+// Moves every port from g_locateLit to `next`, one thread per port.
+// `clear` first turns identify off everywhere, whatever was on before.
+static void SendLocateStep(const std::vector<uint64_t> &next, bool clear) {
+  uint64_t srcUID = GetControllerUID();
+  int ports = static_cast<int>(g_ports.size());
+  std::vector<std::vector<uint64_t>> now(ports), then(ports);
+  auto byPort = [ports](const std::vector<uint64_t> &uids,
+                        std::vector<std::vector<uint64_t>> &out) {
+    for (uint64_t uid : uids) {
+      auto it = g_locatePort.find(uid);
+      if (it != g_locatePort.end() && it->second < ports)
+        out[it->second].push_back(uid);
+    }
+  };
+  byPort(g_locateLit, now);
+  byPort(next, then);
+
+  std::vector<IdentifyStep> steps(ports);
+  std::vector<std::vector<uint64_t>> failed(ports);
+  int64_t t0 = RdmNowUs();
+  for (int i = 0; i < ports; ++i) {
+    steps[i] = PlanIdentifyStep(now[i], then[i]);
+    if (clear) {
+      steps[i].allOff = true;
+      steps[i].off.clear();
+      steps[i].on = then[i];
+    }
+  }
+  ForEachPort([&](int i) {
+    if (!steps[i].Transactions())
       return;
-    std::string hex;
-    hex.reserve(len * 3 + 8);
-    for (int i = 0; i < len && i < 128; ++i) {
-      char buf[4];
-      snprintf(buf, sizeof(buf), "%02X ", data[i]);
-      hex += buf;
+    failed[i] = OnPort(i, std::vector<uint64_t>(), [&](auto &bus) {
+      return SendIdentifyStep(bus, srcUID, steps[i]);
+    });
+  });
+
+  g_locateState.transactions = 0;
+  g_locateState.failed = 0;
+  for (int i = 0; i < ports; ++i) {
+    g_locateState.transactions += steps[i].Transactions();
+    g_locateState.failed += static_cast<int32_t>(failed[i].size());
+  }
+  g_locateState.elapsedUs = RdmNowUs() - t0;
+  g_locateLit = next;
+}
+
+static void UpdateLocateState() {
+  g_locateState.targets = g_locator.Targets();
+  g_locateState.steps = g_locator.Steps();
+  g_locateState.stepsLeft = g_locator.StepsLeft();
+  g_locateState.lit = static_cast<int32_t>(g_locator.Lit().size());
+  g_locateState.done = g_locator.Done() ? 1 : 0;
+}
+
+RDX_API bool RDX_StartLocate(int targets, RDX_LocateState *state) {
+  if (targets < 1 || targets > RDX_LOCATE_MAX_TARGETS)
+    return false;
+  if (BusBusy())
+    return false;
+  std::lock_guard<std::mutex> lk(g_locateMutex);
+  std::vector<uint64_t> candidates;
+  g_locatePort.clear();
+  for (size_t i = 0; i < g_ports.size(); ++i) {
+    std::lock_guard<std::mutex> plk(g_ports[i]->mutex);
+    for (uint64_t uid : g_ports[i]->discovered) {
+      candidates.push_back(uid);
+      g_locatePort[uid] = static_cast<int>(i);
     }
-    if (len > 128)
-      hex += "...";
-    g_logCb(tx, hex.c_str(), NowUs());
+  }
+  if (candidates.empty())
+    return false;
+
+  memset(&g_locateState, 0, sizeof(g_locateState));
+  g_locateState.candidates = static_cast<int32_t>(candidates.size());
+  g_locator.Start(candidates, targets);
+  SendLocateStep(g_locator.Lit(), true);
+  UpdateLocateState();
+  TRACE_INFO("[Locate] %d target(s) among %d fixture(s), %d step(s)\n",
+             targets, g_locateState.candidates, g_locateState.stepsLeft);
+  if (state)
+    *state = g_locateState;
+  return true;
+}
+
+RDX_API bool RDX_LocateAnswer(const uint8_t *lit, int count,
+                              RDX_LocateState *state) {
+  if (!lit)
+    return false;
+  if (BusBusy())
+    return false;
+  std::lock_guard<std::mutex> lk(g_locateMutex);
+  if (!g_locator.Answer(std::vector<bool>(lit, lit + std::max(count, 0))))
+    return false;
+  SendLocateStep(g_locator.Lit(), false);
+  UpdateLocateState();
+  if (state)
+    *state = g_locateState;
+  return true;
+}
+
+RDX_API bool RDX_GetLocateState(RDX_LocateState *state) {
+  std::lock_guard<std::mutex> lk(g_locateMutex);
+  if (!state || !g_locator.Active())
+    return false;
+  *state = g_locateState;
+  return true;
+}
+
+RDX_API int RDX_GetLocateCandidates(int target, uint64_t *uids, int max) {
+  std::lock_guard<std::mutex> lk(g_locateMutex);
+  const std::vector<uint64_t> &cell = g_locator.Candidates(target);
+  int n = std::min(static_cast<int>(cell.size()), std::max(max, 0));
+  for (int i = 0; i < n && uids; ++i)
+    uids[i] = cell[i];
+  return static_cast<int>(cell.size());
+}
+
+RDX_API void RDX_StopLocate() {
+  std::lock_guard<std::mutex> lk(g_locateMutex);
+  if (!g_locator.Active())
+    return;
+  SendLocateStep({}, true);
+  g_locator.Stop();
+  g_locateLit.clear();
+  g_locatePort.clear();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Logging
+// ═══════════════════════════════════════════════════════════════════════
+
+RDX_API void RDX_SetLogCallback(RDX_LogCallback cb) {
+  g_logCb = cb;
+  StartTraceDispatcher();
+
+  // Drivers only copy raw frames into the trace ring; hex formatting and
+  // the callback run on the dispatcher thread.
+  InstallAllFrameHooks();
+}
+
+RDX_API void RDX_SetLogLevel(int level) {
+  if (level < RDX_LOG_OFF)
+    level = RDX_LOG_OFF;
+  if (level > RDX_LOG_FRAME)
+    level = RDX_LOG_FRAME;
+  GlobalTracer().SetLevel(static_cast<TraceLevel>(level));
+  StartTraceDispatcher();
+}
+
+RDX_API int RDX_GetLogLevel() {
+  return static_cast<int>(GlobalTracer().GetLevel());
+}
+
+RDX_API uint64_t RDX_GetLogDropped() { return GlobalTracer().Dropped(); }
+
+// ═══════════════════════════════════════════════════════════════════════
+// Metrics
+// ═══════════════════════════════════════════════════════════════════════
+
+static int MetricsPortCount() {
+  return g_ports.empty() ? 1 : static_cast<int>(g_ports.size());
+}
+
+static std::string RenderMetricsText() {
+  std::string text =
+      GlobalMetrics().RenderPrometheus(MetricsPortCount(), RdmNowUs());
+  char line[192];
+  snprintf(line, sizeof(line),
+           "# HELP rdx_log_queue_depth Log events waiting for delivery\n"
+           "# TYPE rdx_log_queue_depth gauge\n"
+           "rdx_log_queue_depth %llu\n",
+           static_cast<unsigned long long>(GlobalTracer().Pending()));
+  return text + line;
+}
+
+// Written to a temp file and moved over the target, so a scraper never
+// reads a half-written file.
+static bool WriteMetricsFile(const std::string &path) {
+  std::string text = RenderMetricsText();
+  std::string tmp = path + ".tmp";
+  FILE *f = fopen(tmp.c_str(), "wb");
+  if (!f)
+    return false;
+  bool ok = fwrite(text.data(), 1, text.size(), f) == text.size();
+  ok = (fclose(f) == 0) && ok;
+  return ok && MoveFileExA(tmp.c_str(), path.c_str(),
+                           MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+RDX_API bool RDX_GetMetrics(int port, RDX_Metrics *out) {
+  if (!out || port < -1 || port >= MetricsRegistry::kMaxPorts)
+    return false;
+  MetricsSnapshot s = GlobalMetrics().Snapshot(port, RdmNowUs());
+  out->dmxFramesTx = s[Metric::DMX_FRAMES_TX];
+  out->rdmRequestsTx = s[Metric::RDM_REQUESTS_TX];
+  out->rdmResponses = s[Metric::RDM_RESPONSES];
+  out->rdmNacks = s[Metric::RDM_NACKS];
+  out->rdmTimeouts = s[Metric::RDM_TIMEOUTS];
+  out->checksumErrors = s[Metric::CHECKSUM_ERRORS];
+  out->invalidResponses = s[Metric::INVALID_RESPONSES];
+  out->rxFrameErrors = s[Metric::RX_FRAME_ERRORS];
+  out->dubCollisions = s[Metric::DUB_COLLISIONS];
+  out->uidsDiscovered = s[Metric::UIDS_DISCOVERED];
+  out->purges = s[Metric::PURGES];
+  out->deviceOpens = s[Metric::DEVICE_OPENS];
+  out->recoveries = s[Metric::RECOVERIES];
+  out->usbErrors = s[Metric::USB_ERRORS];
+  out->rxQueueBytes = s.gauges[static_cast<int>(Gauge::RX_QUEUE_BYTES)];
+  out->logQueueDepth = static_cast<int64_t>(GlobalTracer().Pending());
+  out->dmxRateHz = s.dmxRateHz;
+  return true;
+}
+
+RDX_API void RDX_ResetMetrics() { GlobalMetrics().Reset(); }
+
+RDX_API bool RDX_WriteMetrics(const char *path) {
+  return path && WriteMetricsFile(path);
+}
+
+RDX_API bool RDX_StartMetricsDump(const char *path, int intervalMs) {
+  if (!path || intervalMs <= 0)
+    return false;
+  RDX_StopMetricsDump();
+  g_metricsStop = false;
+  std::string target(path);
+  g_metricsThread = std::thread([target, intervalMs] {
+    std::unique_lock<std::mutex> lk(g_metricsMutex);
+    do {
+      lk.unlock();
+      WriteMetricsFile(target);
+      lk.lock();
+    } while (!g_metricsCv.wait_for(lk, std::chrono::milliseconds(intervalMs),
+                                   [] { return g_metricsStop; }));
   });
+  return true;
+}
+
+RDX_API void RDX_StopMetricsDump() {
+  {
+    std::lock_guard<std::mutex> lk(g_metricsMutex);
+    g_metricsStop = true;
+  }
+  g_metricsCv.notify_all();
+  if (g_metricsThread.joinable())
+    g_metricsThread.join();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Performance trace
+// ═══════════════════════════════════════════════════════════════════════
+
+RDX_API bool RDX_PerfTraceAvailable() { return RDX_PERF_TRACE != 0; }
+
+RDX_API bool RDX_PerfTraceStart() {
+  if (!RDX_PERF_TRACE)
+    return false;
+  GlobalPerfTrace().Start();
+  return true;
+}
+
+RDX_API void RDX_PerfTraceStop() { GlobalPerfTrace().Stop(); }
+
+RDX_API int RDX_PerfTraceExport(const char *jsonPath) {
+  if (!jsonPath)
+    return -1;
+  return GlobalPerfTrace().ExportChromeJson(std::string(jsonPath));
+}
+
+RDX_API uint64_t RDX_GetPerfTraceDropped() {
+  return GlobalPerfTrace().Dropped();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Capture / replay
+// ═══════════════════════════════════════════════════════════════════════
+
+RDX_API bool RDX_StartCapture(const char *path) {
+  if (!path)
+    return false;
+  InstallAllFrameHooks();
+  if (!Capture().Open(path)) {
+    TRACE_ERROR("[RDX] cannot create capture %s\n", path);
+    return false;
+  }
+  return true;
+}
+
+RDX_API void RDX_StopCapture() { Capture().Close(); }
+
+RDX_API bool RDX_GetCaptureStats(RDX_CaptureStats *stats) {
+  if (!stats)
+    return false;
+  stats->frames = Capture().Frames();
+  stats->dropped = Capture().Dropped();
+  stats->bytes = Capture().Bytes();
+  return true;
+}
+
+RDX_API bool RDX_OpenReplay(const char *path, int port, double speed) {
+  if (!path)
+    return false;
+  RDX_Close();
+  g_driverType = RDX_DRIVER_REPLAY;
+  if (!g_replay.Open(path, port, speed))
+    return false;
+  OpenPorts();
+  return true;
+}
+
+RDX_API uint64_t RDX_GetReplayMismatches() { return g_replay.Mismatches(); }
+
+RDX_API bool RDX_OpenSimulator(const char *mapCsv, const char *attrCsv,
+                               int fixtures, int ports) {
+  if (!mapCsv || fixtures < 0 || ports < 1)
+    return false;
+  RDX_Close();
+  g_driverType = RDX_DRIVER_SIM;
+  auto model = LoadSimModel(mapCsv, attrCsv ? attrCsv : "");
+  if (!model) {
+    TRACE_ERROR("[RDX] cannot load parameter map %s\n", mapCsv);
+    return false;
+  }
+  g_simUIDs = MakeSimUIDs(fixtures, 0x434B);
+  g_simPorts = ports;
+  if (!g_sim.Open(model, SimPortUIDs(0)))
+    return false;
+  OpenPorts();
+  return true;
 }
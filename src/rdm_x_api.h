@@ -20,15 +20,27 @@ extern "C" {
 // ── Driver selection ────────────────────────────────────────────────────
 #define RDX_DRIVER_ENTTEC 0
 #define RDX_DRIVER_PEPERONI 1
+#define RDX_DRIVER_REPLAY 2 // capture file, see RDX_OpenReplay
+#define RDX_DRIVER_SIM 3    // simulated responders, see RDX_OpenSimulator
 
 RDX_API void RDX_SetDriver(int driverType); // call before Open
 RDX_API int RDX_GetDriver();                // current driver type
 RDX_API const char *RDX_GetDriverName(int driverType);
 
 // ── Device management ───────────────────────────────────────────────────
-RDX_API int RDX_ListDevices();
-RDX_API bool RDX_Open(int deviceIndex);
+RDX_API int RDX_ListDevices(); // cached after the first call
+RDX_API int RDX_RefreshDevices(); // rescan (hot-plug)
+RDX_API bool RDX_Open(int listIndex); // position in RDX_ListDevices
+
+// Serial-based selection (Peperoni).  Device numbers move when adapters are
+// plugged / unplugged; serials do not.
+RDX_API bool RDX_GetDeviceSerial(int listIndex, char *serial, int maxLen);
+RDX_API bool RDX_OpenBySerial(const char *serial);
 RDX_API void RDX_Close();
+// Closes the device and stops the background threads (log dispatcher,
+// metrics dump), delivering pending log events.  Call before unloading
+// the DLL with FreeLibrary; not needed at process exit.
+RDX_API void RDX_Shutdown();
 RDX_API bool RDX_IsOpen();
 RDX_API const char *RDX_FirmwareString();
 RDX_API uint32_t RDX_SerialNumber();
@@ -36,6 +48,89 @@ RDX_API uint32_t RDX_SerialNumber();
 // ── DMX output ──────────────────────────────────────────────────────────
 RDX_API bool RDX_SendDMX(const uint8_t *data, int len);
 
+// ── DMX input (Enttec only) ──────────────────────────────────────────────
+// Puts the widget into receive mode and captures every incoming frame on
+// a background thread.  RDM commands are refused while input is running.
+#pragma pack(push, 1)
+typedef struct {
+  uint64_t frames;      // frames received since start
+  uint64_t errorFrames; // widget reported queue overflow / overrun
+  int slotCount;        // slots in the last frame (excl. start code)
+  int startCode;        // start code of the last frame
+  double refreshHz;     // measured refresh rate
+  double intervalUs;    // mean inter-frame interval
+  double jitterUs;      // std deviation of the inter-frame interval
+  double minIntervalUs;
+  double maxIntervalUs;
+} RDX_DmxInputStats;
+#pragma pack(pop)
+
+RDX_API bool RDX_StartDmxInput();
+RDX_API void RDX_StopDmxInput();
+RDX_API bool RDX_IsDmxInputRunning();
+
+// Copies the latest frame (start code first) into `slots` and returns its
+// length.  `changedBits` (64 bytes, bit n = slot n+1, may be null) marks
+// slots changed since frame `*frameNum`; on return `*frameNum` holds the
+// number of the frame copied.  Pass *frameNum = 0 for "everything".
+RDX_API int RDX_GetDmxInput(uint8_t *slots, int maxLen, uint8_t *changedBits,
+                            uint64_t *frameNum);
+RDX_API bool RDX_GetDmxInputStats(RDX_DmxInputStats *stats);
+
+// ── Passive RDM sniffer ─────────────────────────────────────────────────
+// Listens on the active driver's receive path, classifies every frame and
+// pairs requests with responses.  Decoding runs on its own thread; records
+// wait in a bounded queue (oldest-first) until read.  RDM commands are
+// refused while the sniffer runs.
+#define RDX_SNIFF_DMX 0
+#define RDX_SNIFF_RDM_REQUEST 1
+#define RDX_SNIFF_RDM_RESPONSE 2
+#define RDX_SNIFF_DUB_RESPONSE 3
+#define RDX_SNIFF_ALT_START 4
+#define RDX_SNIFF_INVALID 5
+
+#pragma pack(push, 1)
+typedef struct {
+  int kind;             // RDX_SNIFF_*
+  int64_t timestampUs;  // capture time
+  uint64_t srcUID;      // DUB response: decoded responder UID
+  uint64_t destUID;
+  int transNum;
+  int commandClass;
+  int responseType;     // port ID for requests
+  int pid;
+  int paramLen;
+  int frameLen;
+  int64_t turnaroundUs; // responses: time since the request, else -1
+} RDX_SniffRecord;
+
+typedef struct {
+  uint64_t uid;
+  uint32_t responses;
+  uint32_t unanswered;
+  int64_t minTurnaroundUs;
+  int64_t maxTurnaroundUs;
+  int64_t meanTurnaroundUs;
+} RDX_SniffFixtureStats;
+
+typedef struct {
+  uint64_t framesCaptured;
+  uint64_t dmxFrames;
+  uint64_t framesDropped;
+  uint64_t recordsDropped;
+  uint64_t invalidFrames;
+  uint64_t fixturesDropped;
+} RDX_SnifferCounters;
+#pragma pack(pop)
+
+RDX_API bool RDX_StartSniffer();
+RDX_API void RDX_StopSniffer();
+RDX_API bool RDX_IsSnifferRunning();
+RDX_API int RDX_ReadSniffRecords(RDX_SniffRecord *out, int maxRecords);
+RDX_API int RDX_GetSniffFixtureStats(RDX_SniffFixtureStats *out,
+                                     int maxFixtures);
+RDX_API bool RDX_GetSnifferCounters(RDX_SnifferCounters *counters);
+
 // ── RDM Discovery ───────────────────────────────────────────────────────
 RDX_API int RDX_Discover(); // returns UID count
 RDX_API bool RDX_GetDiscoveredUID(int index, uint64_t *uid);
@@ -47,15 +142,35 @@ RDX_API bool RDX_GetDiscoveredUID(int index, uint64_t *uid);
 #define RDX_STATUS_TIMEOUT 3
 #define RDX_STATUS_CHECKSUM_ERR 4
 #define RDX_STATUS_INVALID 5
+// Not sent: the bus is held by DMX input, the sniffer or a fleet run
+#define RDX_STATUS_BUSY 6
+
+// Where RDX_Timing.responderUs came from
+#define RDX_TIMING_NONE 0          // no response
+#define RDX_TIMING_HOST_ESTIMATE 1 // host clock minus wire time (upper bound)
+#define RDX_TIMING_DEVICE 2        // interface hardware timestamps
 
 #pragma pack(push, 1)
+// Per-stage breakdown of one transaction.  The stages add up to totalUs.
+typedef struct {
+  int64_t totalUs;     // submit -> response parsed
+  int64_t usbWriteUs;  // submit -> USB write complete
+  int64_t wireUs;      // request + response frames on the DMX line
+  int64_t responderUs; // responder turnaround, -1 if no response
+  int64_t hostUs;      // first RX on the host -> parsed
+  int64_t overheadUs;  // remaining USB / interface latency
+  int responderSource; // RDX_TIMING_*
+  int resolutionUs;    // granularity of responderUs (0 = host clock)
+} RDX_Timing;
+
 typedef struct {
   int status;         // RDX_STATUS_*
   int nackReason;     // valid when status == NACK
   int dataLen;        // bytes in data[]
   uint8_t data[231];  // max RDM PDL
-  int64_t latencyUs;  // TX-to-RX microseconds
+  int64_t latencyUs;  // end-to-end microseconds (== timing.totalUs)
   bool checksumValid; // was the RDM checksum correct?
+  RDX_Timing timing;
 } RDX_Response;
 #pragma pack(pop)
 
@@ -69,18 +184,512 @@ RDX_API bool RDX_SendSET(uint64_t destUID, uint16_t pid,
                          const uint8_t *paramData, int paramLen,
                          RDX_Response *response);
 
+// ── Ports (multi-universe interfaces) ───────────────────────────────────
+// Each DMX line of the open interface is a separate logical bus with its
+// own DMX buffer, RDM transaction state and discovery list.  Enttec has a
+// single port; a multi-universe Peperoni exposes one port per universe.
+// Different ports may be driven from different threads at the same time.
+RDX_API int RDX_GetPortCount();
+RDX_API int RDX_DiscoverPorts(); // parallel, one thread per port; total UIDs
+RDX_API int RDX_GetPortUIDCount(int port);
+RDX_API bool RDX_GetPortDiscoveredUID(int port, int index, uint64_t *uid);
+RDX_API bool RDX_SendPortDMX(int port, const uint8_t *data, int len);
+RDX_API bool RDX_SendPortGET(int port, uint64_t destUID, uint16_t pid,
+                             const uint8_t *paramData, int paramLen,
+                             RDX_Response *response);
+RDX_API bool RDX_SendPortSET(int port, uint64_t destUID, uint16_t pid,
+                             const uint8_t *paramData, int paramLen,
+                             RDX_Response *response);
+
+// ── Latency statistics ──────────────────────────────────────────────────
+// Every GET/SET is recorded per (UID, PID, command class): a latency
+// histogram of the responder turnaround (RDX_Timing.responderUs) and a
+// count per RDX_STATUS_*.  `windowed` selects the rolling window (the
+// last 1-2 window lengths) instead of everything since the last reset.
+#pragma pack(push, 1)
+typedef struct {
+  uint64_t uid; // 0 in the fleet-wide summary
+  uint16_t pid;
+  uint8_t commandClass;
+  uint8_t reserved;
+  uint32_t statusCounts[6]; // indexed by RDX_STATUS_*
+  uint64_t samples;         // latency samples (responses)
+  int64_t minUs;
+  int64_t p50Us;
+  int64_t p90Us;
+  int64_t p99Us;
+  int64_t maxUs;
+  double meanUs;
+} RDX_LatencyStats;
+#pragma pack(pop)
+
+RDX_API int RDX_GetLatencyStatCount();
+// Copies up to `max` entries, slowest p99 first; returns the count.
+RDX_API int RDX_GetLatencyStats(RDX_LatencyStats *out, int max,
+                                bool windowed);
+RDX_API bool RDX_GetFleetLatency(RDX_LatencyStats *out, bool windowed);
+RDX_API void RDX_SetLatencyWindow(int seconds); // default 60
+RDX_API void RDX_ResetLatencyStats();
+
 // ── Parameter database ──────────────────────────────────────────────────
 RDX_API int RDX_LoadParameters(const char *csvPath); // returns count
 RDX_API bool RDX_GetParameterInfo(int index, uint16_t *pid, char *name,
                                   int nameMaxLen, char *cmdClass,
                                   int cmdClassMaxLen, bool *isMandatory);
 
+// ── Device profile ──────────────────────────────────────────────────────
+// Reads a fixture's DEVICE_INFO and SUPPORTED_PARAMETERS, then every
+// indexed descriptor they call for in the same call: each personality
+// description, each sensor definition and the PARAMETER_DESCRIPTION of
+// each manufacturer PID.  Goes through the descriptor cache when it is
+// on.  The pieces are read back with the RDX_GetProfile* calls until the
+// next RDX_ReadDeviceProfile.
+#pragma pack(push, 1)
+typedef struct {
+  int32_t haveInfo;      // DEVICE_INFO answered
+  int32_t haveSupported; // SUPPORTED_PARAMETERS answered
+  uint16_t protocol;
+  uint16_t model;
+  uint16_t category;
+  uint32_t softwareVersion;
+  uint16_t footprint;
+  uint8_t personality;
+  uint8_t personalityCount;
+  uint16_t startAddress;
+  uint16_t subDevices;
+  uint8_t sensorCount;
+  int32_t supported;     // PIDs listed
+  int32_t personalities; // descriptions read
+  int32_t sensors;
+  int32_t parameters;
+  int32_t requests;      // GETs sent
+  int32_t failed;        // indexed GETs without a usable answer
+  int64_t elapsedUs;
+} RDX_DeviceProfile;
+
+typedef struct {
+  uint8_t number;
+  uint16_t footprint;
+  char description[33];
+} RDX_PersonalityDesc;
+
+typedef struct {
+  uint8_t number;
+  uint8_t type;
+  uint8_t unit;
+  uint8_t prefix;
+  int16_t rangeMin;
+  int16_t rangeMax;
+  int16_t normalMin;
+  int16_t normalMax;
+  uint8_t recordedSupport;
+  char description[33];
+} RDX_SensorDef;
+
+typedef struct {
+  uint16_t pid;
+  uint8_t pdlSize;
+  uint8_t dataType;
+  uint8_t commandClass;
+  uint8_t type;
+  uint8_t unit;
+  uint8_t prefix;
+  uint32_t minValue;
+  uint32_t maxValue;
+  uint32_t defaultValue;
+  char description[33];
+} RDX_ParameterDesc;
+#pragma pack(pop)
+
+// False when neither DEVICE_INFO nor SUPPORTED_PARAMETERS answered
+RDX_API bool RDX_ReadDeviceProfile(uint64_t uid, RDX_DeviceProfile *out);
+// Copies up to `max` listed PIDs; returns the count copied (all of them
+// when `pids` is null)
+RDX_API int RDX_GetProfileSupported(uint16_t *pids, int max);
+RDX_API bool RDX_GetProfilePersonality(int index, RDX_PersonalityDesc *out);
+RDX_API bool RDX_GetProfileSensor(int index, RDX_SensorDef *out);
+RDX_API bool RDX_GetProfileParameter(int index, RDX_ParameterDesc *out);
+
+// ── Configuration push ──────────────────────────────────────────────────
+// Applies a Settings column of the map loaded with RDX_LoadParameters to
+// every UID found by RDX_DiscoverPorts, one thread per port.  Each port
+// runs three passes over its fixtures: compare GETs (a PID that already
+// holds the value is skipped), SETs, then read-back GETs.  Blocks until
+// every port is done.
+#define RDX_CONFIG_FW_DEFAULTS 0
+#define RDX_CONFIG_TEST 1
+#define RDX_CONFIG_SHIPPING 2
+
+#define RDX_PUSH_VERIFY 1        // read every SET back
+#define RDX_PUSH_SKIP_MATCHING 2 // GET first, SET only what differs
+#define RDX_PUSH_USE_KNOWN 4     // trust values verified by earlier pushes
+
+#pragma pack(push, 1)
+typedef struct {
+  int32_t configSets;   // SETs the column calls for, per fixture
+  int32_t fixtures;
+  int32_t okFixtures;   // no failed or mismatched SET
+  int32_t transactions; // GETs + SETs sent, all fixtures
+  int32_t sent;         // SETs sent
+  int32_t skipped;      // already held the value
+  int32_t failed;       // SET refused or unanswered
+  int32_t mismatched;   // read back another value
+  int32_t pending;      // ACK_TIMER, still deferred at read-back
+  int64_t elapsedUs;
+} RDX_PushSummary;
+
+typedef struct {
+  uint64_t uid;
+  int32_t port;
+  int32_t gets;     // compare GETs
+  int32_t sets;
+  int32_t verifies; // read-back GETs
+  int32_t skipped;
+  int32_t failed;
+  int32_t mismatched;
+  int32_t pending;
+  int64_t elapsedUs;
+} RDX_PushFixture;
+#pragma pack(pop)
+
+// SETs in `column` (RDX_CONFIG_*); -1 for a bad column
+RDX_API int RDX_GetConfigCount(int column);
+RDX_API bool RDX_PushConfig(int column, int flags, RDX_PushSummary *summary);
+RDX_API bool RDX_GetPushFixture(int index, RDX_PushFixture *out);
+// Forgets the values RDX_PUSH_USE_KNOWN relies on
+RDX_API void RDX_ClearPushedValues();
+
+// ── Broadcast SET ───────────────────────────────────────────────────────
+// One SET frame per port to every responder of the line (0xFFFFFFFFFFFF)
+// or of one manufacturer (mmmm:FFFFFFFF) — identify off, reset, curve,
+// fade time — instead of a SET and its ACK per fixture.  Nobody answers
+// a broadcast; `verifySamples` > 0 re-reads the PID on that many randomly
+// chosen discovered UIDs per port to confirm it was applied.
+#pragma pack(push, 1)
+typedef struct {
+  int32_t ports;
+  int32_t sent;        // ports the frame went out on
+  int32_t addressed;   // discovered UIDs the destination reaches
+  int32_t sampled;
+  int32_t confirmed;   // read back the value
+  int32_t mismatched;  // answered with another value
+  int32_t unconfirmed; // NACK or no answer
+  int64_t elapsedUs;
+} RDX_BroadcastResult;
+#pragma pack(pop)
+
+// False for a unicast destination, or when a port could not send
+RDX_API bool RDX_SendBroadcastSET(uint64_t destUID, uint16_t pid,
+                                  const uint8_t *paramData, int paramLen,
+                                  int verifySamples,
+                                  RDX_BroadcastResult *result);
+// Sampled UIDs of the last broadcast that did not confirm the value
+RDX_API bool RDX_GetBroadcastFailedUID(int index, uint64_t *uid);
+
+// ── DMX address plan ────────────────────────────────────────────────────
+// Commissioning a line in two calls.  RDX_PlanAddresses reads every
+// discovered fixture's footprint and start address (DEVICE_INFO, or the
+// CK footprint opcode 0x860F) and packs the start addresses of each port
+// gap-free from `firstAddress`, lowest UID first, around the fixtures
+// marked fixed.  RDX_ApplyAddressPlan then SETs every address that moves,
+// one thread per port, and reads them back when `verify` is set.
+#pragma pack(push, 1)
+typedef struct {
+  int32_t ports;
+  int32_t fixtures;
+  int32_t moves;      // start addresses the plan changes (still to change)
+  int32_t unplaced;   // no room left, or the footprint could not be read
+  int32_t overlaps;   // fixed fixtures sharing DMX slots
+  int32_t sent;       // RDX_ApplyAddressPlan: SETs sent
+  int32_t failed;     // SET refused or unanswered
+  int32_t mismatched; // read back another address
+  int64_t elapsedUs;
+} RDX_AddressSummary;
+
+typedef struct {
+  uint64_t uid;
+  int32_t port;
+  uint16_t footprint;
+  uint16_t current; // 0xFFFF: none
+  uint16_t planned; // 0xFFFF: none (no footprint, or unplaced)
+  uint8_t fixed;
+  uint8_t overlaps;
+} RDX_AddressSlot;
+
+typedef struct {
+  uint64_t uid;
+  int32_t port;
+  uint16_t from;
+  uint16_t to;
+  int32_t outcome; // 1 set, 2 failed, 3 read back another address,
+                   // 4 ACK_TIMER, still deferred at read-back
+  uint16_t nackReason;
+  uint16_t readBack;
+} RDX_AddressPatch;
+#pragma pack(pop)
+
+// Fixed fixtures keep their current address in later plans
+RDX_API void RDX_SetAddressFixed(uint64_t uid, bool fixed);
+RDX_API void RDX_ClearFixedAddresses();
+RDX_API bool RDX_PlanAddresses(int firstAddress, RDX_AddressSummary *summary);
+RDX_API bool RDX_GetAddressSlot(int index, RDX_AddressSlot *out);
+// False when a SET failed or did not read back
+RDX_API bool RDX_ApplyAddressPlan(bool verify, RDX_AddressSummary *summary);
+RDX_API bool RDX_GetAddressPatch(int index, RDX_AddressPatch *out);
+
+// ── Fixture locator ─────────────────────────────────────────────────────
+// Finds where discovered UIDs hang by binary search with identify: each
+// step identifies half of the candidates and the operator answers, for
+// every fixture being looked for, whether it lit up.  One fixture out of
+// 512 takes 9 answers; up to RDX_LOCATE_MAX_TARGETS fixtures are looked
+// for in the same number of steps.  Only fixtures whose identify state
+// changes are sent a SET, or one broadcast off when that is shorter.
+// A SET is one exchange of about 3-5 ms, so the first step on a line of
+// 512 takes about 1-1.3 s and later ones at most half that; ports step in
+// parallel.
+// Once done the found fixtures are left identifying until RDX_StopLocate.
+#define RDX_LOCATE_MAX_TARGETS 32
+
+#pragma pack(push, 1)
+typedef struct {
+  int32_t targets;
+  int32_t candidates;   // discovered UIDs the search started with
+  int32_t steps;        // answers given
+  int32_t stepsLeft;    // answers still needed, at most
+  int32_t lit;          // fixtures identifying now
+  int32_t done;         // every target down to one UID
+  int32_t transactions; // last step: frames sent, all ports
+  int32_t failed;       // last step: identify SETs not acknowledged
+  int64_t elapsedUs;    // last step
+} RDX_LocateState;
+#pragma pack(pop)
+
+RDX_API bool RDX_StartLocate(int targets, RDX_LocateState *state);
+// `lit[t]` non-zero: target t is identifying; `count` must equal targets
+RDX_API bool RDX_LocateAnswer(const uint8_t *lit, int count,
+                              RDX_LocateState *state);
+RDX_API bool RDX_GetLocateState(RDX_LocateState *state);
+// Copies up to `max` of target's candidates; returns how many it has
+// (one once found)
+RDX_API int RDX_GetLocateCandidates(int target, uint64_t *uids, int max);
+// Identify off everywhere
+RDX_API void RDX_StopLocate();
+
+// ── Fleet validation ────────────────────────────────────────────────────
+// Validates every UID found by RDX_DiscoverPorts against the parameters
+// loaded with RDX_LoadParameters, one worker per port.  Each sweep is
+// planned from the fixture's SUPPORTED_PARAMETERS (and the CK
+// available-parameter list): unlisted parameters are classified without
+// a request, the rest are sent cheapest first.  A fixture found on
+// several ports is swept by whichever of them is free first.  Every row
+// is published to a lock-free stream the moment its GET completes (a
+// full stream drops rows, counted), and each fixture's result is queued
+// once its sweep is done; other RDM calls are refused until the run ends.
+// The rows of a run are kept in one columnar store (about 30 bytes a row
+// plus response data) until the next run or RDX_ClosePorts.
+#pragma pack(push, 1)
+typedef struct {
+  uint64_t uid;
+  int32_t port;        // port that ran the sweep
+  int32_t stolen;      // 1 = taken over from another port's queue
+  int32_t rowCount;    // see RDX_GetFleetResultRow
+  int32_t green;
+  int32_t yellow;
+  int32_t red;
+  int64_t sweepUs;     // duration of this fixture's sweep
+  int64_t completedUs; // time since the run started
+  int32_t missing;     // rows classified from the supported list
+  int64_t predictedUs; // the plan's estimate (0 when not planned)
+  int32_t aborted;       // 1 = fail-fast skipped rows after a RED one
+  int64_t firstResultUs; // sweep start to its first row
+  int32_t cached;        // rows reused from the fixture's snapshot
+  int32_t shared;        // descriptor GETs answered from the model cache
+} RDX_FleetFixture;
+
+typedef struct {
+  uint16_t pid;
+  uint8_t status;      // 0 green, 1 yellow, 2 red
+  uint8_t isMandatory;
+  int32_t response;    // RDX_STATUS_*
+  char value[128];     // hex response data or the failure, truncated
+} RDX_ValidationRow;
+
+typedef struct {
+  uint64_t uid;
+  int32_t port;
+  int32_t index;  // row index in the parameter list
+  int64_t timeUs; // since the run started
+  RDX_ValidationRow row;
+} RDX_StreamRow;
+
+typedef struct {
+  int32_t supported;     // PIDs the fixture listed
+  int32_t gets;          // requests the sweep will send
+  int32_t missing;       // parameters classified without a request
+  int32_t haveSupported; // 0: SUPPORTED_PARAMETERS failed, blind sweep
+  int64_t probeUs;       // spent fetching the lists
+  int64_t predictedUs;   // expected duration of the requests
+} RDX_ValidationPlan;
+
+typedef struct {
+  int32_t fixtures;  // queued at start
+  int32_t completed;
+  int32_t stolen;
+  int32_t running;   // 1 until every port has finished
+  int64_t elapsedUs;
+} RDX_FleetProgress;
+
+typedef struct {
+  uint64_t hits;   // descriptor GETs answered from the cache
+  uint64_t misses; // descriptor GETs sent
+  int32_t models;  // manufacturer / model / software version keys
+  int32_t entries; // responses held
+} RDX_DescriptorStats;
+#pragma pack(pop)
+
+// Plans (but does not run) the sweep of one fixture on the main driver
+RDX_API bool RDX_PlanValidation(uint64_t uid, RDX_ValidationPlan *plan);
+// Off: every parameter is requested in map order, as before.  Default on.
+RDX_API void RDX_SetValidationPlanning(bool enable);
+
+// Re-test passes: keep each CK fixture's last sweep and, on the next run,
+// re-read only the PIDs whose database changed according to its settings
+// hash (0x803A) — one GET for an unchanged fixture.  Default off.
+RDX_API void RDX_SetSnapshotValidation(bool enable);
+// Forgets every snapshot (after a firmware update, say)
+RDX_API void RDX_ClearSnapshots();
+
+// Large fleets of one model: read descriptive PIDs (PARAMETER_DESCRIPTION,
+// labels, personality / sensor / curve descriptions) once per model and
+// software version, and answer them from memory for the other fixtures.
+// Default off.
+RDX_API void RDX_SetDescriptorCaching(bool enable);
+// Merges a saved cache; returns the responses read, -1 on error or for a
+// file of another version.  Damaged lines are skipped.
+RDX_API int RDX_LoadDescriptorCache(const char *path);
+RDX_API bool RDX_SaveDescriptorCache(const char *path);
+RDX_API void RDX_ClearDescriptorCache();
+RDX_API bool RDX_GetDescriptorCacheStats(RDX_DescriptorStats *stats);
+
+// Pass / fail stations: stop each fixture's sweep at its first RED row.
+// Applies to the next run.  Default off.
+RDX_API void RDX_SetFleetFailFast(bool enable);
+
+// Returns the number of fixtures queued; -1 when a run is in progress,
+// nothing was discovered or no parameters are loaded.
+RDX_API int RDX_StartFleetValidation();
+// Copies up to `max` rows from the live stream; returns the count
+RDX_API int RDX_ReadFleetRows(RDX_StreamRow *out, int max);
+RDX_API uint64_t RDX_GetFleetRowsDropped(); // rows lost to a full stream
+// Pops the next completed fixture; false when none is ready yet
+RDX_API bool RDX_NextFleetResult(RDX_FleetFixture *out);
+// Rows of the fixture last returned by RDX_NextFleetResult
+RDX_API bool RDX_GetFleetResultRow(int index, RDX_ValidationRow *row);
+// Memory held by the rows of the current run
+RDX_API uint64_t RDX_GetFleetResultBytes();
+RDX_API bool RDX_GetFleetProgress(RDX_FleetProgress *progress);
+RDX_API int RDX_GetFleetPortCompleted(int port); // fixtures done by `port`
+// Stops handing out fixtures and waits for the sweeps still running; their
+// results remain queued.
+RDX_API void RDX_CancelFleetValidation();
+
 // ── Logging ─────────────────────────────────────────────────────────────
 // Callback: isTX, hex string, timestamp in microseconds since DLL load.
 typedef void(__stdcall *RDX_LogCallback)(bool isTX, const char *hex,
                                          int64_t timestampUs);
 RDX_API void RDX_SetLogCallback(RDX_LogCallback cb);
 
+// Log events are recorded as binary events in a lock-free ring and
+// formatted / delivered on a background thread.  Events above the level
+// are not recorded at all.  Default RDX_LOG_FRAME (everything).
+#define RDX_LOG_OFF 0
+#define RDX_LOG_ERROR 1
+#define RDX_LOG_INFO 2
+#define RDX_LOG_DEBUG 3 // protocol steps
+#define RDX_LOG_FRAME 4 // raw TX / RX frames
+RDX_API void RDX_SetLogLevel(int level);
+RDX_API int RDX_GetLogLevel();
+RDX_API uint64_t RDX_GetLogDropped(); // events lost to a full ring
+
+// ── Metrics ─────────────────────────────────────────────────────────────
+// Counters are cumulative since load / RDX_ResetMetrics.  `port` -1 sums
+// every port; the single-port drivers report as port 0.
+#pragma pack(push, 1)
+typedef struct {
+  uint64_t dmxFramesTx;
+  uint64_t rdmRequestsTx;    // RDM + discovery requests written
+  uint64_t rdmResponses;     // ACK / ACK_TIMER / NACK
+  uint64_t rdmNacks;
+  uint64_t rdmTimeouts;
+  uint64_t checksumErrors;   // RDX_STATUS_CHECKSUM_ERR
+  uint64_t invalidResponses; // RDX_STATUS_INVALID
+  uint64_t rxFrameErrors;    // framing error / overrun
+  uint64_t dubCollisions;
+  uint64_t uidsDiscovered;
+  uint64_t purges;
+  uint64_t deviceOpens;
+  uint64_t recoveries; // FTDI driver reloads after a failed open
+  uint64_t usbErrors;
+  int64_t rxQueueBytes;  // gauge: interface RX queue at last poll
+  int64_t logQueueDepth; // gauge: log events awaiting delivery (global)
+  double dmxRateHz;      // achieved DMX output rate (>= 1 s sample)
+} RDX_Metrics;
+#pragma pack(pop)
+
+RDX_API bool RDX_GetMetrics(int port, RDX_Metrics *out);
+RDX_API void RDX_ResetMetrics();
+// Prometheus text format (node_exporter textfile collector compatible).
+// The file is replaced atomically on every write.
+RDX_API bool RDX_WriteMetrics(const char *path);
+RDX_API bool RDX_StartMetricsDump(const char *path, int intervalMs);
+RDX_API void RDX_StopMetricsDump();
+
+// ── Performance trace ───────────────────────────────────────────────────
+// Scoped spans around API calls, RDM transactions, discovery steps, DMX
+// frames, purges, sleeps and USB driver calls, recorded into per-thread
+// buffers.  Export writes Chrome trace-event JSON (open in
+// chrome://tracing or ui.perfetto.dev) with the events recorded since the
+// previous export; returns the event count or -1.  Only available when
+// the DLL was built with RDM_PERF_TRACE=ON.
+RDX_API bool RDX_PerfTraceAvailable();
+RDX_API bool RDX_PerfTraceStart();
+RDX_API void RDX_PerfTraceStop();
+RDX_API int RDX_PerfTraceExport(const char *jsonPath);
+RDX_API uint64_t RDX_GetPerfTraceDropped(); // events lost to full buffers
+
+// ── Capture / replay ────────────────────────────────────────────────────
+// Records every RDM / DMX frame written or read by the interface (time,
+// direction, port, widget label, raw bytes) to a binary capture file with
+// a seek index.  Frames are queued from the I/O threads and written by a
+// background thread through a memory-mapped view; a full queue drops the
+// frame (counted) instead of stalling the bus.
+#pragma pack(push, 1)
+typedef struct {
+  uint64_t frames;  // frames written
+  uint64_t dropped; // frames lost to a full queue
+  uint64_t bytes;   // file size so far
+} RDX_CaptureStats;
+#pragma pack(pop)
+
+RDX_API bool RDX_StartCapture(const char *path);
+RDX_API void RDX_StopCapture(); // writes the index, closes the file
+RDX_API bool RDX_GetCaptureStats(RDX_CaptureStats *stats);
+
+// Opens a capture as the RDX_DRIVER_REPLAY device: discovery and GET/SET
+// run against the recorded responses of `port`.  `speed` scales the
+// recorded pacing (1 = original, 0 = as fast as possible).
+RDX_API bool RDX_OpenReplay(const char *path, int port, double speed);
+// Requests that did not match the capture (changed traffic)
+RDX_API uint64_t RDX_GetReplayMismatches();
+
+// Opens `fixtures` simulated responders as the RDX_DRIVER_SIM device, built
+// from the Vaya parameter map and (optionally, may be NULL) the
+// PIDAttributes.csv opcode table.  The fixtures are spread over `ports`
+// simulated buses; discovery, GET/SET and the port calls work as on
+// hardware, without an interface attached.
+RDX_API bool RDX_OpenSimulator(const char *mapCsv, const char *attrCsv,
+                               int fixtures, int ports);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,228 @@
+// ────────────────────────────────────────────────────────────────────────
+// ReplayDriver — feeds a capture file back through the RDM stack
+// ────────────────────────────────────────────────────────────────────────
+#include "replay_driver.h"
+#include "capture_file.h"
+#include "enttec_pro.h"
+#include "metrics.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <cstring>
+#include <windows.h>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Open / close
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool ReplayDriver::Open(const std::string &path, int port, double speed) {
+  CaptureReader reader;
+  if (!reader.Open(path)) {
+    TRACE_ERROR("[Replay] cannot read capture %s\n", path.c_str());
+    return false;
+  }
+  return LoadFrom(reader, port, speed);
+}
+
+bool ReplayDriver::Load(const std::vector<uint8_t> &capture, int port,
+                        double speed) {
+  CaptureReader reader;
+  if (!reader.Load(capture))
+    return false;
+  return LoadFrom(reader, port, speed);
+}
+
+// Keeps only the frames the RDM layer sees: requests as written and
+// responses as ReceiveRDM returns them.  DMX output and widget
+// housekeeping (parameters, serial number) are dropped.
+bool ReplayDriver::LoadFrom(CaptureReader &reader, int port, double speed) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_frames.clear();
+  CaptureFrameView v;
+  while (reader.Next(v)) {
+    if (v.port != port)
+      continue;
+    Frame f;
+    f.timestampUs = v.timestampUs;
+    f.tx = v.direction == CaptureDirection::TX;
+    f.statusByte = 0;
+    const uint8_t *p = v.payload;
+    int n = v.length;
+    if (v.label == CAPTURE_LABEL_RAW) {
+      // Peperoni: requests and responses exactly as on the line
+    } else if (f.tx) {
+      if (v.label != LABEL_TX_RDM && v.label != LABEL_TX_RDM_DISCOVERY)
+        continue;
+    } else {
+      if (v.label != LABEL_RX_DMX_PACKET || n < 1)
+        continue;
+      f.statusByte = p[0]; // widget status byte, then the slots
+      ++p;
+      --n;
+    }
+    f.bytes.assign(p, p + n);
+    m_frames.push_back(std::move(f));
+  }
+
+  m_cursor = 0;
+  m_rx.clear();
+  m_rxHead = 0;
+  m_speed = speed > 0 ? speed : 0;
+  m_firstUs = m_frames.empty() ? 0 : m_frames.front().timestampUs;
+  m_startUs = RdmNowUs();
+  m_requests = 0;
+  m_mismatches = 0;
+  m_open = true;
+  TRACE_INFO("[Replay] %d frame(s) for port %d, speed %.1f\n",
+             (int)m_frames.size(), port, m_speed);
+  return true;
+}
+
+void ReplayDriver::Close() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_open = false;
+  m_frames.clear();
+  m_rx.clear();
+  m_rxHead = 0;
+  m_cursor = 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Recorded state
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Caller holds m_mutex
+size_t ReplayDriver::NextRequest(size_t from) const {
+  while (from < m_frames.size() && !m_frames[from].tx)
+    ++from;
+  return from;
+}
+
+uint64_t ReplayDriver::ControllerUID() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  size_t i = NextRequest(0);
+  if (i >= m_frames.size() || m_frames[i].bytes.size() < 15)
+    return 0;
+  const uint8_t *b = m_frames[i].bytes.data() + 9; // source UID
+  uint64_t uid = 0;
+  for (int k = 0; k < 6; ++k)
+    uid = (uid << 8) | b[k];
+  return uid;
+}
+
+uint8_t ReplayDriver::NextTransNum() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  size_t i = NextRequest(m_cursor);
+  if (i >= m_frames.size() || m_frames[i].bytes.size() < 16)
+    return 0;
+  return m_frames[i].bytes[15];
+}
+
+uint64_t ReplayDriver::Requests() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_requests;
+}
+
+uint64_t ReplayDriver::Mismatches() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_mismatches;
+}
+
+bool ReplayDriver::AtEnd() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return NextRequest(m_cursor) >= m_frames.size();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Driver interface
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool ReplayDriver::SendDMX(const uint8_t *data, int len) {
+  if (!m_open || !data || len <= 0)
+    return false;
+  GlobalMetrics().Add(m_metricsPort, Metric::DMX_FRAMES_TX);
+  return true;
+}
+
+bool ReplayDriver::SendRDM(const uint8_t *data, int len) {
+  return Exchange(data, len);
+}
+
+bool ReplayDriver::SendRDMDiscovery(const uint8_t *data, int len) {
+  return Exchange(data, len);
+}
+
+// Sleeps until the recorded request time, scaled by the replay speed.
+// Caller holds m_mutex.
+void ReplayDriver::Pace(int64_t timestampUs) {
+  if (m_speed <= 0)
+    return;
+  int64_t due = m_startUs + static_cast<int64_t>(
+                                (timestampUs - m_firstUs) / m_speed);
+  int64_t waitUs = due - RdmNowUs();
+  if (waitUs > 1000)
+    Sleep(static_cast<DWORD>(waitUs / 1000));
+}
+
+bool ReplayDriver::Exchange(const uint8_t *data, int len) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (!m_open || !data || len <= 0)
+    return false;
+  GlobalMetrics().Add(m_metricsPort, Metric::RDM_REQUESTS_TX);
+  m_rx.clear();
+  m_rxHead = 0;
+
+  size_t req = NextRequest(m_cursor);
+  if (req >= m_frames.size()) {
+    ++m_mismatches; // more requests than the capture holds
+    TRACE_DEBUG("[Replay] request beyond the end of the capture\n");
+    return true;
+  }
+  const Frame &f = m_frames[req];
+  ++m_requests;
+  if (f.bytes.size() != static_cast<size_t>(len) ||
+      memcmp(f.bytes.data(), data, len) != 0) {
+    ++m_mismatches;
+    TRACE_DEBUG("[Replay] request %llu differs from the capture\n",
+                static_cast<unsigned long long>(m_requests));
+  }
+  Pace(f.timestampUs);
+
+  // Responses recorded up to the next request
+  size_t next = NextRequest(req + 1);
+  for (size_t i = req + 1; i < next; ++i)
+    m_rx.push_back(i);
+  m_cursor = next;
+  return true;
+}
+
+int ReplayDriver::ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (!m_open || m_rxHead >= m_rx.size()) {
+    statusByte = 0xFF;
+    return -1;
+  }
+  const Frame &f = m_frames[m_rx[m_rxHead++]];
+  statusByte = f.statusByte;
+  if (statusByte & 0x03)
+    GlobalMetrics().Add(m_metricsPort, Metric::RX_FRAME_ERRORS);
+  int n = static_cast<int>(f.bytes.size());
+  if (n > maxLen)
+    n = maxLen;
+  if (n > 0)
+    memcpy(out, f.bytes.data(), n);
+  return n;
+}
+
+// Replies are queued as the request is sent; there is nothing to wait for
+bool ReplayDriver::WaitForData(int /*timeoutMs*/) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_rxHead < m_rx.size();
+}
+
+void ReplayDriver::Purge() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_rx.clear();
+  m_rxHead = 0;
+  GlobalMetrics().Add(m_metricsPort, Metric::PURGES);
+}
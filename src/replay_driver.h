@@ -0,0 +1,82 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// ReplayDriver — feeds a capture file back through the RDM stack
+// ────────────────────────────────────────────────────────────────────────
+#ifndef REPLAY_DRIVER_H
+#define REPLAY_DRIVER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class CaptureReader; // forward
+
+// Duck-typed like EnttecPro / PeperoniRodin, so RDMDiscovery, the API's
+// command path and OnPort() run unchanged against recorded traffic.
+//
+// Each SendRDM / SendRDMDiscovery consumes the next recorded RDM request
+// of the selected port and queues the responses recorded after it;
+// ReceiveRDM hands those back.  A request that differs from the recorded
+// one is counted in Mismatches() (the replay carries on regardless), so a
+// parser or protocol change that alters the traffic shows up as a count.
+// NextTransNum() and ControllerUID() return the recorded values, so an
+// unchanged stack reproduces the capture byte for byte.
+class ReplayDriver {
+public:
+  // `speed` scales the recorded pacing (1 = original timing, 10 = ten
+  // times faster, 0 = as fast as possible).  `port` selects one port's
+  // frames of a multi-port capture.
+  bool Open(const std::string &path, int port = 0, double speed = 0);
+  bool Load(const std::vector<uint8_t> &capture, int port = 0,
+            double speed = 0); // same, from memory
+  void Close();
+  bool IsOpen() const { return m_open; }
+
+  std::string GetFirmwareString() const { return "Replay"; }
+  uint32_t GetSerialNumber() const { return 0; }
+  uint64_t ControllerUID() const; // source UID of the first request
+
+  bool SendDMX(const uint8_t *data, int len);
+  bool SendRDM(const uint8_t *data, int len);
+  bool SendRDMDiscovery(const uint8_t *data, int len);
+  int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte);
+  bool WaitForData(int timeoutMs);
+  void Purge();
+  uint8_t NextTransNum();
+
+  void SetMetricsPort(int port) { m_metricsPort = port; }
+  int MetricsPort() const { return m_metricsPort; }
+
+  uint64_t Requests() const; // recorded requests consumed
+  uint64_t Mismatches() const;
+  bool AtEnd() const; // every recorded request consumed
+
+private:
+  struct Frame {
+    int64_t timestampUs;
+    bool tx;
+    std::vector<uint8_t> bytes; // RDM bytes (start code first)
+    uint8_t statusByte;         // RX only
+  };
+
+  bool LoadFrom(CaptureReader &reader, int port, double speed);
+  bool Exchange(const uint8_t *data, int len);
+  size_t NextRequest(size_t from) const;
+  void Pace(int64_t timestampUs);
+
+  mutable std::mutex m_mutex;
+  std::vector<Frame> m_frames;
+  size_t m_cursor = 0;
+  std::vector<size_t> m_rx; // queued responses (indices into m_frames)
+  size_t m_rxHead = 0;
+  bool m_open = false;
+  double m_speed = 0;
+  int64_t m_firstUs = 0; // recorded time of the first frame
+  int64_t m_startUs = 0; // RdmNowUs() when the replay started
+  uint64_t m_requests = 0;
+  uint64_t m_mismatches = 0;
+  int m_metricsPort = 0;
+};
+
+#endif // REPLAY_DRIVER_H
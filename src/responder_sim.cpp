@@ -0,0 +1,779 @@
+// ────────────────────────────────────────────────────────────────────────
+// ResponderSim — E1.20 responders built from the fixture parameter map
+// ────────────────────────────────────────────────────────────────────────
+#include "responder_sim.h"
+#include "rdm.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+// CK manufacturing lock (PID 0x9001): "LOCK" engages, zero releases
+static const uint16_t kPidLock = 0x9001;
+static const uint32_t kLockMagic = 0x4C4F434B;
+
+// CK opcodes the simulator computes from fixture state (434B_PIDs.csv)
+static const uint16_t kPidSerialNumber = 0x8060;
+static const uint16_t kPidDeviceType = 0x8070;
+static const uint16_t kPidSoftwareVersion = 0x80C0;
+static const uint16_t kPidSettingsHash = 0x803A;
+static const uint16_t kPidAvailableCount = 0x8050;
+static const uint16_t kPidAvailableList = 0x8051;
+static const uint16_t kPidFootprint = 0x860F;
+static const uint16_t kPidModelDescription = 0x0080;
+static const uint16_t kPidSoftwareLabel = 0x00C0;
+static const uint16_t kPidSensorValue = 0x0201;
+
+const SimPid *SimModel::Find(uint16_t pid) const {
+  auto it = std::lower_bound(
+      pids.begin(), pids.end(), pid,
+      [](const SimPid &p, uint16_t v) { return p.pid < v; });
+  return it != pids.end() && it->pid == pid ? &*it : nullptr;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Model
+// ═══════════════════════════════════════════════════════════════════════════
+
+static const int kSizeUnknown = -2;
+
+// Fixed size, -1 for "Variable ...", kSizeUnknown for blank or prose
+static int SizeFromMap(const std::string &text, int &maxSize) {
+  int n = ParsePayloadLength(text);
+  if (n >= 0)
+    return n;
+  std::string t = text;
+  std::transform(t.begin(), t.end(), t.begin(), [](unsigned char c) {
+    return static_cast<char>(tolower(c));
+  });
+  if (t.compare(0, 8, "variable") != 0)
+    return kSizeUnknown;
+  size_t upTo = t.find("up to ");
+  if (upTo != std::string::npos)
+    maxSize = std::min(231, atoi(t.c_str() + upTo + 6));
+  return -1;
+}
+
+std::shared_ptr<const SimModel>
+BuildSimModel(const std::vector<RDMParameterRow> &rows,
+              const std::vector<PIDAttribute> &attrs) {
+  if (rows.empty())
+    return nullptr;
+
+  std::map<uint16_t, SimPid> byPid;
+  for (const RDMParameterRow &row : rows) {
+    if (row.commandClass != RDM_CC_GET && row.commandClass != RDM_CC_SET)
+      continue; // discovery is handled by the protocol layer
+    SimPid &p = byPid[row.pid];
+    if (p.pid == 0) {
+      p.pid = row.pid;
+      p.name = row.name;
+      p.getSize = p.setSize = kSizeUnknown;
+    }
+    if (row.inSupportedParams == "Yes")
+      p.inSupportedParams = true;
+    int size = SizeFromMap(row.payloadLength, p.maxSize);
+    if (row.commandClass == RDM_CC_GET) {
+      p.get = true;
+      p.getWhenLocked = row.lockedAccess;
+      p.getSize = size;
+    } else {
+      p.set = true;
+      p.setWhenLocked = row.lockedAccess;
+      p.setSize = size;
+    }
+
+    // Range check only where both bounds are literals of one width
+    std::vector<uint8_t> lo, hi;
+    if (ParseHexBytes(row.minValue, lo) && ParseHexBytes(row.maxValue, hi) &&
+        lo.size() == hi.size() &&
+        (p.minValue.empty() || row.commandClass == RDM_CC_SET)) {
+      p.minValue = lo;
+      p.maxValue = hi;
+    }
+    std::vector<uint8_t> fw;
+    if (ParseHexBytes(row.fwDefault, fw))
+      p.initial = fw;
+  }
+
+  // The opcode table fills in sizes the map leaves open and adds the
+  // opcodes the map does not list (firmware-only, not open when locked)
+  for (const PIDAttribute &a : attrs) {
+    auto it = byPid.find(a.pid);
+    if (it == byPid.end()) {
+      SimPid &p = byPid[a.pid];
+      p.pid = a.pid;
+      p.name = a.name;
+      p.get = a.canGet;
+      p.set = a.canSet;
+      p.setWhenLocked = false;
+      p.getSize = p.setSize = a.size;
+      continue;
+    }
+    SimPid &p = it->second;
+    if (p.getSize == kSizeUnknown)
+      p.getSize = a.size;
+    if (p.setSize == kSizeUnknown)
+      p.setSize = a.size;
+  }
+
+  // QUEUED_MESSAGE carries the ACK_TIMER results
+  if (!byPid.count(PID_QUEUED_MESSAGE)) {
+    SimPid &q = byPid[PID_QUEUED_MESSAGE];
+    q.pid = PID_QUEUED_MESSAGE;
+    q.name = "Get queued message";
+    q.get = true;
+  }
+
+  auto model = std::make_shared<SimModel>();
+  for (auto &kv : byPid) {
+    SimPid p = std::move(kv.second);
+    int rangeWidth = static_cast<int>(p.minValue.size());
+    if (p.getSize == kSizeUnknown)
+      p.getSize = rangeWidth ? rangeWidth
+                  : p.setSize >= 0 ? p.setSize : -1;
+    if (p.setSize == kSizeUnknown)
+      p.setSize = rangeWidth ? rangeWidth : p.getSize;
+    if (rangeWidth && rangeWidth != (p.set ? p.setSize : p.getSize)) {
+      p.minValue.clear();
+      p.maxValue.clear();
+    }
+    int valueSize = p.getSize >= 0 ? p.getSize : p.setSize;
+    if (valueSize < 0) {
+      p.initial.clear();
+    } else if (static_cast<int>(p.initial.size()) != valueSize) {
+      p.initial = static_cast<int>(p.minValue.size()) == valueSize
+                      ? p.minValue
+                      : std::vector<uint8_t>(valueSize, 0);
+    }
+    model->pids.push_back(std::move(p));
+  }
+  return model;
+}
+
+std::shared_ptr<const SimModel> LoadSimModel(const std::string &mapCsv,
+                                             const std::string &attrCsv) {
+  std::vector<PIDAttribute> attrs;
+  if (!attrCsv.empty())
+    attrs = LoadPIDAttributes(attrCsv);
+  return BuildSimModel(LoadParameterMap(mapCsv), attrs);
+}
+
+std::vector<uint64_t> MakeSimUIDs(int count, uint16_t manufacturerId,
+                                  uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::unordered_set<uint32_t> used;
+  std::vector<uint64_t> uids;
+  while (static_cast<int>(uids.size()) < count) {
+    uint32_t device = rng();
+    if (device == 0 || device == 0xFFFFFFFF || !used.insert(device).second)
+      continue;
+    uids.push_back((static_cast<uint64_t>(manufacturerId) << 32) | device);
+  }
+  return uids;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Fixture state
+// ═══════════════════════════════════════════════════════════════════════════
+
+static void PutBE(std::vector<uint8_t> &out, uint64_t v, int bytes) {
+  for (int i = bytes - 1; i >= 0; --i)
+    out.push_back(static_cast<uint8_t>(v >> (i * 8)));
+}
+
+static uint64_t GetBE(const std::vector<uint8_t> &v) {
+  uint64_t r = 0;
+  for (uint8_t b : v)
+    r = (r << 8) | b;
+  return r;
+}
+
+static uint64_t UnpackUID(const uint8_t *p) {
+  uint64_t v = 0;
+  for (int i = 0; i < 6; ++i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+// CRC-16 CCITT (x^16+x^12+x^5+1), as the firmware computes its hashes
+static uint16_t Crc16Ccitt(uint16_t crc, const uint8_t *p, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    crc ^= static_cast<uint16_t>(p[i] << 8);
+    for (int b = 0; b < 8; ++b)
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+  }
+  return crc;
+}
+
+// Power-up values: the model's defaults plus what identifies the unit
+void ResponderSim::ResetValues(Fixture &fx) const {
+  fx.values.clear();
+  for (const SimPid &p : m_model->pids)
+    fx.values[p.pid] = p.initial;
+
+  auto put = [&](uint16_t pid, uint64_t v, int bytes) {
+    const SimPid *p = m_model->Find(pid);
+    if (!p || p->getSize != bytes)
+      return;
+    std::vector<uint8_t> &dst = fx.values[pid];
+    dst.clear();
+    PutBE(dst, v, bytes);
+  };
+  put(kPidSerialNumber, fx.uid, 6);
+  put(kPidDeviceType,
+      (static_cast<uint32_t>(m_opts.modelId) << 16) | m_opts.productCategory,
+      4);
+  put(kPidSoftwareVersion, m_opts.softwareVersion, 4);
+  put(kPidFootprint, m_opts.footprint, 1);
+  put(kPidLock, fx.locked ? kLockMagic : 0, 4);
+  if (m_model->Find(kPidModelDescription))
+    fx.values[kPidModelDescription].assign(m_opts.modelDescription.begin(),
+                                           m_opts.modelDescription.end());
+  fx.factoryDefaults = true;
+}
+
+std::vector<uint8_t> ResponderSim::Computed(const Fixture &fx,
+                                            uint16_t pid) const {
+  auto value = [&](uint16_t p, uint64_t fallback) {
+    auto it = fx.values.find(p);
+    return it != fx.values.end() && !it->second.empty() ? GetBE(it->second)
+                                                        : fallback;
+  };
+  std::vector<uint8_t> out;
+  switch (pid) {
+  case PID_SUPPORTED_PARAMS:
+    for (const SimPid &p : m_model->pids)
+      if (p.inSupportedParams)
+        PutBE(out, p.pid, 2);
+    break;
+  case PID_DEVICE_INFO: {
+    const SimPid *pers = m_model->Find(PID_DMX_PERSONALITY);
+    uint64_t type = value(kPidDeviceType,
+                          (static_cast<uint32_t>(m_opts.modelId) << 16) |
+                              m_opts.productCategory);
+    PutBE(out, 0x0100, 2); // RDM protocol 1.0
+    PutBE(out, type, 4);   // model ID, product category
+    PutBE(out, value(kPidSoftwareVersion, m_opts.softwareVersion), 4);
+    PutBE(out, value(kPidFootprint, m_opts.footprint), 2);
+    PutBE(out, value(PID_DMX_PERSONALITY, 1), 1);
+    PutBE(out, pers && !pers->maxValue.empty() ? pers->maxValue.back() : 1,
+          1);
+    PutBE(out, value(PID_DMX_START_ADDRESS, 0xFFFF), 2);
+    PutBE(out, 0, 2); // sub-devices
+    PutBE(out, 0, 1); // sensors
+    break;
+  }
+  case PID_FACTORY_DEFAULTS:
+    out.push_back(fx.factoryDefaults ? 1 : 0);
+    break;
+  case kPidSoftwareLabel: {
+    char label[32];
+    uint32_t v = static_cast<uint32_t>(
+        value(kPidSoftwareVersion, m_opts.softwareVersion));
+    int n = snprintf(label, sizeof(label), "%u.%u.%u", v >> 16,
+                     (v >> 8) & 0xFF, v & 0xFF);
+    out.assign(label, label + n);
+    break;
+  }
+  case PID_DMX_PERSONALITY: { // current, count
+    const SimPid *p = m_model->Find(PID_DMX_PERSONALITY);
+    out.push_back(static_cast<uint8_t>(value(PID_DMX_PERSONALITY, 1)));
+    out.push_back(p && !p->maxValue.empty() ? p->maxValue.back() : 1);
+    break;
+  }
+  case kPidSettingsHash: {
+    // reserved | MFG data CRC | MBR CRC | settings CRC.  MFG data is what
+    // the lock protects; settings are the user-writable values.
+    uint16_t mfg = 0xFFFF, settings = 0xFFFF;
+    for (const SimPid &p : m_model->pids) {
+      if (!p.set || p.pid == PID_IDENTIFY_DEVICE || p.pid == kPidLock)
+        continue;
+      auto it = fx.values.find(p.pid);
+      if (it == fx.values.end())
+        continue;
+      uint8_t id[2] = {static_cast<uint8_t>(p.pid >> 8),
+                       static_cast<uint8_t>(p.pid)};
+      uint16_t &crc = p.setWhenLocked ? settings : mfg;
+      crc = Crc16Ccitt(crc, id, 2);
+      crc = Crc16Ccitt(crc, it->second.data(), it->second.size());
+    }
+    PutBE(out, 0, 2);
+    PutBE(out, mfg, 2);
+    PutBE(out, 0, 2); // no MBR database
+    PutBE(out, settings, 2);
+    break;
+  }
+  case kPidAvailableCount:
+    PutBE(out, m_model->pids.size(), 2);
+    break;
+  default:
+    return fx.values.count(pid) ? fx.values.at(pid) : out;
+  }
+  return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Commands
+// ═══════════════════════════════════════════════════════════════════════════
+
+ResponderSim::Reply ResponderSim::Nack(uint16_t pid, uint16_t reason) {
+  ++m_counters.nacks;
+  Reply r;
+  r.type = RDM_RESPONSE_NACK;
+  r.pid = pid;
+  PutBE(r.data, reason, 2);
+  return r;
+}
+
+ResponderSim::Reply ResponderSim::Command(Fixture &fx, uint8_t commandClass,
+                                          uint16_t pid, const uint8_t *pd,
+                                          int pdl) {
+  const SimPid *p = m_model->Find(pid);
+  if (!p)
+    return Nack(pid, NR_UNKNOWN_PID);
+  if (commandClass == RDM_CC_GET) {
+    if (!p->get)
+      return Nack(pid, p->set ? NR_UNSUPPORTED_COMMAND_CLASS : NR_UNKNOWN_PID);
+    if (fx.locked && !p->getWhenLocked)
+      return Nack(pid, NR_UNKNOWN_PID); // hidden while locked
+    return Get(fx, *p, pd, pdl);
+  }
+  if (!p->set)
+    return Nack(pid, NR_UNSUPPORTED_COMMAND_CLASS);
+  if (fx.locked && !p->setWhenLocked)
+    return Nack(pid, NR_WRITE_PROTECT);
+  return Set(fx, *p, pd, pdl);
+}
+
+ResponderSim::Reply ResponderSim::Get(Fixture &fx, const SimPid &p,
+                                      const uint8_t *pd, int pdl) {
+  Reply r;
+  r.pid = p.pid;
+  switch (p.pid) {
+  case PID_QUEUED_MESSAGE: {
+    if (pdl > 1)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    if (fx.queued.empty() || fx.queued.front().readyUs > RdmNowUs()) {
+      r.pid = PID_STATUS_MESSAGES; // nothing to report yet
+      return r;
+    }
+    Queued q = std::move(fx.queued.front());
+    fx.queued.pop_front();
+    r.type = q.responseType;
+    r.commandClass = q.commandClass;
+    r.pid = q.pid;
+    r.data = std::move(q.data);
+    return r;
+  }
+  case PID_PARAMETER_DESCRIPTION: {
+    if (pdl != 2)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    uint16_t pid = static_cast<uint16_t>((pd[0] << 8) | pd[1]);
+    const SimPid *d = m_model->Find(pid);
+    if (pid < 0x8000 || !d)
+      return Nack(p.pid, NR_DATA_OUT_OF_RANGE);
+    int size = d->getSize >= 0 ? d->getSize : d->setSize;
+    PutBE(r.data, pid, 2);
+    PutBE(r.data, size < 0 ? 0 : size, 1);
+    PutBE(r.data, 0x01, 1); // DS_BIT_FIELD: raw bytes
+    PutBE(r.data, (d->get ? 1 : 0) | (d->set ? 2 : 0), 1); // CC_GET/SET
+    PutBE(r.data, 0, 3); // type, unit, prefix
+    PutBE(r.data, d->minValue.size() <= 4 ? GetBE(d->minValue) : 0, 4);
+    PutBE(r.data, d->maxValue.size() <= 4 ? GetBE(d->maxValue) : 0, 4);
+    PutBE(r.data, d->initial.size() <= 4 ? GetBE(d->initial) : 0, 4);
+    r.data.insert(r.data.end(), d->name.begin(),
+                  d->name.begin() + std::min<size_t>(d->name.size(), 32));
+    return r;
+  }
+  case PID_DMX_PERSONALITY_DESCRIPTION: {
+    if (pdl != 1)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    std::vector<uint8_t> pers = Computed(fx, PID_DMX_PERSONALITY);
+    if (pd[0] == 0 || pd[0] > pers[1])
+      return Nack(p.pid, NR_DATA_OUT_OF_RANGE);
+    char label[32];
+    int n = snprintf(label, sizeof(label), "Personality %u", pd[0]);
+    PutBE(r.data, pd[0], 1);
+    PutBE(r.data, m_opts.footprint, 2);
+    r.data.insert(r.data.end(), label, label + n);
+    return r;
+  }
+  case PID_SENSOR_DEFINITION:
+  case kPidSensorValue: // DEVICE_INFO reports no sensors
+    return Nack(p.pid, pdl == 1 ? NR_DATA_OUT_OF_RANGE : NR_FORMAT_ERROR);
+  case kPidAvailableList: {
+    // 16 opcodes from a 16-bit offset, zero-padded to 32 bytes
+    if (pdl != 2)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    size_t from = static_cast<size_t>((pd[0] << 8) | pd[1]);
+    for (size_t i = from; i < from + 16; ++i)
+      PutBE(r.data, i < m_model->pids.size() ? m_model->pids[i].pid : 0, 2);
+    return r;
+  }
+  default:
+    break;
+  }
+  if (pdl != 0)
+    return Nack(p.pid, NR_FORMAT_ERROR);
+  r.data = Computed(fx, p.pid);
+  return r;
+}
+
+ResponderSim::Reply ResponderSim::Set(Fixture &fx, const SimPid &p,
+                                      const uint8_t *pd, int pdl) {
+  Reply r;
+  r.pid = p.pid;
+  std::vector<uint8_t> v(pd, pd + pdl);
+
+  if (p.pid == PID_FACTORY_DEFAULTS) {
+    if (pdl != 0)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    // Settings only: the manufacturing data survives a restore
+    for (const SimPid &s : m_model->pids)
+      if (s.set && s.setWhenLocked && s.pid != kPidLock)
+        fx.values[s.pid] = s.initial;
+    fx.factoryDefaults = true;
+    return r;
+  }
+  if (p.pid == kPidLock) {
+    if (pdl != 4)
+      return Nack(p.pid, NR_FORMAT_ERROR);
+    uint32_t magic = static_cast<uint32_t>(GetBE(v));
+    if (magic != kLockMagic && magic != 0)
+      return Nack(p.pid, NR_DATA_OUT_OF_RANGE);
+    fx.locked = magic == kLockMagic;
+    fx.values[p.pid] = v;
+    return r;
+  }
+
+  if (p.pid == kPidSensorValue) // DEVICE_INFO reports no sensors
+    return Nack(p.pid, pdl == 1 ? NR_DATA_OUT_OF_RANGE : NR_FORMAT_ERROR);
+  if (p.setSize >= 0 ? pdl != p.setSize : pdl > p.maxSize)
+    return Nack(p.pid, NR_FORMAT_ERROR);
+  if (!p.minValue.empty() && static_cast<int>(p.minValue.size()) == pdl &&
+      (v < p.minValue || v > p.maxValue))
+    return Nack(p.pid, NR_DATA_OUT_OF_RANGE);
+
+  if (p.setSize == 0) {
+    // Clear / reset action: the matching GET value returns to zero
+    std::vector<uint8_t> &cur = fx.values[p.pid];
+    std::fill(cur.begin(), cur.end(), 0);
+  } else {
+    fx.values[p.pid] = std::move(v);
+  }
+  if (p.pid != PID_IDENTIFY_DEVICE)
+    fx.factoryDefaults = false;
+  return r;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Line
+// ═══════════════════════════════════════════════════════════════════════════
+
+// DISC_UNIQUE_BRANCH reply: 7 x FE, AA, EUID (12), checksum (4)
+static std::vector<uint8_t> DubReply(uint64_t uid) {
+  std::vector<uint8_t> r(7, 0xFE);
+  r.push_back(0xAA);
+  uint16_t sum = 0;
+  for (int i = 5; i >= 0; --i) {
+    uint8_t b = static_cast<uint8_t>(uid >> (i * 8));
+    r.push_back(b | 0xAA);
+    r.push_back(b | 0x55);
+    sum += (b | 0xAA) + (b | 0x55);
+  }
+  for (uint8_t b : {uint8_t(sum >> 8), uint8_t(sum & 0xFF)}) {
+    r.push_back(b | 0xAA);
+    r.push_back(b | 0x55);
+  }
+  return r;
+}
+
+void ResponderSim::Respond(const Fixture &fx, const uint8_t *req,
+                           const Reply &r) {
+  uint16_t subDevice = static_cast<uint16_t>((req[18] << 8) | req[19]);
+  uint8_t messages =
+      static_cast<uint8_t>(std::min<size_t>(fx.queued.size(), 255));
+  uint8_t cc = r.commandClass ? r.commandClass : req[20] + 1;
+  m_rx.push_back(BuildRDMPacket(UnpackUID(req + 9), fx.uid, req[15], r.type,
+                                messages, subDevice, cc, r.pid, r.data.data(),
+                                static_cast<uint8_t>(r.data.size())));
+  ++m_counters.responses;
+}
+
+void ResponderSim::Discovery(const uint8_t *req, uint64_t dest) {
+  uint16_t pid = static_cast<uint16_t>((req[21] << 8) | req[22]);
+  if (pid == PID_DISC_UNIQUE_BRANCH) {
+    if (req[23] != 12)
+      return;
+    uint64_t lo = UnpackUID(req + 24), hi = UnpackUID(req + 30);
+    std::vector<uint8_t> line;
+    for (const Fixture &fx : m_fixtures) {
+      if (fx.muted || fx.uid < lo || fx.uid > hi)
+        continue;
+      std::vector<uint8_t> reply = DubReply(fx.uid);
+      if (line.empty()) {
+        line = std::move(reply);
+      } else {
+        // Overlapping replies: the line carries the AND (dominant low)
+        for (size_t i = 0; i < line.size(); ++i)
+          line[i] &= reply[i];
+      }
+    }
+    if (!line.empty()) {
+      m_rx.push_back(std::move(line));
+      ++m_counters.responses;
+    }
+    return;
+  }
+  if (pid != PID_DISC_MUTE && pid != PID_DISC_UN_MUTE)
+    return;
+
+  bool mute = pid == PID_DISC_MUTE;
+  auto it = m_index.find(dest);
+  if (it == m_index.end()) {
+    for (Fixture &fx : m_fixtures)
+      if (RDMAddresses(dest, fx.uid))
+        fx.muted = mute;
+    return;
+  }
+  Fixture &fx = m_fixtures[it->second];
+  fx.muted = mute;
+  Reply r;
+  r.pid = pid;
+  r.data = {0x00, 0x00}; // control field: no sub-devices, no proxy
+  Respond(fx, req, r);
+}
+
+bool ResponderSim::Exchange(const uint8_t *data, int len) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (!m_open)
+    return false;
+  m_rx.clear();
+
+  // Malformed requests go unanswered, as on the line
+  if (len < 26 || data[0] != RDM_START_CODE || data[1] != RDM_SUB_START ||
+      data[2] != len - 2 || data[23] != len - 26)
+    return true;
+  uint16_t sum = static_cast<uint16_t>((data[len - 2] << 8) | data[len - 1]);
+  if (RDMChecksum(data, len - 2) != sum)
+    return true;
+  ++m_counters.requests;
+
+  uint64_t dest = UnpackUID(data + 3);
+  uint16_t subDevice = static_cast<uint16_t>((data[18] << 8) | data[19]);
+  uint8_t cc = data[20];
+  uint16_t pid = static_cast<uint16_t>((data[21] << 8) | data[22]);
+  const uint8_t *pd = data + 24;
+  int pdl = data[23];
+
+  if (cc == RDM_CC_DISCOVERY) {
+    Discovery(data, dest);
+    return true;
+  }
+  if (cc != RDM_CC_GET && cc != RDM_CC_SET)
+    return true;
+
+  auto it = m_index.find(dest);
+  if (it == m_index.end()) {
+    // Broadcast / vendorcast: SETs apply everywhere, nobody answers
+    if (cc != RDM_CC_SET || subDevice != 0)
+      return true;
+    bool any = false;
+    for (Fixture &fx : m_fixtures) {
+      if (!RDMAddresses(dest, fx.uid))
+        continue;
+      Command(fx, cc, pid, pd, pdl);
+      any = true;
+    }
+    if (any)
+      ++m_counters.broadcasts;
+    return true;
+  }
+
+  Fixture &fx = m_fixtures[it->second];
+  bool continuing = cc == RDM_CC_GET && fx.overflowPid == pid;
+  size_t offset = continuing ? fx.overflowOffset : 0;
+  fx.overflowPid = 0;
+
+  Reply r = subDevice != 0 ? Nack(pid, NR_SUB_DEVICE_OUT_OF_RANGE)
+                           : Command(fx, cc, pid, pd, pdl);
+
+  if (pid != PID_QUEUED_MESSAGE &&
+      std::find(m_opts.ackTimerPids.begin(), m_opts.ackTimerPids.end(),
+                pid) != m_opts.ackTimerPids.end()) {
+    // The result is queued; the controller comes back for it
+    fx.queued.push_back({RdmNowUs() + m_opts.ackTimerMs * 1000LL,
+                         static_cast<uint8_t>(cc + 1), r.pid, r.type,
+                         std::move(r.data)});
+    ++m_counters.ackTimers;
+    r.type = RDM_RESPONSE_ACK_TIMER;
+    r.data.clear();
+    PutBE(r.data, (m_opts.ackTimerMs + 99) / 100, 2); // 100 ms units
+  } else if (r.type == RDM_RESPONSE_ACK &&
+             r.data.size() > static_cast<size_t>(m_opts.maxPdl)) {
+    // Segment the response; the same GET fetches the next one
+    if (offset >= r.data.size())
+      offset = 0;
+    size_t n = std::min(r.data.size() - offset,
+                        static_cast<size_t>(m_opts.maxPdl));
+    if (offset + n < r.data.size()) {
+      r.type = RDM_RESPONSE_ACK_OVERFLOW;
+      fx.overflowPid = pid;
+      fx.overflowOffset = offset + n;
+      ++m_counters.overflows;
+    }
+    r.data = std::vector<uint8_t>(r.data.begin() + offset,
+                                  r.data.begin() + offset + n);
+  }
+  Respond(fx, data, r);
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Driver interface
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool ResponderSim::Open(std::shared_ptr<const SimModel> model,
+                        const std::vector<uint64_t> &uids,
+                        const SimOptions &opts) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_model = std::move(model);
+  m_opts = opts;
+  m_opts.maxPdl = std::max(1, std::min(231, m_opts.maxPdl));
+  m_fixtures.clear();
+  m_index.clear();
+  m_rx.clear();
+  m_counters = SimCounters{};
+  m_open = m_model != nullptr;
+  if (!m_open)
+    return false;
+
+  m_fixtures.reserve(uids.size());
+  for (uint64_t uid : uids) {
+    if (!m_index.emplace(uid, m_fixtures.size()).second)
+      continue; // duplicate UID
+    Fixture fx;
+    fx.uid = uid;
+    fx.locked = m_opts.locked;
+    ResetValues(fx);
+    m_fixtures.push_back(std::move(fx));
+  }
+  TRACE_INFO("[Sim] %d fixture(s), %d PIDs\n", (int)m_fixtures.size(),
+             (int)m_model->pids.size());
+  return true;
+}
+
+bool ResponderSim::Open(const std::string &mapCsv, const std::string &attrCsv,
+                        int fixtures, const SimOptions &opts) {
+  return Open(LoadSimModel(mapCsv, attrCsv), MakeSimUIDs(fixtures, 0x434B),
+              opts);
+}
+
+void ResponderSim::Close() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_open = false;
+  m_fixtures.clear();
+  m_index.clear();
+  m_rx.clear();
+}
+
+bool ResponderSim::IsOpen() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_open;
+}
+
+std::shared_ptr<const SimModel> ResponderSim::Model() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_model;
+}
+
+std::vector<uint64_t> ResponderSim::Fixtures() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  std::vector<uint64_t> uids;
+  uids.reserve(m_fixtures.size());
+  for (const Fixture &fx : m_fixtures)
+    uids.push_back(fx.uid);
+  return uids;
+}
+
+bool ResponderSim::GetValue(uint64_t uid, uint16_t pid,
+                            std::vector<uint8_t> &out) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto it = m_index.find(uid);
+  if (it == m_index.end())
+    return false;
+  const Fixture &fx = m_fixtures[it->second];
+  if (!fx.values.count(pid))
+    return false;
+  out = fx.values.at(pid);
+  return true;
+}
+
+bool ResponderSim::SetValue(uint64_t uid, uint16_t pid,
+                            const std::vector<uint8_t> &v) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto it = m_index.find(uid);
+  if (it == m_index.end())
+    return false;
+  m_fixtures[it->second].values[pid] = v;
+  return true;
+}
+
+SimCounters ResponderSim::Counters() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_counters;
+}
+
+bool ResponderSim::SendDMX(const uint8_t *, int) { return IsOpen(); }
+
+bool ResponderSim::SendRDM(const uint8_t *data, int len) {
+  if (!data || !Exchange(data, len))
+    return false;
+  if (m_opts.turnaroundUs > 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(m_opts.turnaroundUs));
+  return true;
+}
+
+bool ResponderSim::SendRDMDiscovery(const uint8_t *data, int len) {
+  return SendRDM(data, len);
+}
+
+int ResponderSim::ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  statusByte = 0;
+  if (!m_open || !out || maxLen <= 0)
+    return -1;
+  if (m_rx.empty())
+    return 0;
+  std::vector<uint8_t> resp = std::move(m_rx.front());
+  m_rx.pop_front();
+  int n = std::min(maxLen, static_cast<int>(resp.size()));
+  memcpy(out, resp.data(), n);
+  return n;
+}
+
+bool ResponderSim::WaitForData(int) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return !m_rx.empty();
+}
+
+void ResponderSim::Purge() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_rx.clear();
+}
+
+uint8_t ResponderSim::NextTransNum() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_transNum++;
+}
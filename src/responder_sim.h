@@ -0,0 +1,172 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// ResponderSim — E1.20 responders built from the fixture parameter map
+// ────────────────────────────────────────────────────────────────────────
+#ifndef RESPONDER_SIM_H
+#define RESPONDER_SIM_H
+
+#include "parameter_loader.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One PID of the simulated device: the GET and SET rows of the map merged
+// with the PIDAttributes.csv opcode entry.
+struct SimPid {
+  uint16_t pid = 0;
+  std::string name;
+  bool get = false;
+  bool set = false;
+  bool getWhenLocked = true; // "O" in Mfg. Locked (Operation)
+  bool setWhenLocked = true;
+  int getSize = -1; // fixed payload bytes, -1 = variable
+  int setSize = -1; // 0 = action without data (reset / clear)
+  int maxSize = 231; // upper bound of a variable payload
+  std::vector<uint8_t> minValue; // big-endian, empty = not range-checked
+  std::vector<uint8_t> maxValue;
+  std::vector<uint8_t> initial; // FW Defaults, else minimum, else zeros
+  bool inSupportedParams = false;
+};
+
+// The device every simulated fixture is an instance of, sorted by PID
+struct SimModel {
+  std::vector<SimPid> pids;
+  const SimPid *Find(uint16_t pid) const;
+};
+
+// Merges the map rows and the opcode table.  Payload sizes come from the
+// map ("2 byte"), then the opcode table, then the width of the range
+// literals.  Returns null when `rows` is empty.
+std::shared_ptr<const SimModel>
+BuildSimModel(const std::vector<RDMParameterRow> &rows,
+              const std::vector<PIDAttribute> &attrs);
+// Same, from CK_Vaya_RDM_map.csv and PIDAttributes.csv (may be empty)
+std::shared_ptr<const SimModel> LoadSimModel(const std::string &mapCsv,
+                                             const std::string &attrCsv);
+
+// `count` distinct UIDs of one manufacturer, device IDs drawn from `seed`
+std::vector<uint64_t> MakeSimUIDs(int count, uint16_t manufacturerId,
+                                  uint32_t seed = 1);
+
+struct SimOptions {
+  uint16_t modelId = 0x0001;
+  uint16_t productCategory = 0x0101; // PRODUCT_CATEGORY_FIXTURE_FIXED
+  uint32_t softwareVersion = 0x00010000;
+  std::string modelDescription = "Vaya (simulated)";
+  uint8_t footprint = 4;
+  // Responses longer than this are split with ACK_OVERFLOW (E1.20: 231)
+  int maxPdl = 231;
+  // Commands for these PIDs answer ACK_TIMER; the result is then read
+  // with GET QUEUED_MESSAGE once `ackTimerMs` has passed
+  std::vector<uint16_t> ackTimerPids;
+  int ackTimerMs = 100;
+  int turnaroundUs = 0; // responder delay, spent inside SendRDM
+  bool locked = false;  // manufacturing lock (PID 0x9001) at power-up
+};
+
+struct SimCounters {
+  uint64_t requests = 0;   // well-formed RDM requests, any destination
+  uint64_t responses = 0;  // frames put on the line (DUB replies included)
+  uint64_t nacks = 0;
+  uint64_t broadcasts = 0; // broadcast / vendorcast commands applied
+  uint64_t ackTimers = 0;
+  uint64_t overflows = 0;  // ACK_OVERFLOW segments
+};
+
+// Duck-typed like EnttecPro / PeperoniRodin, so RDMDiscovery,
+// RDMGetCommand, ValidateFixture and the API's command path run against
+// any number of simulated fixtures without hardware.
+//
+// Each fixture keeps its own parameter values: SETs are range-checked
+// against the map and stored, GETs return them, and the computed PIDs
+// (DEVICE_INFO, SUPPORTED_PARAMETERS, settings hash, available-parameter
+// list, ...) are derived from that state.  Requests to unknown UIDs go
+// unanswered, as on a real line; broadcast and vendorcast SETs are applied
+// to every matching fixture without a response.
+class ResponderSim {
+public:
+  bool Open(std::shared_ptr<const SimModel> model,
+            const std::vector<uint64_t> &uids, const SimOptions &opts = {});
+  bool Open(const std::string &mapCsv, const std::string &attrCsv,
+            int fixtures, const SimOptions &opts = {});
+  void Close();
+  bool IsOpen() const;
+
+  std::shared_ptr<const SimModel> Model() const;
+  std::vector<uint64_t> Fixtures() const;
+  // Direct access to one fixture's stored value (tests / benchmarks)
+  bool GetValue(uint64_t uid, uint16_t pid, std::vector<uint8_t> &out) const;
+  bool SetValue(uint64_t uid, uint16_t pid, const std::vector<uint8_t> &v);
+  SimCounters Counters() const;
+
+  // ── Driver interface ──
+  std::string GetFirmwareString() const { return "Simulator"; }
+  uint32_t GetSerialNumber() const { return 1; }
+  bool SendDMX(const uint8_t *data, int len);
+  bool SendRDM(const uint8_t *data, int len);
+  bool SendRDMDiscovery(const uint8_t *data, int len);
+  int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &statusByte);
+  bool WaitForData(int timeoutMs);
+  void Purge();
+  uint8_t NextTransNum();
+
+  void SetMetricsPort(int port) { m_metricsPort = port; }
+  int MetricsPort() const { return m_metricsPort; }
+
+private:
+  struct Queued { // ACK_TIMER result waiting for QUEUED_MESSAGE
+    int64_t readyUs;
+    uint8_t commandClass;
+    uint16_t pid;
+    uint8_t responseType;
+    std::vector<uint8_t> data;
+  };
+
+  struct Fixture {
+    uint64_t uid = 0;
+    std::unordered_map<uint16_t, std::vector<uint8_t>> values;
+    bool muted = false;
+    bool locked = false;
+    bool factoryDefaults = true; // no SET since the last restore
+    std::deque<Queued> queued;
+    uint16_t overflowPid = 0; // GET being returned in segments
+    size_t overflowOffset = 0;
+  };
+
+  // Outcome of one command before it is framed
+  struct Reply {
+    uint8_t type = 0;         // RDM_RESPONSE_*
+    uint8_t commandClass = 0; // 0 = the request's, plus one
+    uint16_t pid = 0;
+    std::vector<uint8_t> data;
+  };
+
+  bool Exchange(const uint8_t *data, int len);
+  void Discovery(const uint8_t *req, uint64_t dest);
+  Reply Command(Fixture &fx, uint8_t commandClass, uint16_t pid,
+                const uint8_t *pd, int pdl);
+  Reply Get(Fixture &fx, const SimPid &p, const uint8_t *pd, int pdl);
+  Reply Set(Fixture &fx, const SimPid &p, const uint8_t *pd, int pdl);
+  std::vector<uint8_t> Computed(const Fixture &fx, uint16_t pid) const;
+  void ResetValues(Fixture &fx) const;
+  void Respond(const Fixture &fx, const uint8_t *req, const Reply &r);
+  Reply Nack(uint16_t pid, uint16_t reason);
+
+  mutable std::mutex m_mutex;
+  std::shared_ptr<const SimModel> m_model;
+  SimOptions m_opts;
+  std::vector<Fixture> m_fixtures;
+  std::unordered_map<uint64_t, size_t> m_index; // UID -> m_fixtures
+  std::deque<std::vector<uint8_t>> m_rx;        // what ReceiveRDM returns
+  SimCounters m_counters;
+  bool m_open = false;
+  uint8_t m_transNum = 0;
+  int m_metricsPort = 0;
+};
+
+#endif // RESPONDER_SIM_H
@@ -0,0 +1,122 @@
+// ────────────────────────────────────────────────────────────────────────
+// ResultStore — columnar validation results for large fleets
+// ────────────────────────────────────────────────────────────────────────
+#include "result_store.h"
+
+#include <algorithm>
+
+uint16_t ResultStore::Intern(const std::string &name) {
+  auto it = m_nameIds.find(name);
+  if (it != m_nameIds.end())
+    return it->second;
+  uint16_t id = static_cast<uint16_t>(m_names.size());
+  m_names.push_back(name);
+  m_nameIds.emplace(name, id);
+  return id;
+}
+
+void ResultStore::Push(uint64_t uid, uint16_t pid, uint16_t index,
+                       uint16_t name, uint8_t status, uint8_t response,
+                       uint8_t flags, uint16_t nack, uint32_t latencyUs,
+                       const uint8_t *data, size_t len) {
+  len = std::min<size_t>(len, 0xFF);
+  m_uid.push_back(uid);
+  m_pid.push_back(pid);
+  m_index.push_back(index);
+  m_name.push_back(name);
+  m_status.push_back(status);
+  m_response.push_back(response);
+  m_flags.push_back(flags);
+  m_nack.push_back(nack);
+  m_latencyUs.push_back(latencyUs);
+  m_offset.push_back(static_cast<uint32_t>(m_payload.size()));
+  m_length.push_back(static_cast<uint8_t>(len));
+  m_payload.insert(m_payload.end(), data, data + len);
+}
+
+size_t ResultStore::Append(uint64_t uid, const ValidationSample &sample) {
+  const RDMParameter &param = *sample.parameter;
+  const RDMResponse *resp = sample.response;
+  uint8_t flags = (param.isMandatory ? kMandatory : 0) | (resp ? kSent : 0);
+  RDMResponseType type = resp ? resp->type
+                         : IsDiscoveryPid(param.pid) ? RDMResponseType::ACK
+                                                     : RDMResponseType::NACK;
+  Push(uid, param.pid, static_cast<uint16_t>(sample.param),
+       Intern(param.name), static_cast<uint8_t>(sample.status),
+       static_cast<uint8_t>(type), flags, resp ? resp->nackReason : 0,
+       static_cast<uint32_t>(std::max<int64_t>(sample.latencyUs, 0)),
+       resp ? resp->data.data() : nullptr, resp ? resp->data.size() : 0);
+  return Size() - 1;
+}
+
+size_t ResultStore::Append(const ResultStore &from, size_t row) {
+  uint16_t name = &from == this ? from.m_name[row] : Intern(from.Name(row));
+  Push(from.m_uid[row], from.m_pid[row], from.m_index[row], name,
+       from.m_status[row], from.m_response[row], from.m_flags[row],
+       from.m_nack[row], from.m_latencyUs[row], from.Payload(row),
+       from.m_length[row]);
+  return Size() - 1;
+}
+
+void ResultStore::Reserve(size_t rows, size_t payloadBytes) {
+  m_uid.reserve(rows);
+  m_pid.reserve(rows);
+  m_index.reserve(rows);
+  m_name.reserve(rows);
+  m_status.reserve(rows);
+  m_response.reserve(rows);
+  m_flags.reserve(rows);
+  m_nack.reserve(rows);
+  m_latencyUs.reserve(rows);
+  m_offset.reserve(rows);
+  m_length.reserve(rows);
+  m_payload.reserve(payloadBytes);
+}
+
+void ResultStore::Clear() {
+  m_uid.clear();
+  m_pid.clear();
+  m_index.clear();
+  m_name.clear();
+  m_status.clear();
+  m_response.clear();
+  m_flags.clear();
+  m_nack.clear();
+  m_latencyUs.clear();
+  m_offset.clear();
+  m_length.clear();
+  m_payload.clear();
+}
+
+std::string ResultStore::Value(size_t row) const {
+  if (!WasSent(row))
+    return OfflineValue(m_pid[row]);
+  return ResponseValue(Response(row), m_nack[row], Payload(row),
+                       m_length[row]);
+}
+
+ValidationResult ResultStore::Result(size_t row) const {
+  ValidationResult vr;
+  vr.pid = m_pid[row];
+  vr.name = Name(row);
+  vr.isMandatory = IsMandatory(row);
+  vr.status = Status(row);
+  vr.value = Value(row);
+  vr.responseType = Response(row);
+  return vr;
+}
+
+size_t ResultStore::MemoryBytes() const {
+  size_t bytes = m_uid.capacity() * sizeof(uint64_t) +
+                 (m_pid.capacity() + m_index.capacity() +
+                  m_name.capacity() + m_nack.capacity()) *
+                     sizeof(uint16_t) +
+                 (m_latencyUs.capacity() + m_offset.capacity()) *
+                     sizeof(uint32_t) +
+                 m_status.capacity() + m_response.capacity() +
+                 m_flags.capacity() + m_length.capacity() +
+                 m_payload.capacity();
+  for (const auto &n : m_names)
+    bytes += sizeof(std::string) + n.capacity();
+  return bytes;
+}
@@ -0,0 +1,89 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// ResultStore — columnar validation results for large fleets
+// ────────────────────────────────────────────────────────────────────────
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include "validator.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Validation rows kept column by column instead of as ValidationResult
+// objects: a row is 28 bytes plus its response data, which sits in one
+// shared arena.  Parameter names are interned, so a fleet holds each name
+// once; the `value` text is only made when a row is read (Value / Result).
+//
+// Clear() keeps the capacity, so a store reused from sweep to sweep stops
+// allocating once it has grown.  Not thread-safe.
+class ResultStore {
+public:
+  // Appends a row for fixture `uid`; returns its index
+  size_t Append(uint64_t uid, const ValidationSample &sample);
+  // Copies row `row` of another store
+  size_t Append(const ResultStore &from, size_t row);
+
+  void Reserve(size_t rows, size_t payloadBytes);
+  void Clear();
+
+  size_t Size() const { return m_uid.size(); }
+  bool Empty() const { return m_uid.empty(); }
+
+  uint64_t Uid(size_t row) const { return m_uid[row]; }
+  uint16_t Pid(size_t row) const { return m_pid[row]; }
+  // Index of the parameter in the list the fixture was validated against
+  uint16_t Index(size_t row) const { return m_index[row]; }
+  ValidationStatus Status(size_t row) const {
+    return static_cast<ValidationStatus>(m_status[row]);
+  }
+  RDMResponseType Response(size_t row) const {
+    return static_cast<RDMResponseType>(m_response[row]);
+  }
+  uint16_t NackReason(size_t row) const { return m_nack[row]; }
+  uint32_t LatencyUs(size_t row) const { return m_latencyUs[row]; }
+  bool IsMandatory(size_t row) const { return m_flags[row] & kMandatory; }
+  // False when the row was decided without a request
+  bool WasSent(size_t row) const { return m_flags[row] & kSent; }
+  const std::string &Name(size_t row) const { return m_names[m_name[row]]; }
+  const uint8_t *Payload(size_t row) const {
+    return m_payload.data() + m_offset[row];
+  }
+  size_t PayloadSize(size_t row) const { return m_length[row]; }
+
+  // Display text, formatted now, as ClassifyResponse would have
+  std::string Value(size_t row) const;
+  ValidationResult Result(size_t row) const;
+
+  // Bytes held, capacity included
+  size_t MemoryBytes() const;
+  size_t NameCount() const { return m_names.size(); }
+
+private:
+  enum : uint8_t { kMandatory = 1, kSent = 2 };
+
+  uint16_t Intern(const std::string &name);
+  void Push(uint64_t uid, uint16_t pid, uint16_t index, uint16_t name,
+            uint8_t status, uint8_t response, uint8_t flags, uint16_t nack,
+            uint32_t latencyUs, const uint8_t *data, size_t len);
+
+  std::vector<uint64_t> m_uid;
+  std::vector<uint16_t> m_pid;
+  std::vector<uint16_t> m_index;
+  std::vector<uint16_t> m_name; // into m_names
+  std::vector<uint8_t> m_status;
+  std::vector<uint8_t> m_response;
+  std::vector<uint8_t> m_flags;
+  std::vector<uint16_t> m_nack;
+  std::vector<uint32_t> m_latencyUs;
+  std::vector<uint32_t> m_offset; // into m_payload
+  std::vector<uint8_t> m_length;  // an RDM parameter is at most 231 bytes
+
+  std::vector<uint8_t> m_payload;
+  std::vector<std::string> m_names;
+  std::unordered_map<std::string, uint16_t> m_nameIds;
+};
+
+#endif // RESULT_STORE_H
@@ -0,0 +1,263 @@
+// ────────────────────────────────────────────────────────────────────────
+// SnapshotCache — settings-hash gated re-validation of known fixtures
+// ────────────────────────────────────────────────────────────────────────
+#include "snapshot_cache.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+#include <numeric>
+
+static const uint16_t kManufacturerCK = 0x434B;
+static const uint16_t kPidSettingsHash = 0x803A;
+
+bool ParseSettingsHash(const std::vector<uint8_t> &data, SettingsHash &out) {
+  if (data.size() < 8)
+    return false;
+  out.mfg = static_cast<uint16_t>((data[2] << 8) | data[3]);
+  out.mbr = static_cast<uint16_t>((data[4] << 8) | data[5]);
+  out.settings = static_cast<uint16_t>((data[6] << 8) | data[7]);
+  return true;
+}
+
+SettingsDbMap SettingsDatabases(const std::vector<RDMParameterRow> &rows) {
+  SettingsDbMap dbs;
+  for (const RDMParameterRow &row : rows) {
+    if (row.commandClass != RDM_CC_SET || row.pid == PID_IDENTIFY_DEVICE)
+      continue; // identify is not stored
+    dbs[row.pid] = row.lockedAccess ? SettingsDb::SETTINGS : SettingsDb::MFG;
+  }
+  return dbs;
+}
+
+// FNV-1a over what a snapshot row depends on
+static uint64_t ParamsKey(const std::vector<RDMParameter> &params) {
+  uint64_t h = 1469598103934665603ULL;
+  auto mix = [&h](uint8_t b) {
+    h ^= b;
+    h *= 1099511628211ULL;
+  };
+  for (const RDMParameter &p : params) {
+    mix(static_cast<uint8_t>(p.pid >> 8));
+    mix(static_cast<uint8_t>(p.pid));
+    mix(p.isMandatory ? 1 : 0);
+  }
+  return h;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Cache
+// ═══════════════════════════════════════════════════════════════════════
+
+void SnapshotCache::SetDatabases(SettingsDbMap dbs) {
+  auto shared = std::make_shared<const SettingsDbMap>(std::move(dbs));
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_dbs = std::move(shared);
+}
+
+SettingsDb SnapshotCache::Database(uint16_t pid) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  if (!m_dbs)
+    return SettingsDb::NONE;
+  auto it = m_dbs->find(pid);
+  return it == m_dbs->end() ? SettingsDb::NONE : it->second;
+}
+
+bool SnapshotCache::Has(uint64_t uid) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_snapshots.count(uid) != 0;
+}
+
+void SnapshotCache::Invalidate(uint64_t uid) {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_snapshots.erase(uid);
+}
+
+void SnapshotCache::Clear() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_snapshots.clear();
+}
+
+size_t SnapshotCache::Size() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  return m_snapshots.size();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Validation
+// ═══════════════════════════════════════════════════════════════════════
+
+std::vector<ValidationResult>
+SnapshotCache::Validate(const ValidationPlanner::Get &get, uint64_t uid,
+                        const std::vector<RDMParameter> &params,
+                        ValidationPlanner *planner,
+                        const ValidationOptions &opts, SnapshotStats *stats) {
+  SnapshotStats local;
+  SnapshotStats &st = stats ? *stats : local;
+  st = SnapshotStats{};
+  ValidationPlanner::Get counted =
+      [&get, &st](uint16_t pid, const std::vector<uint8_t> &pd) {
+        ++st.requests;
+        return get(pid, pd);
+      };
+
+  RDMResponse hashResp;
+  bool asked = static_cast<uint16_t>(uid >> 32) == kManufacturerCK;
+  if (asked) {
+    hashResp = counted(kPidSettingsHash, {});
+    st.haveHash = hashResp.type == RDMResponseType::ACK &&
+                  ParseSettingsHash(hashResp.data, st.hash);
+  }
+
+  uint64_t key = ParamsKey(params);
+  std::shared_ptr<const Snapshot> prev;
+  std::shared_ptr<const SettingsDbMap> dbs;
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    dbs = m_dbs;
+    auto it = m_snapshots.find(uid);
+    if (it != m_snapshots.end() && it->second->paramsKey == key &&
+        it->second->rows.Size() == params.size() && st.haveHash)
+      prev = it->second;
+  }
+  static const SettingsDbMap kNoDbs;
+
+  Snapshot next;
+  next.hash = st.hash;
+  next.paramsKey = key;
+  bool complete = false;
+  std::vector<ValidationResult> results;
+  if (prev || !planner) {
+    results = Sweep(counted, uid, params, prev.get(), dbs ? *dbs : kNoDbs,
+                    asked ? &hashResp : nullptr, opts, next, complete, st);
+  } else if (!st.haveHash) {
+    results = planner->Validate(counted, uid, params, nullptr, opts);
+  } else {
+    // First sweep of this fixture: let the planner skip what it does not
+    // support, and keep its rows in `params` order
+    ResultStore scratch;
+    scratch.Reserve(params.size(), params.size() * 8);
+    ValidationOptions wrapped = opts;
+    wrapped.samples = [&scratch, &opts, uid](const ValidationSample &s) {
+      scratch.Append(uid, s);
+      return !opts.samples || opts.samples(s);
+    };
+    results = planner->Validate(counted, uid, params, nullptr, wrapped);
+    complete = scratch.Size() == params.size();
+    std::vector<size_t> order(scratch.Size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&scratch](size_t a, size_t b) {
+      return scratch.Index(a) < scratch.Index(b);
+    });
+    next.rows.Reserve(scratch.Size(), 0);
+    for (size_t i : order)
+      next.rows.Append(scratch, i);
+  }
+
+  if (!st.haveHash) {
+    Invalidate(uid); // nothing to check a snapshot against
+  } else if (complete) {
+    auto snapshot = std::make_shared<const Snapshot>(std::move(next));
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_snapshots[uid] = std::move(snapshot);
+  }
+  TRACE_DEBUG("[Snapshot] %012llX: %s, %d cached, %d request(s)\n",
+              (unsigned long long)uid,
+              st.hit ? "hash checked" : "full sweep", st.cached,
+              st.requests);
+  return results;
+}
+
+std::vector<ValidationResult>
+SnapshotCache::Sweep(const ValidationPlanner::Get &get, uint64_t uid,
+                     const std::vector<RDMParameter> &params,
+                     const Snapshot *prev, const SettingsDbMap &dbs,
+                     const RDMResponse *hashResp,
+                     const ValidationOptions &opts, Snapshot &next,
+                     bool &complete, SnapshotStats &st) {
+  bool anyChanged = false;
+  if (prev) {
+    st.hit = true;
+    st.mfgChanged = prev->hash.mfg != st.hash.mfg;
+    st.mbrChanged = prev->hash.mbr != st.hash.mbr;
+    st.settingsChanged = prev->hash.settings != st.hash.settings;
+    anyChanged = st.mfgChanged || st.mbrChanged || st.settingsChanged;
+  }
+  auto changed = [&](uint16_t pid) {
+    auto it = dbs.find(pid);
+    switch (it == dbs.end() ? SettingsDb::NONE : it->second) {
+    case SettingsDb::MFG:
+      return st.mfgChanged;
+    case SettingsDb::MBR:
+      return st.mbrChanged;
+    case SettingsDb::SETTINGS:
+      return st.settingsChanged;
+    default:
+      return anyChanged;
+    }
+  };
+
+  std::vector<ValidationResult> results;
+  if (opts.keepResults)
+    results.reserve(params.size());
+  next.rows.Reserve(params.size(), params.size() * 8);
+  complete = true;
+
+  for (size_t i = 0; i < params.size(); ++i) {
+    const RDMParameter &param = params[i];
+    ValidationSample sample;
+    sample.param = i;
+    sample.parameter = &param;
+    sample.status = ValidationStatus::GREEN;
+
+    RDMResponse resp;
+    bool fromSnapshot = false;
+    if (param.pid == kPidSettingsHash && hashResp) {
+      sample.response = hashResp; // asked for already
+    } else if (prev) {
+      const ResultStore &old = prev->rows;
+      RDMResponseType type = old.Response(i);
+      bool answered = type != RDMResponseType::TIMEOUT &&
+                      type != RDMResponseType::INVALID;
+      // Rows decided without a request (discovery, not supported) do not
+      // depend on the settings
+      fromSnapshot = !old.WasSent(i) || (answered && !changed(param.pid));
+    }
+
+    if (fromSnapshot) {
+      const ResultStore &old = prev->rows;
+      ++st.cached;
+      next.rows.Append(old, i);
+      sample.status = old.Status(i);
+      if (old.WasSent(i)) {
+        resp.type = old.Response(i);
+        resp.nackReason = old.NackReason(i);
+        resp.data.assign(old.Payload(i), old.Payload(i) + old.PayloadSize(i));
+        sample.response = &resp;
+      }
+    } else {
+      if (!sample.response && !IsDiscoveryPid(param.pid)) {
+        int64_t t0 = RdmNowUs();
+        resp = get(param.pid, {});
+        if (!resp.cached)
+          sample.latencyUs = RdmNowUs() - t0;
+        sample.response = &resp;
+      }
+      if (sample.response)
+        sample.status = ClassifyStatus(param, sample.response->type);
+      next.rows.Append(uid, sample);
+    }
+
+    bool more = !opts.samples || opts.samples(sample);
+    if (opts.keepResults) {
+      ValidationResult vr = SampleResult(sample);
+      more = (!opts.sink || opts.sink(i, vr)) && more;
+      results.push_back(std::move(vr));
+    }
+    if (!more || (opts.failFast && sample.status == ValidationStatus::RED)) {
+      complete = i + 1 == params.size();
+      break;
+    }
+  }
+  return results;
+}
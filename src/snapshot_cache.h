@@ -0,0 +1,106 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// SnapshotCache — settings-hash gated re-validation of known fixtures
+// ────────────────────────────────────────────────────────────────────────
+#ifndef SNAPSHOT_CACHE_H
+#define SNAPSHOT_CACHE_H
+
+#include "result_store.h"
+#include "validation_planner.h"
+#include "validator.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// OP_CODE_SETTINGS_HASH (0x803A): one CRC-16 CCITT per device database,
+// 0x0000 for a database the device does not have
+struct SettingsHash {
+  uint16_t mfg = 0;      // manufacturing data (what the lock protects)
+  uint16_t mbr = 0;
+  uint16_t settings = 0; // user-writable settings
+};
+
+// reserved(2) | MFG data CRC | MBR CRC | settings CRC, big-endian
+bool ParseSettingsHash(const std::vector<uint8_t> &data, SettingsHash &out);
+
+// Which database holds a PID's value
+enum class SettingsDb : uint8_t {
+  NONE,     // read-only or derived state: re-read when anything changed
+  MFG,      // settable, but not while locked
+  MBR,
+  SETTINGS, // settable while locked
+};
+using SettingsDbMap = std::unordered_map<uint16_t, SettingsDb>;
+
+// From the map's SET rows: "O" in Mfg. Locked marks a setting, any other
+// SET row manufacturing data.  PIDs with no SET row are left out (NONE).
+SettingsDbMap SettingsDatabases(const std::vector<RDMParameterRow> &rows);
+
+struct SnapshotStats {
+  bool haveHash = false; // 0x803A answered
+  bool hit = false;      // a snapshot of this parameter list existed
+  bool mfgChanged = false;
+  bool mbrChanged = false;
+  bool settingsChanged = false;
+  int cached = 0;   // rows served from the snapshot
+  int requests = 0; // GETs sent, 0x803A included
+  SettingsHash hash;
+};
+
+// Keeps the last complete sweep of every CK fixture, keyed by UID, with
+// the settings hash it was taken under.  A re-check starts with one GET of
+// 0x803A:
+//
+//   - hash unchanged: every row comes from the snapshot, except rows that
+//     went unanswered (TIMEOUT / INVALID), which are asked again;
+//   - a database changed: its PIDs and the read-only ones are re-read,
+//     the other databases' rows are reused;
+//   - no snapshot, another parameter list, no hash (not a CK fixture, or
+//     0x803A not answered): full sweep, planned when a planner is given.
+//
+// Rows are published through the options in `params` order (a full
+// sweep: in the planner's order) and the new snapshot replaces the old
+// one only when the sweep ran to the end.  Firmware updates do not show
+// in the hash; Clear() after updating.  Thread-safe.
+class SnapshotCache {
+public:
+  void SetDatabases(SettingsDbMap dbs);
+  SettingsDb Database(uint16_t pid) const;
+
+  std::vector<ValidationResult>
+  Validate(const ValidationPlanner::Get &get, uint64_t uid,
+           const std::vector<RDMParameter> &params,
+           ValidationPlanner *planner = nullptr,
+           const ValidationOptions &opts = {},
+           SnapshotStats *stats = nullptr);
+
+  bool Has(uint64_t uid) const;
+  void Invalidate(uint64_t uid);
+  void Clear();
+  size_t Size() const;
+
+private:
+  struct Snapshot {
+    SettingsHash hash;
+    uint64_t paramsKey = 0;
+    ResultStore rows; // one per parameter, `params` order
+  };
+
+  // Every row in `params` order: from `prev` where still valid, else a
+  // GET (all of them when `prev` is null)
+  std::vector<ValidationResult>
+  Sweep(const ValidationPlanner::Get &get, uint64_t uid,
+        const std::vector<RDMParameter> &params, const Snapshot *prev,
+        const SettingsDbMap &dbs, const RDMResponse *hashResp,
+        const ValidationOptions &opts, Snapshot &next, bool &complete,
+        SnapshotStats &stats);
+
+  mutable std::mutex m_mutex;
+  std::shared_ptr<const SettingsDbMap> m_dbs;
+  std::unordered_map<uint64_t, std::shared_ptr<const Snapshot>> m_snapshots;
+};
+
+#endif // SNAPSHOT_CACHE_H
@@ -0,0 +1,68 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// SpscRing — bounded lock-free single-producer / single-consumer queue
+// ────────────────────────────────────────────────────────────────────────
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed capacity, no allocation after construction.  Push() fails instead
+// of blocking when full, so the producer (usually an I/O thread) is never
+// stalled by a slow consumer; callers count the drop and carry on.
+// `Capacity` must be a power of two.
+template <typename T, size_t Capacity> class SpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRing capacity must be a power of two");
+
+public:
+  // Producer side
+  bool Push(const T &item) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+      return false;
+    m_items[head & (Capacity - 1)] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer side — fill a slot in place (avoids a copy of large items).
+  // Returns nullptr when full; call Commit() after writing the slot.
+  T *Reserve() {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+      return nullptr;
+    return &m_items[head & (Capacity - 1)];
+  }
+  void Commit() {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_release);
+  }
+
+  // Consumer side
+  bool Pop(T &out) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire))
+      return false;
+    out = m_items[tail & (Capacity - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called from a third thread
+  size_t Size() const {
+    return m_head.load(std::memory_order_acquire) -
+           m_tail.load(std::memory_order_acquire);
+  }
+  bool Empty() const { return Size() == 0; }
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+  T m_items[Capacity];
+};
+
+#endif // SPSC_RING_H
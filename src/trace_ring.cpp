@@ -0,0 +1,152 @@
+// ────────────────────────────────────────────────────────────────────────
+// Trace ring — binary protocol / debug events, formatted off the I/O path
+// ────────────────────────────────────────────────────────────────────────
+#include "trace_ring.h"
+#include "rdm_timing.h"
+
+#include <cstdio>
+
+Tracer &GlobalTracer() {
+  static Tracer tracer;
+  return tracer;
+}
+
+int64_t Tracer::Now() { return RdmNowUs(); }
+
+void Tracer::PutString(TraceEvent &e, int i, const char *s, size_t len) {
+  size_t room = TraceEvent::kPayload - e.payloadLen;
+  if (len > room)
+    len = room;
+  e.argTypes[i] = TraceEvent::ARG_STR;
+  e.args[i].s.offset = e.payloadLen;
+  e.args[i].s.len = static_cast<uint16_t>(len);
+  if (len > 0)
+    memcpy(e.payload + e.payloadLen, s, len);
+  e.payloadLen = static_cast<uint16_t>(e.payloadLen + len);
+}
+
+void Tracer::Frame(TraceLevel level, bool tx, const uint8_t *data, int len) {
+  if (!data || len <= 0)
+    return;
+  int64_t now = Now();
+  bool ok = m_ring.Emplace([&](TraceEvent &e) {
+    int n = (len < TraceEvent::kPayload) ? len : TraceEvent::kPayload;
+    e.timestampUs = now;
+    e.fmt = nullptr;
+    e.kind = tx ? TraceKind::FRAME_TX : TraceKind::FRAME_RX;
+    e.level = level;
+    e.argc = 0;
+    e.payloadLen = static_cast<uint16_t>(n);
+    e.frameLen = static_cast<uint16_t>(len);
+    memcpy(e.payload, data, n);
+  });
+  if (!ok)
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ── Deferred printf ─────────────────────────────────────────────────────
+//    Walks the format string and renders each conversion with the stored
+//    argument.  Length modifiers in the format are ignored: integers were
+//    widened to 64 bits when recorded, so the spec is rebuilt with "ll".
+
+static void AppendArg(std::string &out, const std::string &spec, char conv,
+                      const TraceEvent &e, int i) {
+  char buf[128];
+  const TraceEvent::Arg &a = e.args[i];
+  TraceEvent::ArgType t = e.argTypes[i];
+
+  if (conv == 's') {
+    if (t == TraceEvent::ARG_STR) {
+      const char *str = reinterpret_cast<const char *>(e.payload) + a.s.offset;
+      if (spec.size() == 1) {
+        out.append(str, a.s.len);
+      } else {
+        std::string tmp(str, a.s.len);
+        snprintf(buf, sizeof(buf), (spec + 's').c_str(), tmp.c_str());
+        out += buf;
+      }
+      return;
+    }
+    conv = (t == TraceEvent::ARG_DOUBLE) ? 'g' : 'd';
+  }
+
+  if (conv == 'f' || conv == 'F' || conv == 'e' || conv == 'E' ||
+      conv == 'g' || conv == 'G') {
+    double d = (t == TraceEvent::ARG_DOUBLE) ? a.d
+               : (t == TraceEvent::ARG_INT)  ? static_cast<double>(a.i)
+                                             : static_cast<double>(a.u);
+    snprintf(buf, sizeof(buf), (spec + conv).c_str(), d);
+  } else if (conv == 'c') {
+    snprintf(buf, sizeof(buf), (spec + 'c').c_str(), static_cast<int>(a.i));
+  } else if (t == TraceEvent::ARG_STR) {
+    snprintf(buf, sizeof(buf), "%.*s", static_cast<int>(a.s.len),
+             reinterpret_cast<const char *>(e.payload) + a.s.offset);
+  } else {
+    // d i u o x X p
+    if (conv == 'p')
+      conv = 'x';
+    long long v = (t == TraceEvent::ARG_DOUBLE)
+                      ? static_cast<long long>(a.d)
+                      : static_cast<long long>(a.u);
+    snprintf(buf, sizeof(buf), (spec + "ll" + conv).c_str(), v);
+  }
+  out += buf;
+}
+
+static std::string FormatText(const TraceEvent &e) {
+  std::string out;
+  if (!e.fmt)
+    return out;
+  int argi = 0;
+  for (const char *p = e.fmt; *p; ++p) {
+    if (*p != '%') {
+      out += *p;
+      continue;
+    }
+    if (p[1] == '%') {
+      out += '%';
+      ++p;
+      continue;
+    }
+
+    // %[flags][width][.precision][length]conv
+    std::string spec = "%";
+    const char *q = p + 1;
+    while (*q && strchr("-+ #0", *q))
+      spec += *q++;
+    while (*q >= '0' && *q <= '9')
+      spec += *q++;
+    if (*q == '.') {
+      spec += *q++;
+      while (*q >= '0' && *q <= '9')
+        spec += *q++;
+    }
+    while (*q && strchr("hlLzjtI64", *q))
+      ++q;
+    if (!*q)
+      break;
+
+    if (argi < e.argc)
+      AppendArg(out, spec, *q, e, argi++);
+    p = q;
+  }
+  return out;
+}
+
+std::string Tracer::Format(const TraceEvent &e, int maxHexBytes) {
+  if (e.kind == TraceKind::TEXT)
+    return FormatText(e);
+
+  static const char kHex[] = "0123456789ABCDEF";
+  int n = e.payloadLen < maxHexBytes ? e.payloadLen : maxHexBytes;
+  std::string hex;
+  hex.reserve(n * 3 + 4);
+  for (int i = 0; i < n; ++i) {
+    hex += kHex[e.payload[i] >> 4];
+    hex += kHex[e.payload[i] & 0x0F];
+    hex += ' ';
+  }
+  if (e.frameLen > n)
+    hex += "...";
+  return hex;
+}
@@ -0,0 +1,176 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// Trace ring — binary protocol / debug events, formatted off the I/O path
+// ────────────────────────────────────────────────────────────────────────
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include "mpsc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Levels, most important first.  An event is recorded when its level is
+// <= the tracer level; TraceLevel::OFF records nothing.
+enum class TraceLevel : uint8_t {
+  OFF = 0,
+  ERR = 1, // (ERROR is a Windows macro)
+  INFO = 2,
+  DEBUG = 3, // protocol steps (discovery branches, command flow)
+  FRAME = 4, // raw TX / RX frames
+};
+
+enum class TraceKind : uint8_t { TEXT, FRAME_TX, FRAME_RX };
+
+// ── One fixed-size event ────────────────────────────────────────────────
+//    TEXT: `fmt` points at a string literal; arguments are stored raw and
+//    only formatted by the consumer.  String arguments are copied into
+//    `payload`.  FRAME_*: `payload` holds the first kPayload frame bytes,
+//    `frameLen` the original length.
+struct TraceEvent {
+  static constexpr int kMaxArgs = 6;
+  static constexpr int kPayload = 256;
+
+  enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_STR };
+  union Arg {
+    int64_t i;
+    uint64_t u;
+    double d;
+    struct {
+      uint16_t offset; // into payload
+      uint16_t len;
+    } s;
+  };
+
+  int64_t timestampUs = 0; // RdmNowUs clock
+  const char *fmt = nullptr;
+  TraceKind kind = TraceKind::TEXT;
+  TraceLevel level = TraceLevel::OFF;
+  uint8_t argc = 0;
+  uint16_t payloadLen = 0;
+  uint16_t frameLen = 0;
+  ArgType argTypes[kMaxArgs] = {};
+  Arg args[kMaxArgs] = {};
+  uint8_t payload[kPayload];
+};
+
+// ── Tracer ──────────────────────────────────────────────────────────────
+//    Producers (any thread) copy raw data into a lock-free ring and
+//    return; nothing is formatted, allocated or called back on the I/O
+//    path.  One consumer drains the ring and formats with Format().  Use
+//    the TRACE_* macros: when the level is filtered out they cost one
+//    relaxed atomic load and do not evaluate their arguments.
+class Tracer {
+public:
+  static constexpr size_t kCapacity = 1024;
+
+  bool Enabled(TraceLevel level) const {
+    return static_cast<uint8_t>(level) <=
+           m_level.load(std::memory_order_relaxed);
+  }
+  void SetLevel(TraceLevel level) {
+    m_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+  }
+  TraceLevel GetLevel() const {
+    return static_cast<TraceLevel>(m_level.load(std::memory_order_relaxed));
+  }
+
+  template <typename... Args>
+  void Text(TraceLevel level, const char *fmt, const Args &...args) {
+    static_assert(sizeof...(Args) <= TraceEvent::kMaxArgs,
+                  "too many trace arguments");
+    int64_t now = Now();
+    bool ok = m_ring.Emplace([&](TraceEvent &e) {
+      e.timestampUs = now;
+      e.fmt = fmt;
+      e.kind = TraceKind::TEXT;
+      e.level = level;
+      e.argc = 0;
+      e.payloadLen = 0;
+      e.frameLen = 0;
+      int dummy[] = {0, (Put(e, args), 0)...};
+      (void)dummy;
+    });
+    if (!ok)
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Frame(TraceLevel level, bool tx, const uint8_t *data, int len);
+
+  // Consumer side (one thread at a time).  Calls `fn(const TraceEvent&)`
+  // for up to `max` events; returns the number delivered.
+  template <typename Fn> int Drain(Fn &&fn, int max = 1 << 30) {
+    int n = 0;
+    while (n < max && m_ring.Consume(fn))
+      ++n;
+    return n;
+  }
+
+  // Renders a TEXT event through its format string, or a frame as hex
+  // ("7E 07 ..."; the first `maxHexBytes` bytes, then "...").
+  static std::string Format(const TraceEvent &e, int maxHexBytes = 128);
+
+  uint64_t Dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+  size_t Pending() const { return m_ring.Size(); }
+
+private:
+  static int64_t Now();
+
+  template <typename T> static void Put(TraceEvent &e, const T &v) {
+    if (e.argc >= TraceEvent::kMaxArgs)
+      return;
+    int i = e.argc++;
+    if constexpr (std::is_floating_point<T>::value) {
+      e.argTypes[i] = TraceEvent::ARG_DOUBLE;
+      e.args[i].d = static_cast<double>(v);
+    } else if constexpr (std::is_enum<T>::value) {
+      e.argTypes[i] = TraceEvent::ARG_INT;
+      e.args[i].i = static_cast<int64_t>(v);
+    } else if constexpr (std::is_integral<T>::value &&
+                         std::is_signed<T>::value) {
+      e.argTypes[i] = TraceEvent::ARG_INT;
+      e.args[i].i = static_cast<int64_t>(v);
+    } else if constexpr (std::is_integral<T>::value) {
+      e.argTypes[i] = TraceEvent::ARG_UINT;
+      e.args[i].u = static_cast<uint64_t>(v);
+    } else if constexpr (std::is_same<T, std::string>::value) {
+      PutString(e, i, v.data(), v.size());
+    } else {
+      const char *s = v; // const char* / char arrays
+      PutString(e, i, s, s ? strlen(s) : 0);
+    }
+  }
+  static void PutString(TraceEvent &e, int i, const char *s, size_t len);
+
+  std::atomic<uint8_t> m_level{static_cast<uint8_t>(TraceLevel::FRAME)};
+  std::atomic<uint64_t> m_dropped{0};
+  MpscRing<TraceEvent, kCapacity> m_ring;
+};
+
+// Process-wide tracer shared by the drivers, the RDM core and the API
+Tracer &GlobalTracer();
+
+#define TRACE_AT(level, ...)                                                 \
+  do {                                                                       \
+    if (GlobalTracer().Enabled(level))                                       \
+      GlobalTracer().Text(level, __VA_ARGS__);                               \
+  } while (0)
+#define TRACE_ERROR(...) TRACE_AT(TraceLevel::ERR, __VA_ARGS__)
+#define TRACE_INFO(...) TRACE_AT(TraceLevel::INFO, __VA_ARGS__)
+#define TRACE_DEBUG(...) TRACE_AT(TraceLevel::DEBUG, __VA_ARGS__)
+#define TRACE_FRAME(tx, data, len)                                           \
+  do {                                                                       \
+    if (GlobalTracer().Enabled(TraceLevel::FRAME))                           \
+      GlobalTracer().Frame(TraceLevel::FRAME, (tx), (data), (len));          \
+  } while (0)
+
+// A UID as two trace arguments, for "%04X:%08X" (formatted by the consumer)
+#define TRACE_UID(uid)                                                       \
+  static_cast<unsigned>(((uid) >> 32) & 0xFFFF),                             \
+      static_cast<unsigned>((uid) & 0xFFFFFFFF)
+
+#endif // TRACE_RING_H
@@ -0,0 +1,251 @@
+// ────────────────────────────────────────────────────────────────────────
+// ValidationPlanner — SUPPORTED_PARAMETERS-driven sweeps with a cost model
+// ────────────────────────────────────────────────────────────────────────
+#include "validation_planner.h"
+#include "rdm_timing.h"
+#include "trace_ring.h"
+
+#include <algorithm>
+
+static const uint16_t kManufacturerCK = 0x434B;
+static const uint16_t kPidAvailableCount = 0x8050;
+static const uint16_t kPidAvailableList = 0x8051;
+static const int kAvailablePage = 16; // PIDs per 0x8051 response
+
+bool IsRequiredPid(uint16_t pid) {
+  switch (pid) {
+  case PID_SUPPORTED_PARAMS:
+  case PID_PARAMETER_DESCRIPTION:
+  case PID_DEVICE_INFO:
+  case PID_SOFTWARE_VERSION_LABEL:
+  case PID_DMX_START_ADDRESS:
+  case PID_IDENTIFY_DEVICE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Big-endian PID list, as in SUPPORTED_PARAMETERS; zero entries are padding
+static void AppendPids(const std::vector<uint8_t> &data,
+                       std::vector<uint16_t> &out) {
+  for (size_t i = 0; i + 1 < data.size(); i += 2) {
+    uint16_t pid = static_cast<uint16_t>((data[i] << 8) | data[i + 1]);
+    if (pid != 0)
+      out.push_back(pid);
+  }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Cost model
+// ═══════════════════════════════════════════════════════════════════════
+
+int64_t ValidationPlanner::ExpectedUs(uint16_t pid, bool listed) const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  auto it = m_table.find(pid);
+  double answered = static_cast<double>(m_costs.ackUs);
+  double silent = static_cast<double>(m_costs.timeoutUs);
+  // A listed PID is expected to answer; an unknown one is a coin toss
+  double prior = listed ? 1.0 : 0.5;
+  double p = prior;
+  if (it != m_table.end()) {
+    const PidCost &c = it->second;
+    if (c.answered.samples)
+      answered = c.answered.us;
+    if (c.silent.samples)
+      silent = c.silent.us;
+    p = (c.replies + prior) / (c.requests + 1.0);
+  }
+  return static_cast<int64_t>(p * answered + (1 - p) * silent);
+}
+
+void ValidationPlanner::Observe(uint16_t pid, RDMResponseType outcome,
+                                int64_t us) {
+  bool replied = outcome == RDMResponseType::ACK ||
+                 outcome == RDMResponseType::ACK_TIMER ||
+                 outcome == RDMResponseType::NACK;
+  std::lock_guard<std::mutex> lk(m_mutex);
+  PidCost &c = m_table[pid];
+  Mean &m = replied ? c.answered : c.silent;
+  m.us = m.samples ? m.us + m_costs.learnRate * (us - m.us)
+                   : static_cast<double>(us);
+  ++m.samples;
+  ++c.requests;
+  if (replied)
+    ++c.replies;
+}
+
+void ValidationPlanner::ResetCosts() {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_table.clear();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Planning
+// ═══════════════════════════════════════════════════════════════════════
+
+ValidationPlan
+ValidationPlanner::Plan(const Get &get, uint64_t uid,
+                        const std::vector<RDMParameter> &params) {
+  ValidationPlan plan;
+  plan.uid = uid;
+  int64_t t0 = RdmNowUs();
+
+  RDMResponse resp = get(PID_SUPPORTED_PARAMS, {});
+  Observe(PID_SUPPORTED_PARAMS, resp.type, RdmNowUs() - t0);
+  if (resp.type == RDMResponseType::ACK) {
+    plan.haveSupported = true;
+    AppendPids(resp.data, plan.supported);
+  }
+
+  auto listed = [&plan](uint16_t pid) {
+    return IsDiscoveryPid(pid) || IsRequiredPid(pid) ||
+           std::find(plan.supported.begin(), plan.supported.end(), pid) !=
+               plan.supported.end();
+  };
+  bool unresolved = false;
+  for (const auto &p : params)
+    unresolved = unresolved || !listed(p.pid);
+
+  // CK fixtures also report their full opcode table, 16 at a time; only
+  // worth its requests when 0x0050 left parameters unaccounted for
+  uint16_t manufacturer = static_cast<uint16_t>(uid >> 32);
+  if (plan.haveSupported && unresolved && manufacturer == kManufacturerCK) {
+    int64_t t = RdmNowUs();
+    resp = get(kPidAvailableCount, {});
+    Observe(kPidAvailableCount, resp.type, RdmNowUs() - t);
+    if (resp.type == RDMResponseType::ACK && resp.data.size() >= 2) {
+      int count = (resp.data[0] << 8) | resp.data[1];
+      plan.haveAvailable = true;
+      for (int from = 0; from < count; from += kAvailablePage) {
+        std::vector<uint8_t> pd = {static_cast<uint8_t>(from >> 8),
+                                   static_cast<uint8_t>(from)};
+        t = RdmNowUs();
+        resp = get(kPidAvailableList, pd);
+        Observe(kPidAvailableList, resp.type, RdmNowUs() - t);
+        if (resp.type != RDMResponseType::ACK) {
+          plan.haveAvailable = false; // partial list: trust 0x0050 only
+          break;
+        }
+        AppendPids(resp.data, plan.supported);
+      }
+    }
+  }
+  std::sort(plan.supported.begin(), plan.supported.end());
+  plan.supported.erase(
+      std::unique(plan.supported.begin(), plan.supported.end()),
+      plan.supported.end());
+  plan.probeUs = RdmNowUs() - t0;
+
+  for (size_t i = 0; i < params.size(); ++i) {
+    uint16_t pid = params[i].pid;
+    if (IsDiscoveryPid(pid)) {
+      plan.offline.push_back(i);
+      continue;
+    }
+    bool listed = IsRequiredPid(pid) ||
+                  std::binary_search(plan.supported.begin(),
+                                     plan.supported.end(), pid);
+    if (plan.haveSupported && !listed) {
+      plan.missing.push_back(i);
+      continue;
+    }
+    plan.gets.push_back({i, pid, ExpectedUs(pid, plan.haveSupported)});
+  }
+  std::stable_sort(plan.gets.begin(), plan.gets.end(),
+                   [](const PlannedGet &a, const PlannedGet &b) {
+                     return a.expectedUs < b.expectedUs;
+                   });
+  for (const auto &g : plan.gets)
+    plan.predictedUs += g.expectedUs;
+
+  TRACE_DEBUG("[Plan] %012llX: %d GET(s), %d missing, %d listed, "
+              "~%lld ms\n",
+              (unsigned long long)uid, (int)plan.gets.size(),
+              (int)plan.missing.size(), (int)plan.supported.size(),
+              (long long)plan.predictedUs / 1000);
+  return plan;
+}
+
+std::vector<ValidationResult>
+ValidationPlanner::Execute(const Get &get, const ValidationPlan &plan,
+                           const std::vector<RDMParameter> &params,
+                           const ValidationOptions &opts) {
+  std::vector<ValidationResult> results;
+  std::vector<bool> done;
+  if (opts.keepResults) {
+    results.resize(params.size());
+    done.resize(params.size(), false);
+  }
+  bool stopped = false;
+  auto publish = [&](const ValidationSample &sample) {
+    bool more = !opts.samples || opts.samples(sample);
+    if (opts.keepResults) {
+      size_t i = sample.param;
+      results[i] = SampleResult(sample);
+      more = (!opts.sink || opts.sink(i, results[i])) && more;
+      done[i] = true;
+    }
+    if (!more || (opts.failFast && sample.status == ValidationStatus::RED))
+      stopped = true;
+  };
+  auto offline = [&](size_t i, ValidationStatus status) {
+    ValidationSample sample;
+    sample.param = i;
+    sample.parameter = &params[i];
+    sample.status = status;
+    publish(sample);
+  };
+
+  for (size_t i : plan.offline) {
+    if (stopped)
+      break;
+    offline(i, ValidationStatus::GREEN);
+  }
+
+  // What the fixture would answer: NACK UNKNOWN_PID, or nothing at all
+  for (size_t i : plan.missing) {
+    if (stopped)
+      break;
+    offline(i, ClassifyStatus(params[i], RDMResponseType::NACK));
+  }
+
+  for (const auto &g : plan.gets) {
+    if (stopped)
+      break;
+    int64_t t0 = RdmNowUs();
+    RDMResponse resp = get(g.pid, {});
+    ValidationSample sample;
+    sample.param = g.param;
+    sample.parameter = &params[g.param];
+    sample.response = &resp;
+    sample.status = ClassifyStatus(params[g.param], resp.type);
+    // A cache hit says nothing about what the PID costs on the line
+    if (!resp.cached) {
+      sample.latencyUs = RdmNowUs() - t0;
+      Observe(g.pid, resp.type, sample.latencyUs);
+    }
+    publish(sample);
+  }
+
+  if (stopped && opts.keepResults) {
+    std::vector<ValidationResult> reached;
+    for (size_t i = 0; i < results.size(); ++i)
+      if (done[i])
+        reached.push_back(std::move(results[i]));
+    return reached;
+  }
+  return results;
+}
+
+std::vector<ValidationResult>
+ValidationPlanner::Validate(const Get &get, uint64_t uid,
+                            const std::vector<RDMParameter> &params,
+                            ValidationPlan *planOut,
+                            const ValidationOptions &opts) {
+  ValidationPlan plan = Plan(get, uid, params);
+  std::vector<ValidationResult> results = Execute(get, plan, params, opts);
+  if (planOut)
+    *planOut = std::move(plan);
+  return results;
+}
@@ -0,0 +1,122 @@
+#pragma once
+// ────────────────────────────────────────────────────────────────────────
+// ValidationPlanner — SUPPORTED_PARAMETERS-driven sweeps with a cost model
+// ────────────────────────────────────────────────────────────────────────
+#ifndef VALIDATION_PLANNER_H
+#define VALIDATION_PLANNER_H
+
+#include "validator.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Default per-GET costs before anything has been measured, for an Enttec
+// line.  An answered GET costs the exchange plus USB latency; an
+// unanswered one waits out the reply poll and the driver's read timeout.
+struct PlanCosts {
+  int64_t ackUs = 5000;       // request / response + 2 ms latency timer
+  int64_t timeoutUs = 550000; // 50 ms reply poll + 500 ms FTDI read timeout
+  double learnRate = 0.25;    // weight of a new sample in the running mean
+};
+
+struct PlannedGet {
+  size_t param = 0; // index into the parameter list
+  uint16_t pid = 0;
+  int64_t expectedUs = 0;
+};
+
+struct ValidationPlan {
+  uint64_t uid = 0;
+  bool haveSupported = false; // SUPPORTED_PARAMETERS answered
+  bool haveAvailable = false; // CK available-parameter list answered
+  std::vector<uint16_t> supported; // both lists merged, sorted
+  std::vector<PlannedGet> gets;    // requests to send, cheapest first
+  std::vector<size_t> missing;     // not on the fixture, classified offline
+  std::vector<size_t> offline;     // discovery PIDs, no request needed
+  int64_t probeUs = 0;             // spent fetching the lists
+  int64_t predictedUs = 0;         // expected time for `gets`
+};
+
+// Plans a fixture's sweep from what it says it supports instead of
+// sending a GET for every parameter of the map:
+//
+//   1. GET SUPPORTED_PARAMETERS; on CK fixtures (manufacturer 0x434B),
+//      if that leaves parameters unaccounted for, also the available-
+//      parameter list (0x8050 count, 0x8051 in pages of 16).
+//   2. Parameters on neither list are classified right away (RED when
+//      mandatory, YELLOW otherwise) — each would have cost a timeout.
+//      The E1.20 minimum set is never listed and is always requested.
+//   3. The rest is ordered by expected cost, cheapest first, so results
+//      come in early and the slow PIDs are left until last.
+//
+// If SUPPORTED_PARAMETERS does not answer, every parameter is requested,
+// as ValidateFixture does.  The cost model is a running mean of the
+// measured time of each (PID, outcome) and is shared by every fixture
+// planned with the same planner; it is thread-safe.
+class ValidationPlanner {
+public:
+  // One GET to the fixture being planned
+  using Get = RDMGet;
+
+  explicit ValidationPlanner(const PlanCosts &costs = {}) : m_costs(costs) {}
+
+  ValidationPlan Plan(const Get &get, uint64_t uid,
+                      const std::vector<RDMParameter> &params);
+  // Results are in `params` order, as ValidateFixture returns them.  The
+  // sink sees the offline rows first (discovery, then unsupported), then
+  // each GET as it completes; an early stop leaves out the rows not
+  // reached, so a mandatory unsupported PID fails fast without a GET.
+  std::vector<ValidationResult>
+  Execute(const Get &get, const ValidationPlan &plan,
+          const std::vector<RDMParameter> &params,
+          const ValidationOptions &opts = {});
+  std::vector<ValidationResult>
+  Validate(const Get &get, uint64_t uid,
+           const std::vector<RDMParameter> &params,
+           ValidationPlan *planOut = nullptr,
+           const ValidationOptions &opts = {});
+
+  // Expected cost of a GET of `pid`; `listed` = the fixture reported it
+  int64_t ExpectedUs(uint16_t pid, bool listed) const;
+  void Observe(uint16_t pid, RDMResponseType outcome, int64_t us);
+  void ResetCosts();
+
+  const PlanCosts &Costs() const { return m_costs; }
+
+private:
+  struct Mean {
+    double us = 0;
+    uint32_t samples = 0;
+  };
+  struct PidCost {
+    Mean answered; // ACK / ACK_TIMER / NACK: the fixture replied
+    Mean silent;   // TIMEOUT / INVALID
+    uint32_t replies = 0;
+    uint32_t requests = 0;
+  };
+
+  PlanCosts m_costs;
+  mutable std::mutex m_mutex;
+  std::unordered_map<uint16_t, PidCost> m_table;
+};
+
+// Binds RDMGetCommand on a driver for one fixture
+template <typename Driver>
+ValidationPlanner::Get PlannerGet(Driver &bus, uint64_t srcUID,
+                                  uint64_t destUID) {
+  return [&bus, srcUID, destUID](uint16_t pid,
+                                 const std::vector<uint8_t> &pd) {
+    return RDMGetCommand(bus, srcUID, destUID, pid,
+                         pd.empty() ? nullptr : pd.data(),
+                         static_cast<uint8_t>(pd.size()));
+  };
+}
+
+// E1.20 parameters a responder must support but leaves out of
+// SUPPORTED_PARAMETERS
+bool IsRequiredPid(uint16_t pid);
+
+#endif // VALIDATION_PLANNER_H
@@ -3,6 +3,10 @@
 // ────────────────────────────────────────────────────────────────────────
 #include "validator.h"
 #include "enttec_pro.h"
+#include "peperoni_rodin.h"
+#include "replay_driver.h"
+#include "responder_sim.h"
+#include "rdm_timing.h"
 #include <cstdio>
 
 // ── Hex formatter ───────────────────────────────────────────────────────
@@ -20,74 +24,179 @@ std::string BytesToHex(const uint8_t* data, int len)
     return out;
 }
 
+// ── Classify one response ───────────────────────────────────────────────
+ValidationStatus ClassifyStatus(const RDMParameter& param,
+                                RDMResponseType type)
+{
+    // Case C: valid data → GREEN; ACK_TIMER is treated as success
+    if (type == RDMResponseType::ACK || type == RDMResponseType::ACK_TIMER)
+        return ValidationStatus::GREEN;
+    // Case A: mandatory + fail → RED
+    // Case B: optional + fail → YELLOW
+    return param.isMandatory ? ValidationStatus::RED
+                             : ValidationStatus::YELLOW;
+}
+
+std::string ResponseValue(RDMResponseType type, uint16_t nackReason,
+                          const uint8_t* data, size_t len)
+{
+    switch (type) {
+    case RDMResponseType::ACK:
+        if (len)
+            return BytesToHex(data, static_cast<int>(len));
+        return "(empty)";
+    case RDMResponseType::ACK_TIMER:
+        return "(ACK_TIMER)";
+    case RDMResponseType::NACK:
+        return "NACK (0x" + BytesToHex(
+            reinterpret_cast<const uint8_t*>(&nackReason), 2) + ")";
+    case RDMResponseType::TIMEOUT:
+        return "TIMEOUT";
+    default:
+        return "INVALID";
+    }
+}
+
+ValidationResult ClassifyResponse(const RDMParameter& param,
+                                  const RDMResponse& resp)
+{
+    ValidationResult vr;
+    vr.pid          = param.pid;
+    vr.name         = param.name;
+    vr.isMandatory  = param.isMandatory;
+    vr.responseType = resp.type;
+    vr.status       = ClassifyStatus(param, resp.type);
+    vr.value        = ResponseValue(resp.type, resp.nackReason,
+                                    resp.data.data(), resp.data.size());
+    return vr;
+}
+
+ValidationResult SampleResult(const ValidationSample& sample)
+{
+    if (sample.response)
+        return ClassifyResponse(*sample.parameter, *sample.response);
+
+    // Decided without a request: a discovery PID, or one the fixture does
+    // not list (see ValidationPlanner) — what it would NACK
+    ValidationResult vr;
+    vr.pid          = sample.parameter->pid;
+    vr.name         = sample.parameter->name;
+    vr.isMandatory  = sample.parameter->isMandatory;
+    vr.status       = sample.status;
+    vr.value        = OfflineValue(vr.pid);
+    vr.responseType = IsDiscoveryPid(vr.pid) ? RDMResponseType::ACK
+                                             : RDMResponseType::NACK;
+    return vr;
+}
+
 // ── Validate fixture ────────────────────────────────────────────────────
-std::vector<ValidationResult> ValidateFixture(
-    EnttecPro& pro,
-    uint64_t srcUID,
-    uint64_t destUID,
-    const std::vector<RDMParameter>& params)
+// `get(pid)` sends one GET_COMMAND to the fixture
+template <typename Get>
+static std::vector<ValidationResult> ValidateFixtureImpl(
+    Get&& get,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
 {
     std::vector<ValidationResult> results;
-    results.reserve(params.size());
+    if (opts.keepResults)
+        results.reserve(params.size());
 
-    for (const auto& param : params) {
-        ValidationResult vr;
-        vr.pid         = param.pid;
-        vr.name        = param.name;
-        vr.isMandatory = param.isMandatory;
+    for (size_t i = 0; i < params.size(); ++i) {
+        const RDMParameter& param = params[i];
+        ValidationSample sample;
+        sample.param     = i;
+        sample.parameter = &param;
+        sample.status    = ValidationStatus::GREEN;
 
         // Skip discovery PIDs — they aren't standard GET targets
-        if (param.pid <= 0x0003) {
-            vr.status       = ValidationStatus::GREEN;
-            vr.value        = "(discovery)";
-            vr.responseType = RDMResponseType::ACK;
-            results.push_back(std::move(vr));
-            continue;
+        RDMResponse resp;
+        if (!IsDiscoveryPid(param.pid)) {
+            // Send GET_COMMAND
+            int64_t t0 = RdmNowUs();
+            resp = get(param.pid);
+            if (!resp.cached)
+                sample.latencyUs = RdmNowUs() - t0;
+            sample.response  = &resp;
+            sample.status    = ClassifyStatus(param, resp.type);
         }
 
-        // Send GET_COMMAND
-        RDMResponse resp = RDMGetCommand(pro, srcUID, destUID, param.pid);
-        vr.responseType = resp.type;
-
-        switch (resp.type) {
-        case RDMResponseType::ACK:
-            // Case C: valid data → GREEN
-            vr.status = ValidationStatus::GREEN;
-            if (!resp.data.empty())
-                vr.value = BytesToHex(resp.data.data(), static_cast<int>(resp.data.size()));
-            else
-                vr.value = "(empty)";
+        // Publish as soon as it is known
+        bool more = !opts.samples || opts.samples(sample);
+        if (opts.keepResults) {
+            ValidationResult vr = SampleResult(sample);
+            more = (!opts.sink || opts.sink(i, vr)) && more;
+            results.push_back(std::move(vr));
+        }
+        if (!more ||
+            (opts.failFast && sample.status == ValidationStatus::RED))
             break;
+    }
 
-        case RDMResponseType::ACK_TIMER:
-            // Treat as success but note it
-            vr.status = ValidationStatus::GREEN;
-            vr.value  = "(ACK_TIMER)";
-            break;
+    return results;
+}
 
-        case RDMResponseType::NACK:
-        case RDMResponseType::TIMEOUT:
-        case RDMResponseType::INVALID:
-        default:
-            // Case A: mandatory + fail → RED
-            // Case B: optional + fail → YELLOW
-            if (param.isMandatory)
-                vr.status = ValidationStatus::RED;
-            else
-                vr.status = ValidationStatus::YELLOW;
-
-            if (resp.type == RDMResponseType::NACK)
-                vr.value = "NACK (0x" + BytesToHex(
-                    reinterpret_cast<const uint8_t*>(&resp.nackReason), 2) + ")";
-            else if (resp.type == RDMResponseType::TIMEOUT)
-                vr.value = "TIMEOUT";
-            else
-                vr.value = "INVALID";
-            break;
-        }
+std::vector<ValidationResult> ValidateFixture(
+    EnttecPro& pro,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
+{
+    return ValidateFixtureImpl(
+        [&](uint16_t pid) {
+            return RDMGetCommand(pro, srcUID, destUID, pid);
+        },
+        params, opts);
+}
 
-        results.push_back(std::move(vr));
-    }
+std::vector<ValidationResult> ValidateFixture(
+    PeperoniRodin& rodin,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
+{
+    return ValidateFixtureImpl(
+        [&](uint16_t pid) {
+            return RDMGetCommand(rodin, srcUID, destUID, pid);
+        },
+        params, opts);
+}
 
-    return results;
+std::vector<ValidationResult> ValidateFixture(
+    ReplayDriver& replay,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
+{
+    return ValidateFixtureImpl(
+        [&](uint16_t pid) {
+            return RDMGetCommand(replay, srcUID, destUID, pid);
+        },
+        params, opts);
+}
+
+std::vector<ValidationResult> ValidateFixture(
+    ResponderSim& sim,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
+{
+    return ValidateFixtureImpl(
+        [&](uint16_t pid) {
+            return RDMGetCommand(sim, srcUID, destUID, pid);
+        },
+        params, opts);
+}
+
+std::vector<ValidationResult> ValidateFixture(
+    const RDMGet& get,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts)
+{
+    return ValidateFixtureImpl(
+        [&](uint16_t pid) { return get(pid, std::vector<uint8_t>()); },
+        params, opts);
 }
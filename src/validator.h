@@ -8,10 +8,14 @@
 #include "parameter_loader.h"
 #include "rdm.h"
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
 class EnttecPro;
+class PeperoniRodin;
+class ReplayDriver;
+class ResponderSim;
 
 enum class ValidationStatus { GREEN, YELLOW, RED };
 
@@ -24,14 +28,103 @@ struct ValidationResult {
     RDMResponseType  responseType = RDMResponseType::TIMEOUT;
 };
 
+// Receives each result the moment its transaction completes, with its
+// index in `params`.  Runs on the validating thread; return false to stop
+// the sweep.
+using ValidationSink =
+    std::function<bool(size_t index, const ValidationResult& result)>;
+
+// A classified row before any display string is made: what ResultStore
+// keeps.  `response` is null when no request was sent (a discovery PID, or
+// one the fixture does not list) and is only valid during the call.
+struct ValidationSample
+{
+    size_t              param     = 0;       // index in `params`
+    const RDMParameter* parameter = nullptr;
+    ValidationStatus    status    = ValidationStatus::RED;
+    const RDMResponse*  response  = nullptr;
+    int64_t             latencyUs = 0;
+};
+
+// Same moment as ValidationSink; return false to stop the sweep
+using SampleSink = std::function<bool(const ValidationSample& sample)>;
+
+// One GET_COMMAND to a fixture: PID and parameter data in, response out
+using RDMGet = std::function<RDMResponse(uint16_t pid,
+                                         const std::vector<uint8_t>& pd)>;
+
+struct ValidationOptions
+{
+    ValidationSink sink;             // optional
+    SampleSink     samples;          // optional
+    bool           failFast = false; // stop after the first RED result
+    // false: no ValidationResult is built (sink is not called) and the
+    // sweep returns nothing; the rows only go to `samples`
+    bool           keepResults = true;
+};
+
 // Validate all GET_COMMAND parameters against the given fixture UID.
 // `srcUID` is this controller's UID.
-// Results are returned in the same order as `params`.
+// Results are returned in the same order as `params`.  When the sweep is
+// stopped early (sink / samples / failFast) only the rows up to the stop
+// are returned.
 std::vector<ValidationResult> ValidateFixture(
     EnttecPro& pro,
     uint64_t srcUID,
     uint64_t destUID,
-    const std::vector<RDMParameter>& params);
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts = ValidationOptions());
+
+// Same sweep on the other drivers (one universe of a Peperoni, a capture
+// replay, simulated responders — see responder_sim.h)
+std::vector<ValidationResult> ValidateFixture(
+    PeperoniRodin& rodin,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts = ValidationOptions());
+
+std::vector<ValidationResult> ValidateFixture(
+    ReplayDriver& replay,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts = ValidationOptions());
+
+std::vector<ValidationResult> ValidateFixture(
+    ResponderSim& sim,
+    uint64_t srcUID,
+    uint64_t destUID,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts = ValidationOptions());
+
+// Same sweep through any GET function (see PlannerGet, DescriptorCache)
+std::vector<ValidationResult> ValidateFixture(
+    const RDMGet& get,
+    const std::vector<RDMParameter>& params,
+    const ValidationOptions& opts = ValidationOptions());
+
+// GREEN for ACK / ACK_TIMER; otherwise RED if the parameter is mandatory,
+// YELLOW if optional.  `value` holds the data or the failure.
+ValidationResult ClassifyResponse(const RDMParameter& param,
+                                  const RDMResponse& resp);
+ValidationStatus ClassifyStatus(const RDMParameter& param,
+                                RDMResponseType type);
+// The `value` text of a response: hex data, "NACK (0x....)", "TIMEOUT"...
+std::string ResponseValue(RDMResponseType type, uint16_t nackReason,
+                          const uint8_t* data, size_t len);
+// Builds the full row for a sample
+ValidationResult SampleResult(const ValidationSample& sample);
+
+// DISC_UNIQUE_BRANCH / DISC_MUTE / DISC_UN_MUTE are not GET targets and
+// pass without a request
+inline bool IsDiscoveryPid(uint16_t pid) { return pid <= 0x0003; }
+
+// `value` of a row decided without a request
+inline const char* OfflineValue(uint16_t pid)
+{
+    return IsDiscoveryPid(pid) ? "(discovery)" : "(not supported)";
+}
 
 // Convert raw bytes to a hex string like "0A 1B FF"
 std::string BytesToHex(const uint8_t* data, int len);
@@ -0,0 +1,89 @@
+// tests/cpp/fake_fixture.h
+// In-memory fixture shared by the unit tests: GETs are answered from a
+// table, SETs are written into it.  No driver, no timing.
+#pragma once
+
+#include "rdm.h"
+#include "validator.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Answers GETs from a table keyed by PID and parameter data; PIDs not in it
+// time out.  An entry without parameter data also answers every request of
+// its PID that has no entry of its own.  An ACKed SET becomes the PID's
+// answer.  Every request is recorded.
+struct FakeFixture {
+    using Key = std::pair<uint16_t, std::vector<uint8_t>>;
+
+    uint64_t uid = 0;
+    std::map<Key, RDMResponse> answers;
+    std::vector<uint16_t> requests;              // GET PIDs, in order
+    std::vector<std::vector<uint8_t>> paramData; // and their parameter data
+    std::set<uint16_t> refuse;                   // SET: NACK WRITE_PROTECT
+    std::set<uint16_t> ignore;                   // SET: ACK, value unchanged
+    std::set<uint16_t> slow; // SET: ACK_TIMER of 100 ms, value stored
+    // Shared by the fixtures of a port: "G<n>" / "S<n>" per request, n the
+    // low UID digit
+    std::vector<std::string> *log = nullptr;
+
+    void Ack(uint16_t pid, std::vector<uint8_t> data,
+             std::vector<uint8_t> pd = {}) {
+        RDMResponse &r = answers[{pid, std::move(pd)}];
+        r.type = RDMResponseType::ACK;
+        r.data = std::move(data);
+    }
+    void Nack(uint16_t pid, uint16_t reason, std::vector<uint8_t> pd = {}) {
+        RDMResponse &r = answers[{pid, std::move(pd)}];
+        r.type = RDMResponseType::NACK;
+        r.nackReason = reason;
+    }
+    // What a GET without parameter data returns now
+    std::vector<uint8_t> Data(uint16_t pid) const {
+        auto it = answers.find({pid, {}});
+        return it == answers.end() ? std::vector<uint8_t>() : it->second.data;
+    }
+    int Count(uint16_t pid) const {
+        return static_cast<int>(
+            std::count(requests.begin(), requests.end(), pid));
+    }
+
+    RDMGet Get() {
+        return [this](uint16_t pid, const std::vector<uint8_t> &pd) {
+            Log('G');
+            requests.push_back(pid);
+            paramData.push_back(pd);
+            auto it = answers.find({pid, pd});
+            if (it == answers.end())
+                it = answers.find({pid, {}});
+            return it == answers.end() ? RDMResponse() : it->second;
+        };
+    }
+    RDMGet Set() {
+        return [this](uint16_t pid, const std::vector<uint8_t> &pd) {
+            Log('S');
+            RDMResponse r;
+            r.type = RDMResponseType::ACK;
+            if (refuse.count(pid)) {
+                r.type = RDMResponseType::NACK;
+                r.nackReason = NR_WRITE_PROTECT;
+            } else if (!ignore.count(pid)) {
+                Ack(pid, pd);
+            }
+            if (slow.count(pid)) {
+                r.type = RDMResponseType::ACK_TIMER;
+                r.data = {0x00, 0x01};
+            }
+            return r;
+        };
+    }
+
+private:
+    void Log(char command) {
+        if (log)
+            log->push_back(command + std::to_string(uid & 0xF));
+    }
+};
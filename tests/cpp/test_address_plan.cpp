@@ -0,0 +1,244 @@
+// tests/cpp/test_address_plan.cpp
+// Unit tests for the DMX address planner: gap-free packing, fixed
+// fixtures, footprints that do not fit, reading, planning and patching a
+// simulated line at bus speed, and ACK_TIMER read-backs.
+#include <gtest/gtest.h>
+#include "address_plan.h"
+#include "rdm_timing.h"
+#include "responder_sim.h"
+#include "validation_planner.h"
+#include <algorithm>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static AddressFixture Fx(uint64_t uid, uint16_t footprint,
+                         uint16_t current = DMX_NO_ADDRESS,
+                         bool fixed = false) {
+    AddressFixture f;
+    f.uid = uid;
+    f.answered = true;
+    f.footprint = footprint;
+    f.current = current;
+    f.fixed = fixed;
+    return f;
+}
+
+static const AddressSlot *Slot(const AddressPlan &plan, uint64_t uid) {
+    for (const AddressSlot &s : plan.slots)
+        if (s.uid == uid)
+            return &s;
+    return nullptr;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Plan
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(AddressPlan, PacksByUIDWithoutGaps) {
+    AddressPlan plan = PlanAddresses({Fx(3, 4), Fx(1, 8), Fx(2, 16, 100)});
+    EXPECT_EQ(Slot(plan, 1)->planned, 1);
+    EXPECT_EQ(Slot(plan, 2)->planned, 9);
+    EXPECT_EQ(Slot(plan, 3)->planned, 25);
+    EXPECT_EQ(plan.moves, 3);
+    EXPECT_EQ(plan.lastUsed, 28);
+    EXPECT_EQ(plan.unplaced, 0);
+}
+
+TEST(AddressPlan, KeepsFixedFixturesAndFillsAroundThem) {
+    AddressPlan plan = PlanAddresses(
+        {Fx(1, 4), Fx(2, 4), Fx(3, 6), Fx(9, 3, 5, true)},
+        AddressPlanOptions());
+    EXPECT_EQ(Slot(plan, 9)->planned, 5);
+    EXPECT_FALSE(Slot(plan, 9)->Moves());
+    EXPECT_EQ(Slot(plan, 1)->planned, 1); // 1-4 fits before the fixed 5-7
+    EXPECT_EQ(Slot(plan, 2)->planned, 8);
+    EXPECT_EQ(Slot(plan, 3)->planned, 12);
+    EXPECT_EQ(plan.moves, 3);
+}
+
+TEST(AddressPlan, ReportsWhatDoesNotFit) {
+    AddressPlanOptions opts;
+    opts.firstAddress = 501;
+    AddressFixture silent = Fx(4, 0);
+    silent.answered = false;
+    AddressPlan plan = PlanAddresses(
+        {Fx(1, 8), Fx(2, 8), Fx(3, 0, 10), silent}, opts);
+    EXPECT_EQ(Slot(plan, 1)->planned, 501);
+    EXPECT_EQ(Slot(plan, 2)->planned, DMX_NO_ADDRESS); // 509-516
+    EXPECT_EQ(Slot(plan, 3)->planned, DMX_NO_ADDRESS); // no footprint
+    EXPECT_FALSE(Slot(plan, 3)->Moves());
+    EXPECT_EQ(Slot(plan, 4)->planned, DMX_NO_ADDRESS);
+    EXPECT_EQ(plan.unplaced, 2);
+    EXPECT_EQ(plan.moves, 1);
+}
+
+TEST(AddressPlan, FlagsOverlappingFixedFixtures) {
+    AddressPlan plan = PlanAddresses(
+        {Fx(1, 10, 1, true), Fx(2, 10, 5, true), Fx(3, 2)});
+    EXPECT_EQ(plan.overlaps, 2);
+    EXPECT_TRUE(Slot(plan, 1)->overlaps);
+    EXPECT_EQ(Slot(plan, 2)->planned, 5);
+    EXPECT_EQ(Slot(plan, 3)->planned, 15);
+}
+
+TEST(AddressPlan, PlannedLineIsStable) {
+    AddressPlan plan = PlanAddresses({Fx(1, 4), Fx(2, 4), Fx(3, 4)});
+    std::vector<AddressFixture> patched;
+    for (const AddressSlot &s : plan.slots)
+        patched.push_back(Fx(s.uid, s.footprint, s.planned));
+    EXPECT_EQ(PlanAddresses(patched).moves, 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated line
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::vector<RDMParameterRow> Rows(bool deviceInfo) {
+    auto row = [](uint16_t pid, uint8_t cc, const char *size) {
+        RDMParameterRow r;
+        r.pid = pid;
+        r.commandClass = cc;
+        r.payloadLength = size;
+        return r;
+    };
+    std::vector<RDMParameterRow> rows = {
+        row(PID_DMX_START_ADDRESS, RDM_CC_GET, "2 byte"),
+        row(PID_DMX_START_ADDRESS, RDM_CC_SET, "2 byte"),
+        row(PID_CK_DMX_FOOTPRINT, RDM_CC_GET, "1 byte")};
+    rows[0].fwDefault = "0x0001";
+    rows[1].minValue = "0x0001";
+    rows[1].maxValue = "0x0200";
+    if (deviceInfo)
+        rows.push_back(row(PID_DEVICE_INFO, RDM_CC_GET, "19 bytes"));
+    return rows;
+}
+
+static void PatchSimulatedLine(bool deviceInfo) {
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(6, 0x434B);
+    std::sort(uids.begin(), uids.end()); // the plan's order
+    ASSERT_TRUE(sim.Open(BuildSimModel(Rows(deviceInfo), {}), uids));
+    for (size_t i = 0; i < uids.size(); ++i)
+        sim.SetValue(uids[i], PID_CK_DMX_FOOTPRINT,
+                     {static_cast<uint8_t>(i + 1)});
+    sim.SetValue(uids[3], PID_DMX_START_ADDRESS, {0x01, 0x00});
+
+    auto read = [&] {
+        std::vector<AddressFixture> line(uids.size());
+        for (size_t i = 0; i < uids.size(); ++i) {
+            line[i].fixed = i == 3;
+            EXPECT_TRUE(ReadAddressFixture(
+                PlannerGet(sim, kController, uids[i]), uids[i], line[i]));
+        }
+        return line;
+    };
+    std::vector<AddressFixture> line = read();
+    EXPECT_EQ(line[2].footprint, 3);
+    EXPECT_EQ(line[3].current, 0x100);
+
+    AddressPlan plan = PlanAddresses(line);
+    EXPECT_EQ(plan.moves, 4); // the first fixture already sits at 1
+    std::vector<PushTarget> port;
+    for (uint64_t uid : uids)
+        port.push_back({uid, PlannerGet(sim, kController, uid),
+                        PushSet(sim, kController, uid)});
+    uint64_t before = sim.Counters().requests;
+    std::vector<AddressPatch> patches = PatchAddresses(port, plan);
+    EXPECT_EQ(sim.Counters().requests - before, 2u * 4u);
+    ASSERT_EQ(patches.size(), 4u);
+    for (const AddressPatch &p : patches)
+        EXPECT_EQ(p.outcome, PushOutcome::SET) << std::hex << p.uid;
+
+    // 1, 2-3, 4-6, 0x100 fixed, 7-11, 12-17
+    const uint16_t expected[] = {1, 2, 4, 0x100, 7, 12};
+    for (size_t i = 0; i < uids.size(); ++i) {
+        std::vector<uint8_t> v;
+        ASSERT_TRUE(sim.GetValue(uids[i], PID_DMX_START_ADDRESS, v));
+        EXPECT_EQ((v[0] << 8) | v[1], expected[i]) << i;
+    }
+    EXPECT_EQ(PlanAddresses(read()).moves, 0);
+}
+
+TEST(AddressPlan, PatchesALineFromDeviceInfo) { PatchSimulatedLine(true); }
+
+TEST(AddressPlan, PatchesALineFromTheFootprintOpcode) {
+    PatchSimulatedLine(false);
+}
+
+TEST(AddressPlan, ReportsRefusedAddresses) {
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(1, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(Rows(true), {}), uids));
+    AddressPlan plan;
+    AddressSlot s;
+    s.uid = uids[0];
+    s.footprint = 1;
+    s.current = 1;
+    s.planned = 600; // out of the map's range
+    plan.slots.push_back(s);
+    std::vector<AddressPatch> patches = PatchAddresses(
+        {{uids[0], PlannerGet(sim, kController, uids[0]),
+          PushSet(sim, kController, uids[0])}},
+        plan);
+    ASSERT_EQ(patches.size(), 1u);
+    EXPECT_EQ(patches[0].outcome, PushOutcome::FAILED);
+    EXPECT_EQ(patches[0].nackReason, NR_DATA_OUT_OF_RANGE);
+}
+
+TEST(AddressPlan, DeferredReadBackIsPending) {
+    SimOptions opts;
+    opts.ackTimerPids = {PID_DMX_START_ADDRESS}; // GETs answer ACK_TIMER too
+    opts.ackTimerMs = 50;
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(1, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(Rows(true), {}), uids, opts));
+    AddressPlan plan;
+    AddressSlot s;
+    s.uid = uids[0];
+    s.footprint = 1;
+    s.current = 1;
+    s.planned = 2;
+    plan.slots.push_back(s);
+
+    int64_t start = RdmNowUs();
+    std::vector<AddressPatch> patches = PatchAddresses(
+        {{uids[0], PlannerGet(sim, kController, uids[0]),
+          PushSet(sim, kController, uids[0])}},
+        plan);
+    ASSERT_EQ(patches.size(), 1u);
+    EXPECT_EQ(patches[0].outcome, PushOutcome::PENDING);
+    EXPECT_GE(RdmNowUs() - start, 100000); // estimate rounded up to 100 ms
+}
+
+// The SET and read-back passes wait for each reply, not a fixed pause:
+// 100 fixtures with a 3 ms turnaround take about 0.6 s of bus time,
+// against 6 s of dead waits with a 30 ms pause per transaction
+TEST(AddressPlan, PatchesAtBusSpeed) {
+    SimOptions opts;
+    opts.turnaroundUs = 3000;
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(100, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(Rows(true), {}), uids, opts));
+    AddressPlan plan;
+    std::vector<PushTarget> port;
+    for (size_t i = 0; i < uids.size(); ++i) {
+        AddressSlot s;
+        s.uid = uids[i];
+        s.footprint = 1;
+        s.current = 1;
+        s.planned = static_cast<uint16_t>(i + 2);
+        plan.slots.push_back(s);
+        port.push_back({uids[i], PlannerGet(sim, kController, uids[i]),
+                        PushSet(sim, kController, uids[i])});
+    }
+
+    int64_t start = RdmNowUs();
+    std::vector<AddressPatch> patches = PatchAddresses(port, plan);
+    int64_t elapsedUs = RdmNowUs() - start;
+    ASSERT_EQ(patches.size(), 100u);
+    for (const AddressPatch &p : patches)
+        EXPECT_EQ(p.outcome, PushOutcome::SET) << std::hex << p.uid;
+    EXPECT_GE(elapsedUs, 200 * 3000);
+    EXPECT_LT(elapsedUs, 200 * 30000 / 2);
+}
@@ -0,0 +1,127 @@
+// tests/cpp/test_broadcast_set.cpp
+// Unit tests for BroadcastSet: broadcast / vendorcast addressing, the
+// read-back sample, and one SET frame applied across a simulated line.
+#include <gtest/gtest.h>
+#include "broadcast_set.h"
+#include "responder_sim.h"
+#include <set>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static std::vector<RDMParameterRow> StartAddressRows() {
+    RDMParameterRow get, set;
+    get.pid = set.pid = PID_DMX_START_ADDRESS;
+    get.commandClass = RDM_CC_GET;
+    set.commandClass = RDM_CC_SET;
+    get.payloadLength = set.payloadLength = "2 byte";
+    get.fwDefault = "0x0001";
+    set.minValue = "0x0001";
+    set.maxValue = "0x0200";
+    return {get, set};
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Addressing
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(BroadcastSet, AddressesUnicastBroadcastAndVendorcast) {
+    EXPECT_EQ(RDMVendorcastUID(0x434B), 0x434BFFFFFFFFULL);
+    EXPECT_TRUE(RDMAddresses(0x434B00000001ULL, 0x434B00000001ULL));
+    EXPECT_FALSE(RDMAddresses(0x434B00000002ULL, 0x434B00000001ULL));
+    EXPECT_TRUE(RDMAddresses(RDM_BROADCAST_UID, 0x434B00000001ULL));
+    EXPECT_TRUE(RDMAddresses(RDMVendorcastUID(0x434B), 0x434B00000001ULL));
+    EXPECT_FALSE(RDMAddresses(RDMVendorcastUID(0x434B), 0x414200000001ULL));
+}
+
+TEST(BroadcastSet, SampleIsDrawnFromTheAddressedUIDs) {
+    std::vector<uint64_t> known = MakeSimUIDs(10, 0x434B);
+    std::vector<uint64_t> other = MakeSimUIDs(10, 0x4142);
+    known.insert(known.end(), other.begin(), other.end());
+
+    auto a = PickSample(known, RDMVendorcastUID(0x434B), 4, 7);
+    auto b = PickSample(known, RDMVendorcastUID(0x434B), 4, 7);
+    EXPECT_EQ(a, b); // same seed, same sample
+    ASSERT_EQ(a.size(), 4u);
+    EXPECT_EQ(std::set<uint64_t>(a.begin(), a.end()).size(), 4u);
+    for (uint64_t uid : a)
+        EXPECT_EQ(uid >> 32, 0x434Bu);
+
+    EXPECT_EQ(PickSample(known, RDM_BROADCAST_UID, 50, 1).size(), 20u);
+    EXPECT_TRUE(PickSample(known, RDM_BROADCAST_UID, 0, 1).empty());
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated line
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(BroadcastSet, OneFrameSetsEveryFixture) {
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(20, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(StartAddressRows(), {}), uids));
+
+    BroadcastOptions opts;
+    opts.verifySamples = 3;
+    opts.seed = 42;
+    BroadcastResult r = BroadcastSet(sim, kController, RDM_BROADCAST_UID,
+                                     PID_DMX_START_ADDRESS, {0x00, 0x21},
+                                     uids, opts);
+    EXPECT_TRUE(r.sent);
+    EXPECT_EQ(r.addressed, 20);
+    EXPECT_EQ(r.sampled, 3);
+    EXPECT_EQ(r.confirmed, 3);
+    EXPECT_TRUE(r.failed.empty());
+    EXPECT_EQ(sim.Counters().requests, 1u + 3u);
+    EXPECT_EQ(sim.Counters().broadcasts, 1u);
+    for (uint64_t uid : uids) {
+        std::vector<uint8_t> v;
+        ASSERT_TRUE(sim.GetValue(uid, PID_DMX_START_ADDRESS, v));
+        EXPECT_EQ(v, (std::vector<uint8_t>{0x00, 0x21}));
+    }
+}
+
+TEST(BroadcastSet, VendorcastLeavesOtherManufacturersAlone) {
+    ResponderSim sim;
+    std::vector<uint64_t> ours = MakeSimUIDs(3, 0x434B);
+    std::vector<uint64_t> uids = MakeSimUIDs(3, 0x4142);
+    uids.insert(uids.end(), ours.begin(), ours.end());
+    ASSERT_TRUE(sim.Open(BuildSimModel(StartAddressRows(), {}), uids));
+
+    BroadcastResult r = BroadcastSet(sim, kController,
+                                     RDMVendorcastUID(0x434B),
+                                     PID_DMX_START_ADDRESS, {0x00, 0x40},
+                                     uids);
+    EXPECT_EQ(r.addressed, 3);
+    EXPECT_EQ(r.sampled, 0); // no verification asked for
+    for (uint64_t uid : uids) {
+        std::vector<uint8_t> v;
+        ASSERT_TRUE(sim.GetValue(uid, PID_DMX_START_ADDRESS, v));
+        EXPECT_EQ(v[1], (uid >> 32) == 0x434B ? 0x40 : 0x01) << std::hex
+                                                             << uid;
+    }
+}
+
+TEST(BroadcastSet, SampleReportsFixturesThatDidNotApplyIt) {
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(4, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(StartAddressRows(), {}), uids));
+
+    // Out of the map's range: every fixture refuses it, nobody answers
+    BroadcastOptions opts;
+    opts.verifySamples = 4;
+    BroadcastResult r = BroadcastSet(sim, kController, RDM_BROADCAST_UID,
+                                     PID_DMX_START_ADDRESS, {0x03, 0x00},
+                                     uids, opts);
+    EXPECT_TRUE(r.sent);
+    EXPECT_EQ(r.sampled, 4);
+    EXPECT_EQ(r.confirmed, 0);
+    EXPECT_EQ(r.mismatched, 4);
+    EXPECT_EQ(r.failed.size(), 4u);
+
+    // Unknown UID in the sample pool: no answer to the read-back
+    std::vector<uint64_t> known = {0x434B0000FFFFULL};
+    r = BroadcastSet(sim, kController, RDM_BROADCAST_UID,
+                     PID_DMX_START_ADDRESS, {0x00, 0x02}, known, opts);
+    EXPECT_EQ(r.unconfirmed, 1);
+    EXPECT_EQ(r.failed, known);
+}
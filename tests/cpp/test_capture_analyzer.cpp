@@ -0,0 +1,353 @@
+// tests/cpp/test_capture_analyzer.cpp
+// Unit tests for the rdm_simd kernels (every level the CPU supports must
+// match the scalar code in rdm.cpp) and CaptureAnalyzer pairing /
+// statistics over synthetic captures.
+#include <gtest/gtest.h>
+#include "capture_analyzer.h"
+#include "enttec_pro.h"
+#include "rdm.h"
+#include "rdm_simd.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Runs `body` once per supported SIMD level, then restores the default
+template <typename Fn> static void ForEachLevel(Fn body) {
+    SimdLevel best = DetectSimdLevel();
+    for (int l = 0; l <= static_cast<int>(best); ++l) {
+        SetSimdLevel(static_cast<SimdLevel>(l));
+        SCOPED_TRACE(SimdLevelName(ActiveSimdLevel()));
+        body();
+    }
+    SetSimdLevel(best);
+}
+
+static const uint64_t kSrc = 0x454E00000001ULL;
+static const uint64_t kFixA = 0x4C4500000010ULL;
+static const uint64_t kFixB = 0x4C4500000020ULL;
+
+static std::vector<uint8_t> EncodeDub(uint64_t uid) {
+    std::vector<uint8_t> out(7, 0xFE);
+    out.push_back(0xAA);
+    uint16_t sum = 0;
+    for (int i = 5; i >= 0; --i) {
+        uint8_t b = static_cast<uint8_t>(uid >> (i * 8));
+        out.push_back(b | 0xAA);
+        out.push_back(b | 0x55);
+        sum += (b | 0xAA) + (b | 0x55);
+    }
+    for (uint8_t b : {uint8_t(sum >> 8), uint8_t(sum & 0xFF)}) {
+        out.push_back(b | 0xAA);
+        out.push_back(b | 0x55);
+    }
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Kernels
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RdmSimd, ChecksumMatchesScalarForAllLengths) {
+    std::mt19937 rng(7);
+    std::vector<uint8_t> buf(300);
+    for (auto &b : buf)
+        b = static_cast<uint8_t>(rng());
+    ForEachLevel([&] {
+        for (int len = 0; len <= 300; ++len)
+            ASSERT_EQ(RDMChecksumSimd(buf.data(), len),
+                      RDMChecksum(buf.data(), len)) << "len " << len;
+    });
+}
+
+TEST(RdmSimd, BatchVerifyFlagsCorruptPackets) {
+    std::vector<std::vector<uint8_t>> pkts;
+    for (int i = 0; i < 40; ++i) {
+        uint8_t pd[40] = {};
+        pd[0] = static_cast<uint8_t>(i);
+        pkts.push_back(BuildRDMPacket(kFixA, kSrc, uint8_t(i), 1, 0, 0,
+                                      RDM_CC_SET, 0x8000, pd,
+                                      static_cast<uint8_t>(i)));
+    }
+    pkts[3][10] ^= 0x01;
+    pkts[39].back() ^= 0x80;
+    std::vector<const uint8_t *> ptrs;
+    std::vector<int> lens;
+    for (auto &p : pkts) {
+        ptrs.push_back(p.data());
+        lens.push_back(static_cast<int>(p.size()));
+    }
+    ForEachLevel([&] {
+        std::vector<uint8_t> ok(pkts.size());
+        EXPECT_EQ(VerifyRDMChecksums(ptrs.data(), lens.data(),
+                                     static_cast<int>(ptrs.size()),
+                                     ok.data()),
+                  38);
+        EXPECT_EQ(ok[0], 1);
+        EXPECT_EQ(ok[3], 0);
+        EXPECT_EQ(ok[39], 0);
+    });
+}
+
+TEST(RdmSimd, DubDecode) {
+    auto reply = EncodeDub(kFixB);
+    ForEachLevel([&] {
+        uint64_t uid = 0;
+        bool valid = false;
+        ASSERT_TRUE(DecodeDubReply(reply.data(),
+                                   static_cast<int>(reply.size()), &uid,
+                                   &valid));
+        EXPECT_EQ(uid, kFixB);
+        EXPECT_TRUE(valid);
+
+        auto garbled = reply;
+        garbled[10] ^= 0x04; // collision-damaged slot
+        ASSERT_TRUE(DecodeDubReply(garbled.data(),
+                                   static_cast<int>(garbled.size()), &uid,
+                                   &valid));
+        EXPECT_FALSE(valid);
+
+        EXPECT_FALSE(DecodeDubReply(reply.data(), 20, &uid, &valid));
+    });
+}
+
+TEST(RdmSimd, DubDecodeWithoutPreamble) {
+    auto reply = EncodeDub(kFixA);
+    reply.erase(reply.begin(), reply.begin() + 7); // separator only
+    uint64_t uid = 0;
+    bool valid = false;
+    ASSERT_TRUE(DecodeDubReply(reply.data(), static_cast<int>(reply.size()),
+                               &uid, &valid));
+    EXPECT_EQ(uid, kFixA);
+    EXPECT_TRUE(valid);
+}
+
+TEST(RdmSimd, HeaderExtraction) {
+    uint8_t pd[2] = {0x12, 0x34};
+    auto pkt = BuildRDMPacket(kFixA, kSrc, 0x5A, 2, 3, 0x0102, RDM_CC_SET,
+                              0x803A, pd, 2);
+    const uint8_t *ptr = pkt.data();
+    ForEachLevel([&] {
+        RdmHeaderFields h;
+        ExtractRDMHeaders(&ptr, 1, &h);
+        EXPECT_EQ(h.destUID, kFixA);
+        EXPECT_EQ(h.srcUID, kSrc);
+        EXPECT_EQ(h.transNum, 0x5A);
+        EXPECT_EQ(h.portOrResponse, 2);
+        EXPECT_EQ(h.messageCount, 3);
+        EXPECT_EQ(h.subDevice, 0x0102);
+        EXPECT_EQ(h.commandClass, RDM_CC_SET);
+        EXPECT_EQ(h.pid, 0x803A);
+        EXPECT_EQ(h.paramLen, 2);
+        EXPECT_EQ(h.messageLength, 26);
+    });
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Analyzer
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Feeds frames straight into the analyzer, Enttec-labelled like the
+// capture hooks record them.  Keeps the payloads alive until Finish().
+struct Feed {
+    CaptureAnalyzer a;
+    std::vector<std::vector<uint8_t>> keep;
+    int64_t t = 0;
+
+    void Frame(CaptureDirection dir, uint8_t label,
+               std::vector<uint8_t> bytes, int64_t dtUs = 1000,
+               uint8_t port = 0) {
+        keep.push_back(std::move(bytes));
+        CaptureFrameView v;
+        v.timestampUs = (t += dtUs);
+        v.direction = dir;
+        v.port = port;
+        v.label = label;
+        v.length = static_cast<uint16_t>(keep.back().size());
+        v.payload = keep.back().data();
+        a.Add(v);
+    }
+    void Request(std::vector<uint8_t> pkt, uint8_t port = 0) {
+        Frame(CaptureDirection::TX, LABEL_TX_RDM, std::move(pkt), 1000, port);
+    }
+    void Response(std::vector<uint8_t> pkt, int64_t dtUs, uint8_t port = 0) {
+        pkt.insert(pkt.begin(), 0x00); // widget status byte
+        Frame(CaptureDirection::RX, LABEL_RX_DMX_PACKET, std::move(pkt),
+              dtUs, port);
+    }
+};
+
+static std::vector<uint8_t> Get(uint64_t uid, uint16_t pid, uint8_t tn) {
+    return BuildRDMPacket(uid, kSrc, tn, 1, 0, 0, RDM_CC_GET, pid);
+}
+static std::vector<uint8_t> Reply(uint64_t uid, uint16_t pid, uint8_t tn,
+                                  uint8_t type, uint8_t cc = RDM_CC_GET_RSP) {
+    uint8_t nack[2] = {0x00, 0x05};
+    return BuildRDMPacket(kSrc, uid, tn, type, 0, 0, cc, pid,
+                          type == 2 ? nack : nullptr, type == 2 ? 2 : 0);
+}
+
+static const AnalyzerPidStats *Find(const CaptureAnalyzer &a, uint64_t uid,
+                                    uint16_t pid, uint8_t cc) {
+    for (const AnalyzerPidStats *s : a.Stats())
+        if (s->key.uid == uid && s->key.pid == pid &&
+            s->key.commandClass == cc)
+            return s;
+    return nullptr;
+}
+
+static uint64_t Outcome(const AnalyzerPidStats *s, LatencyOutcome o) {
+    return s->outcomes[static_cast<int>(o)];
+}
+
+TEST(CaptureAnalyzer, PairsRequestsWithResponses) {
+    Feed f;
+    f.Frame(CaptureDirection::TX, LABEL_TX_DMX, {0, 1, 2, 3}); // skipped
+    f.Request(Get(kFixA, PID_DEVICE_INFO, 1));
+    f.Response(Reply(kFixA, PID_DEVICE_INFO, 1, 0), 2400);
+    f.Request(Get(kFixA, PID_DEVICE_INFO, 2));
+    f.Response(Reply(kFixA, PID_DEVICE_INFO, 2, 2), 1800); // NACK
+    f.Request(Get(kFixB, PID_DEVICE_INFO, 3));            // no answer
+    f.Request(Get(kFixB, PID_DEVICE_INFO, 4));
+    f.Response(Reply(kFixB, PID_DEVICE_INFO, 4, 1), 3000); // ACK_TIMER
+    f.a.Finish();
+
+    const AnalyzerTotals &t = f.a.Totals();
+    EXPECT_EQ(t.frames, 8u);
+    EXPECT_EQ(t.dmxFrames, 1u);
+    EXPECT_EQ(t.rdmRequests, 4u);
+    EXPECT_EQ(t.rdmResponses, 3u);
+    EXPECT_EQ(t.fixtures, 2u);
+
+    const AnalyzerPidStats *a = Find(f.a, kFixA, PID_DEVICE_INFO,
+                                     RDM_CC_GET);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->requests, 2u);
+    EXPECT_EQ(Outcome(a, LatencyOutcome::ACK), 1u);
+    EXPECT_EQ(Outcome(a, LatencyOutcome::NACK), 1u);
+    EXPECT_EQ(a->turnaround.Count(), 2u);
+    EXPECT_EQ(a->turnaround.Max(), 2400);
+
+    const AnalyzerPidStats *b = Find(f.a, kFixB, PID_DEVICE_INFO,
+                                     RDM_CC_GET);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(Outcome(b, LatencyOutcome::TIMEOUT), 1u);
+    EXPECT_EQ(Outcome(b, LatencyOutcome::ACK_TIMER), 1u);
+}
+
+TEST(CaptureAnalyzer, ChecksumErrorsAndStrays) {
+    Feed f;
+    f.Request(Get(kFixA, 0x8001, 9));
+    auto bad = Reply(kFixA, 0x8001, 9, 0);
+    bad[bad.size() - 1] ^= 0xFF;
+    f.Response(bad, 500);
+    f.Response(Reply(kFixB, 0x8001, 7, 0), 500); // nobody asked
+    f.Request(BuildRDMPacket(RDM_BROADCAST_UID, kSrc, 10, 1, 0, 0,
+                             RDM_CC_SET, PID_IDENTIFY_DEVICE));
+    f.Frame(CaptureDirection::RX, LABEL_RX_DMX_PACKET, {0x00, 0xCC, 0x01});
+    f.a.Finish();
+
+    const AnalyzerTotals &t = f.a.Totals();
+    EXPECT_EQ(t.checksumErrors, 1u);
+    EXPECT_EQ(t.unmatched, 1u);
+    EXPECT_EQ(t.broadcasts, 1u);
+    EXPECT_EQ(t.malformed, 1u);
+    const AnalyzerPidStats *a = Find(f.a, kFixA, 0x8001, RDM_CC_GET);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(Outcome(a, LatencyOutcome::CHECKSUM_ERR), 1u);
+}
+
+TEST(CaptureAnalyzer, DiscoveryReplies) {
+    Feed f;
+    uint8_t range[12] = {0, 0, 0, 0, 0, 0, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF};
+    auto dub = BuildRDMPacket(RDM_BROADCAST_UID, kSrc, 1, 1, 0, 0,
+                              RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH,
+                              range, 12);
+    f.Frame(CaptureDirection::TX, LABEL_TX_RDM_DISCOVERY, dub);
+    auto reply = EncodeDub(kFixA);
+    reply.insert(reply.begin(), 0x00);
+    f.Frame(CaptureDirection::RX, LABEL_RX_DMX_PACKET, reply, 300);
+    f.Frame(CaptureDirection::TX, LABEL_TX_RDM_DISCOVERY, dub);
+    auto garbled = EncodeDub(kFixB);
+    garbled[12] = 0x00;
+    garbled.insert(garbled.begin(), 0x00);
+    f.Frame(CaptureDirection::RX, LABEL_RX_DMX_PACKET, garbled, 300);
+    f.a.Finish();
+
+    const AnalyzerTotals &t = f.a.Totals();
+    EXPECT_EQ(t.dubRequests, 2u);
+    EXPECT_EQ(t.dubReplies, 1u);
+    EXPECT_EQ(t.dubCollisions, 1u);
+    const AnalyzerPidStats *a = Find(f.a, kFixA, PID_DISC_UNIQUE_BRANCH,
+                                     RDM_CC_DISCOVERY);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->turnaround.Max(), 300);
+}
+
+TEST(CaptureAnalyzer, RawFramesAndPortsAreSeparate) {
+    Feed f;
+    // Peperoni: raw slots; two ports interleaved
+    f.Frame(CaptureDirection::TX, CAPTURE_LABEL_RAW,
+            Get(kFixA, PID_DEVICE_INFO, 1), 1000, 0);
+    f.Frame(CaptureDirection::TX, CAPTURE_LABEL_RAW,
+            Get(kFixB, PID_DEVICE_INFO, 1), 100, 1);
+    f.Frame(CaptureDirection::RX, CAPTURE_LABEL_RAW,
+            Reply(kFixB, PID_DEVICE_INFO, 1, 0), 100, 1);
+    f.Frame(CaptureDirection::RX, CAPTURE_LABEL_RAW,
+            Reply(kFixA, PID_DEVICE_INFO, 1, 0), 100, 0);
+    f.a.Finish();
+    EXPECT_EQ(f.a.Totals().unmatched, 0u);
+    EXPECT_EQ(Outcome(Find(f.a, kFixA, PID_DEVICE_INFO, RDM_CC_GET),
+                      LatencyOutcome::ACK),
+              1u);
+    EXPECT_EQ(Outcome(Find(f.a, kFixB, PID_DEVICE_INFO, RDM_CC_GET),
+                      LatencyOutcome::ACK),
+              1u);
+}
+
+TEST(CaptureAnalyzer, SameResultAtEveryLevelAcrossBatches) {
+    // More than one batch, so pairing must survive the batch boundary
+    std::string reference;
+    ForEachLevel([&] {
+        Feed f;
+        for (int i = 0; i < 3 * CaptureAnalyzer::kBatch + 17; ++i) {
+            uint64_t uid = kFixA + (i % 5);
+            uint16_t pid = static_cast<uint16_t>(0x8000 + i % 7);
+            f.Request(Get(uid, pid, uint8_t(i)));
+            if (i % 11)
+                f.Response(Reply(uid, pid, uint8_t(i), i % 3), 700 + i % 90);
+        }
+        f.a.Finish();
+        std::string csv = f.a.RenderCsv();
+        if (reference.empty())
+            reference = csv;
+        EXPECT_EQ(csv, reference);
+        EXPECT_EQ(f.a.Totals().fixtures, 5u);
+    });
+}
+
+TEST(CaptureAnalyzer, ReadsCaptureFile) {
+    CaptureWriter w;
+    char dir[MAX_PATH], path[MAX_PATH];
+    GetTempPathA(MAX_PATH, dir);
+    GetTempFileNameA(dir, "ana", 0, path);
+    ASSERT_TRUE(w.Open(path));
+    auto req = Get(kFixA, PID_DEVICE_INFO, 4);
+    auto resp = Reply(kFixA, PID_DEVICE_INFO, 4, 0);
+    resp.insert(resp.begin(), 0x00);
+    w.Append(100, CaptureDirection::TX, 0, LABEL_TX_RDM, 0, req.data(),
+             static_cast<int>(req.size()));
+    w.Append(2100, CaptureDirection::RX, 0, LABEL_RX_DMX_PACKET, 0,
+             resp.data(), static_cast<int>(resp.size()));
+    w.Close();
+
+    CaptureReader r;
+    ASSERT_TRUE(r.Open(path));
+    CaptureAnalyzer a;
+    a.Analyze(r);
+    const AnalyzerPidStats *s = Find(a, kFixA, PID_DEVICE_INFO, RDM_CC_GET);
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->turnaround.Min(), 2000);
+    EXPECT_NE(a.RenderCsv().find("4C45:00000010,0x0060,0x20,1,1,"),
+              std::string::npos);
+    DeleteFileA(path);
+}
@@ -0,0 +1,329 @@
+// tests/cpp/test_capture_file.cpp
+// Unit tests for CaptureWriter / CaptureReader (format, index, files
+// without a footer) and ReplayDriver (request matching, discovery replay).
+// No hardware is opened.
+#include <gtest/gtest.h>
+#include "capture_file.h"
+#include "enttec_pro.h"
+#include "rdm.h"
+#include "replay_driver.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <windows.h>
+
+// ── RAII temp file helper ────────────────────────────────────────────────
+struct TempPath {
+    std::string path;
+
+    TempPath() {
+        char dir[MAX_PATH], buf[MAX_PATH];
+        GetTempPathA(MAX_PATH, dir);
+        GetTempFileNameA(dir, "cap", 0, buf);
+        path = buf;
+    }
+    ~TempPath() { DeleteFileA(path.c_str()); }
+
+    std::vector<uint8_t> Bytes() const {
+        std::ifstream f(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), {});
+    }
+
+    TempPath(const TempPath&) = delete;
+    TempPath& operator=(const TempPath&) = delete;
+};
+
+// Frame i carries its own number in the first two payload bytes
+static void AppendNumbered(CaptureWriter& w, int count) {
+    for (int i = 0; i < count; ++i) {
+        uint8_t payload[3] = {uint8_t(i & 0xFF), uint8_t(i >> 8), 0xAB};
+        ASSERT_TRUE(w.Append(1000 + i * 10, CaptureDirection::TX, 0,
+                             LABEL_TX_DMX, 0, payload, sizeof(payload)));
+    }
+}
+
+static int FrameNumber(const CaptureFrameView& v) {
+    return v.payload[0] | (v.payload[1] << 8);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Writer / reader
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(CaptureFile, RoundTripPreservesFrames) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    const uint8_t tx[] = {0xCC, 0x01, 0x18};
+    const uint8_t rx[] = {0x00, 0xCC, 0x01, 0x18, 0x99, 0x42};
+    w.Append(5000, CaptureDirection::TX, 3, LABEL_TX_RDM, 0, tx, sizeof(tx));
+    w.Append(5800, CaptureDirection::RX, 3, LABEL_RX_DMX_PACKET, 0, rx,
+             sizeof(rx));
+    w.Close();
+    EXPECT_EQ(w.Frames(), 2u);
+    EXPECT_EQ(w.Dropped(), 0u);
+
+    CaptureReader r;
+    ASSERT_TRUE(r.Open(tmp.path));
+    EXPECT_TRUE(r.HadFooter());
+    EXPECT_EQ(r.FrameCount(), 2u);
+    EXPECT_EQ(memcmp(r.Header().magic, kCaptureMagic, 8), 0);
+    EXPECT_GT(r.Header().wallClockUs, 0);
+
+    CaptureFrameView v;
+    ASSERT_TRUE(r.Next(v));
+    EXPECT_EQ(v.timestampUs, 5000);
+    EXPECT_EQ(v.direction, CaptureDirection::TX);
+    EXPECT_EQ(v.port, 3);
+    EXPECT_EQ(v.label, LABEL_TX_RDM);
+    ASSERT_EQ(v.length, sizeof(tx));
+    EXPECT_EQ(memcmp(v.payload, tx, sizeof(tx)), 0);
+    ASSERT_TRUE(r.Next(v));
+    EXPECT_EQ(v.direction, CaptureDirection::RX);
+    ASSERT_EQ(v.length, sizeof(rx));
+    EXPECT_EQ(memcmp(v.payload, rx, sizeof(rx)), 0);
+    EXPECT_FALSE(r.Next(v));
+}
+
+TEST(CaptureFile, FileTrimmedToContent) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    AppendNumbered(w, 10);
+    w.Close();
+    // header + 10 * (16 + 8) + 1 index entry + footer
+    EXPECT_EQ(tmp.Bytes().size(), 40u + 10 * 24 + 24 + 40);
+    EXPECT_EQ(w.Bytes(), tmp.Bytes().size());
+}
+
+TEST(CaptureFile, SeekThroughIndex) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    AppendNumbered(w, 1000);
+    w.Close();
+
+    CaptureReader r;
+    ASSERT_TRUE(r.Open(tmp.path));
+    ASSERT_EQ(r.FrameCount(), 1000u);
+    CaptureFrameView v;
+    ASSERT_TRUE(r.Seek(700));
+    ASSERT_TRUE(r.Next(v));
+    EXPECT_EQ(FrameNumber(v), 700);
+
+    ASSERT_TRUE(r.SeekTime(1000 + 513 * 10 - 5)); // between 512 and 513
+    EXPECT_EQ(r.Position(), 513u);
+
+    ASSERT_TRUE(r.Seek(1000)); // end
+    EXPECT_FALSE(r.Next(v));
+    EXPECT_FALSE(r.Seek(1001));
+}
+
+TEST(CaptureFile, ReadableWithoutFooter) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    AppendNumbered(w, 300);
+    w.Close();
+
+    // Simulate a killed writer: drop index + footer, leave a zero tail
+    std::vector<uint8_t> bytes = tmp.Bytes();
+    CaptureFooter f;
+    memcpy(&f, bytes.data() + bytes.size() - sizeof(f), sizeof(f));
+    bytes.resize(f.indexOffset);
+    bytes.resize(bytes.size() + 4096, 0);
+
+    CaptureReader r;
+    ASSERT_TRUE(r.Load(bytes));
+    EXPECT_FALSE(r.HadFooter());
+    EXPECT_EQ(r.FrameCount(), 300u);
+    CaptureFrameView v;
+    ASSERT_TRUE(r.Seek(299));
+    ASSERT_TRUE(r.Next(v));
+    EXPECT_EQ(FrameNumber(v), 299);
+}
+
+TEST(CaptureFile, RejectsForeignFile) {
+    CaptureReader r;
+    std::vector<uint8_t> junk(128, 0x41);
+    EXPECT_FALSE(r.Load(junk));
+    EXPECT_FALSE(r.Open("/nonexistent-dir/x/capture.rdxcap"));
+}
+
+TEST(CaptureFile, OversizePayloadTruncated) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    std::vector<uint8_t> big(kCaptureMaxPayload + 50, 0x55);
+    w.Append(0, CaptureDirection::RX, 0, LABEL_RX_DMX_PACKET, 0, big.data(),
+             static_cast<int>(big.size()));
+    w.Close();
+
+    CaptureReader r;
+    ASSERT_TRUE(r.Open(tmp.path));
+    CaptureFrameView v;
+    ASSERT_TRUE(r.Next(v));
+    EXPECT_EQ(v.length, kCaptureMaxPayload);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ReplayDriver
+// ═══════════════════════════════════════════════════════════════════════════
+
+static const uint64_t kSrc = 0x454E00001234ULL;
+static const uint64_t kFixture = 0x4C4500000042ULL;
+
+// Builds a capture in memory the way the API's frame hooks record an
+// Enttec session: requests under their TX label, responses as Label 5
+// (status byte first).
+struct CaptureBuilder {
+    TempPath tmp;
+    CaptureWriter w;
+    int64_t t = 0;
+
+    CaptureBuilder() { w.Open(tmp.path); }
+
+    void Tx(uint8_t label, const std::vector<uint8_t>& pkt) {
+        w.Append(t += 1000, CaptureDirection::TX, 0, label, 0, pkt.data(),
+                 static_cast<int>(pkt.size()));
+    }
+    void Rx(const std::vector<uint8_t>& slots, uint8_t status = 0) {
+        std::vector<uint8_t> payload{status};
+        payload.insert(payload.end(), slots.begin(), slots.end());
+        w.Append(t += 1000, CaptureDirection::RX, 0, LABEL_RX_DMX_PACKET, 0,
+                 payload.data(), static_cast<int>(payload.size()));
+    }
+    std::vector<uint8_t> Finish() {
+        w.Close();
+        return tmp.Bytes();
+    }
+};
+
+static std::vector<uint8_t> GetDeviceInfo(uint8_t tn) {
+    return BuildRDMPacket(kFixture, kSrc, tn, 1, 0, 0, RDM_CC_GET,
+                          PID_DEVICE_INFO);
+}
+
+TEST(ReplayDriver, ReplaysRecordedResponse) {
+    CaptureBuilder b;
+    auto req = GetDeviceInfo(7);
+    auto resp = BuildRDMPacket(kSrc, kFixture, 7, 0, 0, 0, RDM_CC_GET_RSP,
+                               PID_DEVICE_INFO);
+    b.Tx(LABEL_TX_DMX, {0, 1, 2}); // DMX output is skipped
+    b.Tx(LABEL_TX_RDM, req);
+    b.Rx(resp);
+
+    ReplayDriver d;
+    ASSERT_TRUE(d.Load(b.Finish()));
+    EXPECT_EQ(d.ControllerUID(), kSrc);
+    EXPECT_EQ(d.NextTransNum(), 7);
+
+    ASSERT_TRUE(d.SendRDM(req.data(), static_cast<int>(req.size())));
+    EXPECT_TRUE(d.WaitForData(0));
+    uint8_t buf[512], status = 0xEE;
+    int n = d.ReceiveRDM(buf, sizeof(buf), status);
+    ASSERT_EQ(n, static_cast<int>(resp.size()));
+    EXPECT_EQ(memcmp(buf, resp.data(), n), 0);
+    EXPECT_EQ(status, 0);
+    EXPECT_EQ(d.ReceiveRDM(buf, sizeof(buf), status), -1);
+    EXPECT_EQ(status, 0xFF);
+    EXPECT_EQ(d.Mismatches(), 0u);
+    EXPECT_TRUE(d.AtEnd());
+}
+
+TEST(ReplayDriver, CountsChangedRequests) {
+    CaptureBuilder b;
+    b.Tx(LABEL_TX_RDM, GetDeviceInfo(1));
+    b.Tx(LABEL_TX_RDM, GetDeviceInfo(2));
+
+    ReplayDriver d;
+    ASSERT_TRUE(d.Load(b.Finish()));
+    auto same = GetDeviceInfo(1);
+    auto changed = BuildRDMPacket(kFixture, kSrc, 2, 1, 0, 0, RDM_CC_GET,
+                                  PID_SUPPORTED_PARAMS);
+    d.SendRDM(same.data(), static_cast<int>(same.size()));
+    d.SendRDM(changed.data(), static_cast<int>(changed.size()));
+    d.SendRDM(same.data(), static_cast<int>(same.size())); // past the end
+    EXPECT_EQ(d.Requests(), 2u);
+    EXPECT_EQ(d.Mismatches(), 2u);
+}
+
+TEST(ReplayDriver, PurgeDropsQueuedResponses) {
+    CaptureBuilder b;
+    auto req = GetDeviceInfo(0);
+    b.Tx(LABEL_TX_RDM, req);
+    b.Rx({0xCC, 0x01});
+
+    ReplayDriver d;
+    ASSERT_TRUE(d.Load(b.Finish()));
+    d.SendRDM(req.data(), static_cast<int>(req.size()));
+    d.Purge();
+    EXPECT_FALSE(d.WaitForData(0));
+}
+
+TEST(ReplayDriver, FiltersByPort) {
+    TempPath tmp;
+    CaptureWriter w;
+    ASSERT_TRUE(w.Open(tmp.path));
+    auto req = GetDeviceInfo(9);
+    w.Append(0, CaptureDirection::TX, 1, CAPTURE_LABEL_RAW, 0, req.data(),
+             static_cast<int>(req.size()));
+    w.Close();
+
+    ReplayDriver port0, port1;
+    ASSERT_TRUE(port0.Load(tmp.Bytes(), 0));
+    ASSERT_TRUE(port1.Load(tmp.Bytes(), 1));
+    EXPECT_TRUE(port0.AtEnd());
+    EXPECT_EQ(port1.NextTransNum(), 9);
+}
+
+// Encodes a DISC_UNIQUE_BRANCH reply (E1.20 7.5.3)
+static std::vector<uint8_t> EncodeDubReply(uint64_t uid) {
+    std::vector<uint8_t> out(7, 0xFE);
+    out.push_back(0xAA);
+    uint16_t sum = 0;
+    for (int i = 5; i >= 0; --i) {
+        uint8_t byte = static_cast<uint8_t>(uid >> (i * 8));
+        out.push_back(byte | 0xAA);
+        out.push_back(byte | 0x55);
+        sum += (byte | 0xAA) + (byte | 0x55);
+    }
+    for (uint8_t byte : {uint8_t(sum >> 8), uint8_t(sum & 0xFF)}) {
+        out.push_back(byte | 0xAA);
+        out.push_back(byte | 0x55);
+    }
+    return out;
+}
+
+TEST(ReplayDriver, DiscoveryReplaysThroughRdmStack) {
+    // One responder: un-mute x2, branch -> UID, mute, branch -> silence
+    CaptureBuilder b;
+    uint8_t tn = 0x40;
+    uint8_t range[12] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                         0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF};
+    for (int i = 0; i < 2; ++i)
+        b.Tx(LABEL_TX_RDM,
+             BuildRDMPacket(RDM_BROADCAST_UID, kSrc, tn++, 1, 0, 0,
+                            RDM_CC_DISCOVERY, PID_DISC_UN_MUTE));
+    b.Tx(LABEL_TX_RDM_DISCOVERY,
+         BuildRDMPacket(RDM_BROADCAST_UID, kSrc, tn++, 1, 0, 0,
+                        RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH, range, 12));
+    b.Rx(EncodeDubReply(kFixture));
+    b.Tx(LABEL_TX_RDM, BuildRDMPacket(kFixture, kSrc, tn, 1, 0, 0,
+                                      RDM_CC_DISCOVERY, PID_DISC_MUTE));
+    b.Rx(BuildRDMPacket(kSrc, kFixture, tn++, 0, 0, 0, RDM_CC_DISCOVERY_RSP,
+                        PID_DISC_MUTE));
+    b.Tx(LABEL_TX_RDM_DISCOVERY,
+         BuildRDMPacket(RDM_BROADCAST_UID, kSrc, tn++, 1, 0, 0,
+                        RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH, range, 12));
+
+    ReplayDriver d;
+    ASSERT_TRUE(d.Load(b.Finish()));
+    std::vector<uint64_t> found = RDMDiscovery(d, d.ControllerUID());
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], kFixture);
+    EXPECT_EQ(d.Mismatches(), 0u);
+    EXPECT_TRUE(d.AtEnd());
+}
@@ -0,0 +1,270 @@
+// tests/cpp/test_config_push.cpp
+// Unit tests for ConfigPusher: the SET list taken from a map column, the
+// compare / SET / read-back passes across a port's fixtures, refused and
+// unconfirmed SETs, ACK_TIMER SETs, remembered values, and pushes to
+// ResponderSim.
+#include <gtest/gtest.h>
+#include "config_push.h"
+#include "fake_fixture.h"
+#include "responder_sim.h"
+#include "validation_planner.h"
+#include <string>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+static const uint64_t kUID1 = 0x434B00000001ULL;
+static const uint64_t kUID2 = 0x434B00000002ULL;
+
+static RDMParameterRow Row(uint16_t pid, uint8_t cc, const char *fw,
+                           const char *test, const char *shipping) {
+    RDMParameterRow r;
+    r.pid = pid;
+    r.commandClass = cc;
+    r.fwDefault = fw;
+    r.testValue = test;
+    r.shippingValue = shipping;
+    return r;
+}
+
+// A fixture of a port whose requests all go to one log
+static FakeFixture OnLog(uint64_t uid, std::vector<std::string> *log) {
+    FakeFixture fx;
+    fx.uid = uid;
+    fx.log = log;
+    return fx;
+}
+
+static PushTarget Target(FakeFixture &fx) {
+    PushTarget t;
+    t.uid = fx.uid;
+    t.get = fx.Get();
+    t.set = fx.Set();
+    return t;
+}
+
+static std::vector<ConfigSet> Config() {
+    return {{0x00E0, "Personality", {0x02}},
+            {0x00F0, "Start Address", {0x00, 0x05}}};
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Map
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ConfigPush, TakesTheColumnFromTheMap) {
+    std::vector<RDMParameterRow> rows = {
+        Row(0x00E0, RDM_CC_GET, "", "0x02", "0x01"), // value on GET row
+        Row(0x00E0, RDM_CC_SET, "", "", ""),
+        Row(0x00F0, RDM_CC_GET, "0x0001", "0x0001", "0x0001"),
+        Row(0x00F0, RDM_CC_SET, "", "", ""),
+        Row(0x0060, RDM_CC_GET, "", "0x01", "0x01"), // read-only
+        Row(0x1000, RDM_CC_SET, "", "0x01", "0x00"), // identify
+        Row(0x8600, RDM_CC_SET, "", "see notes", "")};
+
+    auto test = ConfigFromMap(rows, ConfigColumn::TEST);
+    ASSERT_EQ(test.size(), 2u);
+    EXPECT_EQ(test[0].pid, 0x00E0);
+    EXPECT_EQ(test[0].value, (std::vector<uint8_t>{0x02}));
+    EXPECT_EQ(test[1].pid, 0x00F0);
+    EXPECT_EQ(test[1].value, (std::vector<uint8_t>{0x00, 0x01}));
+
+    auto shipping = ConfigFromMap(rows, ConfigColumn::SHIPPING);
+    ASSERT_EQ(shipping.size(), 2u);
+    EXPECT_EQ(shipping[0].value, (std::vector<uint8_t>{0x01}));
+    EXPECT_EQ(ConfigFromMap(rows, ConfigColumn::FW_DEFAULTS).size(), 1u);
+}
+
+TEST(ConfigPush, MatchesTheWholeGet) {
+    EXPECT_TRUE(ConfigMatches(PID_DMX_START_ADDRESS, {0x00, 0x05},
+                              {0x00, 0x05}));
+    EXPECT_FALSE(ConfigMatches(PID_DMX_START_ADDRESS, {0x00, 0x05, 0x00},
+                               {0x00, 0x05}));
+    EXPECT_FALSE(ConfigMatches(PID_DMX_START_ADDRESS, {}, {0x00, 0x05}));
+}
+
+TEST(ConfigPush, MatchesThePrefixOfCurrentAndCount) {
+    EXPECT_TRUE(ConfigMatches(PID_DMX_PERSONALITY, {0x02, 0x03}, {0x02}));
+    EXPECT_TRUE(ConfigMatches(PID_CURVE, {0x01, 0x04}, {0x01}));
+    EXPECT_FALSE(ConfigMatches(PID_DMX_PERSONALITY, {0x01, 0x03}, {0x02}));
+    EXPECT_FALSE(ConfigMatches(PID_DMX_PERSONALITY, {}, {0x02}));
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Passes
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ConfigPush, ComparesSetsThenReadsBackAcrossThePort) {
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    FakeFixture b = OnLog(kUID2, &log);
+    a.Ack(0x00E0, {0x02, 0x03}); // personality already right
+    ConfigPusher pusher;
+
+    auto results = pusher.Push({Target(a), Target(b)}, Config());
+    EXPECT_EQ(log, (std::vector<std::string>{"G1", "G1", "G2", "G2", "S1",
+                                             "S2", "S2", "G1", "G2",
+                                             "G2"}));
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].skipped, 1);
+    EXPECT_EQ(results[0].sets, 1);
+    EXPECT_EQ(results[0].items[0].outcome, PushOutcome::SKIPPED);
+    EXPECT_EQ(results[0].items[1].outcome, PushOutcome::SET);
+    EXPECT_EQ(results[1].sets, 2);
+    EXPECT_EQ(results[1].Transactions(), 6);
+    EXPECT_TRUE(results[0].Ok());
+    EXPECT_TRUE(results[1].Ok());
+    EXPECT_EQ(b.Data(0x00F0), (std::vector<uint8_t>{0x00, 0x05}));
+}
+
+TEST(ConfigPush, ReportsRefusedAndUnconfirmedSets) {
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    a.refuse.insert(0x00E0);
+    a.ignore.insert(0x00F0);
+    a.Ack(0x00F0, {0x00, 0x01});
+    ConfigPusher pusher;
+
+    PushResult r = pusher.Push({Target(a)}, Config())[0];
+    EXPECT_EQ(r.failed, 1);
+    EXPECT_EQ(r.items[0].outcome, PushOutcome::FAILED);
+    EXPECT_EQ(r.items[0].nackReason, NR_WRITE_PROTECT);
+    EXPECT_EQ(r.mismatched, 1);
+    EXPECT_EQ(r.items[1].outcome, PushOutcome::MISMATCH);
+    EXPECT_EQ(r.items[1].readBack, (std::vector<uint8_t>{0x00, 0x01}));
+    EXPECT_EQ(r.verifies, 1); // the refused SET is not read back
+    EXPECT_FALSE(r.Ok());
+    EXPECT_EQ(pusher.KnownCount(), 0u);
+}
+
+TEST(ConfigPush, ReadsBackAnAckTimerSetWhenItIsDue) {
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    a.slow.insert(0x00F0);
+    ConfigPusher pusher;
+    PushResult r = pusher.Push({Target(a)}, Config())[0];
+    EXPECT_EQ(r.items[1].setResponse, RDMResponseType::ACK_TIMER);
+    EXPECT_EQ(r.items[1].outcome, PushOutcome::SET);
+    EXPECT_TRUE(r.Ok());
+    EXPECT_GE(r.elapsedUs, 100000); // the 100 ms the fixture asked for
+}
+
+TEST(ConfigPush, RemembersVerifiedValues) {
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    ConfigPusher pusher;
+    pusher.Push({Target(a)}, Config());
+    EXPECT_EQ(pusher.KnownCount(), 2u);
+
+    log.clear();
+    PushOptions opts;
+    opts.useKnown = true;
+    PushResult r = pusher.Push({Target(a)}, Config(), opts)[0];
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(r.known, 2);
+    EXPECT_EQ(r.skipped, 2);
+
+    pusher.Forget(kUID1);
+    r = pusher.Push({Target(a)}, Config(), opts)[0];
+    EXPECT_EQ(r.gets, 2);
+}
+
+TEST(ConfigPush, LongerGetIsNotTheSameValue) {
+    const uint16_t kDeviceLabel = 0x0082;
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    a.Ack(kDeviceLabel, {'S', 't', 'a', 'g', 'e', ' ', 'L', 'e', 'f', 't'});
+    ConfigPusher pusher;
+    PushResult r = pusher.Push(
+        {Target(a)}, {{kDeviceLabel, "Label", {'S', 't', 'a', 'g', 'e'}}})[0];
+    EXPECT_EQ(r.skipped, 0);
+    EXPECT_EQ(r.sets, 1);
+    EXPECT_EQ(r.items[0].outcome, PushOutcome::SET);
+    EXPECT_EQ(a.Data(kDeviceLabel),
+              (std::vector<uint8_t>{'S', 't', 'a', 'g', 'e'}));
+}
+
+TEST(ConfigPush, BlindPushSendsOnlySets) {
+    std::vector<std::string> log;
+    FakeFixture a = OnLog(kUID1, &log);
+    PushOptions opts;
+    opts.skipMatching = false;
+    opts.verify = false;
+    ConfigPusher pusher;
+    PushResult r = pusher.Push({Target(a)}, Config(), opts)[0];
+    EXPECT_EQ(log, (std::vector<std::string>{"S1", "S1"}));
+    EXPECT_EQ(r.Transactions(), 2);
+    EXPECT_EQ(pusher.KnownCount(), 0u); // nothing confirmed
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated port
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ConfigPush, ShippingPrepOnASimulatedPort) {
+    std::vector<RDMParameterRow> rows = {
+        Row(PID_DMX_START_ADDRESS, RDM_CC_GET, "0x0001", "0x0010", "0x0001"),
+        Row(PID_DMX_START_ADDRESS, RDM_CC_SET, "", "", "")};
+    rows[0].payloadLength = rows[1].payloadLength = "2 byte";
+    rows[1].minValue = "0x0001";
+    rows[1].maxValue = "0x0200";
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(3, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(rows, {}), uids));
+
+    auto port = [&] {
+        std::vector<PushTarget> targets;
+        for (uint64_t uid : uids)
+            targets.push_back({uid, PlannerGet(sim, kController, uid),
+                               PushSet(sim, kController, uid)});
+        return targets;
+    };
+    ConfigPusher pusher;
+    auto test = pusher.Push(port(), ConfigFromMap(rows, ConfigColumn::TEST));
+    for (const PushResult &r : test) {
+        EXPECT_TRUE(r.Ok());
+        EXPECT_EQ(r.sets, 1);
+    }
+    std::vector<uint8_t> v;
+    ASSERT_TRUE(sim.GetValue(uids[1], PID_DMX_START_ADDRESS, v));
+    EXPECT_EQ(v, (std::vector<uint8_t>{0x00, 0x10}));
+
+    uint64_t before = sim.Counters().requests;
+    auto shipping =
+        pusher.Push(port(), ConfigFromMap(rows, ConfigColumn::SHIPPING));
+    EXPECT_EQ(sim.Counters().requests - before, 3u * 3u);
+    ASSERT_TRUE(sim.GetValue(uids[2], PID_DMX_START_ADDRESS, v));
+    EXPECT_EQ(v, (std::vector<uint8_t>{0x00, 0x01}));
+
+    // Already shipped: compare GETs only
+    before = sim.Counters().requests;
+    auto again =
+        pusher.Push(port(), ConfigFromMap(rows, ConfigColumn::SHIPPING));
+    EXPECT_EQ(sim.Counters().requests - before, 3u);
+    EXPECT_EQ(again[0].skipped, 1);
+}
+
+TEST(ConfigPush, DeferredReadBackIsPendingNotMismatched) {
+    std::vector<RDMParameterRow> rows = {
+        Row(PID_DMX_START_ADDRESS, RDM_CC_GET, "0x0001", "0x0010", ""),
+        Row(PID_DMX_START_ADDRESS, RDM_CC_SET, "", "", "")};
+    rows[0].payloadLength = rows[1].payloadLength = "2 byte";
+    rows[1].minValue = "0x0001";
+    rows[1].maxValue = "0x0200";
+    SimOptions opts;
+    opts.ackTimerPids = {PID_DMX_START_ADDRESS}; // GETs answer ACK_TIMER too
+    opts.ackTimerMs = 50;
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(1, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(rows, {}), uids, opts));
+
+    ConfigPusher pusher;
+    PushResult r = pusher.Push({{uids[0], PlannerGet(sim, kController, uids[0]),
+                                 PushSet(sim, kController, uids[0])}},
+                               ConfigFromMap(rows, ConfigColumn::TEST))[0];
+    ASSERT_EQ(r.items.size(), 1u);
+    EXPECT_EQ(r.items[0].setResponse, RDMResponseType::ACK_TIMER);
+    EXPECT_EQ(r.items[0].outcome, PushOutcome::PENDING);
+    EXPECT_EQ(r.pending, 1);
+    EXPECT_EQ(r.mismatched, 0);
+    EXPECT_GE(r.elapsedUs, 100000); // estimate rounded up to 100 ms
+}
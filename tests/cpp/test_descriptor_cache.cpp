@@ -0,0 +1,286 @@
+// tests/cpp/test_descriptor_cache.cpp
+// Unit tests for DescriptorCache: the model key from DEVICE_INFO, which
+// PIDs count as descriptors, a second fixture of a model answered from
+// memory, what is never cached, the cache file and its damaged lines, and
+// a simulated fleet.
+#include <gtest/gtest.h>
+#include "descriptor_cache.h"
+#include "fake_fixture.h"
+#include "fleet_validator.h"
+#include "responder_sim.h"
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+static const uint64_t kUID1 = 0x434B00000001ULL;
+static const uint64_t kUID2 = 0x434B00000002ULL;
+
+static std::vector<uint8_t> DeviceInfo(uint16_t model, uint32_t software) {
+    std::vector<uint8_t> d(19, 0);
+    d[0] = 0x01;
+    d[2] = static_cast<uint8_t>(model >> 8);
+    d[3] = static_cast<uint8_t>(model);
+    d[6] = static_cast<uint8_t>(software >> 24);
+    d[7] = static_cast<uint8_t>(software >> 16);
+    d[8] = static_cast<uint8_t>(software >> 8);
+    d[9] = static_cast<uint8_t>(software);
+    return d;
+}
+
+// One fixture of a model: DEVICE_INFO, a label and a start address
+static FakeFixture Fixture(uint16_t model, uint32_t software) {
+    FakeFixture fx;
+    fx.Ack(PID_DEVICE_INFO, DeviceInfo(model, software));
+    fx.Ack(PID_SOFTWARE_VERSION_LABEL, {'1', '.', '0'});
+    fx.Ack(PID_DMX_START_ADDRESS, {0x00, 0x01});
+    return fx;
+}
+
+static std::vector<RDMParameter> Params() {
+    return {{PID_DEVICE_INFO, "Device Info", "", true, ""},
+            {PID_SOFTWARE_VERSION_LABEL, "Software Label", "", true, ""},
+            {PID_DMX_START_ADDRESS, "Start Address", "", true, ""}};
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Key and PIDs
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DescriptorCache, ParsesTheModelKey) {
+    ModelKey key;
+    EXPECT_FALSE(ParseModelKey(kUID1, {0x01, 0x00, 0x12}, key));
+    ASSERT_TRUE(ParseModelKey(kUID1, DeviceInfo(0x1234, 0x00010203), key));
+    EXPECT_EQ(key.manufacturer, 0x434B);
+    EXPECT_EQ(key.model, 0x1234);
+    EXPECT_EQ(key.softwareVersion, 0x00010203u);
+}
+
+TEST(DescriptorCache, DescriptorPids) {
+    EXPECT_TRUE(IsDescriptorPid(PID_PARAMETER_DESCRIPTION));
+    EXPECT_TRUE(IsDescriptorPid(PID_SOFTWARE_VERSION_LABEL));
+    EXPECT_TRUE(IsDescriptorPid(PID_SENSOR_DEFINITION));
+    EXPECT_FALSE(IsDescriptorPid(PID_DEVICE_INFO));
+    EXPECT_FALSE(IsDescriptorPid(PID_DMX_START_ADDRESS));
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Sharing
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DescriptorCache, SecondFixtureOfAModelIsAnsweredFromMemory) {
+    DescriptorCache cache;
+    FakeFixture a = Fixture(0x0001, 0x00010000);
+    FakeFixture b = Fixture(0x0001, 0x00010000);
+    int servedA = 0, servedB = 0;
+
+    auto first = ValidateFixture(cache.Wrap(a.Get(), kUID1, &servedA),
+                                 Params());
+    auto second = ValidateFixture(cache.Wrap(b.Get(), kUID2, &servedB),
+                                  Params());
+
+    // DEVICE_INFO is read once and reused for its own row
+    EXPECT_EQ(a.requests, (std::vector<uint16_t>{PID_DEVICE_INFO,
+                                                 PID_SOFTWARE_VERSION_LABEL,
+                                                 PID_DMX_START_ADDRESS}));
+    EXPECT_EQ(b.requests, (std::vector<uint16_t>{PID_DEVICE_INFO,
+                                                 PID_DMX_START_ADDRESS}));
+    EXPECT_EQ(servedA, 0);
+    EXPECT_EQ(servedB, 1);
+    ASSERT_EQ(second.size(), 3u);
+    EXPECT_EQ(second[1].value, first[1].value);
+    EXPECT_EQ(second[1].status, ValidationStatus::GREEN);
+
+    DescriptorStats st = cache.Stats();
+    EXPECT_EQ(st.hits, 1u);
+    EXPECT_EQ(st.misses, 1u);
+    EXPECT_EQ(st.models, 1u);
+    EXPECT_EQ(st.entries, 1u);
+}
+
+TEST(DescriptorCache, OtherFirmwareIsAnotherModel) {
+    DescriptorCache cache;
+    FakeFixture a = Fixture(0x0001, 0x00010000);
+    FakeFixture b = Fixture(0x0001, 0x00020000);
+    b.Ack(PID_SOFTWARE_VERSION_LABEL, {'2', '.', '0'});
+    ValidateFixture(cache.Wrap(a.Get(), kUID1), Params());
+    auto rows = ValidateFixture(cache.Wrap(b.Get(), kUID2), Params());
+
+    EXPECT_EQ(b.requests.size(), 3u);
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_EQ(rows[1].value, "32 2E 30");
+    EXPECT_EQ(cache.Stats().models, 2u);
+}
+
+TEST(DescriptorCache, KeepsOnlyAnswersOfTheModel) {
+    DescriptorCache cache;
+    ModelKey key;
+    ASSERT_TRUE(ParseModelKey(kUID1, DeviceInfo(1, 1), key));
+    RDMResponse timeout, busy, unknown, out;
+    busy.type = unknown.type = RDMResponseType::NACK;
+    busy.nackReason = NR_HARDWARE_FAULT;
+    unknown.nackReason = NR_UNKNOWN_PID;
+
+    cache.Store(key, PID_SENSOR_DEFINITION, {0}, timeout);
+    cache.Store(key, PID_SENSOR_DEFINITION, {1}, busy);
+    cache.Store(key, PID_SENSOR_DEFINITION, {2}, unknown);
+    EXPECT_FALSE(cache.Find(key, PID_SENSOR_DEFINITION, {0}, out));
+    EXPECT_FALSE(cache.Find(key, PID_SENSOR_DEFINITION, {1}, out));
+    ASSERT_TRUE(cache.Find(key, PID_SENSOR_DEFINITION, {2}, out));
+    EXPECT_EQ(out.type, RDMResponseType::NACK);
+    EXPECT_EQ(out.nackReason, NR_UNKNOWN_PID);
+}
+
+TEST(DescriptorCache, NothingIsSharedWithoutDeviceInfo) {
+    DescriptorCache cache;
+    FakeFixture a = Fixture(1, 1);
+    FakeFixture b = Fixture(1, 1);
+    a.answers.erase({PID_DEVICE_INFO, {}});
+    b.answers.erase({PID_DEVICE_INFO, {}});
+    ValidateFixture(cache.Wrap(a.Get(), kUID1), Params());
+    ValidateFixture(cache.Wrap(b.Get(), kUID2), Params());
+    EXPECT_EQ(cache.Stats().entries, 0u);
+    EXPECT_EQ(b.requests.size(), 3u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// File
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DescriptorCache, SavesAndLoads) {
+    DescriptorCache cache;
+    ModelKey key;
+    ASSERT_TRUE(ParseModelKey(kUID1, DeviceInfo(0x0042, 0x01020304), key));
+    RDMResponse label, nack;
+    label.type = RDMResponseType::ACK;
+    label.data = {'V', 'a', 'y', 'a'};
+    nack.type = RDMResponseType::NACK;
+    nack.nackReason = NR_DATA_OUT_OF_RANGE;
+    cache.Store(key, PID_DEVICE_MODEL_DESCRIPTION, {}, label);
+    cache.Store(key, PID_DMX_PERSONALITY_DESCRIPTION, {9}, nack);
+
+    std::string path = ::testing::TempDir() + "descriptor_cache_test.txt";
+    ASSERT_TRUE(cache.Save(path));
+    DescriptorCache loaded;
+    EXPECT_EQ(loaded.Load(path), 2);
+    std::remove(path.c_str());
+    EXPECT_EQ(loaded.Load(path), -1);
+
+    RDMResponse out;
+    ASSERT_TRUE(loaded.Find(key, PID_DEVICE_MODEL_DESCRIPTION, {}, out));
+    EXPECT_EQ(out.type, RDMResponseType::ACK);
+    EXPECT_EQ(out.data, label.data);
+    ASSERT_TRUE(loaded.Find(key, PID_DMX_PERSONALITY_DESCRIPTION, {9}, out));
+    EXPECT_EQ(out.type, RDMResponseType::NACK);
+    EXPECT_EQ(out.nackReason, NR_DATA_OUT_OF_RANGE);
+    EXPECT_TRUE(out.data.empty());
+}
+
+TEST(DescriptorCache, SkipsDamagedLinesAndOtherVersions) {
+    DescriptorCache cache;
+    ModelKey key;
+    ASSERT_TRUE(ParseModelKey(kUID1, DeviceInfo(0x0042, 0x01020304), key));
+    RDMResponse label;
+    label.type = RDMResponseType::ACK;
+    label.data = {'V', 'a', 'y', 'a'};
+    cache.Store(key, PID_DEVICE_MODEL_DESCRIPTION, {}, label);
+    cache.Store(key, PID_MANUFACTURER_LABEL, {}, label);
+    std::string path = ::testing::TempDir() + "descriptor_cache_bad.txt";
+    ASSERT_TRUE(cache.Save(path));
+
+    // Edit one response in place: its line check no longer matches
+    std::vector<std::string> lines;
+    {
+        std::ifstream in(path);
+        for (std::string l; std::getline(in, l);)
+            lines.push_back(l);
+    }
+    ASSERT_EQ(lines.size(), 3u);
+    size_t at = lines[1].find("56617961"); // "Vaya"
+    ASSERT_NE(at, std::string::npos);
+    lines[1][at] = '4';
+    {
+        std::ofstream out(path);
+        for (const std::string &l : lines)
+            out << l << "\n";
+    }
+    DescriptorCache loaded;
+    EXPECT_EQ(loaded.Load(path), 1);
+    EXPECT_EQ(loaded.Stats().entries, 1u);
+
+    // A file without the current header is not read at all
+    {
+        std::ofstream out(path);
+        out << "# RDM-X descriptor cache v1\n" << lines[2] << "\n";
+    }
+    EXPECT_EQ(DescriptorCache().Load(path), -1);
+    std::remove(path.c_str());
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated fleet
+TEST(DescriptorCache, CacheHitsAreNotPlannerCosts) {
+    DescriptorCache cache;
+    FakeFixture a = Fixture(0x0001, 0x00010000);
+    FakeFixture b = Fixture(0x0001, 0x00010000);
+    ValidateFixture(cache.Wrap(a.Get(), kUID1), Params());
+
+    ValidationPlanner planner;
+    planner.Observe(PID_SOFTWARE_VERSION_LABEL, RDMResponseType::ACK, 5000);
+    int64_t label = planner.ExpectedUs(PID_SOFTWARE_VERSION_LABEL, true);
+
+    int served = 0;
+    int64_t labelUs = -1;
+    ValidationOptions opts;
+    opts.samples = [&labelUs](const ValidationSample &s) {
+        if (s.parameter->pid == PID_SOFTWARE_VERSION_LABEL)
+            labelUs = s.latencyUs;
+        return true;
+    };
+    planner.Validate(cache.Wrap(b.Get(), kUID2, &served), kUID2, Params(),
+                     nullptr, opts);
+
+    EXPECT_EQ(served, 1);
+    EXPECT_EQ(planner.ExpectedUs(PID_SOFTWARE_VERSION_LABEL, true), label);
+    EXPECT_EQ(labelUs, 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DescriptorCache, FleetOfOneModelReadsDescriptorsOnce) {
+    RDMParameterRow info, label;
+    info.pid = PID_DEVICE_INFO;
+    info.commandClass = RDM_CC_GET;
+    info.payloadLength = "19 bytes";
+    label.pid = PID_SOFTWARE_VERSION_LABEL;
+    label.commandClass = RDM_CC_GET;
+    label.payloadLength = "32 bytes";
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(6, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel({info, label}, {}), uids));
+
+    DescriptorCache cache;
+    FleetValidator fleet;
+    fleet.AddPort(sim, kController, Params(), uids, nullptr, nullptr,
+                  &cache);
+    std::vector<FleetFixtureResult> results;
+    std::mutex mutex;
+    ASSERT_TRUE(fleet.Start([&](FleetFixtureResult &&r) {
+        std::lock_guard<std::mutex> lk(mutex);
+        results.push_back(std::move(r));
+    }));
+    fleet.Wait();
+
+    // Three GETs for the first fixture, two for each of the others
+    EXPECT_EQ(sim.Counters().requests, 3u + 5u * 2u);
+    ASSERT_EQ(results.size(), 6u);
+    int shared = 0;
+    for (const auto &r : results) {
+        shared += r.shared;
+        ASSERT_EQ(r.results.size(), 3u);
+        EXPECT_EQ(r.results[1].value, results[0].results[1].value);
+    }
+    EXPECT_EQ(shared, 5);
+}
@@ -0,0 +1,201 @@
+// tests/cpp/test_device_profile.cpp
+// Unit tests for ReadDeviceProfile: the E1.20 descriptor layouts, the
+// indexed GETs derived from DEVICE_INFO and SUPPORTED_PARAMETERS, indexes
+// that fail, and profiles read from ResponderSim at bus speed.
+#include <gtest/gtest.h>
+#include "descriptor_cache.h"
+#include "device_profile.h"
+#include "fake_fixture.h"
+#include "responder_sim.h"
+#include "validation_planner.h"
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+static const uint64_t kUID = 0x434B00000001ULL;
+
+static std::vector<uint8_t> Info(uint8_t personalities, uint8_t sensors) {
+    std::vector<uint8_t> d(19, 0);
+    d[0] = 0x01;
+    d[3] = 0x42;            // model
+    d[11] = 4;              // footprint
+    d[12] = 1;
+    d[13] = personalities;
+    d[14] = 0x00;
+    d[15] = 0x01;           // start address
+    d[18] = sensors;
+    return d;
+}
+
+static std::vector<uint8_t> WithLabel(std::vector<uint8_t> d,
+                                      const std::string &label) {
+    d.insert(d.end(), label.begin(), label.end());
+    return d;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Layouts
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DeviceProfile, ParsesDeviceInfo) {
+    DeviceInfo info;
+    EXPECT_FALSE(ParseDeviceInfo(std::vector<uint8_t>(18, 0), info));
+    ASSERT_TRUE(ParseDeviceInfo(Info(3, 2), info));
+    EXPECT_EQ(info.protocol, 0x0100);
+    EXPECT_EQ(info.model, 0x0042);
+    EXPECT_EQ(info.footprint, 4);
+    EXPECT_EQ(info.personalityCount, 3);
+    EXPECT_EQ(info.startAddress, 1);
+    EXPECT_EQ(info.sensorCount, 2);
+}
+
+TEST(DeviceProfile, ParsesDescriptors) {
+    PersonalityDesc pers;
+    EXPECT_FALSE(ParsePersonalityDesc({1, 0}, pers));
+    ASSERT_TRUE(ParsePersonalityDesc(WithLabel({2, 0x00, 0x08}, "RGBW"),
+                                     pers));
+    EXPECT_EQ(pers.number, 2);
+    EXPECT_EQ(pers.footprint, 8);
+    EXPECT_EQ(pers.description, "RGBW");
+
+    SensorDef sensor;
+    EXPECT_FALSE(ParseSensorDef(std::vector<uint8_t>(12, 0), sensor));
+    ASSERT_TRUE(ParseSensorDef(WithLabel({0, 0x00, 0x01, 0x00, 0xFF, 0xD8,
+                                          0x00, 0x96, 0x00, 0x00, 0x00,
+                                          0x50, 0x03},
+                                         std::string("LED\0\0", 5)),
+                               sensor));
+    EXPECT_EQ(sensor.unit, 1);
+    EXPECT_EQ(sensor.rangeMin, -40);
+    EXPECT_EQ(sensor.rangeMax, 150);
+    EXPECT_EQ(sensor.normalMax, 80);
+    EXPECT_EQ(sensor.recordedSupport, 3);
+    EXPECT_EQ(sensor.description, "LED");
+
+    ParameterDesc param;
+    std::vector<uint8_t> d = {0x80, 0x60, 6, 1, 1, 0, 0, 0,
+                              0, 0, 0, 1, 0, 0, 0x02, 0,
+                              0, 0, 0, 1};
+    EXPECT_FALSE(ParseParameterDesc({0x80, 0x60}, param));
+    ASSERT_TRUE(ParseParameterDesc(WithLabel(d, "Serial"), param));
+    EXPECT_EQ(param.pid, 0x8060);
+    EXPECT_EQ(param.pdlSize, 6);
+    EXPECT_EQ(param.commandClass, 1);
+    EXPECT_EQ(param.minValue, 1u);
+    EXPECT_EQ(param.maxValue, 0x200u);
+    EXPECT_EQ(param.defaultValue, 1u);
+    EXPECT_EQ(param.description, "Serial");
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Enumeration
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(DeviceProfile, ReadsEveryIndexTheCountsCallFor) {
+    FakeFixture fx;
+    fx.Ack(PID_DEVICE_INFO, Info(2, 1));
+    fx.Ack(PID_SUPPORTED_PARAMS, {0x00, 0xF0, 0x80, 0x60, 0x80, 0x70});
+    fx.Ack(PID_DMX_PERSONALITY_DESCRIPTION, WithLabel({1, 0, 4}, "A"), {1});
+    fx.Ack(PID_DMX_PERSONALITY_DESCRIPTION, WithLabel({2, 0, 8}, "B"), {2});
+    fx.Ack(PID_SENSOR_DEFINITION, std::vector<uint8_t>(13, 0), {0});
+    std::vector<uint8_t> desc(20, 0);
+    desc[0] = 0x80;
+    desc[1] = 0x60;
+    fx.Ack(PID_PARAMETER_DESCRIPTION, desc, {0x80, 0x60}); // 0x8070 times out
+
+    DeviceProfile p = ReadDeviceProfile(fx.Get(), kUID);
+    EXPECT_TRUE(p.haveInfo);
+    EXPECT_TRUE(p.haveSupported);
+    EXPECT_EQ(p.supported, (std::vector<uint16_t>{0x00F0, 0x8060, 0x8070}));
+    ASSERT_EQ(p.personalities.size(), 2u);
+    EXPECT_EQ(p.personalities[1].description, "B");
+    EXPECT_EQ(p.sensors.size(), 1u);
+    ASSERT_EQ(p.parameters.size(), 1u);
+    EXPECT_EQ(p.parameters[0].pid, 0x8060);
+    EXPECT_EQ(p.failed, 1);
+    EXPECT_EQ(p.requests, 2 + 2 + 1 + 2);
+
+    // Standard PIDs get no PARAMETER_DESCRIPTION
+    ASSERT_EQ(fx.requests.size(), 7u);
+    EXPECT_EQ(fx.paramData[5], (std::vector<uint8_t>{0x80, 0x60}));
+    EXPECT_EQ(fx.paramData[6], (std::vector<uint8_t>{0x80, 0x70}));
+}
+
+TEST(DeviceProfile, SilentFixtureCostsTwoGets) {
+    FakeFixture fx;
+    DeviceProfile p = ReadDeviceProfile(fx.Get(), kUID);
+    EXPECT_FALSE(p.haveInfo);
+    EXPECT_FALSE(p.haveSupported);
+    EXPECT_EQ(p.requests, 2);
+    EXPECT_EQ(p.failed, 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated fixture
+// ═══════════════════════════════════════════════════════════════════════
+
+static RDMParameterRow Row(uint16_t pid, uint8_t cc, const char *name,
+                           const char *size) {
+    RDMParameterRow r;
+    r.pid = pid;
+    r.commandClass = cc;
+    r.name = name;
+    r.payloadLength = size;
+    return r;
+}
+
+TEST(DeviceProfile, ProfilesASimulatedFixture) {
+    std::vector<RDMParameterRow> rows = {
+        Row(PID_DEVICE_INFO, RDM_CC_GET, "Device Info", "19 bytes"),
+        Row(PID_SUPPORTED_PARAMS, RDM_CC_GET, "Supported", ""),
+        Row(PID_PARAMETER_DESCRIPTION, RDM_CC_GET, "Description", ""),
+        Row(PID_DMX_PERSONALITY, RDM_CC_GET, "Personality", "2 byte"),
+        Row(PID_DMX_PERSONALITY, RDM_CC_SET, "Personality", "1 byte"),
+        Row(PID_DMX_PERSONALITY_DESCRIPTION, RDM_CC_GET, "Pers. Desc", ""),
+        Row(0x8060, RDM_CC_GET, "Serial Number", "6 byte")};
+    rows[4].minValue = "0x01";
+    rows[4].maxValue = "0x03";
+    rows[6].inSupportedParams = "Yes";
+    ResponderSim sim;
+    ASSERT_TRUE(sim.Open(BuildSimModel(rows, {}), {kUID}));
+
+    DescriptorCache cache;
+    DeviceProfile p = ReadDeviceProfile(
+        cache.Wrap(PlannerGet(sim, kController, kUID), kUID), kUID);
+    EXPECT_TRUE(p.haveInfo);
+    EXPECT_EQ(p.info.personalityCount, 3);
+    ASSERT_EQ(p.personalities.size(), 3u);
+    EXPECT_EQ(p.personalities[2].number, 3);
+    EXPECT_EQ(p.personalities[2].description, "Personality 3");
+    ASSERT_EQ(p.parameters.size(), 1u);
+    EXPECT_EQ(p.parameters[0].pid, 0x8060);
+    EXPECT_EQ(p.parameters[0].pdlSize, 6);
+    EXPECT_EQ(p.parameters[0].description, "Serial Number");
+    EXPECT_EQ(p.failed, 0);
+    // DEVICE_INFO read once although the cache needs it for the key
+    EXPECT_EQ(sim.Counters().requests, 2u + 3u + 1u);
+    EXPECT_EQ(cache.Stats().entries, 4u);
+}
+
+// Each GET waits for its reply, not a fixed pause: 34 GETs with a 3 ms
+// turnaround take about 0.1 s, against 1 s at 30 ms per GET
+TEST(DeviceProfile, ReadsAtBusSpeed) {
+    std::vector<RDMParameterRow> rows = {
+        Row(PID_DEVICE_INFO, RDM_CC_GET, "Device Info", "19 bytes"),
+        Row(PID_SUPPORTED_PARAMS, RDM_CC_GET, "Supported", ""),
+        Row(PID_DMX_PERSONALITY, RDM_CC_GET, "Personality", "2 byte"),
+        Row(PID_DMX_PERSONALITY, RDM_CC_SET, "Personality", "1 byte"),
+        Row(PID_DMX_PERSONALITY_DESCRIPTION, RDM_CC_GET, "Pers. Desc", "")};
+    rows[3].minValue = "0x01";
+    rows[3].maxValue = "0x20";
+    SimOptions opts;
+    opts.turnaroundUs = 3000;
+    ResponderSim sim;
+    ASSERT_TRUE(sim.Open(BuildSimModel(rows, {}), {kUID}, opts));
+
+    DeviceProfile p =
+        ReadDeviceProfile(PlannerGet(sim, kController, kUID), kUID);
+    EXPECT_EQ(p.personalities.size(), 32u);
+    ASSERT_EQ(p.requests, 2 + 32);
+    EXPECT_GE(p.elapsedUs, p.requests * 3000);
+    EXPECT_LT(p.elapsedUs, p.requests * 30000 / 2);
+}
@@ -0,0 +1,173 @@
+// tests/cpp/test_dmx_input.cpp
+// Unit tests for DmxUniverseBuffer — publish / snapshot / change bitmap /
+// refresh statistics.  No hardware is opened.
+#include <gtest/gtest.h>
+#include "dmx_input.h"
+#include <cstdint>
+#include <vector>
+
+static std::vector<uint8_t> MakeFrame(int slots, uint8_t level) {
+    std::vector<uint8_t> f(1 + slots, level);
+    f[0] = 0x00; // start code
+    return f;
+}
+
+static bool BitSet(const uint8_t* bits, int slot) {
+    return (bits[(slot - 1) >> 3] >> ((slot - 1) & 7)) & 1;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Snapshot
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(DmxUniverseBuffer, EmptyBeforeFirstFrame) {
+    DmxUniverseBuffer buf;
+    uint8_t slots[DMX_MAX_FRAME];
+    uint64_t num = 99;
+    EXPECT_EQ(buf.Snapshot(slots, sizeof(slots), nullptr, 0, &num), 0);
+    EXPECT_EQ(num, 0u);
+}
+
+TEST(DmxUniverseBuffer, SnapshotReturnsLatestFrame) {
+    DmxUniverseBuffer buf;
+    auto a = MakeFrame(512, 10);
+    auto b = MakeFrame(512, 20);
+    buf.Publish(a.data(), (int)a.size(), 0, 0);
+    buf.Publish(b.data(), (int)b.size(), 22727, 0);
+
+    uint8_t slots[DMX_MAX_FRAME] = {};
+    uint64_t num = 0;
+    EXPECT_EQ(buf.Snapshot(slots, sizeof(slots), nullptr, 0, &num), 513);
+    EXPECT_EQ(num, 2u);
+    EXPECT_EQ(slots[0], 0x00);
+    EXPECT_EQ(slots[1], 20);
+    EXPECT_EQ(slots[512], 20);
+}
+
+TEST(DmxUniverseBuffer, SnapshotTruncatesToMaxLen) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 7);
+    buf.Publish(f.data(), (int)f.size(), 0, 0);
+    uint8_t slots[16] = {};
+    EXPECT_EQ(buf.Snapshot(slots, sizeof(slots), nullptr, 0, nullptr), 16);
+    EXPECT_EQ(slots[15], 7);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Change bitmap
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(DmxUniverseBuffer, FirstFrameMarksAllSlotsChanged) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(24, 0);
+    buf.Publish(f.data(), (int)f.size(), 0, 0);
+    uint8_t bits[DMX_CHANGE_BYTES];
+    buf.Snapshot(nullptr, 0, bits, 0, nullptr);
+    EXPECT_TRUE(BitSet(bits, 1));
+    EXPECT_TRUE(BitSet(bits, 24));
+    EXPECT_FALSE(BitSet(bits, 25));
+}
+
+TEST(DmxUniverseBuffer, OnlyChangedSlotsReported) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 0);
+    buf.Publish(f.data(), (int)f.size(), 0, 0);
+    f[5] = 255;
+    f[300] = 1;
+    buf.Publish(f.data(), (int)f.size(), 1000, 0);
+
+    uint8_t bits[DMX_CHANGE_BYTES];
+    uint64_t num = 1;
+    buf.Snapshot(nullptr, 0, bits, 1, &num);
+    EXPECT_EQ(num, 2u);
+    EXPECT_TRUE(BitSet(bits, 5));
+    EXPECT_TRUE(BitSet(bits, 300));
+    EXPECT_FALSE(BitSet(bits, 4));
+    EXPECT_FALSE(BitSet(bits, 6));
+}
+
+TEST(DmxUniverseBuffer, SlowReaderSeesChangesFromSkippedFrames) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 0);
+    buf.Publish(f.data(), (int)f.size(), 0, 0);      // frame 1
+    f[10] = 1;
+    buf.Publish(f.data(), (int)f.size(), 1000, 0);   // frame 2
+    f[20] = 1;
+    buf.Publish(f.data(), (int)f.size(), 2000, 0);   // frame 3
+    buf.Publish(f.data(), (int)f.size(), 3000, 0);   // frame 4 (no change)
+
+    uint8_t bits[DMX_CHANGE_BYTES];
+    buf.Snapshot(nullptr, 0, bits, 1, nullptr);
+    EXPECT_TRUE(BitSet(bits, 10));
+    EXPECT_TRUE(BitSet(bits, 20));
+
+    buf.Snapshot(nullptr, 0, bits, 3, nullptr);
+    EXPECT_FALSE(BitSet(bits, 10));
+    EXPECT_FALSE(BitSet(bits, 20));
+}
+
+TEST(DmxUniverseBuffer, ShorterFrameMarksDroppedSlots) {
+    DmxUniverseBuffer buf;
+    auto a = MakeFrame(100, 5);
+    auto b = MakeFrame(50, 5);
+    buf.Publish(a.data(), (int)a.size(), 0, 0);
+    buf.Publish(b.data(), (int)b.size(), 1000, 0);
+    uint8_t bits[DMX_CHANGE_BYTES];
+    buf.Snapshot(nullptr, 0, bits, 1, nullptr);
+    EXPECT_FALSE(BitSet(bits, 50));
+    EXPECT_TRUE(BitSet(bits, 51));
+    EXPECT_TRUE(BitSet(bits, 100));
+    EXPECT_EQ(buf.GetStats().slotCount, 50);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Statistics
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(DmxUniverseBuffer, SteadyRefreshRateHasNoJitter) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 0);
+    for (int i = 0; i < 10; ++i)
+        buf.Publish(f.data(), (int)f.size(), i * 25000LL, 0); // 40 Hz
+    auto st = buf.GetStats();
+    EXPECT_EQ(st.frames, 10u);
+    EXPECT_EQ(st.slotCount, 512);
+    EXPECT_NEAR(st.refreshHz, 40.0, 1e-6);
+    EXPECT_NEAR(st.intervalUs, 25000.0, 1e-6);
+    EXPECT_NEAR(st.jitterUs, 0.0, 1e-6);
+}
+
+TEST(DmxUniverseBuffer, JitterIsIntervalStdDev) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 0);
+    // Intervals alternate 20 ms / 30 ms: mean 25 ms, std dev 5 ms
+    int64_t t = 0;
+    buf.Publish(f.data(), (int)f.size(), t, 0);
+    for (int i = 0; i < 8; ++i) {
+        t += (i & 1) ? 30000 : 20000;
+        buf.Publish(f.data(), (int)f.size(), t, 0);
+    }
+    auto st = buf.GetStats();
+    EXPECT_NEAR(st.intervalUs, 25000.0, 1e-6);
+    EXPECT_NEAR(st.jitterUs, 5000.0, 1e-6);
+    EXPECT_NEAR(st.minIntervalUs, 20000.0, 1e-6);
+    EXPECT_NEAR(st.maxIntervalUs, 30000.0, 1e-6);
+}
+
+TEST(DmxUniverseBuffer, ErrorFramesCounted) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 0);
+    buf.Publish(f.data(), (int)f.size(), 0, 0x00);
+    buf.Publish(f.data(), (int)f.size(), 1000, 0x01);
+    buf.Publish(f.data(), (int)f.size(), 2000, 0x02);
+    EXPECT_EQ(buf.GetStats().errorFrames, 2u);
+}
+
+TEST(DmxUniverseBuffer, ResetClearsHistory) {
+    DmxUniverseBuffer buf;
+    auto f = MakeFrame(512, 9);
+    buf.Publish(f.data(), (int)f.size(), 0, 0);
+    buf.Reset();
+    EXPECT_EQ(buf.GetStats().frames, 0u);
+    EXPECT_EQ(buf.Snapshot(nullptr, 0, nullptr, 0, nullptr), 0);
+}
@@ -0,0 +1,354 @@
+// tests/cpp/test_fault_injector.cpp
+// Unit tests for FaultInjector: pass-through, each fault kind, seeded
+// reproducibility, damaged replies refused by the command layer and
+// discovery through the wrapper.  The wrapped driver
+// is an in-process loopback bus; no hardware is opened.
+#include <gtest/gtest.h>
+#include "fault_injector.h"
+#include "rdm.h"
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+static const uint64_t kController = 0x454E00000001ULL;
+
+// Answers GET with an ACK echoing the PID, DISC_UNIQUE_BRANCH with the
+// (wire-ORed) replies of every unmuted responder in range, DISC_MUTE with
+// an ACK.  Same members as the Peperoni: the reply is ready once SendRDM
+// returns and there is no WaitForData.
+struct LoopbackBus {
+    std::vector<uint64_t> uids;
+    std::set<uint64_t> muted;
+    std::vector<uint8_t> rx;
+    uint8_t transNum = 0;
+    int sends = 0;
+    int mutesToDrop = 0; // DISC_MUTE heard, its ACK lost on the line
+    int phantoms = 0;    // DUB replies decoding to a UID outside the branch
+
+    bool IsOpen() const { return true; }
+    std::string GetFirmwareString() const { return "Loopback"; }
+    uint32_t GetSerialNumber() const { return 42; }
+    bool SendDMX(const uint8_t *, int) { return true; }
+    uint8_t NextTransNum() { return transNum++; }
+    int MetricsPort() const { return 0; }
+    void Purge() { rx.clear(); }
+
+    static uint64_t Uid(const uint8_t *p) {
+        uint64_t v = 0;
+        for (int i = 0; i < 6; ++i)
+            v = (v << 8) | p[i];
+        return v;
+    }
+
+    bool SendRDM(const uint8_t *d, int) {
+        ++sends;
+        rx.clear();
+        uint64_t dest = Uid(d + 3);
+        uint16_t pid = static_cast<uint16_t>((d[21] << 8) | d[22]);
+        if (pid == PID_DISC_UN_MUTE) {
+            if (dest == RDM_BROADCAST_UID)
+                muted.clear();
+            else
+                muted.erase(dest);
+            return true;
+        }
+        if (std::find(uids.begin(), uids.end(), dest) == uids.end())
+            return true;
+        if (pid == PID_DISC_MUTE) {
+            muted.insert(dest);
+            if (mutesToDrop > 0) {
+                --mutesToDrop;
+                return true;
+            }
+        }
+        uint8_t cc = d[20] + 1;
+        uint8_t pd[2] = {d[21], d[22]};
+        rx = BuildRDMPacket(Uid(d + 9), dest, d[15], 0, 0, 0, cc, pid, pd, 2);
+        return true;
+    }
+
+    static std::vector<uint8_t> DubReply(uint64_t uid) {
+        std::vector<uint8_t> reply(7, 0xFE);
+        reply.push_back(0xAA);
+        uint16_t sum = 0;
+        for (int i = 5; i >= 0; --i) {
+            uint8_t b = static_cast<uint8_t>(uid >> (i * 8));
+            reply.push_back(b | 0xAA);
+            reply.push_back(b | 0x55);
+            sum += (b | 0xAA) + (b | 0x55);
+        }
+        for (uint8_t b : {uint8_t(sum >> 8), uint8_t(sum & 0xFF)}) {
+            reply.push_back(b | 0xAA);
+            reply.push_back(b | 0x55);
+        }
+        return reply;
+    }
+
+    bool SendRDMDiscovery(const uint8_t *d, int) {
+        ++sends;
+        rx.clear();
+        uint64_t lo = Uid(d + 24), hi = Uid(d + 30);
+        if (phantoms > 0 && hi < RDM_BROADCAST_UID) {
+            --phantoms;
+            rx = DubReply(hi + 1);
+            return true;
+        }
+        for (uint64_t uid : uids) {
+            if (uid < lo || uid > hi || muted.count(uid))
+                continue;
+            std::vector<uint8_t> reply = DubReply(uid);
+            if (rx.empty()) {
+                rx = reply;
+            } else {
+                // Two talkers: the line carries the AND of both (dominant
+                // low); one short frame is enough to force a split
+                for (size_t i = 0; i < rx.size(); ++i)
+                    rx[i] &= reply[i];
+                rx.resize(10);
+            }
+        }
+        return true;
+    }
+
+    int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &status) {
+        status = 0;
+        int n = std::min<int>(maxLen, static_cast<int>(rx.size()));
+        if (n > 0)
+            memcpy(out, rx.data(), n);
+        rx.clear();
+        return n;
+    }
+};
+
+static const uint64_t kFix = 0x4C4500000010ULL;
+
+static std::vector<uint8_t> GetOnce(FaultInjector &fi, uint16_t pid = 0x0060) {
+    auto pkt = BuildRDMPacket(kFix, kController, fi.NextTransNum(), 1, 0, 0,
+                              RDM_CC_GET, pid);
+    fi.SendRDM(pkt.data(), static_cast<int>(pkt.size()));
+    uint8_t buf[512];
+    uint8_t st;
+    int n = fi.ReceiveRDM(buf, sizeof(buf), st);
+    return std::vector<uint8_t>(buf, buf + std::max(n, 0));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Faults
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FaultInjector, PassesThroughWithoutFaults) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    EXPECT_TRUE(fi.IsOpen());
+    EXPECT_EQ(fi.GetSerialNumber(), 42u);
+
+    RDMResponse r = RDMGetCommand(fi, kController, kFix, PID_DEVICE_INFO);
+    EXPECT_EQ(r.type, RDMResponseType::ACK);
+    FaultCounters c = fi.Counters();
+    EXPECT_EQ(c.exchanges, 1u);
+    EXPECT_EQ(c.responses, 1u);
+    EXPECT_EQ(c.dropped + c.bitFlips + c.truncated + c.collisions, 0u);
+}
+
+TEST(FaultInjector, DropTurnsResponsesIntoTimeouts) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    FaultProfile p;
+    p.drop = 1.0;
+    fi.SetProfile(p);
+    RDMResponse r = RDMGetCommand(fi, kController, kFix, PID_DEVICE_INFO);
+    EXPECT_EQ(r.type, RDMResponseType::TIMEOUT);
+    EXPECT_EQ(fi.Counters().dropped, 1u);
+}
+
+TEST(FaultInjector, BitFlipChangesExactlyOneBit) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    auto clean = GetOnce(fi);
+    FaultProfile p;
+    p.bitFlip = 1.0;
+    fi.SetProfile(p);
+    bus.transNum = 0; // same request, same reply
+    auto flipped = GetOnce(fi);
+    ASSERT_EQ(flipped.size(), clean.size());
+    int bits = 0;
+    for (size_t i = 0; i < clean.size(); ++i) {
+        uint8_t x = clean[i] ^ flipped[i];
+        for (; x; x &= x - 1)
+            ++bits;
+    }
+    EXPECT_EQ(bits, 1);
+}
+
+TEST(FaultInjector, TruncateShortens) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    FaultProfile p;
+    p.truncate = 1.0;
+    fi.SetProfile(p);
+    for (int i = 0; i < 20; ++i) {
+        auto r = GetOnce(fi);
+        EXPECT_GE(r.size(), 1u);
+        EXPECT_LT(r.size(), 28u);
+    }
+    EXPECT_EQ(fi.Counters().truncated, 20u);
+}
+
+TEST(FaultInjector, StaleResponseIsReadFirst) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    auto first = GetOnce(fi, 0x0060);
+    FaultProfile p;
+    p.stale = 1.0;
+    fi.SetProfile(p); // resets the stale source too
+    GetOnce(fi, 0x0060);
+    auto second = GetOnce(fi, 0x00F0); // previous reply arrives first
+    ASSERT_GE(second.size(), 24u);
+    EXPECT_EQ(second[22], 0x60);
+    // The real reply is still buffered; Purge() clears it
+    uint8_t buf[64], st;
+    fi.Purge();
+    EXPECT_EQ(fi.ReceiveRDM(buf, sizeof(buf), st), 0);
+}
+
+TEST(FaultInjector, LateResponseLandsInTheNextExchange) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    FaultProfile p;
+    p.latencyUs = 200;
+    p.lateAfterUs = 100;
+    fi.SetProfile(p);
+    EXPECT_TRUE(GetOnce(fi, 0x0060).empty());
+    auto next = GetOnce(fi, 0x00F0); // sees the late 0x0060 reply
+    ASSERT_GE(next.size(), 24u);
+    EXPECT_EQ(next[22], 0x60);
+    EXPECT_EQ(fi.Counters().late, 2u);
+
+    // With a purge in between the leftover is gone
+    fi.Purge();
+    EXPECT_TRUE(GetOnce(fi, 0x00F0).empty());
+}
+
+TEST(FaultInjector, SameSeedSameFaults) {
+    auto run = [](uint32_t seed) {
+        LoopbackBus bus;
+        bus.uids = {kFix};
+        FaultInjector fi;
+        fi.Attach(bus);
+        FaultProfile p;
+        p.drop = 0.1;
+        p.bitFlip = 0.2;
+        p.truncate = 0.1;
+        p.collision = 0.1;
+        p.seed = seed;
+        fi.SetProfile(p);
+        std::vector<std::vector<uint8_t>> out;
+        for (int i = 0; i < 200; ++i)
+            out.push_back(GetOnce(fi));
+        return out;
+    };
+    EXPECT_EQ(run(7), run(7));
+    EXPECT_NE(run(7), run(8));
+}
+
+TEST(FaultInjector, CommandsRejectDamagedAndStrayReplies) {
+    LoopbackBus bus;
+    bus.uids = {kFix};
+    FaultInjector fi;
+    fi.Attach(bus);
+    FaultProfile p;
+    p.bitFlip = 1.0;
+    fi.SetProfile(p);
+    for (int i = 0; i < 50; ++i) {
+        RDMResponse r = RDMGetCommand(fi, kController, kFix, PID_DEVICE_INFO);
+        EXPECT_EQ(r.type, RDMResponseType::INVALID) << i;
+    }
+
+    // The reply to the previous request: another transaction and PID
+    p = FaultProfile();
+    p.stale = 1.0;
+    fi.SetProfile(p);
+    RDMGetCommand(fi, kController, kFix, PID_DEVICE_INFO);
+    RDMResponse r =
+        RDMGetCommand(fi, kController, kFix, PID_DMX_START_ADDRESS);
+    EXPECT_EQ(r.type, RDMResponseType::INVALID);
+    EXPECT_EQ(fi.Counters().stale, 1u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Discovery through the wrapper
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(FaultInjector, DiscoveryWithoutFaultsFindsEveryone) {
+    LoopbackBus bus;
+    bus.uids = {0x100000000001ULL, 0x800000000002ULL, 0xC00000000003ULL};
+    FaultInjector fi;
+    fi.Attach(bus);
+    auto found = RDMDiscovery(fi, kController);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, bus.uids);
+}
+
+TEST(FaultInjector, DiscoveryRetriesALostMuteReply) {
+    LoopbackBus bus;
+    bus.uids = {0x100000000001ULL, 0x800000000002ULL, 0xC00000000003ULL};
+    bus.mutesToDrop = 1;
+    FaultInjector fi;
+    fi.Attach(bus);
+    auto found = RDMDiscovery(fi, kController);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, bus.uids);
+    EXPECT_EQ(bus.mutesToDrop, 0);
+}
+
+TEST(FaultInjector, DiscoveryFindsFixturesWhoseMuteAcksAreAllLost) {
+    // Every mute is heard but no ACK ever comes back
+    LoopbackBus one;
+    one.uids = {0x434B00000001ULL};
+    one.mutesToDrop = 1000;
+    FaultInjector fi;
+    fi.Attach(one);
+    EXPECT_EQ(RDMDiscovery(fi, kController), one.uids);
+
+    LoopbackBus bus;
+    bus.uids = {0x100000000001ULL, 0x100000000002ULL, 0xC00000000003ULL};
+    bus.mutesToDrop = 1000;
+    fi.Attach(bus);
+    auto found = RDMDiscovery(fi, kController);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, bus.uids);
+}
+
+TEST(FaultInjector, DiscoveryIgnoresUIDsOutsideTheBranch) {
+    LoopbackBus bus;
+    bus.uids = {0x100000000001ULL, 0x800000000002ULL};
+    bus.phantoms = 4;
+    FaultInjector fi;
+    fi.Attach(bus);
+    auto found = RDMDiscovery(fi, kController);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, bus.uids);
+    EXPECT_EQ(bus.phantoms, 0);
+}
+
+TEST(FaultInjector, DetachedInjectorIsClosed) {
+    FaultInjector fi;
+    EXPECT_FALSE(fi.IsOpen());
+    uint8_t pkt[26] = {RDM_START_CODE};
+    EXPECT_FALSE(fi.SendRDM(pkt, sizeof(pkt)));
+    uint8_t st;
+    EXPECT_EQ(fi.ReceiveRDM(pkt, sizeof(pkt), st), -1);
+}
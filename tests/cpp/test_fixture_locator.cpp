@@ -0,0 +1,184 @@
+// tests/cpp/test_fixture_locator.cpp
+// Unit tests for FixtureLocator: single and multi-target binary search
+// with a simulated operator, identify step planning, and identify steps
+// sent to ResponderSim, including their cost in bus time.
+#include <gtest/gtest.h>
+#include "fixture_locator.h"
+#include "rdm_timing.h"
+#include "responder_sim.h"
+#include <algorithm>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static std::vector<uint64_t> UIDs(int n) {
+    std::vector<uint64_t> uids;
+    for (int i = 0; i < n; ++i)
+        uids.push_back(0x434B00000000ULL + i);
+    return uids;
+}
+
+// The operator: looks at `targets` and says whether each one is lit
+static std::vector<bool> Look(const FixtureLocator &loc,
+                              const std::vector<uint64_t> &targets) {
+    std::vector<bool> lit;
+    for (uint64_t uid : targets) {
+        const auto &on = loc.Lit();
+        lit.push_back(std::find(on.begin(), on.end(), uid) != on.end());
+    }
+    return lit;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Search
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(FixtureLocator, FindsOneOf512InNineAnswers) {
+    std::vector<uint64_t> uids = UIDs(512);
+    for (uint64_t target : {uids[0], uids[77], uids[511]}) {
+        FixtureLocator loc;
+        loc.Start(uids);
+        EXPECT_EQ(loc.StepsLeft(), 9);
+        EXPECT_EQ(loc.Lit().size(), 256u);
+        while (!loc.Done())
+            ASSERT_TRUE(loc.Answer(Look(loc, {target})[0]));
+        EXPECT_EQ(loc.Steps(), 9);
+        ASSERT_EQ(loc.Candidates(0).size(), 1u);
+        EXPECT_EQ(loc.Candidates(0)[0], target);
+        EXPECT_EQ(loc.Lit(), (std::vector<uint64_t>{target}));
+        EXPECT_FALSE(loc.Answer(true)); // nothing left to ask
+    }
+}
+
+TEST(FixtureLocator, OddSetsTakeTheLargerHalfAtMost) {
+    FixtureLocator loc;
+    loc.Start(UIDs(100));
+    EXPECT_EQ(loc.StepsLeft(), 7);
+    EXPECT_EQ(loc.Lit().size(), 50u);
+    loc.Start(UIDs(3));
+    EXPECT_EQ(loc.Lit().size(), 2u);
+    loc.Answer(false);
+    EXPECT_TRUE(loc.Done());
+    EXPECT_EQ(loc.Steps(), 1);
+}
+
+TEST(FixtureLocator, LocatesSeveralTargetsInTheSameSteps) {
+    std::vector<uint64_t> uids = UIDs(200);
+    std::vector<uint64_t> targets = {uids[3], uids[4], uids[150], uids[199]};
+    FixtureLocator loc;
+    loc.Start(uids, static_cast<int>(targets.size()));
+    int expected = loc.StepsLeft();
+    EXPECT_EQ(expected, 8);
+    while (!loc.Done())
+        ASSERT_TRUE(loc.Answer(Look(loc, targets)));
+    EXPECT_EQ(loc.Steps(), expected);
+    for (int t = 0; t < loc.Targets(); ++t) {
+        ASSERT_EQ(loc.Candidates(t).size(), 1u);
+        EXPECT_EQ(loc.Candidates(t)[0], targets[t]);
+    }
+    EXPECT_EQ(loc.Lit().size(), 4u);
+}
+
+TEST(FixtureLocator, RejectsAWrongAnswerCount) {
+    FixtureLocator loc;
+    EXPECT_FALSE(loc.Answer(true)); // not started
+    loc.Start(UIDs(8), 2);
+    EXPECT_FALSE(loc.Answer(true));
+    EXPECT_TRUE(loc.Answer({true, false}));
+    loc.Stop();
+    EXPECT_FALSE(loc.Active());
+    EXPECT_TRUE(loc.Lit().empty());
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Identify steps
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(FixtureLocator, SendsOnlyTheChanges) {
+    IdentifyStep step = PlanIdentifyStep({1, 2, 3, 4}, {3, 4, 5});
+    EXPECT_FALSE(step.allOff);
+    EXPECT_EQ(step.off, (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(step.on, (std::vector<uint64_t>{5}));
+    EXPECT_EQ(step.Transactions(), 3);
+
+    EXPECT_EQ(PlanIdentifyStep({1, 2}, {1, 2}).Transactions(), 0);
+}
+
+TEST(FixtureLocator, BroadcastsOffWhenMostGoDark) {
+    std::vector<uint64_t> uids = UIDs(256);
+    std::vector<uint64_t> next(uids.begin(), uids.begin() + 64);
+    IdentifyStep step = PlanIdentifyStep(uids, next);
+    EXPECT_TRUE(step.allOff);
+    EXPECT_TRUE(step.off.empty());
+    EXPECT_EQ(step.on, next);
+    EXPECT_EQ(step.Transactions(), 65); // against 192 single SETs
+}
+
+static std::shared_ptr<const SimModel> IdentifyModel() {
+    RDMParameterRow get, set;
+    get.pid = set.pid = PID_IDENTIFY_DEVICE;
+    get.commandClass = RDM_CC_GET;
+    set.commandClass = RDM_CC_SET;
+    get.payloadLength = set.payloadLength = "1 byte";
+    get.fwDefault = "0x00";
+    set.minValue = "0x00";
+    set.maxValue = "0x01";
+    return BuildSimModel({get, set}, {});
+}
+
+TEST(FixtureLocator, IdentifiesOnASimulatedLine) {
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(16, 0x434B);
+    std::sort(uids.begin(), uids.end()); // lit halves stay contiguous
+    ASSERT_TRUE(sim.Open(IdentifyModel(), uids));
+    auto identifying = [&] {
+        std::vector<uint64_t> on;
+        for (uint64_t uid : uids) {
+            std::vector<uint8_t> v;
+            if (sim.GetValue(uid, PID_IDENTIFY_DEVICE, v) && !v.empty() &&
+                v[0])
+                on.push_back(uid);
+        }
+        std::sort(on.begin(), on.end());
+        return on;
+    };
+
+    FixtureLocator loc;
+    loc.Start(uids);
+    std::vector<uint64_t> lit;
+    EXPECT_TRUE(SendIdentifyStep(sim, kController,
+                                 PlanIdentifyStep(lit, loc.Lit()))
+                    .empty());
+    EXPECT_EQ(identifying(), loc.Lit());
+    EXPECT_EQ(sim.Counters().requests, 8u);
+
+    uint64_t target = loc.Lit()[0];
+    while (!loc.Done()) {
+        lit = loc.Lit();
+        loc.Answer(Look(loc, {target})[0]);
+        SendIdentifyStep(sim, kController, PlanIdentifyStep(lit, loc.Lit()));
+        EXPECT_EQ(identifying(), loc.Lit());
+    }
+    EXPECT_EQ(identifying(), (std::vector<uint64_t>{target}));
+    // 8 on, then 4 off, 2 off, 1 off: only the changes
+    EXPECT_EQ(sim.Counters().requests, 8u + 4u + 2u + 1u);
+}
+
+TEST(FixtureLocator, StepRunsAtBusSpeed) {
+    SimOptions opts;
+    opts.turnaroundUs = 3000;
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(128, 0x434B);
+    ASSERT_TRUE(sim.Open(IdentifyModel(), uids, opts));
+    FixtureLocator loc;
+    loc.Start(uids);
+    IdentifyStep step = PlanIdentifyStep({}, loc.Lit());
+    ASSERT_EQ(step.Transactions(), 64);
+
+    // One exchange per SET, not a fixed sleep
+    int64_t start = RdmNowUs();
+    EXPECT_TRUE(SendIdentifyStep(sim, kController, step).empty());
+    int64_t elapsedUs = RdmNowUs() - start;
+    EXPECT_GE(elapsedUs, 64 * 3000);
+    EXPECT_LT(elapsedUs, 64 * 30000 / 2);
+}
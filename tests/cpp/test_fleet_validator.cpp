@@ -0,0 +1,361 @@
+// tests/cpp/test_fleet_validator.cpp
+// Unit tests for FleetValidator: every fixture swept exactly once, ports
+// running in parallel, work stealing limited to fixtures a port reaches,
+// cancellation, streamed rows and fail-fast, the shared result store, and
+// a run over simulated responders on two buses.
+#include <gtest/gtest.h>
+#include "fleet_validator.h"
+#include "responder_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static std::vector<uint64_t> UIDs(uint64_t first, int count) {
+    std::vector<uint64_t> uids;
+    for (int i = 0; i < count; ++i)
+        uids.push_back(first + i);
+    return uids;
+}
+
+// A sweep that holds its bus for `ms` and reports one GREEN and one RED row
+static FleetValidator::Sweep SleepSweep(int ms) {
+    return [ms](uint64_t, const ValidationOptions &, FleetFixtureResult &r) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        r.results.resize(2);
+        r.results[0].status = ValidationStatus::GREEN;
+        r.results[1].status = ValidationStatus::RED;
+    };
+}
+
+struct Collector {
+    std::mutex mutex;
+    std::vector<FleetFixtureResult> results;
+
+    FleetValidator::ResultFn Fn() {
+        return [this](FleetFixtureResult &&r) {
+            std::lock_guard<std::mutex> lk(mutex);
+            results.push_back(std::move(r));
+        };
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════
+// Scheduling
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(FleetValidator, DeliversEveryFixtureOnce) {
+    FleetValidator fleet;
+    EXPECT_EQ(fleet.AddPort(SleepSweep(1), UIDs(0x100, 10)), 0);
+    EXPECT_EQ(fleet.AddPort(SleepSweep(1), UIDs(0x200, 7)), 1);
+    EXPECT_EQ(fleet.AddPort(SleepSweep(1), UIDs(0x300, 3)), 2);
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 20u);
+    std::map<uint64_t, int> seen;
+    for (const auto &r : c.results) {
+        ++seen[r.uid];
+        EXPECT_EQ(static_cast<int>(r.uid >> 8) - 1, r.port);
+        EXPECT_EQ(r.green, 1);
+        EXPECT_EQ(r.red, 1);
+        EXPECT_EQ(r.results.size(), 2u);
+        EXPECT_GE(r.endUs, r.startUs);
+    }
+    for (const auto &kv : seen)
+        EXPECT_EQ(kv.second, 1);
+
+    FleetProgress pr = fleet.Progress();
+    EXPECT_FALSE(pr.running);
+    EXPECT_EQ(pr.fixtures, 20);
+    EXPECT_EQ(pr.completed, 20);
+    EXPECT_EQ(pr.perPort, (std::vector<int>{10, 7, 3}));
+}
+
+TEST(FleetValidator, PortsRunInParallel) {
+    FleetValidator fleet;
+    for (int p = 0; p < 4; ++p)
+        fleet.AddPort(SleepSweep(20), UIDs(0x1000 * (p + 1), 5));
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+    EXPECT_EQ(c.results.size(), 20u);
+    // 20 sweeps of 20 ms take 400 ms on one bus, about 100 ms on four
+    EXPECT_LT(fleet.Progress().elapsedUs, 300000);
+}
+
+TEST(FleetValidator, SharedFixturesAreSplitAndStolen) {
+    FleetValidator fleet;
+    std::vector<uint64_t> shared = UIDs(0x500, 12);
+    fleet.AddPort(SleepSweep(1), shared);  // fast bus
+    fleet.AddPort(SleepSweep(25), shared); // slow bus, same fixtures
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 12u);
+    FleetProgress pr = fleet.Progress();
+    // Queued 6 / 6; the fast port takes over most of the slow one's queue
+    EXPECT_GT(pr.stolen, 0);
+    EXPECT_GT(pr.perPort[0], 6);
+    for (const auto &r : c.results)
+        EXPECT_TRUE(!r.stolen || r.port == 0);
+}
+
+TEST(FleetValidator, NeverStealsUnreachableFixtures) {
+    FleetValidator fleet;
+    fleet.AddPort(SleepSweep(1), UIDs(0x100, 1));
+    fleet.AddPort(SleepSweep(5), UIDs(0x200, 6));
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    FleetProgress pr = fleet.Progress();
+    EXPECT_EQ(pr.completed, 7);
+    EXPECT_EQ(pr.stolen, 0);
+    EXPECT_EQ(pr.perPort, (std::vector<int>{1, 6}));
+}
+
+TEST(FleetValidator, CancelStopsHandingOutFixtures) {
+    FleetValidator fleet;
+    fleet.AddPort(SleepSweep(10), UIDs(0x100, 50));
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(35));
+    fleet.Stop();
+
+    EXPECT_FALSE(fleet.IsRunning());
+    FleetProgress pr = fleet.Progress();
+    EXPECT_GT(pr.completed, 0);
+    EXPECT_LT(pr.completed, 50);
+    EXPECT_EQ(static_cast<int>(c.results.size()), pr.completed);
+}
+
+TEST(FleetValidator, RefusesEmptyFleetAndPortsWhileRunning) {
+    FleetValidator fleet;
+    EXPECT_FALSE(fleet.Start(nullptr));
+    fleet.AddPort(SleepSweep(20), UIDs(0x100, 3));
+    ASSERT_TRUE(fleet.Start(nullptr));
+    EXPECT_TRUE(fleet.IsRunning());
+    EXPECT_FALSE(fleet.Start(nullptr));
+    EXPECT_EQ(fleet.AddPort(SleepSweep(1), UIDs(0x200, 1)), -1);
+    fleet.Wait();
+    EXPECT_EQ(fleet.Progress().completed, 3);
+
+    // A finished run can be started again
+    ASSERT_TRUE(fleet.Start(nullptr));
+    fleet.Wait();
+    EXPECT_EQ(fleet.Progress().completed, 3);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Streaming
+// ═══════════════════════════════════════════════════════════════════════
+
+// Publishes GREEN, RED, GREEN rows `ms` apart, honouring fail-fast
+// Three rows, the one at `red` RED
+static FleetValidator::Sweep StreamingSweep(int ms, size_t red = 1) {
+    return [ms, red](uint64_t, const ValidationOptions &opts,
+                     FleetFixtureResult &r) {
+        static const RDMParameter param = {0x8600, "Hue", "", true, ""};
+        for (size_t i = 0; i < 3; ++i) {
+            if (i)
+                std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            ValidationSample sample;
+            sample.param = i;
+            sample.parameter = &param;
+            sample.status = i == red ? ValidationStatus::RED
+                                     : ValidationStatus::GREEN;
+            if (opts.keepResults)
+                r.results.push_back(SampleResult(sample));
+            if (opts.samples && !opts.samples(sample))
+                break;
+            if (opts.failFast && i == red) {
+                r.aborted = i < 2;
+                break;
+            }
+        }
+    };
+}
+
+TEST(FleetValidator, StreamsRowsBeforeTheFixtureCompletes) {
+    FleetValidator fleet;
+    fleet.AddPort(StreamingSweep(20), UIDs(0x100, 2));
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, size_t>> rows;
+    Collector c;
+    ASSERT_TRUE(fleet.Start(
+        c.Fn(), [&](const FleetFixtureResult &f, const ResultStore &store,
+                    size_t row) {
+            std::lock_guard<std::mutex> lk(mutex);
+            rows.emplace_back(f.uid, store.Index(row));
+        }));
+    fleet.Wait();
+
+    ASSERT_EQ(rows.size(), 6u);
+    EXPECT_EQ(rows[0], std::make_pair(uint64_t(0x100), size_t(0)));
+    ASSERT_EQ(c.results.size(), 2u);
+    for (const auto &r : c.results) {
+        EXPECT_FALSE(r.aborted);
+        EXPECT_EQ(r.results.size(), 3u);
+        // At least one 20 ms gap follows the first row
+        EXPECT_LE(r.firstResultUs + 20000, r.endUs - r.startUs);
+        EXPECT_GE(r.endUs - r.startUs, 40000);
+    }
+}
+
+TEST(FleetValidator, FailFastAbortsOnTheFirstRed) {
+    FleetValidator fleet;
+    fleet.AddPort(StreamingSweep(20), UIDs(0x100, 2));
+    fleet.SetFailFast(true);
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 2u);
+    for (const auto &r : c.results) {
+        EXPECT_TRUE(r.aborted);
+        EXPECT_EQ(r.results.size(), 2u);
+        EXPECT_EQ(r.red, 1); // the last row was never swept
+    }
+}
+
+TEST(FleetValidator, FailFastOnTheLastRowIsNotAnAbort) {
+    FleetValidator fleet;
+    fleet.AddPort(StreamingSweep(1, 2), UIDs(0x100, 2));
+    fleet.SetFailFast(true);
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 2u);
+    for (const auto &r : c.results) {
+        EXPECT_FALSE(r.aborted);
+        EXPECT_EQ(r.results.size(), 3u);
+        EXPECT_EQ(r.red, 1);
+    }
+}
+
+TEST(FleetValidator, StoresRowsInOneColumnarStore) {
+    FleetValidator fleet;
+    fleet.AddPort(StreamingSweep(1), UIDs(0x100, 3));
+    fleet.AddPort(StreamingSweep(1), UIDs(0x200, 3));
+    fleet.SetStoreResults(true);
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 6u);
+    fleet.ReadResults([&](const ResultStore &rows) {
+        EXPECT_EQ(rows.Size(), 18u);
+        EXPECT_EQ(rows.NameCount(), 1u);
+        for (const auto &r : c.results) {
+            EXPECT_TRUE(r.results.empty());
+            EXPECT_EQ(r.rowCount, 3u);
+            EXPECT_EQ(r.green, 2);
+            EXPECT_EQ(r.red, 1);
+            for (size_t i = 0; i < r.rowCount; ++i) {
+                EXPECT_EQ(rows.Uid(r.firstRow + i), r.uid);
+                EXPECT_EQ(rows.Index(r.firstRow + i), i);
+            }
+        }
+    });
+
+    // The next run starts from an empty store
+    fleet.SetStoreResults(false);
+    ASSERT_TRUE(fleet.Start(nullptr));
+    fleet.Wait();
+    fleet.ReadResults(
+        [](const ResultStore &rows) { EXPECT_TRUE(rows.Empty()); });
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated buses
+// ═══════════════════════════════════════════════════════════════════════
+
+static std::shared_ptr<const SimModel> SmallModel() {
+    RDMParameterRow info;
+    info.pid = 0x0060;
+    info.commandClass = 0x20;
+    info.payloadLength = "19 bytes";
+    RDMParameterRow addr;
+    addr.pid = 0x00F0;
+    addr.commandClass = 0x20;
+    addr.payloadLength = "2 byte";
+    addr.fwDefault = "0x0001";
+    return BuildSimModel({info, addr}, {});
+}
+
+TEST(FleetValidator, ValidatesSimulatedFixturesOnEveryPort) {
+    auto model = SmallModel();
+    ResponderSim bus0, bus1;
+    std::vector<uint64_t> uids = MakeSimUIDs(6, 0x434B);
+    std::vector<uint64_t> half0(uids.begin(), uids.begin() + 3);
+    std::vector<uint64_t> half1(uids.begin() + 3, uids.end());
+    ASSERT_TRUE(bus0.Open(model, half0));
+    ASSERT_TRUE(bus1.Open(model, half1));
+
+    std::vector<RDMParameter> params(3);
+    params[0].pid = 0x0060;
+    params[0].isMandatory = true;
+    params[1].pid = 0x00F0;
+    params[1].isMandatory = true;
+    params[2].pid = 0x0400; // not in the model: NACK UNKNOWN_PID
+    params[2].isMandatory = false;
+
+    FleetValidator fleet;
+    fleet.AddPort(bus0, kController, params, half0);
+    fleet.AddPort(bus1, kController, params, half1);
+    Collector c;
+    ASSERT_TRUE(fleet.Start(c.Fn()));
+    fleet.Wait();
+
+    ASSERT_EQ(c.results.size(), 6u);
+    for (const auto &r : c.results) {
+        bool onPort0 =
+            std::find(half0.begin(), half0.end(), r.uid) != half0.end();
+        EXPECT_EQ(r.port, onPort0 ? 0 : 1);
+        EXPECT_EQ(r.green, 2);
+        EXPECT_EQ(r.yellow, 1);
+        EXPECT_EQ(r.red, 0);
+        ASSERT_EQ(r.results.size(), 3u);
+        EXPECT_EQ(r.results[2].responseType, RDMResponseType::NACK);
+    }
+}
+
+TEST(FleetValidator, AbortedOnlyWhenFailFastSkippedRows) {
+    ResponderSim bus;
+    std::vector<uint64_t> uids = MakeSimUIDs(2, 0x434B);
+    ASSERT_TRUE(bus.Open(SmallModel(), uids));
+
+    // 0x0400 is not in the model: a mandatory NACK, RED
+    std::vector<RDMParameter> params(3);
+    for (auto &p : params)
+        p.isMandatory = true;
+    params[0].pid = 0x0060;
+    params[1].pid = 0x00F0;
+    params[2].pid = 0x0400;
+
+    for (bool redFirst : {false, true}) {
+        if (redFirst)
+            std::swap(params[0], params[2]);
+        FleetValidator fleet;
+        fleet.AddPort(bus, kController, params, uids);
+        fleet.SetFailFast(true);
+        Collector c;
+        ASSERT_TRUE(fleet.Start(c.Fn()));
+        fleet.Wait();
+
+        ASSERT_EQ(c.results.size(), 2u);
+        for (const auto &r : c.results) {
+            EXPECT_EQ(r.aborted, redFirst);
+            EXPECT_EQ(r.results.size(), redFirst ? 1u : 3u);
+            EXPECT_EQ(r.red, 1);
+        }
+    }
+}
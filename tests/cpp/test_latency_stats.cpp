@@ -0,0 +1,152 @@
+// tests/cpp/test_latency_stats.cpp
+// Unit tests for: LatencyHistogram, LatencyRecorder
+#include <gtest/gtest.h>
+#include "latency_stats.h"
+#include <cstdint>
+#include <vector>
+
+static const uint64_t kFixA = 0x434B00000001ULL;
+static const uint64_t kFixB = 0x434B00000002ULL;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LatencyHistogram
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(LatencyHistogram, SmallValuesAreExact) {
+    for (int v = 0; v < LatencyHistogram::kLinear; ++v)
+        EXPECT_EQ(LatencyHistogram::BucketUpper(LatencyHistogram::BucketIndex(v)), v);
+}
+
+TEST(LatencyHistogram, BucketsCoverTheirValues) {
+    const int64_t values[] = {32, 33, 100, 999, 1500, 2800, 65535, 1000000,
+                              LatencyHistogram::kMaxValue};
+    for (int64_t v : values) {
+        int i = LatencyHistogram::BucketIndex(v);
+        ASSERT_GE(i, 0);
+        ASSERT_LT(i, LatencyHistogram::kBuckets);
+        int64_t upper = LatencyHistogram::BucketUpper(i);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / LatencyHistogram::kSubBuckets + 1);
+    }
+}
+
+TEST(LatencyHistogram, IndicesAreMonotonic) {
+    int last = -1;
+    for (int64_t v = 0; v < 100000; v += 7) {
+        int i = LatencyHistogram::BucketIndex(v);
+        EXPECT_GE(i, last);
+        last = i;
+    }
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram h;
+    for (int i = 1; i <= 100; ++i)
+        h.Record(i * 100); // 100 .. 10000 us
+    EXPECT_EQ(h.Count(), 100u);
+    EXPECT_EQ(h.Min(), 100);
+    EXPECT_EQ(h.Max(), 10000);
+    EXPECT_NEAR(h.ValueAtPercentile(50), 5000, 5000 / 16 + 1);
+    EXPECT_NEAR(h.ValueAtPercentile(90), 9000, 9000 / 16 + 1);
+    EXPECT_NEAR(h.ValueAtPercentile(99), 9900, 9900 / 16 + 1);
+    EXPECT_EQ(h.ValueAtPercentile(100), 10000);
+    EXPECT_NEAR(h.Mean(), 5050.0, 1e-9);
+}
+
+TEST(LatencyHistogram, MergeAddsCounts) {
+    LatencyHistogram a, b;
+    a.Record(10);
+    b.Record(20000);
+    a.Merge(b);
+    EXPECT_EQ(a.Count(), 2u);
+    EXPECT_EQ(a.Min(), 10);
+    EXPECT_EQ(a.Max(), 20000);
+}
+
+TEST(LatencyHistogram, EmptyReportsZero) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.ValueAtPercentile(99), 0);
+    EXPECT_EQ(h.Max(), 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LatencyRecorder
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(LatencyRecorder, KeysAreSeparatedByUidPidAndClass) {
+    LatencyRecorder r;
+    r.Record({kFixA, 0x0060, 0x20}, LatencyOutcome::ACK, 1000, 0);
+    r.Record({kFixA, 0x0060, 0x30}, LatencyOutcome::ACK, 1000, 0);
+    r.Record({kFixA, 0x00F0, 0x20}, LatencyOutcome::ACK, 1000, 0);
+    r.Record({kFixB, 0x0060, 0x20}, LatencyOutcome::ACK, 1000, 0);
+    r.Record({kFixB, 0x0060, 0x20}, LatencyOutcome::ACK, 1000, 0);
+    EXPECT_EQ(r.EntryCount(), 4);
+}
+
+TEST(LatencyRecorder, OutcomesCountedTimeoutsHaveNoSample) {
+    LatencyRecorder r;
+    LatencyKey k{kFixA, 0x0060, 0x20};
+    r.Record(k, LatencyOutcome::ACK, 900, 0);
+    r.Record(k, LatencyOutcome::NACK, 1100, 0);
+    r.Record(k, LatencyOutcome::TIMEOUT, -1, 0);
+    LatencySummary s;
+    ASSERT_EQ(r.Snapshot(&s, 1, false, 0), 1);
+    EXPECT_EQ(s.outcomes[static_cast<int>(LatencyOutcome::ACK)], 1u);
+    EXPECT_EQ(s.outcomes[static_cast<int>(LatencyOutcome::NACK)], 1u);
+    EXPECT_EQ(s.outcomes[static_cast<int>(LatencyOutcome::TIMEOUT)], 1u);
+    EXPECT_EQ(s.samples, 2u);
+    EXPECT_EQ(s.maxUs, 1100);
+}
+
+TEST(LatencyRecorder, SnapshotSortsSlowestFirst) {
+    LatencyRecorder r;
+    r.Record({kFixA, 0x0060, 0x20}, LatencyOutcome::ACK, 500, 0);
+    r.Record({kFixB, 0x0060, 0x20}, LatencyOutcome::ACK, 15000, 0);
+    LatencySummary s[2];
+    ASSERT_EQ(r.Snapshot(s, 2, false, 0), 2);
+    EXPECT_EQ(s[0].key.uid, kFixB);
+    EXPECT_EQ(s[1].key.uid, kFixA);
+}
+
+TEST(LatencyRecorder, WindowDropsOldIntervals) {
+    LatencyRecorder r(1000000); // 1 s window
+    LatencyKey k{kFixA, 0x0060, 0x20};
+    r.Record(k, LatencyOutcome::ACK, 100, 0);
+    r.Record(k, LatencyOutcome::ACK, 200, 1500000); // next interval
+
+    LatencySummary s;
+    r.Snapshot(&s, 1, true, 1500000);
+    EXPECT_EQ(s.samples, 2u); // current + previous interval
+
+    r.Snapshot(&s, 1, true, 2500000);
+    EXPECT_EQ(s.samples, 1u); // first interval aged out
+
+    r.Snapshot(&s, 1, true, 9000000);
+    EXPECT_EQ(s.samples, 0u);
+
+    r.Snapshot(&s, 1, false, 9000000);
+    EXPECT_EQ(s.samples, 2u); // lifetime keeps everything
+}
+
+TEST(LatencyRecorder, FleetMergesAllKeys) {
+    LatencyRecorder r;
+    r.Record({kFixA, 0x0060, 0x20}, LatencyOutcome::ACK, 500, 0);
+    r.Record({kFixB, 0x0060, 0x20}, LatencyOutcome::ACK, 15000, 0);
+    r.Record({kFixB, 0x00F0, 0x20}, LatencyOutcome::TIMEOUT, -1, 0);
+    auto f = r.Fleet(false, 0);
+    EXPECT_EQ(f.key.uid, 0u);
+    EXPECT_EQ(f.samples, 2u);
+    EXPECT_EQ(f.maxUs, 15000);
+    EXPECT_EQ(f.outcomes[static_cast<int>(LatencyOutcome::TIMEOUT)], 1u);
+}
+
+TEST(LatencyRecorder, EntryTableIsBounded) {
+    LatencyRecorder r;
+    for (int i = 0; i < LatencyRecorder::kMaxEntries + 5; ++i)
+        r.Record({kFixA, static_cast<uint16_t>(i), 0x20},
+                 LatencyOutcome::ACK, 100, 0);
+    EXPECT_EQ(r.EntryCount(), LatencyRecorder::kMaxEntries);
+    EXPECT_EQ(r.EntriesDropped(), 5u);
+    r.Reset();
+    EXPECT_EQ(r.EntryCount(), 0);
+}
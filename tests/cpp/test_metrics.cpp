@@ -0,0 +1,113 @@
+// tests/cpp/test_metrics.cpp
+// Unit tests for MetricsRegistry — counters, gauges, per-port sums, DMX
+// rate sampling and Prometheus rendering.
+#include <gtest/gtest.h>
+#include "metrics.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Counters / gauges
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MetricsRegistry, CountersArePerPort) {
+    MetricsRegistry m;
+    m.Add(0, Metric::RDM_TIMEOUTS);
+    m.Add(0, Metric::RDM_TIMEOUTS);
+    m.Add(1, Metric::RDM_TIMEOUTS, 5);
+    EXPECT_EQ(m.Snapshot(0, 0)[Metric::RDM_TIMEOUTS], 2u);
+    EXPECT_EQ(m.Snapshot(1, 0)[Metric::RDM_TIMEOUTS], 5u);
+    EXPECT_EQ(m.Snapshot(1, 0)[Metric::PURGES], 0u);
+}
+
+TEST(MetricsRegistry, AllPortsSums) {
+    MetricsRegistry m;
+    m.Add(0, Metric::DUB_COLLISIONS, 3);
+    m.Add(7, Metric::DUB_COLLISIONS, 4);
+    m.Set(0, Gauge::RX_QUEUE_BYTES, 10);
+    m.Set(7, Gauge::RX_QUEUE_BYTES, 20);
+    MetricsSnapshot s = m.Snapshot(-1, 0);
+    EXPECT_EQ(s[Metric::DUB_COLLISIONS], 7u);
+    EXPECT_EQ(s.gauges[static_cast<int>(Gauge::RX_QUEUE_BYTES)], 30);
+}
+
+TEST(MetricsRegistry, OutOfRangePortIgnored) {
+    MetricsRegistry m;
+    m.Add(MetricsRegistry::kMaxPorts, Metric::PURGES);
+    m.Add(-2, Metric::PURGES);
+    EXPECT_EQ(m.Snapshot(-1, 0)[Metric::PURGES], 0u);
+    EXPECT_EQ(m.Snapshot(MetricsRegistry::kMaxPorts, 0)[Metric::PURGES], 0u);
+}
+
+TEST(MetricsRegistry, ConcurrentIncrementsAreExact) {
+    MetricsRegistry m;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&] {
+            for (int i = 0; i < 100000; ++i)
+                m.Add(0, Metric::DMX_FRAMES_TX);
+        });
+    for (auto &t : threads) t.join();
+    EXPECT_EQ(m.Snapshot(0, 0)[Metric::DMX_FRAMES_TX], 400000u);
+}
+
+TEST(MetricsRegistry, ResetClearsEverything) {
+    MetricsRegistry m;
+    m.Add(2, Metric::USB_ERRORS);
+    m.Set(2, Gauge::RX_QUEUE_BYTES, 64);
+    m.Reset();
+    MetricsSnapshot s = m.Snapshot(2, 0);
+    EXPECT_EQ(s[Metric::USB_ERRORS], 0u);
+    EXPECT_EQ(s.gauges[0], 0);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DMX rate
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MetricsRegistry, DmxRateNeedsOneSecondBaseline) {
+    MetricsRegistry m;
+    EXPECT_EQ(m.Snapshot(0, 1000000).dmxRateHz, 0.0); // baseline
+    m.Add(0, Metric::DMX_FRAMES_TX, 20);
+    EXPECT_EQ(m.Snapshot(0, 1500000).dmxRateHz, 0.0); // < 1 s: not sampled
+    m.Add(0, Metric::DMX_FRAMES_TX, 20);
+    EXPECT_NEAR(m.Snapshot(0, 2000000).dmxRateHz, 40.0, 1e-9);
+    // Held until the next full interval
+    EXPECT_NEAR(m.Snapshot(0, 2500000).dmxRateHz, 40.0, 1e-9);
+}
+
+TEST(MetricsRegistry, DmxRateSumsAcrossPorts) {
+    MetricsRegistry m;
+    m.Snapshot(-1, 1000000);
+    m.Add(0, Metric::DMX_FRAMES_TX, 44);
+    m.Add(1, Metric::DMX_FRAMES_TX, 30);
+    EXPECT_NEAR(m.Snapshot(-1, 2000000).dmxRateHz, 74.0, 1e-9);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Prometheus text
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MetricsRegistry, PrometheusTextHasTypedLabelledSamples) {
+    MetricsRegistry m;
+    m.Add(0, Metric::CHECKSUM_ERRORS, 3);
+    m.Add(1, Metric::CHECKSUM_ERRORS, 1);
+    std::string text = m.RenderPrometheus(2, 0);
+    EXPECT_NE(text.find("# TYPE rdx_rdm_checksum_errors_total counter\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("rdx_rdm_checksum_errors_total{port=\"0\"} 3\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("rdx_rdm_checksum_errors_total{port=\"1\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("# TYPE rdx_dmx_rate_hz gauge\n"), std::string::npos);
+    EXPECT_EQ(text.find("{port=\"2\"}"), std::string::npos);
+}
+
+TEST(MetricsRegistry, EveryMetricHasAName) {
+    for (int i = 0; i < kMetricCount; ++i) {
+        std::string name = MetricsRegistry::Name(static_cast<Metric>(i));
+        EXPECT_EQ(name.rfind("rdx_", 0), 0u);
+        EXPECT_EQ(name.substr(name.size() - 6), "_total");
+    }
+}
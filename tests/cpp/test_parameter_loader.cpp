@@ -1,5 +1,6 @@
 // tests/cpp/test_parameter_loader.cpp
-// Unit tests for LoadParameters() — CSV parsing via temporary files.
+// Unit tests for LoadParameters(), LoadParameterMap() and
+// LoadPIDAttributes() — CSV parsing via temporary files.
 // No hardware is opened.
 #include <gtest/gtest.h>
 #include "parameter_loader.h"
@@ -165,3 +166,86 @@ TEST(LoadParameters, CommandClassContainsGetCommand) {
     ASSERT_EQ(params.size(), 1u);
     EXPECT_NE(params[0].commandClass.find("GET_COMMAND"), std::string::npos);
 }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LoadParameterMap / LoadPIDAttributes
+// ═══════════════════════════════════════════════════════════════════════════
+// Columns used beyond LoadParameters(): [7]=Mfg. Locked "O" [10]=min
+// [11]=max [12]=FW Defaults [13]=Test Values [14]=Shipping [16]=supported
+
+static const char* kFullRows =
+    ",,Command Class,PID,Purpose,Payload,Description,O,A,B,Min,Max,"
+    "FW,Test,Ship,Notes,Supported\n"
+    ",Vaya Must have,,,,\n"
+    ",Y,GET_COMMAND (0x20),00F0,Get start,2 byte,,O,A,B,0x0001,0x0200,"
+    "0x0001,0x0001,0x0001,,No per RDM standard\n"
+    ",Y,SET_COMMAND (0x30),00F0,Set start,2 byte,,O,A,B,0x0001,0x0200,"
+    ",,,,No per RDM standard\n"
+    ",,SET_COMMAND (0x30),8060,Set serial,6 byte,,,A,B,,,,,,,No\n"
+    ",Y,DISCOVERY_COMMAND (0X10),0001,Disc Unique Branch,,,O,A,B\n";
+
+static const char* kAttributes =
+    "PID,    Name,                     Type,             Access,         "
+    "Device,            Size,\n"
+    "0x803A, OP_CODE_SETTINGS_HASH,    OPCODE_TYPE_1_DI, ACCESS_TYPE_GO, "
+    "OPCODE_DEVICE_PCC, 8,\n"
+    "0x1001, OP_CODE_RESET_DEVICE,     OPCODE_TYPE_1_DI, ACCESS_TYPE_SO, "
+    "OPCODE_DEVICE_F,   0,\n";
+
+TEST(LoadParameterMap, KeepsEveryCommandClass) {
+    TempCSV f(kFullRows);
+    auto rows = LoadParameterMap(f.path);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[0].commandClass, 0x20);
+    EXPECT_EQ(rows[1].commandClass, 0x30);
+    EXPECT_EQ(rows[3].commandClass, 0x10);
+}
+
+TEST(LoadParameterMap, SettingsColumnsParsed) {
+    TempCSV f(kFullRows);
+    auto rows = LoadParameterMap(f.path);
+    ASSERT_GE(rows.size(), 3u);
+    EXPECT_EQ(rows[0].payloadLength, "2 byte");
+    EXPECT_TRUE(rows[0].lockedAccess);
+    EXPECT_EQ(rows[0].minValue, "0x0001");
+    EXPECT_EQ(rows[0].maxValue, "0x0200");
+    EXPECT_EQ(rows[0].fwDefault, "0x0001");
+    EXPECT_EQ(rows[0].testValue, "0x0001");
+    EXPECT_EQ(rows[0].shippingValue, "0x0001");
+    EXPECT_EQ(rows[0].inSupportedParams, "No per RDM standard");
+    EXPECT_FALSE(rows[2].lockedAccess);
+    EXPECT_EQ(rows[2].inSupportedParams, "No");
+}
+
+TEST(LoadPIDAttributes, PaddedFieldsParsed) {
+    TempCSV f(kAttributes);
+    auto attrs = LoadPIDAttributes(f.path);
+    ASSERT_EQ(attrs.size(), 2u);
+    EXPECT_EQ(attrs[0].pid, 0x803A);
+    EXPECT_EQ(attrs[0].name, "OP_CODE_SETTINGS_HASH");
+    EXPECT_TRUE(attrs[0].canGet);
+    EXPECT_FALSE(attrs[0].canSet);
+    EXPECT_EQ(attrs[0].size, 8);
+    EXPECT_FALSE(attrs[1].canGet);
+    EXPECT_TRUE(attrs[1].canSet);
+    EXPECT_EQ(attrs[1].size, 0);
+}
+
+TEST(ParsePayloadLength, MapWordings) {
+    EXPECT_EQ(ParsePayloadLength("19 bytes"), 19);
+    EXPECT_EQ(ParsePayloadLength("2 byte"), 2);
+    EXPECT_EQ(ParsePayloadLength("1 byte signed"), 1);
+    EXPECT_EQ(ParsePayloadLength("none"), 0);
+    EXPECT_EQ(ParsePayloadLength("Variable, see RDM standard"), -1);
+    EXPECT_EQ(ParsePayloadLength(""), -1);
+}
+
+TEST(ParseHexBytes, BigEndianBytes) {
+    std::vector<uint8_t> v;
+    ASSERT_TRUE(ParseHexBytes("0x0200", v));
+    EXPECT_EQ(v, (std::vector<uint8_t>{0x02, 0x00}));
+    ASSERT_TRUE(ParseHexBytes(" 0x434B00000000 ", v));
+    EXPECT_EQ(v.size(), 6u);
+    EXPECT_FALSE(ParseHexBytes("See RDM standard", v));
+    EXPECT_FALSE(ParseHexBytes("0x", v));
+}
@@ -0,0 +1,110 @@
+// tests/cpp/test_peperoni_rodin.cpp
+// Unit tests for PeperoniRodin device enumeration against a fake vusbdmx
+// table: list positions vs. device numbers when the numbers have gaps.
+#include <gtest/gtest.h>
+#include "peperoni_rodin.h"
+#include <string>
+
+// Devices answer under numbers 0 and 2; number 1 is unplugged
+static bool Present(USHORT device) { return device == 0 || device == 2; }
+
+static USHORT Number(HANDLE h) {
+    return static_cast<USHORT>(reinterpret_cast<uintptr_t>(h) - 1);
+}
+
+static BOOL __stdcall FakeOpen(USHORT device, PHANDLE h) {
+    if (!Present(device))
+        return FALSE;
+    *h = reinterpret_cast<HANDLE>(static_cast<uintptr_t>(device) + 1);
+    return TRUE;
+}
+
+static BOOL __stdcall FakeClose(HANDLE) { return TRUE; }
+
+static BOOL __stdcall FakeSerial(HANDLE h, PWCHAR str, USHORT size) {
+    std::wstring s = L"SN" + std::to_wstring(Number(h));
+    if (s.size() + 1 > size)
+        return FALSE;
+    std::copy(s.begin(), s.end(), str);
+    str[s.size()] = 0;
+    return TRUE;
+}
+
+static BOOL __stdcall FakeVersion(HANDLE h, PUSHORT version) {
+    *version = static_cast<USHORT>(0x0100 + Number(h));
+    return TRUE;
+}
+
+static BOOL __stdcall FakeTx(HANDLE, UCHAR, USHORT, PUCHAR, UCHAR, FLOAT,
+                             FLOAT, FLOAT, PUSHORT, PUCHAR) {
+    return FALSE;
+}
+
+static BOOL __stdcall FakeRx(HANDLE, UCHAR, USHORT, PUCHAR, FLOAT, FLOAT,
+                             PUSHORT, PUSHORT, PUCHAR) {
+    return FALSE;
+}
+
+static PeperoniApi FakeApi() {
+    PeperoniApi api;
+    api.open = FakeOpen;
+    api.close = FakeClose;
+    api.serialNumberGet = FakeSerial;
+    api.deviceVersion = FakeVersion;
+    api.tx = FakeTx;
+    api.rx = FakeRx;
+    return api;
+}
+
+TEST(PeperoniRodin, RejectsAnIncompleteApi) {
+    PeperoniRodin pep;
+    PeperoniApi api = FakeApi();
+    api.rx = nullptr;
+    EXPECT_FALSE(pep.LoadApi(api));
+    EXPECT_FALSE(pep.IsDLLLoaded());
+}
+
+TEST(PeperoniRodin, ListSkipsGapsInDeviceNumbers) {
+    PeperoniRodin pep;
+    ASSERT_TRUE(pep.LoadApi(FakeApi()));
+    ASSERT_EQ(pep.ListDevices(), 2);
+    PeperoniDeviceInfo info;
+    ASSERT_TRUE(pep.GetDeviceInfo(1, info));
+    EXPECT_EQ(info.index, 2);
+    EXPECT_EQ(info.serial, "SN2");
+    EXPECT_FALSE(pep.GetDeviceInfo(2, info));
+}
+
+TEST(PeperoniRodin, OpenTakesTheListPosition) {
+    PeperoniRodin pep;
+    ASSERT_TRUE(pep.LoadApi(FakeApi()));
+    ASSERT_EQ(pep.ListDevices(), 2);
+
+    ASSERT_TRUE(pep.Open(1)); // second entry: device number 2
+    EXPECT_EQ(pep.GetDeviceIndex(), 2);
+    EXPECT_EQ(pep.GetSerialNumberString(), "SN2");
+    pep.Close();
+
+    EXPECT_FALSE(pep.Open(2)); // only two entries
+    EXPECT_FALSE(pep.IsOpen());
+
+    ASSERT_TRUE(pep.Open(0));
+    EXPECT_EQ(pep.GetDeviceIndex(), 0);
+    pep.Close();
+}
+
+TEST(PeperoniRodin, SerialAndDeviceNumberOpenTheSameAdapter) {
+    PeperoniRodin pep;
+    ASSERT_TRUE(pep.LoadApi(FakeApi()));
+    ASSERT_TRUE(pep.OpenBySerial("SN2"));
+    EXPECT_EQ(pep.GetDeviceIndex(), 2);
+    pep.Close();
+
+    // A second universe of the open adapter, as the API opens its ports
+    PeperoniRodin universe1;
+    ASSERT_TRUE(universe1.LoadApi(FakeApi()));
+    ASSERT_TRUE(universe1.OpenDevice(2, 1));
+    EXPECT_EQ(universe1.GetSerialNumberString(), "SN2");
+    EXPECT_EQ(universe1.GetUniverse(), 1);
+    EXPECT_FALSE(universe1.OpenDevice(1));
+}
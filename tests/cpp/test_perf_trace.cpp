@@ -0,0 +1,175 @@
+// tests/cpp/test_perf_trace.cpp
+// Unit tests for: PerfTrace (per-thread buffers, collection, Chrome JSON
+// export), PerfScope
+#include <gtest/gtest.h>
+#include "perf_trace.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+static size_t CountOf(const std::string &s, const std::string &needle) {
+    size_t n = 0;
+    for (size_t pos = s.find(needle); pos != std::string::npos;
+         pos = s.find(needle, pos + needle.size()))
+        ++n;
+    return n;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Recording
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PerfTrace, ScopeRecordsNothingWhenStopped) {
+    PerfTrace t;
+    { PerfScope s(t, "rdm", "GET"); }
+    std::vector<PerfRecord> out;
+    EXPECT_EQ(t.Collect(out), 0u);
+}
+
+TEST(PerfTrace, ScopeRecordsSpanWithArgument) {
+    PerfTrace t;
+    t.Start();
+    { PerfScope s(t, "rdm", "GET", "pid", 0x60); }
+    std::vector<PerfRecord> out;
+    ASSERT_EQ(t.Collect(out), 1u);
+    EXPECT_STREQ(out[0].event.name, "GET");
+    EXPECT_STREQ(out[0].event.category, "rdm");
+    EXPECT_STREQ(out[0].event.argName, "pid");
+    EXPECT_EQ(out[0].event.arg, 0x60);
+    EXPECT_GE(out[0].event.durUs, 0);
+}
+
+TEST(PerfTrace, NestedScopesSortedByBegin) {
+    PerfTrace t;
+    t.Start();
+    {
+        PerfScope outer(t, "discovery", "RDMDiscovery");
+        PerfScope inner(t, "discovery", "DISC_UNIQUE_BRANCH");
+    }
+    std::vector<PerfRecord> out;
+    ASSERT_EQ(t.Collect(out), 2u);
+    // Inner closes first but begins later
+    EXPECT_STREQ(out[0].event.name, "RDMDiscovery");
+    EXPECT_STREQ(out[1].event.name, "DISC_UNIQUE_BRANCH");
+    EXPECT_GE(out[0].event.durUs, out[1].event.durUs);
+}
+
+TEST(PerfTrace, InstantHasNoDuration) {
+    PerfTrace t;
+    t.Start();
+    PerfInstant(t, "dmx", "frame", "slots", 513);
+    std::vector<PerfRecord> out;
+    ASSERT_EQ(t.Collect(out), 1u);
+    EXPECT_EQ(out[0].event.durUs, -1);
+}
+
+TEST(PerfTrace, ThreadsGetSeparateBuffers) {
+    PerfTrace t;
+    t.Start();
+    { PerfScope s(t, "api", "main"); }
+    std::thread worker([&] {
+        t.SetThreadName("port 0");
+        for (int i = 0; i < 10; ++i)
+            PerfScope s(t, "usb", "FT_Write");
+    });
+    worker.join();
+
+    std::vector<PerfRecord> out;
+    ASSERT_EQ(t.Collect(out), 11u);
+    uint32_t mainTid = 0, workerTid = 0;
+    for (const auto &r : out) {
+        if (std::string(r.event.name) == "main")
+            mainTid = r.tid;
+        else
+            workerTid = r.tid;
+    }
+    EXPECT_NE(mainTid, 0u);
+    EXPECT_NE(workerTid, 0u);
+    EXPECT_NE(mainTid, workerTid);
+}
+
+TEST(PerfTrace, FinishedThreadsHandOnTheirBuffers) {
+    PerfTrace t;
+    t.Start();
+    std::vector<PerfRecord> out;
+    std::vector<uint32_t> tids;
+    for (int i = 0; i < 20; ++i) {
+        std::thread worker([&] {
+            t.SetThreadName("port worker");
+            PerfInstant(t, "rdm", "GET");
+        });
+        worker.join();
+        out.clear();
+        ASSERT_EQ(t.Collect(out), 1u);
+        tids.push_back(out[0].tid);
+    }
+    // One ring, a new tid per thread
+    EXPECT_EQ(CountOf(t.ExportChromeJson(), "\"ph\":\"M\""), 1u);
+    for (size_t i = 1; i < tids.size(); ++i)
+        EXPECT_NE(tids[i], tids[i - 1]);
+}
+
+TEST(PerfTrace, UncollectedBufferOfAFinishedThreadIsKept) {
+    PerfTrace t;
+    t.Start();
+    for (int i = 0; i < 3; ++i)
+        std::thread([&] { PerfInstant(t, "rdm", "GET"); }).join();
+    std::vector<PerfRecord> out;
+    EXPECT_EQ(t.Collect(out), 3u);
+}
+
+TEST(PerfTrace, FullBufferDropsAndCounts) {
+    PerfTrace t;
+    t.Start();
+    for (size_t i = 0; i < PerfTrace::kPerThread + 5; ++i)
+        PerfInstant(t, "dmx", "frame");
+    EXPECT_EQ(t.Dropped(), 5u);
+    std::vector<PerfRecord> out;
+    EXPECT_EQ(t.Collect(out), PerfTrace::kPerThread);
+}
+
+TEST(PerfTrace, StartDiscardsPreviousSession) {
+    PerfTrace t;
+    t.Start();
+    PerfInstant(t, "dmx", "frame");
+    t.Stop();
+    t.Start();
+    std::vector<PerfRecord> out;
+    EXPECT_EQ(t.Collect(out), 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Chrome JSON export
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(PerfTraceExport, ChromeJsonShape) {
+    PerfTrace t;
+    t.SetThreadName("ui \"main\"");
+    t.Start();
+    { PerfScope s(t, "rdm", "SET", "pid", 0x803A); }
+    PerfInstant(t, "dmx", "frame");
+    std::string json = t.ExportChromeJson();
+
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0),
+              0u);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"X\""), 1u);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"i\""), 1u);
+    EXPECT_EQ(CountOf(json, "\"ph\":\"M\""), 1u);
+    EXPECT_NE(json.find("\"args\":{\"pid\":32826}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"ui \\\"main\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\n]}"), std::string::npos);
+}
+
+TEST(PerfTraceExport, ExportConsumesEvents) {
+    PerfTrace t;
+    t.Start();
+    PerfInstant(t, "dmx", "frame");
+    EXPECT_EQ(CountOf(t.ExportChromeJson(), "\"ph\":\"i\""), 1u);
+    EXPECT_EQ(CountOf(t.ExportChromeJson(), "\"ph\":\"i\""), 0u);
+}
+
+TEST(PerfTraceExport, BadPathFails) {
+    PerfTrace t;
+    EXPECT_EQ(t.ExportChromeJson(std::string("/nonexistent-dir/x/trace.json")),
+              -1);
+}
@@ -0,0 +1,248 @@
+// tests/cpp/test_rdm_sniffer.cpp
+// Unit tests for: SpscRing, ClassifySniffFrame, DecodeDubResponse, SniffPairer
+// No hardware is opened — frames are built with BuildRDMPacket.
+#include <gtest/gtest.h>
+#include "rdm.h"
+#include "rdm_sniffer.h"
+#include "spsc_ring.h"
+#include <cstdint>
+#include <vector>
+
+static const uint64_t kCtrl = 0x454E00000001ULL;
+static const uint64_t kFix  = 0x434B00001234ULL;
+
+// Builds a DUB response the way a responder encodes it (E1.20 7.5.3)
+static std::vector<uint8_t> EncodeDub(uint64_t uid, int preamble = 7) {
+    std::vector<uint8_t> f(preamble, 0xFE);
+    f.push_back(0xAA);
+    uint16_t sum = 0;
+    for (int i = 5; i >= 0; --i) {
+        uint8_t b = static_cast<uint8_t>(uid >> (i * 8));
+        uint8_t e1 = b | 0xAA, e2 = b | 0x55;
+        f.push_back(e1);
+        f.push_back(e2);
+        sum += e1 + e2;
+    }
+    uint8_t hi = sum >> 8, lo = sum & 0xFF;
+    f.push_back(hi | 0xAA); f.push_back(hi | 0x55);
+    f.push_back(lo | 0xAA); f.push_back(lo | 0x55);
+    return f;
+}
+
+static SniffRecord MakeRecord(SniffFrameKind kind, int64_t ts,
+                              uint64_t src, uint64_t dest, uint8_t trans,
+                              uint8_t cc = RDM_CC_GET, uint16_t pid = PID_DEVICE_INFO) {
+    SniffRecord r;
+    r.kind = kind;
+    r.timestampUs = ts;
+    r.srcUID = src;
+    r.destUID = dest;
+    r.transNum = trans;
+    r.commandClass = cc;
+    r.pid = pid;
+    return r;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SpscRing
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(SpscRing, PushPopFifo) {
+    SpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_TRUE(ring.Push(1));
+    EXPECT_TRUE(ring.Push(2));
+    int v = 0;
+    EXPECT_TRUE(ring.Pop(v)); EXPECT_EQ(v, 1);
+    EXPECT_TRUE(ring.Pop(v)); EXPECT_EQ(v, 2);
+    EXPECT_FALSE(ring.Pop(v));
+}
+
+TEST(SpscRing, PushFailsWhenFull) {
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(ring.Push(i));
+    EXPECT_FALSE(ring.Push(99));
+    EXPECT_EQ(ring.Size(), 4u);
+}
+
+TEST(SpscRing, WrapsAround) {
+    SpscRing<int, 4> ring;
+    int v = 0;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ring.Push(i));
+        ASSERT_TRUE(ring.Pop(v));
+        EXPECT_EQ(v, i);
+    }
+}
+
+TEST(SpscRing, ReserveCommit) {
+    SpscRing<int, 2> ring;
+    int* slot = ring.Reserve();
+    ASSERT_NE(slot, nullptr);
+    *slot = 42;
+    ring.Commit();
+    int v = 0;
+    EXPECT_TRUE(ring.Pop(v));
+    EXPECT_EQ(v, 42);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ClassifySniffFrame
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ClassifySniffFrame, DmxStartCode) {
+    std::vector<uint8_t> f(513, 0);
+    EXPECT_EQ(ClassifySniffFrame(f.data(), 513, 0), SniffFrameKind::DMX);
+}
+
+TEST(ClassifySniffFrame, AlternateStartCode) {
+    const uint8_t f[] = {0x17, 0x01, 0x02};
+    EXPECT_EQ(ClassifySniffFrame(f, 3, 0), SniffFrameKind::ALT_START);
+}
+
+TEST(ClassifySniffFrame, GetRequest) {
+    auto pkt = BuildRDMPacket(kFix, kCtrl, 5, 1, 0, 0, RDM_CC_GET, PID_DEVICE_INFO);
+    EXPECT_EQ(ClassifySniffFrame(pkt.data(), (int)pkt.size(), 0),
+              SniffFrameKind::RDM_REQUEST);
+}
+
+TEST(ClassifySniffFrame, GetResponse) {
+    uint8_t pd[19] = {};
+    auto pkt = BuildRDMPacket(kCtrl, kFix, 5, 0, 0, 0, RDM_CC_GET_RSP, PID_DEVICE_INFO, pd, 19);
+    EXPECT_EQ(ClassifySniffFrame(pkt.data(), (int)pkt.size(), 0),
+              SniffFrameKind::RDM_RESPONSE);
+}
+
+TEST(ClassifySniffFrame, BadChecksumIsInvalid) {
+    auto pkt = BuildRDMPacket(kFix, kCtrl, 5, 1, 0, 0, RDM_CC_GET, PID_DEVICE_INFO);
+    pkt.back() ^= 0x01;
+    EXPECT_EQ(ClassifySniffFrame(pkt.data(), (int)pkt.size(), 0),
+              SniffFrameKind::INVALID);
+}
+
+TEST(ClassifySniffFrame, TruncatedRdmIsInvalid) {
+    auto pkt = BuildRDMPacket(kFix, kCtrl, 5, 1, 0, 0, RDM_CC_GET, PID_DEVICE_INFO);
+    EXPECT_EQ(ClassifySniffFrame(pkt.data(), 20, 0), SniffFrameKind::INVALID);
+}
+
+TEST(ClassifySniffFrame, DubResponse) {
+    auto f = EncodeDub(kFix);
+    EXPECT_EQ(ClassifySniffFrame(f.data(), (int)f.size(), SNIFF_FLAG_NO_BREAK),
+              SniffFrameKind::DUB_RESPONSE);
+}
+
+TEST(ClassifySniffFrame, FrameErrorIsInvalid) {
+    std::vector<uint8_t> f(513, 0);
+    EXPECT_EQ(ClassifySniffFrame(f.data(), 513, SNIFF_FLAG_ERROR),
+              SniffFrameKind::INVALID);
+}
+
+TEST(ClassifySniffFrame, EmptyIsInvalid) {
+    EXPECT_EQ(ClassifySniffFrame(nullptr, 0, 0), SniffFrameKind::INVALID);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DecodeDubResponse
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(DecodeDubResponse, RoundTrip) {
+    uint64_t uid = 0;
+    auto f = EncodeDub(0xABCD12345678ULL);
+    ASSERT_TRUE(DecodeDubResponse(f.data(), (int)f.size(), &uid));
+    EXPECT_EQ(uid, 0xABCD12345678ULL);
+}
+
+TEST(DecodeDubResponse, NoPreamble) {
+    uint64_t uid = 0;
+    auto f = EncodeDub(kFix, 0);
+    ASSERT_TRUE(DecodeDubResponse(f.data(), (int)f.size(), &uid));
+    EXPECT_EQ(uid, kFix);
+}
+
+TEST(DecodeDubResponse, CorruptedChecksumRejected) {
+    auto f = EncodeDub(kFix);
+    f[10] ^= 0x04; // flip a data bit without fixing the checksum
+    EXPECT_FALSE(DecodeDubResponse(f.data(), (int)f.size(), nullptr));
+}
+
+TEST(DecodeDubResponse, ShortFrameRejected) {
+    auto f = EncodeDub(kFix);
+    EXPECT_FALSE(DecodeDubResponse(f.data(), (int)f.size() - 1, nullptr));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SniffPairer
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(SniffPairer, PairsResponseWithRequest) {
+    SniffPairer p;
+    auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, 1000, kCtrl, kFix, 7);
+    auto rsp = MakeRecord(SniffFrameKind::RDM_RESPONSE, 3500, kFix, kCtrl, 7, RDM_CC_GET_RSP);
+    p.Process(req);
+    p.Process(rsp);
+    EXPECT_EQ(rsp.turnaroundUs, 2500);
+
+    SniffFixtureStats st[4];
+    ASSERT_EQ(p.GetFixtureStats(st, 4), 1);
+    EXPECT_EQ(st[0].uid, kFix);
+    EXPECT_EQ(st[0].responses, 1u);
+    EXPECT_EQ(st[0].minTurnaroundUs, 2500);
+    EXPECT_EQ(st[0].maxTurnaroundUs, 2500);
+}
+
+TEST(SniffPairer, TransactionNumberMustMatch) {
+    SniffPairer p;
+    auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, 1000, kCtrl, kFix, 7);
+    auto rsp = MakeRecord(SniffFrameKind::RDM_RESPONSE, 2000, kFix, kCtrl, 8, RDM_CC_GET_RSP);
+    p.Process(req);
+    p.Process(rsp);
+    EXPECT_EQ(rsp.turnaroundUs, -1);
+}
+
+TEST(SniffPairer, ExpiredRequestCountsUnanswered) {
+    SniffPairer p(10000);
+    auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, 0, kCtrl, kFix, 1);
+    auto dmx = MakeRecord(SniffFrameKind::DMX, 50000, 0, 0, 0);
+    p.Process(req);
+    p.Process(dmx);
+    SniffFixtureStats st[2];
+    ASSERT_EQ(p.GetFixtureStats(st, 2), 1);
+    EXPECT_EQ(st[0].unanswered, 1u);
+    EXPECT_EQ(st[0].responses, 0u);
+}
+
+TEST(SniffPairer, BroadcastRequestNotPending) {
+    SniffPairer p(10000);
+    auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, 0, kCtrl, RDM_BROADCAST_UID, 1, RDM_CC_SET);
+    auto dmx = MakeRecord(SniffFrameKind::DMX, 50000, 0, 0, 0);
+    p.Process(req);
+    p.Process(dmx);
+    SniffFixtureStats st[2];
+    EXPECT_EQ(p.GetFixtureStats(st, 2), 0);
+}
+
+TEST(SniffPairer, DubResponsePairsWithBranch) {
+    SniffPairer p;
+    auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, 100, kCtrl, RDM_BROADCAST_UID, 3,
+                          RDM_CC_DISCOVERY, PID_DISC_UNIQUE_BRANCH);
+    auto dub = MakeRecord(SniffFrameKind::DUB_RESPONSE, 1100, kFix, 0, 0, RDM_CC_DISCOVERY_RSP);
+    p.Process(req);
+    p.Process(dub);
+    EXPECT_EQ(dub.turnaroundUs, 1000);
+}
+
+TEST(SniffPairer, FixtureTableIsBounded) {
+    SniffPairer p;
+    for (int i = 1; i <= SniffPairer::kFixtures + 10; ++i) {
+        uint64_t uid = 0x434B00000000ULL | static_cast<uint64_t>(i);
+        auto req = MakeRecord(SniffFrameKind::RDM_REQUEST, i * 10, kCtrl, uid, 1);
+        auto rsp = MakeRecord(SniffFrameKind::RDM_RESPONSE, i * 10 + 5, uid, kCtrl, 1, RDM_CC_GET_RSP);
+        p.Process(req);
+        p.Process(rsp);
+    }
+    std::vector<SniffFixtureStats> st(SniffPairer::kFixtures + 10);
+    int n = p.GetFixtureStats(st.data(), (int)st.size());
+    EXPECT_LT(n, SniffPairer::kFixtures);
+    EXPECT_GT(p.FixturesDropped(), 0u);
+}
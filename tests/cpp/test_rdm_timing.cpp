@@ -0,0 +1,84 @@
+// tests/cpp/test_rdm_timing.cpp
+// Unit tests for: RdmWireUs, ComputeTimingBreakdown
+#include <gtest/gtest.h>
+#include "rdm_timing.h"
+
+// A GET DEVICE_INFO exchange: 26-slot request, 45-slot response
+static RdmStageTimes MakeStages() {
+    RdmStageTimes t;
+    t.requestSlots = 26;
+    t.responseSlots = 45;
+    t.submitUs = 1000;
+    t.writeDoneUs = 1300;
+    t.firstRxUs = 1300 + RdmWireUs(26) + 800 + RdmWireUs(45) + 1500;
+    t.parsedUs = t.firstRxUs + 40;
+    return t;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RdmWireUs
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(RdmWireUs, BreakMabPlusSlots) {
+    EXPECT_EQ(RdmWireUs(0), 0);
+    EXPECT_EQ(RdmWireUs(1), 176 + 12 + 44);
+    EXPECT_EQ(RdmWireUs(26), 176 + 12 + 26 * 44);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ComputeTimingBreakdown
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(ComputeTimingBreakdown, HostEstimateExcludesWireAndHost) {
+    auto t = MakeStages();
+    auto b = ComputeTimingBreakdown(t);
+    EXPECT_EQ(b.source, TurnaroundSource::HOST_ESTIMATE);
+    EXPECT_EQ(b.totalUs, t.parsedUs - t.submitUs);
+    EXPECT_EQ(b.usbWriteUs, 300);
+    EXPECT_EQ(b.hostUs, 40);
+    EXPECT_EQ(b.wireUs, RdmWireUs(26) + RdmWireUs(45));
+    EXPECT_EQ(b.responderUs, 800 + 1500); // upper bound: includes USB in
+    EXPECT_EQ(b.usbWriteUs + b.wireUs + b.responderUs + b.hostUs +
+              b.overheadUs, b.totalUs);
+}
+
+TEST(ComputeTimingBreakdown, DeviceTurnaroundSplitsOutOverhead) {
+    auto t = MakeStages();
+    t.deviceTurnaroundUs = 1000;
+    t.deviceResolutionUs = 1000;
+    auto b = ComputeTimingBreakdown(t);
+    EXPECT_EQ(b.source, TurnaroundSource::DEVICE);
+    EXPECT_EQ(b.responderUs, 1000);
+    EXPECT_EQ(b.resolutionUs, 1000);
+    EXPECT_EQ(b.overheadUs, 1500 - 200);
+    EXPECT_EQ(b.usbWriteUs + b.wireUs + b.responderUs + b.hostUs +
+              b.overheadUs, b.totalUs);
+}
+
+TEST(ComputeTimingBreakdown, NoResponse) {
+    RdmStageTimes t;
+    t.requestSlots = 26;
+    t.submitUs = 0;
+    t.writeDoneUs = 200;
+    t.parsedUs = 50000;
+    auto b = ComputeTimingBreakdown(t);
+    EXPECT_EQ(b.source, TurnaroundSource::NONE);
+    EXPECT_EQ(b.responderUs, -1);
+    EXPECT_EQ(b.hostUs, 0);
+    EXPECT_EQ(b.wireUs, RdmWireUs(26));
+    EXPECT_EQ(b.overheadUs, 50000 - 200 - RdmWireUs(26));
+}
+
+TEST(ComputeTimingBreakdown, CoarseDeviceTurnaroundNeverGoesNegative) {
+    auto t = MakeStages();
+    t.deviceTurnaroundUs = 60000; // larger than the whole transaction
+    auto b = ComputeTimingBreakdown(t);
+    EXPECT_GE(b.wireUs, 0);
+    EXPECT_GE(b.overheadUs, 0);
+}
+
+TEST(RdmNowUs, Monotonic) {
+    int64_t a = RdmNowUs();
+    int64_t b = RdmNowUs();
+    EXPECT_GE(b, a);
+}
@@ -0,0 +1,118 @@
+// tests/cpp/test_rdm_x_api.cpp
+// Tests for the per-port DLL API against the simulator: ports opened by
+// RDX_OpenSimulator, per-port discovery, RDX_SendPortGET / SET / DMX and
+// out-of-range port indexes.  The parameter map is a small temp CSV.
+#include <gtest/gtest.h>
+#include "rdm_x_api.h"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+static const uint16_t kStartAddress = 0x00F0;
+
+class RdxPorts : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_map = ::testing::TempDir() + "rdx_ports_map.csv";
+        std::ofstream f(m_map);
+        f << ",Must have,Command Class,PID,Purpose,Payload Length,"
+             "Description,Available modes,,,Valid Range,,Settings,,,Notes,"
+             "Supported\n"
+          << ",,,,,,,Locked,Unlocked,Bootloader,Minimum,Maximum,"
+             "FW Defaults,Test Values,Shipping Values,,\n"
+          << ",Y,GET_COMMAND (0x20),0060,Get Device Info,19 bytes,,O,A,"
+             ",,,,,,,No\n"
+          << ",Y,GET_COMMAND (0x20),00F0,Get start address,2 byte,,O,A,"
+             ",0x0001,0x0200,0x0001,,,,No\n"
+          << ",Y,SET_COMMAND (0x30),00F0,Set start address,2 byte,,O,A,"
+             ",0x0001,0x0200,,,,,No\n";
+    }
+    void TearDown() override {
+        RDX_Shutdown();
+        std::remove(m_map.c_str());
+    }
+
+    // 6 fixtures over 2 ports
+    void Open() {
+        ASSERT_TRUE(RDX_OpenSimulator(m_map.c_str(), nullptr, 6, 2));
+    }
+    void OpenAndDiscover() {
+        Open();
+        ASSERT_EQ(RDX_DiscoverPorts(), 6);
+    }
+
+    std::string m_map;
+};
+
+static std::vector<uint64_t> PortUIDs(int port) {
+    std::vector<uint64_t> uids;
+    uint64_t uid = 0;
+    for (int i = 0; RDX_GetPortDiscoveredUID(port, i, &uid); ++i)
+        uids.push_back(uid);
+    return uids;
+}
+
+TEST_F(RdxPorts, DiscoversEveryFixtureOnItsOwnPort) {
+    OpenAndDiscover();
+    ASSERT_EQ(RDX_GetPortCount(), 2);
+    EXPECT_EQ(RDX_GetPortUIDCount(0), 3);
+    EXPECT_EQ(RDX_GetPortUIDCount(1), 3);
+    std::set<uint64_t> all;
+    for (int port = 0; port < 2; ++port)
+        for (uint64_t uid : PortUIDs(port))
+            all.insert(uid);
+    EXPECT_EQ(all.size(), 6u);
+
+    uint64_t uid = 0;
+    EXPECT_FALSE(RDX_GetPortDiscoveredUID(0, 3, &uid));
+    EXPECT_FALSE(RDX_GetPortDiscoveredUID(2, 0, &uid));
+    EXPECT_EQ(RDX_GetPortUIDCount(-1), 0);
+}
+
+TEST_F(RdxPorts, GetAndSetReachTheFixtureOnItsPort) {
+    OpenAndDiscover();
+    uint64_t uid = PortUIDs(1).at(0);
+    RDX_Response r;
+    ASSERT_TRUE(RDX_SendPortGET(1, uid, kStartAddress, nullptr, 0, &r));
+    EXPECT_EQ(r.status, RDX_STATUS_ACK);
+    ASSERT_EQ(r.dataLen, 2);
+    EXPECT_EQ(r.data[1], 0x01); // FW default
+
+    const uint8_t address[2] = {0x00, 0x10};
+    ASSERT_TRUE(RDX_SendPortSET(1, uid, kStartAddress, address, 2, &r));
+    EXPECT_EQ(r.status, RDX_STATUS_ACK);
+    ASSERT_TRUE(RDX_SendPortGET(1, uid, kStartAddress, nullptr, 0, &r));
+    ASSERT_EQ(r.dataLen, 2);
+    EXPECT_EQ(r.data[1], 0x10);
+
+    const uint8_t outOfRange[2] = {0x02, 0x01};
+    RDX_SendPortSET(1, uid, kStartAddress, outOfRange, 2, &r);
+    EXPECT_EQ(r.status, RDX_STATUS_NACK);
+
+    // Not on port 0's line
+    RDX_SendPortGET(0, uid, kStartAddress, nullptr, 0, &r);
+    EXPECT_EQ(r.status, RDX_STATUS_TIMEOUT);
+}
+
+TEST_F(RdxPorts, RejectsBadPortsAndFrames) {
+    Open();
+    uint8_t frame[513] = {};
+    EXPECT_TRUE(RDX_SendPortDMX(0, frame, 513));
+    EXPECT_TRUE(RDX_SendPortDMX(1, frame, 1));
+    EXPECT_FALSE(RDX_SendPortDMX(2, frame, 513));
+    EXPECT_FALSE(RDX_SendPortDMX(0, frame, 0));
+    EXPECT_FALSE(RDX_SendPortDMX(0, frame, 514));
+    EXPECT_FALSE(RDX_SendPortDMX(0, nullptr, 1));
+
+    RDX_Response r;
+    uint64_t uid = 0x434B00000001ULL; // rejected before it is addressed
+    EXPECT_FALSE(RDX_SendPortGET(2, uid, kStartAddress, nullptr, 0, &r));
+    EXPECT_FALSE(RDX_SendPortSET(-1, uid, kStartAddress, nullptr, 0, &r));
+    EXPECT_FALSE(RDX_SendPortGET(0, uid, kStartAddress, nullptr, 0, nullptr));
+
+    RDX_Close();
+    EXPECT_EQ(RDX_GetPortCount(), 0);
+    EXPECT_FALSE(RDX_SendPortDMX(0, frame, 513));
+}
@@ -0,0 +1,301 @@
+// tests/cpp/test_responder_sim.cpp
+// Unit tests for ResponderSim: GET/SET against map-driven state, NACK
+// reasons, manufacturing lock, ACK_TIMER / ACK_OVERFLOW, broadcast SETs,
+// discovery and ValidateFixture over simulated fixtures.  The model is
+// built from in-memory map rows; no files or hardware are opened.
+#include <gtest/gtest.h>
+#include "responder_sim.h"
+#include "rdm.h"
+#include "validator.h"
+#include <algorithm>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static RDMParameterRow Row(uint16_t pid, uint8_t cc, const char *len,
+                           bool locked, const char *minValue = "",
+                           const char *maxValue = "", const char *fw = "",
+                           const char *supported = "No") {
+    RDMParameterRow r;
+    r.pid = pid;
+    r.commandClass = cc;
+    r.name = "PID";
+    r.payloadLength = len;
+    r.lockedAccess = locked;
+    r.minValue = minValue;
+    r.maxValue = maxValue;
+    r.fwDefault = fw;
+    r.inSupportedParams = supported;
+    return r;
+}
+
+static std::shared_ptr<const SimModel> TestModel() {
+    std::vector<RDMParameterRow> rows = {
+        Row(0x0050, 0x20, "Variable, see RDM standard", true),
+        Row(0x0060, 0x20, "19 bytes", true),
+        Row(0x00F0, 0x20, "2 byte", true, "0x0001", "0x0200", "0x0001"),
+        Row(0x00F0, 0x30, "2 byte", true, "0x0001", "0x0200"),
+        Row(0x0400, 0x20, "4 byte", false, "0x00000000", "0xFFFFFFFF"),
+        Row(0x0400, 0x30, "4 byte", false, "0x00000000", "0xFFFFFFFF"),
+        Row(0x1000, 0x20, "1 byte", true, "0x00", "0x01"),
+        Row(0x1000, 0x30, "", true, "0x00", "0x01"),
+        Row(0x8060, 0x20, "6 byte", true),
+        Row(0x8060, 0x30, "6 byte", false),
+        Row(0x8600, 0x20, "1 byte", true, "0x00", "0x01", "", "Yes"),
+        Row(0x8600, 0x30, "1 byte", true, "0x00", "0x01", "", "Yes"),
+        Row(0x860C, 0x20, "1 byte", true, "", "", "", "Yes"),
+        Row(0x9001, 0x20, "4 byte", true),
+        Row(0x9001, 0x30, "Magic value of 0x4C4F434B", true),
+        Row(0x9F02, 0x20, "1 byte", true, "", "", "", "Yes"),
+    };
+    PIDAttribute hash;
+    hash.pid = 0x803A;
+    hash.name = "OP_CODE_SETTINGS_HASH";
+    hash.canGet = true;
+    hash.size = 8;
+    PIDAttribute lock;
+    lock.pid = 0x9001;
+    lock.canGet = lock.canSet = true;
+    lock.size = 4;
+    return BuildSimModel(rows, {hash, lock});
+}
+
+struct Reply {
+    uint8_t type = 0xFF; // 0xFF = no response
+    uint8_t commandClass = 0;
+    uint16_t pid = 0;
+    std::vector<uint8_t> data;
+    uint16_t Nack() const { return (data[0] << 8) | data[1]; }
+};
+
+static Reply Send(ResponderSim &sim, uint64_t dest, uint8_t cc, uint16_t pid,
+                  std::vector<uint8_t> pd = {}, uint16_t subDevice = 0) {
+    auto pkt = BuildRDMPacket(dest, kController, sim.NextTransNum(), 1, 0,
+                              subDevice, cc, pid, pd.data(),
+                              static_cast<uint8_t>(pd.size()));
+    EXPECT_TRUE(sim.SendRDM(pkt.data(), static_cast<int>(pkt.size())));
+    uint8_t buf[512], st;
+    int n = sim.ReceiveRDM(buf, sizeof(buf), st);
+    Reply r;
+    if (n < 26)
+        return r;
+    EXPECT_EQ(RDMChecksum(buf, n - 2), (buf[n - 2] << 8) | buf[n - 1]);
+    r.type = buf[16];
+    r.commandClass = buf[20];
+    r.pid = static_cast<uint16_t>((buf[21] << 8) | buf[22]);
+    r.data.assign(buf + 24, buf + 24 + buf[23]);
+    return r;
+}
+
+class ResponderSimTest : public ::testing::Test {
+protected:
+    void SetUp() override { Open(SimOptions{}); }
+    void Open(const SimOptions &opts, int fixtures = 3) {
+        uids = MakeSimUIDs(fixtures, 0x434B);
+        ASSERT_TRUE(sim.Open(TestModel(), uids, opts));
+    }
+    ResponderSim sim;
+    std::vector<uint64_t> uids;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GET / SET
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(ResponderSimTest, DeviceInfoCarriesFwDefaults) {
+    Reply r = Send(sim, uids[0], RDM_CC_GET, PID_DEVICE_INFO);
+    ASSERT_EQ(r.type, RDM_RESPONSE_ACK);
+    EXPECT_EQ(r.commandClass, RDM_CC_GET_RSP);
+    ASSERT_EQ(r.data.size(), 19u);
+    EXPECT_EQ(r.data[0], 0x01); // protocol 1.0
+    EXPECT_EQ((r.data[14] << 8) | r.data[15], 0x0001); // FW Defaults
+}
+
+TEST_F(ResponderSimTest, SetIsStoredPerFixture) {
+    Reply r = Send(sim, uids[0], RDM_CC_SET, PID_DMX_START_ADDRESS, {0, 42});
+    EXPECT_EQ(r.type, RDM_RESPONSE_ACK);
+    EXPECT_EQ(r.commandClass, RDM_CC_SET_RSP);
+    r = Send(sim, uids[0], RDM_CC_GET, PID_DMX_START_ADDRESS);
+    EXPECT_EQ(r.data, (std::vector<uint8_t>{0, 42}));
+    r = Send(sim, uids[1], RDM_CC_GET, PID_DMX_START_ADDRESS);
+    EXPECT_EQ(r.data, (std::vector<uint8_t>{0, 1}));
+}
+
+TEST_F(ResponderSimTest, NackReasons) {
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_GET, 0x7777).Nack(), NR_UNKNOWN_PID);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x9F02, {1}).Nack(),
+              NR_UNSUPPORTED_COMMAND_CLASS);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x00F0, {1}).Nack(),
+              NR_FORMAT_ERROR);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x00F0, {0x02, 0x01}).Nack(),
+              NR_DATA_OUT_OF_RANGE);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_GET, 0x0060, {}, 1).Nack(),
+              NR_SUB_DEVICE_OUT_OF_RANGE);
+    EXPECT_EQ(sim.Counters().nacks, 5u);
+}
+
+TEST_F(ResponderSimTest, UnknownUidIsSilent) {
+    EXPECT_EQ(Send(sim, 0x434B12345678ULL, RDM_CC_GET, 0x0060).type, 0xFF);
+}
+
+TEST_F(ResponderSimTest, ManufacturingLockProtectsMfgData) {
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x8060,
+                   {0x43, 0x4B, 0, 0, 0, 7}).type,
+              RDM_RESPONSE_ACK);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x9001,
+                   {0x4C, 0x4F, 0x43, 0x4B}).type,
+              RDM_RESPONSE_ACK);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x8060,
+                   {0x43, 0x4B, 0, 0, 0, 8}).Nack(),
+              NR_WRITE_PROTECT);
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_GET, 0x0400).Nack(), NR_UNKNOWN_PID);
+    // Operation PIDs stay open
+    EXPECT_EQ(Send(sim, uids[0], RDM_CC_SET, 0x00F0, {0, 9}).type,
+              RDM_RESPONSE_ACK);
+}
+
+TEST_F(ResponderSimTest, SettingsHashFollowsSettings) {
+    auto hash = [&] { return Send(sim, uids[0], RDM_CC_GET, 0x803A).data; };
+    auto before = hash();
+    ASSERT_EQ(before.size(), 8u);
+    Send(sim, uids[0], RDM_CC_SET, PID_IDENTIFY_DEVICE, {1}); // not a setting
+    EXPECT_EQ(hash(), before);
+    Send(sim, uids[0], RDM_CC_SET, 0x8600, {1});
+    auto after = hash();
+    EXPECT_NE(after, before);
+    EXPECT_EQ(std::vector<uint8_t>(after.begin() + 2, after.begin() + 4),
+              std::vector<uint8_t>(before.begin() + 2, before.begin() + 4));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ACK_TIMER / ACK_OVERFLOW
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(ResponderSimTest, AckTimerResultComesFromQueuedMessage) {
+    SimOptions opts;
+    opts.ackTimerPids = {PID_DMX_START_ADDRESS};
+    opts.ackTimerMs = 0;
+    Open(opts);
+    Reply r = Send(sim, uids[0], RDM_CC_SET, PID_DMX_START_ADDRESS, {0, 5});
+    EXPECT_EQ(r.type, RDM_RESPONSE_ACK_TIMER);
+    r = Send(sim, uids[0], RDM_CC_GET, PID_QUEUED_MESSAGE, {0x04});
+    EXPECT_EQ(r.type, RDM_RESPONSE_ACK);
+    EXPECT_EQ(r.commandClass, RDM_CC_SET_RSP);
+    EXPECT_EQ(r.pid, PID_DMX_START_ADDRESS);
+    // Queue empty: an empty STATUS_MESSAGES
+    r = Send(sim, uids[0], RDM_CC_GET, PID_QUEUED_MESSAGE, {0x04});
+    EXPECT_EQ(r.pid, PID_STATUS_MESSAGES);
+    EXPECT_TRUE(r.data.empty());
+}
+
+TEST_F(ResponderSimTest, AckOverflowSegmentsLongResponses) {
+    SimOptions opts;
+    opts.maxPdl = 4;
+    Open(opts);
+    std::vector<uint8_t> all;
+    Reply r;
+    int segments = 0;
+    do {
+        r = Send(sim, uids[0], RDM_CC_GET, PID_SUPPORTED_PARAMS);
+        all.insert(all.end(), r.data.begin(), r.data.end());
+        ++segments;
+    } while (r.type == RDM_RESPONSE_ACK_OVERFLOW && segments < 10);
+    EXPECT_EQ(r.type, RDM_RESPONSE_ACK);
+    EXPECT_EQ(segments, 2);
+    EXPECT_EQ(all, (std::vector<uint8_t>{0x86, 0x00, 0x86, 0x0C,
+                                         0x9F, 0x02}));
+}
+
+TEST_F(ResponderSimTest, GetCommandJoinsAckOverflowSegments) {
+    SimOptions opts;
+    opts.maxPdl = 4;
+    Open(opts);
+    RDMResponse r =
+        RDMGetCommand(sim, kController, uids[0], PID_SUPPORTED_PARAMS);
+    EXPECT_EQ(r.type, RDMResponseType::ACK);
+    EXPECT_EQ(r.data, (std::vector<uint8_t>{0x86, 0x00, 0x86, 0x0C,
+                                            0x9F, 0x02}));
+    EXPECT_EQ(sim.Counters().overflows, 1u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Bus-level behaviour
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST_F(ResponderSimTest, BroadcastSetReachesEveryFixtureSilently) {
+    Reply r =
+        Send(sim, RDM_BROADCAST_UID, RDM_CC_SET, PID_IDENTIFY_DEVICE, {1});
+    EXPECT_EQ(r.type, 0xFF);
+    for (uint64_t uid : uids) {
+        std::vector<uint8_t> v;
+        ASSERT_TRUE(sim.GetValue(uid, PID_IDENTIFY_DEVICE, v));
+        EXPECT_EQ(v, (std::vector<uint8_t>{1}));
+    }
+    // Vendorcast for another manufacturer changes nothing
+    Send(sim, 0x4C45FFFFFFFFULL, RDM_CC_SET, PID_IDENTIFY_DEVICE, {0});
+    std::vector<uint8_t> v;
+    sim.GetValue(uids[0], PID_IDENTIFY_DEVICE, v);
+    EXPECT_EQ(v, (std::vector<uint8_t>{1}));
+}
+
+TEST_F(ResponderSimTest, DiscoveryFindsEveryFixture) {
+    Open(SimOptions{}, 40);
+    auto found = RDMDiscovery(sim, kController);
+    std::sort(found.begin(), found.end());
+    auto expected = uids;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(found, expected);
+}
+
+TEST_F(ResponderSimTest, ValidateFixtureRunsAgainstTheSimulator) {
+    std::vector<RDMParameter> params = {
+        {0x0060, "Device Info", "GET_COMMAND (0x20)", true, ""},
+        {0x00F0, "Start Address", "GET_COMMAND (0x20)", true, ""},
+        {0x0400, "Device Hours", "GET_COMMAND (0x20)", false, ""},
+        {0x7777, "Not implemented", "GET_COMMAND (0x20)", true, ""},
+    };
+    SimOptions opts;
+    opts.locked = true; // 0x0400 is hidden on locked units
+    Open(opts);
+    auto results = ValidateFixture(sim, kController, uids[0], params);
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_EQ(results[0].status, ValidationStatus::GREEN);
+    EXPECT_EQ(results[1].status, ValidationStatus::GREEN);
+    EXPECT_EQ(results[1].value, "00 01");
+    EXPECT_EQ(results[2].status, ValidationStatus::YELLOW);
+    EXPECT_EQ(results[3].status, ValidationStatus::RED);
+}
+
+TEST_F(ResponderSimTest, ValidateFixtureStreamsRowsAndFailsFast) {
+    std::vector<RDMParameter> params = {
+        {0x0060, "Device Info", "GET_COMMAND (0x20)", true, ""},
+        {0x7777, "Not implemented", "GET_COMMAND (0x20)", true, ""},
+        {0x00F0, "Start Address", "GET_COMMAND (0x20)", true, ""},
+    };
+    Open(SimOptions{});
+    std::vector<size_t> seen;
+    ValidationOptions opts;
+    opts.sink = [&seen](size_t i, const ValidationResult &) {
+        seen.push_back(i);
+        return true;
+    };
+    auto results = ValidateFixture(sim, kController, uids[0], params, opts);
+    EXPECT_EQ(seen, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(results.size(), 3u);
+
+    // Stops on the first mandatory failure: 0x00F0 is never requested
+    seen.clear();
+    opts.failFast = true;
+    uint64_t before = sim.Counters().requests;
+    results = ValidateFixture(sim, kController, uids[0], params, opts);
+    EXPECT_EQ(seen, (std::vector<size_t>{0, 1}));
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[1].status, ValidationStatus::RED);
+    EXPECT_EQ(sim.Counters().requests - before, 2u);
+
+    // The sink can stop the sweep as well
+    opts.failFast = false;
+    opts.sink = [](size_t, const ValidationResult &) { return false; };
+    results = ValidateFixture(sim, kController, uids[0], params, opts);
+    EXPECT_EQ(results.size(), 1u);
+}
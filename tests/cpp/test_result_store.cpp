@@ -0,0 +1,173 @@
+// tests/cpp/test_result_store.cpp
+// Unit tests for ResultStore: columns and payload arena, interned names,
+// lazily formatted values matching ClassifyResponse, copies between
+// stores, and sweeps that report only samples (no ValidationResult rows).
+#include <gtest/gtest.h>
+#include "result_store.h"
+#include "responder_sim.h"
+#include "validation_planner.h"
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+
+static RDMResponse Response(RDMResponseType type,
+                            std::vector<uint8_t> data = {},
+                            uint16_t nack = 0) {
+    RDMResponse r;
+    r.type = type;
+    r.data = std::move(data);
+    r.nackReason = nack;
+    return r;
+}
+
+static ValidationSample Sample(size_t index, const RDMParameter &param,
+                               const RDMResponse *resp) {
+    ValidationSample s;
+    s.param = index;
+    s.parameter = &param;
+    s.response = resp;
+    s.status = resp ? ClassifyStatus(param, resp->type)
+                    : ValidationStatus::GREEN;
+    s.latencyUs = 31000;
+    return s;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Rows
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ResultStore, RowsReadBackAsClassifyResponseWouldBuildThem) {
+    std::vector<RDMParameter> params = {
+        {0x0060, "Device Info", "", true, ""},
+        {0x8600, "Hue", "", false, ""},
+        {0x8601, "Saturation", "", true, ""},
+        {0x8602, "Fan", "", false, ""},
+        {0x0001, "Disc Unique Branch", "", true, ""},
+    };
+    std::vector<RDMResponse> responses = {
+        Response(RDMResponseType::ACK, {0x01, 0x00, 0xAB}),
+        Response(RDMResponseType::NACK, {}, 0x0500),
+        Response(RDMResponseType::TIMEOUT),
+        Response(RDMResponseType::ACK_TIMER),
+    };
+
+    ResultStore store;
+    for (size_t i = 0; i < responses.size(); ++i)
+        EXPECT_EQ(store.Append(0x434B00000001ULL,
+                               Sample(i, params[i], &responses[i])),
+                  i);
+    store.Append(0x434B00000001ULL, Sample(4, params[4], nullptr));
+
+    ASSERT_EQ(store.Size(), 5u);
+    for (size_t i = 0; i < responses.size(); ++i) {
+        ValidationResult expected = ClassifyResponse(params[i], responses[i]);
+        ValidationResult got = store.Result(i);
+        EXPECT_EQ(got.pid, expected.pid);
+        EXPECT_EQ(got.name, expected.name);
+        EXPECT_EQ(got.isMandatory, expected.isMandatory);
+        EXPECT_EQ(got.status, expected.status);
+        EXPECT_EQ(got.value, expected.value);
+        EXPECT_EQ(got.responseType, expected.responseType);
+        EXPECT_TRUE(store.WasSent(i));
+        EXPECT_EQ(store.LatencyUs(i), 31000u);
+    }
+    EXPECT_EQ(store.PayloadSize(0), 3u);
+    EXPECT_EQ(store.Payload(0)[2], 0xAB);
+    EXPECT_EQ(store.NackReason(1), 0x0500);
+    EXPECT_FALSE(store.WasSent(4));
+    EXPECT_EQ(store.Value(4), "(discovery)");
+    EXPECT_EQ(store.Index(4), 4);
+}
+
+TEST(ResultStore, InternsNamesAndStaysSmall) {
+    std::vector<RDMParameter> params;
+    for (uint16_t pid = 0x8600; pid < 0x8600 + 90; ++pid)
+        params.push_back({pid, "Parameter " + std::to_string(pid), "",
+                          false, ""});
+    RDMResponse ack = Response(RDMResponseType::ACK, {0x00, 0x01});
+
+    ResultStore store;
+    const size_t fixtures = 200;
+    store.Reserve(fixtures * params.size(), fixtures * params.size() * 2);
+    for (size_t f = 0; f < fixtures; ++f)
+        for (size_t i = 0; i < params.size(); ++i)
+            store.Append(0x434B00000000ULL + f, Sample(i, params[i], &ack));
+
+    EXPECT_EQ(store.Size(), fixtures * params.size());
+    EXPECT_EQ(store.NameCount(), params.size());
+    // 28 bytes of columns, 2 of payload, the names once
+    EXPECT_LT(store.MemoryBytes() / store.Size(), 40u);
+
+    // Clear() keeps the capacity and the names
+    size_t bytes = store.MemoryBytes();
+    store.Clear();
+    EXPECT_TRUE(store.Empty());
+    EXPECT_EQ(store.MemoryBytes(), bytes);
+}
+
+TEST(ResultStore, CopiesRowsBetweenStores) {
+    RDMParameter a = {0x8600, "Hue", "", true, ""};
+    RDMParameter b = {0x8601, "Saturation", "", true, ""};
+    RDMResponse ack = Response(RDMResponseType::ACK, {0x7F});
+    ResultStore src, dst;
+    src.Append(1, Sample(0, a, &ack));
+    dst.Append(2, Sample(0, b, &ack));
+    dst.Append(src, 0);
+
+    ASSERT_EQ(dst.Size(), 2u);
+    EXPECT_EQ(dst.Uid(1), 1u);
+    EXPECT_EQ(dst.Name(1), "Hue");
+    EXPECT_EQ(dst.Value(1), "7F");
+    EXPECT_EQ(dst.NameCount(), 2u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Sweeps without ValidationResult rows
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ResultStore, SweepsReportSamplesOnly) {
+    RDMParameterRow info;
+    info.pid = PID_DEVICE_INFO;
+    info.commandClass = 0x20;
+    info.payloadLength = "19 bytes";
+    RDMParameterRow list;
+    list.pid = PID_SUPPORTED_PARAMS;
+    list.commandClass = 0x20;
+    list.payloadLength = "Variable";
+    ResponderSim sim;
+    uint64_t uid = MakeSimUIDs(1, 0x1234)[0];
+    ASSERT_TRUE(sim.Open(BuildSimModel({info, list}, {}), {uid}));
+
+    std::vector<RDMParameter> params = {
+        {PID_DEVICE_INFO, "Device Info", "", true, ""},
+        {0x8700, "Unsupported", "", false, ""},
+    };
+    ResultStore store;
+    ValidationOptions opts;
+    opts.keepResults = false;
+    opts.samples = [&](const ValidationSample &s) {
+        store.Append(uid, s);
+        return true;
+    };
+
+    EXPECT_TRUE(ValidateFixture(sim, kController, uid, params, opts).empty());
+    ASSERT_EQ(store.Size(), 2u);
+    EXPECT_EQ(store.Status(0), ValidationStatus::GREEN);
+    EXPECT_EQ(store.PayloadSize(0), 19u);
+    EXPECT_EQ(store.Response(1), RDMResponseType::NACK);
+    EXPECT_TRUE(store.WasSent(1));
+
+    // Planned: the unlisted PID is decided without a request
+    store.Clear();
+    ValidationPlanner planner;
+    EXPECT_TRUE(planner
+                    .Validate(PlannerGet(sim, kController, uid), uid, params,
+                              nullptr, opts)
+                    .empty());
+    ASSERT_EQ(store.Size(), 2u);
+    EXPECT_EQ(store.Index(0), 1); // offline rows come first
+    EXPECT_FALSE(store.WasSent(0));
+    EXPECT_EQ(store.Value(0), "(not supported)");
+    EXPECT_EQ(store.Status(0), ValidationStatus::YELLOW);
+    EXPECT_EQ(store.Index(1), 0);
+}
@@ -0,0 +1,238 @@
+// tests/cpp/test_snapshot_cache.cpp
+// Unit tests for SnapshotCache: settings-hash parsing, the database of
+// each PID from the map, unchanged fixtures answered from the snapshot
+// with one GET, per-database re-reads, and the cases that fall back to a
+// full sweep.  GETs go to an in-memory fake or to ResponderSim.
+#include <gtest/gtest.h>
+#include "fake_fixture.h"
+#include "fleet_validator.h"
+#include "responder_sim.h"
+#include "snapshot_cache.h"
+#include <algorithm>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+static const uint64_t kCKUID = 0x434B00000001ULL;
+static const uint16_t kHash = 0x803A;
+
+static void SetHash(FakeFixture &fx, uint16_t mfg, uint16_t settings) {
+    fx.Ack(kHash, {0, 0, static_cast<uint8_t>(mfg >> 8),
+                   static_cast<uint8_t>(mfg), 0, 0,
+                   static_cast<uint8_t>(settings >> 8),
+                   static_cast<uint8_t>(settings)});
+}
+
+static RDMParameterRow Row(uint16_t pid, uint8_t cc, bool locked) {
+    RDMParameterRow r;
+    r.pid = pid;
+    r.commandClass = cc;
+    r.lockedAccess = locked;
+    return r;
+}
+
+// 0x0060 read-only, 0x00F0 a setting, 0x8060 manufacturing data
+static std::vector<RDMParameterRow> MapRows() {
+    return {Row(0x0060, 0x20, true), Row(0x00F0, 0x20, true),
+            Row(0x00F0, 0x30, true), Row(0x8060, 0x20, true),
+            Row(0x8060, 0x30, false)};
+}
+
+static std::vector<RDMParameter> Params() {
+    return {{0x0060, "Device Info", "", true, ""},
+            {0x00F0, "Start Address", "", true, ""},
+            {0x8060, "Serial", "", false, ""}};
+}
+
+static std::vector<uint16_t> Sorted(std::vector<uint16_t> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Hash and databases
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(SnapshotCache, ParsesTheSettingsHash) {
+    SettingsHash h;
+    EXPECT_FALSE(ParseSettingsHash({0, 0, 1}, h));
+    ASSERT_TRUE(ParseSettingsHash({0, 0, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC},
+                                  h));
+    EXPECT_EQ(h.mfg, 0x1234);
+    EXPECT_EQ(h.mbr, 0x5678);
+    EXPECT_EQ(h.settings, 0x9ABC);
+}
+
+TEST(SnapshotCache, AssignsDatabasesFromTheMap) {
+    auto rows = MapRows();
+    rows.push_back(Row(PID_IDENTIFY_DEVICE, 0x30, true));
+    SettingsDbMap dbs = SettingsDatabases(rows);
+    EXPECT_EQ(dbs.count(0x0060), 0u);
+    EXPECT_EQ(dbs.at(0x00F0), SettingsDb::SETTINGS);
+    EXPECT_EQ(dbs.at(0x8060), SettingsDb::MFG);
+    EXPECT_EQ(dbs.count(PID_IDENTIFY_DEVICE), 0u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Re-validation
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(SnapshotCache, UnchangedFixtureCostsOneGet) {
+    FakeFixture fx;
+    SetHash(fx, 0x1111, 0x2222);
+    fx.Ack(0x0060, std::vector<uint8_t>(19, 0));
+    fx.Ack(0x00F0, {0x00, 0x01});
+    fx.Ack(0x8060, {1, 2, 3, 4, 5, 6});
+    SnapshotCache cache;
+    cache.SetDatabases(SettingsDatabases(MapRows()));
+    auto params = Params();
+
+    SnapshotStats st;
+    auto first = cache.Validate(fx.Get(), kCKUID, params, nullptr, {}, &st);
+    EXPECT_FALSE(st.hit);
+    EXPECT_EQ(st.requests, 4);
+    EXPECT_TRUE(cache.Has(kCKUID));
+
+    fx.requests.clear();
+    std::vector<size_t> seen;
+    ValidationOptions opts;
+    opts.sink = [&seen](size_t i, const ValidationResult &) {
+        seen.push_back(i);
+        return true;
+    };
+    auto again = cache.Validate(fx.Get(), kCKUID, params, nullptr, opts, &st);
+    EXPECT_TRUE(st.hit);
+    EXPECT_EQ(st.cached, 3);
+    EXPECT_EQ(fx.requests, (std::vector<uint16_t>{kHash}));
+    EXPECT_EQ(seen, (std::vector<size_t>{0, 1, 2}));
+    ASSERT_EQ(again.size(), first.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(again[i].status, first[i].status);
+        EXPECT_EQ(again[i].value, first[i].value);
+    }
+}
+
+TEST(SnapshotCache, ReReadsOnlyTheChangedDatabase) {
+    FakeFixture fx;
+    SetHash(fx, 0x1111, 0x2222);
+    fx.Ack(0x0060, std::vector<uint8_t>(19, 0));
+    fx.Ack(0x00F0, {0x00, 0x01});
+    fx.Ack(0x8060, {1, 2, 3, 4, 5, 6});
+    SnapshotCache cache;
+    cache.SetDatabases(SettingsDatabases(MapRows()));
+    auto params = Params();
+    cache.Validate(fx.Get(), kCKUID, params);
+
+    // Settings changed: the setting and the read-only PID
+    SetHash(fx, 0x1111, 0x3333);
+    fx.Ack(0x00F0, {0x00, 0x05});
+    fx.requests.clear();
+    SnapshotStats st;
+    auto results = cache.Validate(fx.Get(), kCKUID, params, nullptr, {}, &st);
+    EXPECT_TRUE(st.settingsChanged);
+    EXPECT_FALSE(st.mfgChanged);
+    EXPECT_EQ(Sorted(fx.requests),
+              (std::vector<uint16_t>{0x0060, 0x00F0, kHash}));
+    EXPECT_EQ(results[1].value, "00 05");
+
+    // Manufacturing data changed
+    SetHash(fx, 0x4444, 0x3333);
+    fx.requests.clear();
+    cache.Validate(fx.Get(), kCKUID, params, nullptr, {}, &st);
+    EXPECT_EQ(Sorted(fx.requests),
+              (std::vector<uint16_t>{0x0060, kHash, 0x8060}));
+    EXPECT_EQ(st.cached, 1);
+}
+
+TEST(SnapshotCache, AsksUnansweredRowsAgain) {
+    FakeFixture fx;
+    SetHash(fx, 1, 2);
+    fx.Ack(0x0060, std::vector<uint8_t>(19, 0));
+    fx.Ack(0x00F0, {0x00, 0x01}); // 0x8060 times out
+    SnapshotCache cache;
+    auto params = Params();
+    cache.Validate(fx.Get(), kCKUID, params);
+
+    fx.requests.clear();
+    auto results = cache.Validate(fx.Get(), kCKUID, params);
+    EXPECT_EQ(fx.requests, (std::vector<uint16_t>{kHash, 0x8060}));
+    EXPECT_EQ(results[2].value, "TIMEOUT");
+}
+
+TEST(SnapshotCache, FallsBackToFullSweeps) {
+    FakeFixture fx;
+    fx.Ack(0x0060, std::vector<uint8_t>(19, 0));
+    SnapshotCache cache;
+    auto params = Params();
+
+    // No hash: nothing is kept
+    cache.Validate(fx.Get(), kCKUID, params);
+    EXPECT_FALSE(cache.Has(kCKUID));
+
+    // Not a CK fixture: 0x803A is not asked
+    SetHash(fx, 1, 2);
+    fx.requests.clear();
+    cache.Validate(fx.Get(), 0x123400000001ULL, params);
+    EXPECT_EQ(std::count(fx.requests.begin(), fx.requests.end(), kHash), 0);
+    EXPECT_EQ(cache.Size(), 0u);
+
+    // A stopped sweep is not kept; another parameter list is not reused
+    ValidationOptions opts;
+    opts.failFast = true; // 0x00F0 is mandatory and times out
+    cache.Validate(fx.Get(), kCKUID, params, nullptr, opts);
+    EXPECT_FALSE(cache.Has(kCKUID));
+    cache.Validate(fx.Get(), kCKUID, params);
+    params.pop_back();
+    SnapshotStats st;
+    cache.Validate(fx.Get(), kCKUID, params, nullptr, {}, &st);
+    EXPECT_FALSE(st.hit);
+    EXPECT_EQ(st.requests, 3);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated fleet
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(SnapshotCache, ReTestPassOverASimulatedFleet) {
+    auto rows = MapRows();
+    rows[0].payloadLength = "19 bytes";
+    rows[1].payloadLength = rows[2].payloadLength = "2 byte";
+    rows[1].minValue = rows[2].minValue = "0x0001";
+    rows[1].maxValue = rows[2].maxValue = "0x0200";
+    rows[1].fwDefault = "0x0001";
+    rows[3].payloadLength = rows[4].payloadLength = "6 byte";
+    PIDAttribute hash;
+    hash.pid = kHash;
+    hash.canGet = true;
+    hash.size = 8;
+    ResponderSim sim;
+    std::vector<uint64_t> uids = MakeSimUIDs(4, 0x434B);
+    ASSERT_TRUE(sim.Open(BuildSimModel(rows, {hash}), uids));
+
+    SnapshotCache cache;
+    cache.SetDatabases(SettingsDatabases(rows));
+    ValidationPlanner planner;
+    FleetValidator fleet;
+    fleet.AddPort(sim, kController, Params(), uids, &planner, &cache);
+    ASSERT_TRUE(fleet.Start(nullptr));
+    fleet.Wait();
+    EXPECT_EQ(cache.Size(), 4u);
+
+    ASSERT_TRUE(sim.SetValue(uids[2], 0x00F0, {0x00, 0x07}));
+    uint64_t before = sim.Counters().requests;
+    std::vector<FleetFixtureResult> results;
+    std::mutex mutex;
+    ASSERT_TRUE(fleet.Start([&](FleetFixtureResult &&r) {
+        std::lock_guard<std::mutex> lk(mutex);
+        results.push_back(std::move(r));
+    }));
+    fleet.Wait();
+
+    // One GET per unchanged fixture; the changed one re-reads two PIDs
+    EXPECT_EQ(sim.Counters().requests - before, 4u + 2u);
+    ASSERT_EQ(results.size(), 4u);
+    for (const auto &r : results) {
+        EXPECT_EQ(r.cached, r.uid == uids[2] ? 1 : 3);
+        ASSERT_EQ(r.results.size(), 3u);
+        EXPECT_EQ(r.results[1].value, r.uid == uids[2] ? "00 07" : "00 01");
+    }
+}
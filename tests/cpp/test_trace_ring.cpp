@@ -0,0 +1,165 @@
+// tests/cpp/test_trace_ring.cpp
+// Unit tests for: MpscRing, Tracer (recording, level filter, deferred
+// formatting)
+#include <gtest/gtest.h>
+#include "mpsc_ring.h"
+#include "trace_ring.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::vector<std::string> DrainText(Tracer &t) {
+    std::vector<std::string> out;
+    t.Drain([&](const TraceEvent &e) { out.push_back(Tracer::Format(e)); });
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MpscRing
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(MpscRing, FifoAndFull) {
+    MpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(ring.Emplace([i](int &v) { v = i; }));
+    EXPECT_FALSE(ring.Emplace([](int &v) { v = 99; }));
+    for (int i = 0; i < 4; ++i) {
+        int got = -1;
+        EXPECT_TRUE(ring.Consume([&](const int &v) { got = v; }));
+        EXPECT_EQ(got, i);
+    }
+    EXPECT_FALSE(ring.Consume([](const int &) {}));
+}
+
+TEST(MpscRing, ConcurrentProducersLoseNothingWhenDrained) {
+    MpscRing<uint64_t, 1024> ring;
+    constexpr int kThreads = 4, kPerThread = 20000;
+    std::atomic<bool> done{false};
+    std::vector<int> seen(kThreads, 0);
+    bool ordered = true;
+
+    std::thread consumer([&] {
+        std::vector<int> next(kThreads, 0);
+        int total = 0;
+        while (total < kThreads * kPerThread) {
+            ring.Consume([&](const uint64_t &v) {
+                int t = static_cast<int>(v >> 32);
+                int n = static_cast<int>(v & 0xFFFFFFFF);
+                if (n != next[t]) ordered = false; // per-producer FIFO
+                next[t] = n + 1;
+                ++seen[t];
+                ++total;
+            });
+        }
+        done = true;
+    });
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&, t] {
+            for (int n = 0; n < kPerThread; ++n) {
+                uint64_t v = (uint64_t(t) << 32) | uint32_t(n);
+                while (!ring.Emplace([v](uint64_t &slot) { slot = v; }))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto &p : producers) p.join();
+    consumer.join();
+
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(ordered);
+    for (int t = 0; t < kThreads; ++t)
+        EXPECT_EQ(seen[t], kPerThread);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Tracer
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(Tracer, FormatsIntegersWithWidthAndHex) {
+    Tracer t;
+    uint8_t status = 0x0A;
+    int64_t lat = 1234;
+    t.Text(TraceLevel::DEBUG, "len=%d st=0x%02X lat=%lldus\n", 26, status, lat);
+    auto out = DrainText(t);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], "len=26 st=0x0A lat=1234us\n");
+}
+
+TEST(Tracer, StringArgumentsAreCopied) {
+    Tracer t;
+    {
+        std::string tmp = "GET";
+        t.Text(TraceLevel::DEBUG, "%s PID 0x%04X", tmp.c_str(), 0x60);
+        tmp = "XXX"; // producer's buffer changes after recording
+    }
+    auto out = DrainText(t);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0], "GET PID 0x0060");
+}
+
+TEST(Tracer, UidMacroRendersLikeUIDToString) {
+    Tracer t;
+    uint64_t uid = 0x434B00001234ULL;
+    t.Text(TraceLevel::DEBUG, "uid %04X:%08X", TRACE_UID(uid));
+    EXPECT_EQ(DrainText(t)[0], "uid 434B:00001234");
+}
+
+TEST(Tracer, PercentAndMissingArgs) {
+    Tracer t;
+    t.Text(TraceLevel::DEBUG, "100%% done %d %d", 7);
+    EXPECT_EQ(DrainText(t)[0], "100% done 7 ");
+}
+
+TEST(Tracer, FrameFormatsAsHexAndTruncates) {
+    Tracer t;
+    t.SetLevel(TraceLevel::FRAME);
+    std::vector<uint8_t> frame(300);
+    for (size_t i = 0; i < frame.size(); ++i)
+        frame[i] = static_cast<uint8_t>(i);
+    t.Frame(TraceLevel::FRAME, true, frame.data(), (int)frame.size());
+
+    int events = 0;
+    t.Drain([&](const TraceEvent &e) {
+        ++events;
+        EXPECT_EQ(e.kind, TraceKind::FRAME_TX);
+        EXPECT_EQ(e.frameLen, 300);
+        std::string hex = Tracer::Format(e, 4);
+        EXPECT_EQ(hex, "00 01 02 03 ...");
+    });
+    EXPECT_EQ(events, 1);
+}
+
+TEST(Tracer, LevelFilter) {
+    Tracer t;
+    t.SetLevel(TraceLevel::INFO);
+    EXPECT_TRUE(t.Enabled(TraceLevel::ERR));
+    EXPECT_TRUE(t.Enabled(TraceLevel::INFO));
+    EXPECT_FALSE(t.Enabled(TraceLevel::DEBUG));
+    EXPECT_FALSE(t.Enabled(TraceLevel::FRAME));
+    t.SetLevel(TraceLevel::OFF);
+    EXPECT_FALSE(t.Enabled(TraceLevel::ERR));
+}
+
+TEST(Tracer, DisabledMacroDoesNotEvaluateArguments) {
+    TraceLevel saved = GlobalTracer().GetLevel();
+    GlobalTracer().SetLevel(TraceLevel::INFO);
+    int calls = 0;
+    auto expensive = [&] { ++calls; return 1; };
+    TRACE_DEBUG("x=%d", expensive());
+    EXPECT_EQ(calls, 0);
+    TRACE_INFO("x=%d", expensive());
+    EXPECT_EQ(calls, 1);
+    GlobalTracer().Drain([](const TraceEvent &) {});
+    GlobalTracer().SetLevel(saved);
+}
+
+TEST(Tracer, FullRingDropsAndCounts) {
+    Tracer t;
+    for (size_t i = 0; i < Tracer::kCapacity + 10; ++i)
+        t.Text(TraceLevel::DEBUG, "n=%d", (int)i);
+    EXPECT_EQ(t.Dropped(), 10u);
+    EXPECT_EQ(DrainText(t).size(), Tracer::kCapacity);
+}
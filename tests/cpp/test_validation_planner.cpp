@@ -0,0 +1,233 @@
+// tests/cpp/test_validation_planner.cpp
+// Unit tests for ValidationPlanner: supported-list probing (0x0050 and the
+// CK 0x8050 / 0x8051 pages), offline classification of unlisted
+// parameters, cost-ordered requests and the learned cost model.  GETs go
+// to an in-memory fake or to ResponderSim; nothing is opened.
+#include <gtest/gtest.h>
+#include "validation_planner.h"
+#include "fake_fixture.h"
+#include "responder_sim.h"
+#include <algorithm>
+#include <vector>
+
+static const uint64_t kController = 0x7FF000000001ULL;
+static const uint64_t kOtherUID = 0x123400000001ULL;
+static const uint64_t kCKUID = 0x434B00000001ULL;
+
+static std::vector<uint8_t> PidList(std::vector<uint16_t> pids) {
+    std::vector<uint8_t> out;
+    for (uint16_t p : pids) {
+        out.push_back(static_cast<uint8_t>(p >> 8));
+        out.push_back(static_cast<uint8_t>(p));
+    }
+    return out;
+}
+
+static RDMParameter Param(uint16_t pid, bool mandatory) {
+    RDMParameter p;
+    p.pid = pid;
+    p.name = "PID";
+    p.isMandatory = mandatory;
+    return p;
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Planning
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ValidationPlanner, UnlistedParametersAreClassifiedWithoutTraffic) {
+    FakeFixture fx;
+    fx.Ack(PID_SUPPORTED_PARAMS, PidList({0x8600}));
+    fx.Ack(PID_DEVICE_INFO, std::vector<uint8_t>(19, 0));
+    fx.Ack(0x8600, {0x01});
+    std::vector<RDMParameter> params = {
+        Param(0x0001, true),          // discovery: no request
+        Param(PID_DEVICE_INFO, true), // E1.20 minimum set: never listed
+        Param(0x8600, true),
+        Param(0x8700, true),          // mandatory, not supported
+        Param(0x8701, false),         // optional, not supported
+    };
+
+    ValidationPlanner planner;
+    ValidationPlan plan;
+    auto results = planner.Validate(fx.Get(), kOtherUID, params, &plan);
+
+    EXPECT_TRUE(plan.haveSupported);
+    EXPECT_FALSE(plan.haveAvailable);
+    EXPECT_EQ(plan.gets.size(), 2u);
+    EXPECT_EQ(plan.missing, (std::vector<size_t>{3, 4}));
+    EXPECT_EQ(fx.Count(0x8700), 0);
+    EXPECT_EQ(fx.Count(0x8701), 0);
+    EXPECT_EQ(fx.requests.size(), 3u); // 0x0050, 0x0060, 0x8600
+
+    ASSERT_EQ(results.size(), params.size());
+    for (size_t i = 0; i < params.size(); ++i)
+        EXPECT_EQ(results[i].pid, params[i].pid);
+    EXPECT_EQ(results[0].status, ValidationStatus::GREEN);
+    EXPECT_EQ(results[1].status, ValidationStatus::GREEN);
+    EXPECT_EQ(results[2].value, "01");
+    EXPECT_EQ(results[3].status, ValidationStatus::RED);
+    EXPECT_EQ(results[3].value, "(not supported)");
+    EXPECT_EQ(results[4].status, ValidationStatus::YELLOW);
+}
+
+TEST(ValidationPlanner, BlindSweepWhenSupportedParametersFails) {
+    FakeFixture fx; // answers nothing
+    std::vector<RDMParameter> params = {Param(0x0060, true),
+                                        Param(0x8600, false)};
+    ValidationPlanner planner;
+    ValidationPlan plan;
+    auto results = planner.Validate(fx.Get(), kOtherUID, params, &plan);
+
+    EXPECT_FALSE(plan.haveSupported);
+    EXPECT_TRUE(plan.missing.empty());
+    EXPECT_EQ(plan.gets.size(), 2u);
+    EXPECT_EQ(fx.Count(0x0060), 1);
+    EXPECT_EQ(fx.Count(0x8600), 1);
+    EXPECT_EQ(results[0].status, ValidationStatus::RED);
+    EXPECT_EQ(results[1].status, ValidationStatus::YELLOW);
+}
+
+TEST(ValidationPlanner, MergesTheCKAvailableParameterList) {
+    FakeFixture fx;
+    fx.Ack(PID_SUPPORTED_PARAMS, PidList({0x8600}));
+    fx.Ack(0x8050, {0x00, 0x12}); // 18 opcodes: two pages
+    fx.Ack(0x8051, PidList({0x9000, 0x9001}));
+    std::vector<RDMParameter> params = {Param(0x9001, true),
+                                        Param(0x9002, true)};
+
+    ValidationPlanner planner;
+    ValidationPlan plan = planner.Plan(fx.Get(), kCKUID, params);
+    EXPECT_TRUE(plan.haveAvailable);
+    EXPECT_EQ(fx.Count(0x8051), 2);
+    EXPECT_EQ(fx.paramData[2], (std::vector<uint8_t>{0x00, 0x00}));
+    EXPECT_EQ(fx.paramData[3], (std::vector<uint8_t>{0x00, 0x10}));
+    EXPECT_EQ(plan.supported,
+              (std::vector<uint16_t>{0x8600, 0x9000, 0x9001}));
+    ASSERT_EQ(plan.gets.size(), 1u);
+    EXPECT_EQ(plan.gets[0].pid, 0x9001);
+    EXPECT_EQ(plan.missing, (std::vector<size_t>{1}));
+
+    // Other manufacturers are not asked for the CK list
+    FakeFixture other = fx;
+    other.requests.clear();
+    planner.Plan(other.Get(), kOtherUID, params);
+    EXPECT_EQ(other.Count(0x8050), 0);
+}
+
+TEST(ValidationPlanner, SinkSeesOfflineRowsFirstAndFailFastSkipsGets) {
+    FakeFixture fx;
+    fx.Ack(PID_SUPPORTED_PARAMS, PidList({0x8600}));
+    fx.Ack(PID_DEVICE_INFO, std::vector<uint8_t>(19, 0));
+    fx.Ack(0x8600, {0x01});
+    std::vector<RDMParameter> params = {
+        Param(PID_DEVICE_INFO, true), Param(0x8600, true),
+        Param(0x8700, true), // mandatory, not supported
+        Param(0x0001, true)};
+
+    std::vector<size_t> seen;
+    ValidationOptions opts;
+    opts.sink = [&seen](size_t i, const ValidationResult &) {
+        seen.push_back(i);
+        return true;
+    };
+    ValidationPlanner planner;
+    auto results = planner.Validate(fx.Get(), kOtherUID, params, nullptr,
+                                    opts);
+    ASSERT_EQ(seen.size(), 4u);
+    EXPECT_EQ(seen[0], 3u); // discovery
+    EXPECT_EQ(seen[1], 2u); // unsupported
+    EXPECT_EQ(results.size(), 4u);
+
+    // The unsupported mandatory PID fails before any GET is sent
+    fx.requests.clear();
+    seen.clear();
+    opts.failFast = true;
+    results = planner.Validate(fx.Get(), kOtherUID, params, nullptr, opts);
+    EXPECT_EQ(seen, (std::vector<size_t>{3, 2}));
+    EXPECT_EQ(fx.requests, (std::vector<uint16_t>{PID_SUPPORTED_PARAMS}));
+    ASSERT_EQ(results.size(), 2u); // reached rows, in `params` order
+    EXPECT_EQ(results[0].pid, 0x8700);
+    EXPECT_EQ(results[0].status, ValidationStatus::RED);
+    EXPECT_EQ(results[1].pid, 0x0001);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Cost model
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ValidationPlanner, DefaultCostsFollowTheListing) {
+    PlanCosts costs;
+    ValidationPlanner planner(costs);
+    EXPECT_EQ(planner.ExpectedUs(0x8600, true), costs.ackUs);
+    EXPECT_EQ(planner.ExpectedUs(0x8600, false),
+              (costs.ackUs + costs.timeoutUs) / 2);
+}
+
+TEST(ValidationPlanner, LearnsCostsAndOrdersCheapestFirst) {
+    ValidationPlanner planner;
+    for (int i = 0; i < 4; ++i) {
+        planner.Observe(0x8600, RDMResponseType::ACK, 200000); // slow ACK
+        planner.Observe(0x8601, RDMResponseType::ACK, 10000);
+        planner.Observe(0x8602, RDMResponseType::TIMEOUT, 520000);
+    }
+    EXPECT_EQ(planner.ExpectedUs(0x8601, true), 10000);
+    EXPECT_GT(planner.ExpectedUs(0x8602, true), 400000);
+
+    FakeFixture fx;
+    fx.Ack(PID_SUPPORTED_PARAMS, PidList({0x8600, 0x8601, 0x8602}));
+    std::vector<RDMParameter> params = {
+        Param(0x8602, true), Param(0x8600, true), Param(0x8601, true)};
+    ValidationPlan plan = planner.Plan(fx.Get(), kOtherUID, params);
+    ASSERT_EQ(plan.gets.size(), 3u);
+    EXPECT_EQ(plan.gets[0].pid, 0x8601);
+    EXPECT_EQ(plan.gets[1].pid, 0x8600);
+    EXPECT_EQ(plan.gets[2].pid, 0x8602);
+    int64_t sum = 0;
+    for (const auto &g : plan.gets)
+        sum += g.expectedUs;
+    EXPECT_EQ(plan.predictedUs, sum);
+
+    planner.ResetCosts();
+    EXPECT_EQ(planner.ExpectedUs(0x8602, true), planner.Costs().ackUs);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Simulated fixture
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(ValidationPlanner, SparseSimulatedFixtureSkipsUnsupportedPids) {
+    RDMParameterRow info;
+    info.pid = PID_DEVICE_INFO;
+    info.commandClass = 0x20;
+    info.payloadLength = "19 bytes";
+    RDMParameterRow hue;
+    hue.pid = 0x8600;
+    hue.commandClass = 0x20;
+    hue.payloadLength = "1 byte";
+    hue.inSupportedParams = "Yes";
+    RDMParameterRow list;
+    list.pid = PID_SUPPORTED_PARAMS;
+    list.commandClass = 0x20;
+    list.payloadLength = "Variable";
+    auto model = BuildSimModel({info, hue, list}, {});
+    ResponderSim sim;
+    uint64_t uid = MakeSimUIDs(1, 0x1234)[0];
+    ASSERT_TRUE(sim.Open(model, {uid}));
+
+    std::vector<RDMParameter> params = {Param(PID_DEVICE_INFO, true),
+                                        Param(0x8600, true)};
+    for (uint16_t pid = 0x8700; pid < 0x8708; ++pid)
+        params.push_back(Param(pid, false));
+
+    ValidationPlanner planner;
+    ValidationPlan plan;
+    auto results = planner.Validate(PlannerGet(sim, kController, uid), uid,
+                                    params, &plan);
+    EXPECT_EQ(plan.missing.size(), 8u);
+    EXPECT_EQ(sim.Counters().requests, 3u); // list + two listed PIDs
+    EXPECT_EQ(results[0].status, ValidationStatus::GREEN);
+    EXPECT_EQ(results[1].status, ValidationStatus::GREEN);
+    for (size_t i = 2; i < results.size(); ++i)
+        EXPECT_EQ(results[i].status, ValidationStatus::YELLOW);
+}
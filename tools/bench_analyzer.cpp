@@ -0,0 +1,213 @@
+// ────────────────────────────────────────────────────────────────────────
+// bench_analyzer — rdm_simd kernels and the capture analyzer against the
+// scalar code in rdm.cpp
+// ────────────────────────────────────────────────────────────────────────
+//    bench_analyzer [packets]   (default 1,000,000)
+//
+//    Builds a synthetic traffic set (GET / SET requests with 0-64 byte
+//    parameter data, their responses and DISC_UNIQUE_BRANCH replies) and
+//    times each kernel at every SIMD level the CPU supports.
+#include "capture_analyzer.h"
+#include "capture_file.h"
+#include "rdm.h"
+#include "rdm_simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct Workload {
+  std::vector<uint8_t> storage;
+  std::vector<const uint8_t *> packets;
+  std::vector<int> lens;
+  std::vector<uint8_t> dub; // 24-byte DUB replies, back to back
+  size_t bytes = 0;
+};
+
+static Workload BuildWorkload(int count) {
+  std::mt19937 rng(1234);
+  Workload w;
+  std::vector<size_t> offsets;
+  uint8_t pd[64];
+  for (int i = 0; i < count; ++i) {
+    uint8_t pdl = static_cast<uint8_t>(rng() % 65);
+    for (int k = 0; k < pdl; ++k)
+      pd[k] = static_cast<uint8_t>(rng());
+    uint64_t uid = 0x4C4500000000ULL | (rng() % 500);
+    auto pkt = BuildRDMPacket(uid, 0x454E00000001ULL, uint8_t(i), 1, 0, 0,
+                              i & 1 ? RDM_CC_GET_RSP : RDM_CC_GET,
+                              static_cast<uint16_t>(0x8000 + rng() % 64),
+                              pd, pdl);
+    offsets.push_back(w.storage.size());
+    w.lens.push_back(static_cast<int>(pkt.size()));
+    w.storage.insert(w.storage.end(), pkt.begin(), pkt.end());
+    w.bytes += pkt.size();
+  }
+  for (size_t off : offsets)
+    w.packets.push_back(w.storage.data() + off);
+
+  for (int i = 0; i < count / 4; ++i) {
+    uint64_t uid = 0x4C4500000000ULL | rng();
+    uint8_t reply[24];
+    memset(reply, 0xFE, 7);
+    reply[7] = 0xAA;
+    uint16_t sum = 0;
+    for (int b = 0; b < 6; ++b) {
+      uint8_t v = static_cast<uint8_t>(uid >> ((5 - b) * 8));
+      reply[8 + b * 2] = v | 0xAA;
+      reply[9 + b * 2] = v | 0x55;
+      sum += reply[8 + b * 2] + reply[9 + b * 2];
+    }
+    reply[20] = (sum >> 8) | 0xAA;
+    reply[21] = (sum >> 8) | 0x55;
+    reply[22] = (sum & 0xFF) | 0xAA;
+    reply[23] = (sum & 0xFF) | 0x55;
+    w.dub.insert(w.dub.end(), reply, reply + sizeof(reply));
+  }
+  return w;
+}
+
+// Capture image of the workload: each packet as an Enttec request or
+// Label 5 response.  No footer; the reader indexes it with one scan.
+static std::vector<uint8_t> BuildCapture(const Workload &w) {
+  std::vector<uint8_t> out(sizeof(CaptureFileHeader), 0);
+  CaptureFileHeader h = {};
+  memcpy(h.magic, kCaptureMagic, sizeof(h.magic));
+  h.version = kCaptureVersion;
+  h.headerSize = sizeof(CaptureFileHeader);
+  memcpy(out.data(), &h, sizeof(h));
+  for (size_t i = 0; i < w.packets.size(); ++i) {
+    bool rx = w.packets[i][20] == RDM_CC_GET_RSP;
+    CaptureRecordHeader r = {};
+    r.timestampUs = static_cast<int64_t>(i) * 1500;
+    r.length = static_cast<uint16_t>(w.lens[i] + (rx ? 1 : 0));
+    r.direction = static_cast<uint8_t>(rx ? CaptureDirection::RX
+                                          : CaptureDirection::TX);
+    r.label = rx ? 5 : 7; // Enttec RX / TX RDM
+    const uint8_t *rh = reinterpret_cast<const uint8_t *>(&r);
+    out.insert(out.end(), rh, rh + sizeof(r));
+    if (rx)
+      out.push_back(0); // widget status byte
+    out.insert(out.end(), w.packets[i], w.packets[i] + w.lens[i]);
+    out.resize((out.size() + 7) & ~size_t(7), 0);
+  }
+  return out;
+}
+
+static double Seconds(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void Report(const char *name, const char *level, double seconds,
+                   size_t items, size_t bytes, double baseline) {
+  printf("%-22s %-7s %9.2f ns/item %8.2f GB/s", name, level,
+         seconds * 1e9 / items, bytes / seconds / 1e9);
+  if (baseline > 0)
+    printf("  x%.2f", baseline / seconds);
+  printf("\n");
+}
+
+static volatile uint64_t g_sink; // keeps results alive
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 1000000;
+  if (count <= 0)
+    count = 1000000;
+  Workload w = BuildWorkload(count);
+  SimdLevel best = DetectSimdLevel();
+  printf("%d packets, %.1f MB, best SIMD level %s\n\n", count,
+         w.bytes / 1e6, SimdLevelName(best));
+
+  // ── Checksum verification ──
+  auto t0 = Clock::now();
+  uint64_t good = 0;
+  for (int i = 0; i < count; ++i) {
+    const uint8_t *p = w.packets[i];
+    int body = w.lens[i] - 2;
+    good += RDMChecksum(p, body) == ((p[body] << 8) | p[body + 1]);
+  }
+  double baseline = Seconds(t0);
+  g_sink = good;
+  Report("checksum (rdm.cpp)", "scalar", baseline, count, w.bytes, 0);
+
+  std::vector<uint8_t> ok(CaptureAnalyzer::kBatch);
+  for (int level = 0; level <= static_cast<int>(best); ++level) {
+    SetSimdLevel(static_cast<SimdLevel>(level));
+    t0 = Clock::now();
+    good = 0;
+    for (int i = 0; i < count; i += CaptureAnalyzer::kBatch) {
+      int n = std::min(CaptureAnalyzer::kBatch, count - i);
+      good += VerifyRDMChecksums(&w.packets[i], &w.lens[i], n, ok.data());
+    }
+    g_sink = good;
+    Report("checksum batch", SimdLevelName(ActiveSimdLevel()), Seconds(t0),
+           count, w.bytes, baseline);
+  }
+
+  // ── DUB decoding ──
+  size_t replies = w.dub.size() / 24;
+  double dubBaseline = 0;
+  for (int level = 0; level <= static_cast<int>(best); ++level) {
+    SetSimdLevel(static_cast<SimdLevel>(level));
+    t0 = Clock::now();
+    uint64_t acc = 0;
+    for (size_t i = 0; i < replies; ++i) {
+      uint64_t uid = 0;
+      bool valid = false;
+      DecodeDubReply(&w.dub[i * 24], 24, &uid, &valid);
+      acc += uid + valid;
+    }
+    g_sink = acc;
+    double s = Seconds(t0);
+    if (level == 0)
+      dubBaseline = s;
+    Report("dub decode", SimdLevelName(ActiveSimdLevel()), s, replies,
+           w.dub.size(), level == 0 ? 0 : dubBaseline);
+  }
+
+  // ── Header extraction ──
+  std::vector<RdmHeaderFields> headers(CaptureAnalyzer::kBatch);
+  double hdrBaseline = 0;
+  for (int level = 0; level <= static_cast<int>(best); ++level) {
+    SetSimdLevel(static_cast<SimdLevel>(level));
+    t0 = Clock::now();
+    uint64_t acc = 0;
+    for (int i = 0; i < count; i += CaptureAnalyzer::kBatch) {
+      int n = std::min(CaptureAnalyzer::kBatch, count - i);
+      ExtractRDMHeaders(&w.packets[i], n, headers.data());
+      acc += headers[0].destUID ^ headers[n - 1].pid;
+    }
+    g_sink = acc;
+    double s = Seconds(t0);
+    if (level == 0)
+      hdrBaseline = s;
+    Report("header extract", SimdLevelName(ActiveSimdLevel()), s, count,
+           size_t(count) * 24, level == 0 ? 0 : hdrBaseline);
+  }
+
+  // ── Whole analyzer over an in-memory capture ──
+  std::vector<uint8_t> image = BuildCapture(w);
+  printf("\n");
+  double fullBaseline = 0;
+  for (int level = 0; level <= static_cast<int>(best); ++level) {
+    SetSimdLevel(static_cast<SimdLevel>(level));
+    CaptureReader reader;
+    reader.Load(image);
+    t0 = Clock::now();
+    CaptureAnalyzer analyzer;
+    analyzer.Analyze(reader);
+    double s = Seconds(t0);
+    if (level == 0)
+      fullBaseline = s;
+    g_sink = analyzer.Totals().rdmResponses;
+    Report("analyzer end-to-end", SimdLevelName(ActiveSimdLevel()), s, count,
+           image.size(), level == 0 ? 0 : fullBaseline);
+  }
+  return 0;
+}
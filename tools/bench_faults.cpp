@@ -0,0 +1,283 @@
+// ────────────────────────────────────────────────────────────────────────
+// bench_faults — RDM throughput and discovery under injected bus faults
+// ────────────────────────────────────────────────────────────────────────
+//    bench_faults [--kind mixed|drop|flip|truncate|collision|stale|late]
+//                 [fixtures] [transactions] [trials]
+//                 (defaults: mixed, 16 fixtures, 200 GETs, 1 trial)
+//
+//    Runs RDMDiscovery and a round of GET DEVICE_INFO through a
+//    FaultInjector wrapped around a simulated bus, at rising fault rates.
+//    Reports effective transactions per second (ACKs carrying the right
+//    parameter data), corrupt responses the stack accepted as ACK, and
+//    discovery completeness / phantom UIDs.  The stack's own pauses
+//    (PERF_SLEEP) run for real, so the numbers are comparable to a bus.
+#include "fault_injector.h"
+#include "rdm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static const uint64_t kController = 0x454E00000001ULL;
+
+// ── Simulated bus ───────────────────────────────────────────────────────
+//    Responders answer DISC_UNIQUE_BRANCH (overlapping replies are ANDed,
+//    as on a dominant-low line), DISC_MUTE / UN_MUTE and GET DEVICE_INFO.
+class SimBus {
+public:
+  explicit SimBus(const std::vector<uint64_t> &uids) : m_uids(uids) {}
+
+  bool IsOpen() const { return true; }
+  std::string GetFirmwareString() const { return "SimBus"; }
+  uint32_t GetSerialNumber() const { return 0; }
+  bool SendDMX(const uint8_t *, int) { return true; }
+  uint8_t NextTransNum() { return m_transNum++; }
+  int MetricsPort() const { return 0; }
+  void Purge() { m_rx.clear(); }
+
+  static std::vector<uint8_t> DeviceInfo(uint64_t uid) {
+    std::vector<uint8_t> pd(19, 0);
+    pd[0] = 0x01; // protocol 1.0
+    pd[2] = static_cast<uint8_t>(uid >> 8);
+    pd[3] = static_cast<uint8_t>(uid);
+    pd[10] = 0x01; // footprint 512
+    pd[14] = 0x00; // start address 1
+    pd[15] = 0x01;
+    return pd;
+  }
+
+  bool SendRDM(const uint8_t *d, int len) {
+    m_rx.clear();
+    if (len < 26)
+      return true;
+    uint64_t dest = Uid(d + 3);
+    uint16_t pid = static_cast<uint16_t>((d[21] << 8) | d[22]);
+    if (pid == PID_DISC_UN_MUTE) {
+      m_muted.clear();
+      return true;
+    }
+    if (std::find(m_uids.begin(), m_uids.end(), dest) == m_uids.end())
+      return true;
+    std::vector<uint8_t> pd;
+    if (pid == PID_DISC_MUTE) {
+      m_muted.insert(dest);
+      pd = {0x00, 0x00};
+    } else if (pid == PID_DEVICE_INFO) {
+      pd = DeviceInfo(dest);
+    }
+    m_rx = BuildRDMPacket(Uid(d + 9), dest, d[15], 0, 0, 0, d[20] + 1, pid,
+                          pd.data(), static_cast<uint8_t>(pd.size()));
+    return true;
+  }
+
+  bool SendRDMDiscovery(const uint8_t *d, int len) {
+    m_rx.clear();
+    if (len < 36)
+      return true;
+    uint64_t lo = Uid(d + 24), hi = Uid(d + 30);
+    for (uint64_t uid : m_uids) {
+      if (uid < lo || uid > hi || m_muted.count(uid))
+        continue;
+      std::vector<uint8_t> reply = DubReply(uid);
+      if (m_rx.empty()) {
+        m_rx = reply;
+      } else {
+        for (size_t i = 0; i < m_rx.size(); ++i)
+          m_rx[i] &= reply[i];
+      }
+    }
+    return true;
+  }
+
+  int ReceiveRDM(uint8_t *out, int maxLen, uint8_t &status) {
+    status = 0;
+    int n = std::min<int>(maxLen, static_cast<int>(m_rx.size()));
+    if (n > 0)
+      memcpy(out, m_rx.data(), n);
+    m_rx.clear();
+    return n;
+  }
+
+private:
+  static uint64_t Uid(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 6; ++i)
+      v = (v << 8) | p[i];
+    return v;
+  }
+
+  static std::vector<uint8_t> DubReply(uint64_t uid) {
+    std::vector<uint8_t> r(7, 0xFE);
+    r.push_back(0xAA);
+    uint16_t sum = 0;
+    for (int i = 5; i >= 0; --i) {
+      uint8_t b = static_cast<uint8_t>(uid >> (i * 8));
+      r.push_back(b | 0xAA);
+      r.push_back(b | 0x55);
+      sum += (b | 0xAA) + (b | 0x55);
+    }
+    for (uint8_t b : {uint8_t(sum >> 8), uint8_t(sum & 0xFF)}) {
+      r.push_back(b | 0xAA);
+      r.push_back(b | 0x55);
+    }
+    return r;
+  }
+
+  std::vector<uint64_t> m_uids;
+  std::set<uint64_t> m_muted;
+  std::vector<uint8_t> m_rx;
+  uint8_t m_transNum = 0;
+};
+
+// ── Fault profiles ──────────────────────────────────────────────────────
+
+static FaultProfile ProfileFor(const std::string &kind, double rate,
+                               uint32_t seed) {
+  FaultProfile p;
+  p.seed = seed;
+  bool mixed = kind == "mixed";
+  if (mixed || kind == "drop")
+    p.drop = rate;
+  if (mixed || kind == "flip")
+    p.bitFlip = rate;
+  if (mixed || kind == "truncate")
+    p.truncate = mixed ? rate / 2 : rate;
+  if (mixed || kind == "collision")
+    p.collision = mixed ? rate / 2 : rate;
+  if (mixed || kind == "stale")
+    p.stale = mixed ? rate / 2 : rate;
+  if (mixed || kind == "late") {
+    // Responses normally well inside the 2.8 ms controller window; the
+    // jitter tail pushes a share of them past it
+    p.latencyUs = 500;
+    p.jitterUs = static_cast<int>(rate * 20000);
+    p.lateAfterUs = 2800;
+  }
+  return p;
+}
+
+struct TrialResult {
+  double discoverySeconds = 0;
+  int found = 0;    // true UIDs found
+  int phantoms = 0; // UIDs reported that are not on the bus
+  double getSeconds = 0;
+  int good = 0;     // ACK with the right parameter data
+  int corrupt = 0;  // ACK with wrong data
+  int failed = 0;   // TIMEOUT / NACK / INVALID
+  uint64_t injected = 0; // faults applied, all kinds
+};
+
+static double Seconds(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static TrialResult RunTrial(const std::vector<uint64_t> &uids,
+                            const FaultProfile &profile, int transactions) {
+  SimBus bus(uids);
+  FaultInjector fi;
+  fi.Attach(bus);
+  fi.SetProfile(profile);
+  TrialResult r;
+
+  auto t0 = Clock::now();
+  std::vector<uint64_t> found = RDMDiscovery(fi, kController);
+  r.discoverySeconds = Seconds(t0);
+  std::set<uint64_t> unique(found.begin(), found.end());
+  for (uint64_t uid : unique) {
+    if (std::find(uids.begin(), uids.end(), uid) != uids.end())
+      ++r.found;
+    else
+      ++r.phantoms;
+  }
+
+  t0 = Clock::now();
+  for (int i = 0; i < transactions; ++i) {
+    uint64_t uid = uids[i % uids.size()];
+    RDMResponse resp = RDMGetCommand(fi, kController, uid, PID_DEVICE_INFO);
+    if (resp.type != RDMResponseType::ACK)
+      ++r.failed;
+    else if (resp.data == SimBus::DeviceInfo(uid))
+      ++r.good;
+    else
+      ++r.corrupt;
+  }
+  r.getSeconds = Seconds(t0);
+  FaultCounters c = fi.Counters();
+  r.injected = c.dropped + c.bitFlips + c.truncated + c.collisions + c.noise +
+               c.stale + c.late;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  std::string kind = "mixed";
+  int arg = 1;
+  if (arg + 1 < argc && strcmp(argv[arg], "--kind") == 0) {
+    kind = argv[arg + 1];
+    arg += 2;
+  }
+  static const char *kKinds[] = {"mixed",     "drop",  "flip", "truncate",
+                                 "collision", "stale", "late"};
+  if (std::find_if(std::begin(kKinds), std::end(kKinds), [&](const char *k) {
+        return kind == k;
+      }) == std::end(kKinds)) {
+    fprintf(stderr, "bench_faults: unknown fault kind '%s'\n", kind.c_str());
+    return 2;
+  }
+  int fixtures = arg < argc ? atoi(argv[arg++]) : 16;
+  int transactions = arg < argc ? atoi(argv[arg++]) : 200;
+  int trials = arg < argc ? atoi(argv[arg++]) : 1;
+  if (fixtures <= 0 || transactions <= 0 || trials <= 0) {
+    fprintf(stderr, "usage: bench_faults [--kind k] [fixtures] "
+                    "[transactions] [trials]\n");
+    return 2;
+  }
+
+  // Fixtures of a few manufacturers, spread like a real rig
+  std::mt19937_64 rng(2024);
+  std::vector<uint64_t> uids;
+  static const uint16_t kMfg[] = {0x4C45, 0x0001, 0x7A70, 0x454E};
+  while (static_cast<int>(uids.size()) < fixtures) {
+    uint64_t uid = (static_cast<uint64_t>(kMfg[rng() % 4]) << 32) |
+                   (rng() & 0xFFFFFFFFULL);
+    if (std::find(uids.begin(), uids.end(), uid) == uids.end())
+      uids.push_back(uid);
+  }
+
+  printf("fault kind %s, %d fixtures, %d GET DEVICE_INFO, %d trial(s)\n\n",
+         kind.c_str(), fixtures, transactions, trials);
+  printf("%6s %8s | %8s %8s %8s %8s | %7s %8s %8s\n", "rate", "faults",
+         "good/s", "good %", "corrupt", "failed", "found %", "phantoms",
+         "disc s");
+
+  static const double kRates[] = {0, 0.01, 0.02, 0.05, 0.1, 0.2};
+  for (double rate : kRates) {
+    TrialResult sum;
+    for (int t = 0; t < trials; ++t) {
+      TrialResult r = RunTrial(uids, ProfileFor(kind, rate, 1000 + t),
+                               transactions);
+      sum.discoverySeconds += r.discoverySeconds;
+      sum.found += r.found;
+      sum.phantoms += r.phantoms;
+      sum.getSeconds += r.getSeconds;
+      sum.good += r.good;
+      sum.corrupt += r.corrupt;
+      sum.failed += r.failed;
+      sum.injected += r.injected;
+    }
+    double total = double(transactions) * trials;
+    printf("%6.2f %8llu | %8.1f %7.1f%% %8d %8d | %6.1f%% %8d %8.2f\n",
+           rate, static_cast<unsigned long long>(sum.injected),
+           sum.good / sum.getSeconds, 100.0 * sum.good / total, sum.corrupt,
+           sum.failed, 100.0 * sum.found / (double(fixtures) * trials),
+           sum.phantoms, sum.discoverySeconds / trials);
+  }
+  return 0;
+}
@@ -13,6 +13,8 @@ public static class NativeInterop
     // ── Driver Selection ─────────────────────────────────────────────────
     public const int DRIVER_ENTTEC   = 0;
     public const int DRIVER_PEPERONI = 1;
+    public const int DRIVER_REPLAY   = 2;
+    public const int DRIVER_SIM      = 3;
 
     [DllImport(Dll)] public static extern void RDX_SetDriver(int driverType);
     [DllImport(Dll)] public static extern int  RDX_GetDriver();
@@ -22,8 +24,14 @@ public static class NativeInterop
 
     // ── Device ──────────────────────────────────────────────────────────
     [DllImport(Dll)] public static extern int  RDX_ListDevices();
-    [DllImport(Dll)] public static extern bool RDX_Open(int deviceIndex);
+    [DllImport(Dll)] public static extern int  RDX_RefreshDevices();
+    [DllImport(Dll)] public static extern bool RDX_Open(int listIndex);
+    [DllImport(Dll, CharSet = CharSet.Ansi)]
+    public static extern bool RDX_GetDeviceSerial(int listIndex, [MarshalAs(UnmanagedType.LPStr)] System.Text.StringBuilder serial, int maxLen);
+    [DllImport(Dll, CharSet = CharSet.Ansi)]
+    public static extern bool RDX_OpenBySerial(string serial);
     [DllImport(Dll)] public static extern void RDX_Close();
+    [DllImport(Dll)] public static extern void RDX_Shutdown();
     [DllImport(Dll)] public static extern bool RDX_IsOpen();
 
     [DllImport(Dll)] private static extern IntPtr RDX_FirmwareString();
@@ -35,6 +43,81 @@ public static class NativeInterop
     // ── DMX ─────────────────────────────────────────────────────────────
     [DllImport(Dll)] public static extern bool RDX_SendDMX(byte[] data, int len);
 
+    // ── DMX Input (Enttec only) ─────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_DmxInputStats
+    {
+        public ulong  Frames;
+        public ulong  ErrorFrames;
+        public int    SlotCount;
+        public int    StartCode;
+        public double RefreshHz;
+        public double IntervalUs;
+        public double JitterUs;
+        public double MinIntervalUs;
+        public double MaxIntervalUs;
+    }
+
+    [DllImport(Dll)] public static extern bool RDX_StartDmxInput();
+    [DllImport(Dll)] public static extern void RDX_StopDmxInput();
+    [DllImport(Dll)] public static extern bool RDX_IsDmxInputRunning();
+    [DllImport(Dll)] public static extern int  RDX_GetDmxInput(byte[] slots, int maxLen,
+                                                               byte[]? changedBits, ref ulong frameNum);
+    [DllImport(Dll)] public static extern bool RDX_GetDmxInputStats(out RDX_DmxInputStats stats);
+
+    // ── Passive RDM Sniffer ─────────────────────────────────────────────
+    public const int SNIFF_DMX          = 0;
+    public const int SNIFF_RDM_REQUEST  = 1;
+    public const int SNIFF_RDM_RESPONSE = 2;
+    public const int SNIFF_DUB_RESPONSE = 3;
+    public const int SNIFF_ALT_START    = 4;
+    public const int SNIFF_INVALID      = 5;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_SniffRecord
+    {
+        public int   Kind;
+        public long  TimestampUs;
+        public ulong SrcUID;
+        public ulong DestUID;
+        public int   TransNum;
+        public int   CommandClass;
+        public int   ResponseType;
+        public int   Pid;
+        public int   ParamLen;
+        public int   FrameLen;
+        public long  TurnaroundUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_SniffFixtureStats
+    {
+        public ulong Uid;
+        public uint  Responses;
+        public uint  Unanswered;
+        public long  MinTurnaroundUs;
+        public long  MaxTurnaroundUs;
+        public long  MeanTurnaroundUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_SnifferCounters
+    {
+        public ulong FramesCaptured;
+        public ulong DmxFrames;
+        public ulong FramesDropped;
+        public ulong RecordsDropped;
+        public ulong InvalidFrames;
+        public ulong FixturesDropped;
+    }
+
+    [DllImport(Dll)] public static extern bool RDX_StartSniffer();
+    [DllImport(Dll)] public static extern void RDX_StopSniffer();
+    [DllImport(Dll)] public static extern bool RDX_IsSnifferRunning();
+    [DllImport(Dll)] public static extern int  RDX_ReadSniffRecords([Out] RDX_SniffRecord[] records, int maxRecords);
+    [DllImport(Dll)] public static extern int  RDX_GetSniffFixtureStats([Out] RDX_SniffFixtureStats[] stats, int maxFixtures);
+    [DllImport(Dll)] public static extern bool RDX_GetSnifferCounters(out RDX_SnifferCounters counters);
+
     // ── Discovery ───────────────────────────────────────────────────────
     [DllImport(Dll)] public static extern int  RDX_Discover();
     [DllImport(Dll)] public static extern bool RDX_GetDiscoveredUID(int index, out ulong uid);
@@ -51,6 +134,24 @@ public static class NativeInterop
         public long LatencyUs;
         [MarshalAs(UnmanagedType.U1)]
         public bool ChecksumValid;
+        public RDX_Timing Timing;
+    }
+
+    public const int TIMING_NONE          = 0;
+    public const int TIMING_HOST_ESTIMATE = 1;
+    public const int TIMING_DEVICE        = 2;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_Timing
+    {
+        public long TotalUs;
+        public long UsbWriteUs;
+        public long WireUs;
+        public long ResponderUs;
+        public long HostUs;
+        public long OverheadUs;
+        public int  ResponderSource;
+        public int  ResolutionUs;
     }
 
     public const int STATUS_ACK          = 0;
@@ -59,6 +160,7 @@ public static class NativeInterop
     public const int STATUS_TIMEOUT      = 3;
     public const int STATUS_CHECKSUM_ERR = 4;
     public const int STATUS_INVALID      = 5;
+    public const int STATUS_BUSY         = 6;
 
     [DllImport(Dll)]
     public static extern bool RDX_SendGET(ulong destUID, ushort pid,
@@ -70,6 +172,92 @@ public static class NativeInterop
                                           byte[]? paramData, int paramLen,
                                           out RDX_Response response);
 
+    // ── Ports (multi-universe) ──────────────────────────────────────────
+    [DllImport(Dll)] public static extern int  RDX_GetPortCount();
+    [DllImport(Dll)] public static extern int  RDX_DiscoverPorts();
+    [DllImport(Dll)] public static extern int  RDX_GetPortUIDCount(int port);
+    [DllImport(Dll)] public static extern bool RDX_GetPortDiscoveredUID(int port, int index, out ulong uid);
+    [DllImport(Dll)] public static extern bool RDX_SendPortDMX(int port, byte[] data, int len);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_SendPortGET(int port, ulong destUID, ushort pid,
+                                              byte[]? paramData, int paramLen,
+                                              out RDX_Response response);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_SendPortSET(int port, ulong destUID, ushort pid,
+                                              byte[]? paramData, int paramLen,
+                                              out RDX_Response response);
+
+    // ── Latency statistics ──────────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_LatencyStats
+    {
+        public ulong  Uid;
+        public ushort Pid;
+        public byte   CommandClass;
+        public byte   Reserved;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 6)]
+        public uint[] StatusCounts;
+        public ulong  Samples;
+        public long   MinUs;
+        public long   P50Us;
+        public long   P90Us;
+        public long   P99Us;
+        public long   MaxUs;
+        public double MeanUs;
+    }
+
+    [DllImport(Dll)] public static extern int  RDX_GetLatencyStatCount();
+    [DllImport(Dll)]
+    public static extern int RDX_GetLatencyStats([Out] RDX_LatencyStats[] stats, int max,
+                                                 [MarshalAs(UnmanagedType.U1)] bool windowed);
+    [DllImport(Dll)]
+    public static extern bool RDX_GetFleetLatency(out RDX_LatencyStats stats,
+                                                  [MarshalAs(UnmanagedType.U1)] bool windowed);
+    [DllImport(Dll)] public static extern void RDX_SetLatencyWindow(int seconds);
+    [DllImport(Dll)] public static extern void RDX_ResetLatencyStats();
+
+    // ── Metrics ─────────────────────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_Metrics
+    {
+        public ulong  DmxFramesTx;
+        public ulong  RdmRequestsTx;
+        public ulong  RdmResponses;
+        public ulong  RdmNacks;
+        public ulong  RdmTimeouts;
+        public ulong  ChecksumErrors;
+        public ulong  InvalidResponses;
+        public ulong  RxFrameErrors;
+        public ulong  DubCollisions;
+        public ulong  UidsDiscovered;
+        public ulong  Purges;
+        public ulong  DeviceOpens;
+        public ulong  Recoveries;
+        public ulong  UsbErrors;
+        public long   RxQueueBytes;
+        public long   LogQueueDepth;
+        public double DmxRateHz;
+    }
+
+    public const int METRICS_ALL_PORTS = -1;
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetMetrics(int port, out RDX_Metrics metrics);
+
+    [DllImport(Dll)] public static extern void RDX_ResetMetrics();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_WriteMetrics(
+        [MarshalAs(UnmanagedType.LPStr)] string path);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_StartMetricsDump(
+        [MarshalAs(UnmanagedType.LPStr)] string path, int intervalMs);
+
+    [DllImport(Dll)] public static extern void RDX_StopMetricsDump();
+
     // ── Parameters ──────────────────────────────────────────────────────
     [DllImport(Dll, CharSet = CharSet.Ansi)]
     public static extern int RDX_LoadParameters(string csvPath);
@@ -81,6 +269,401 @@ public static class NativeInterop
         [MarshalAs(UnmanagedType.LPStr)] System.Text.StringBuilder cmdClass, int cmdMax,
         out bool isMandatory);
 
+    // ── Device profile ──────────────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_DeviceProfile
+    {
+        public int    HaveInfo;
+        public int    HaveSupported;
+        public ushort Protocol;
+        public ushort Model;
+        public ushort Category;
+        public uint   SoftwareVersion;
+        public ushort Footprint;
+        public byte   Personality;
+        public byte   PersonalityCount;
+        public ushort StartAddress;
+        public ushort SubDevices;
+        public byte   SensorCount;
+        public int    Supported;
+        public int    Personalities;
+        public int    Sensors;
+        public int    Parameters;
+        public int    Requests;
+        public int    Failed;
+        public long   ElapsedUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1, CharSet = CharSet.Ansi)]
+    public struct RDX_PersonalityDesc
+    {
+        public byte   Number;
+        public ushort Footprint;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 33)]
+        public string Description;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1, CharSet = CharSet.Ansi)]
+    public struct RDX_SensorDef
+    {
+        public byte  Number;
+        public byte  Type;
+        public byte  Unit;
+        public byte  Prefix;
+        public short RangeMin;
+        public short RangeMax;
+        public short NormalMin;
+        public short NormalMax;
+        public byte  RecordedSupport;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 33)]
+        public string Description;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1, CharSet = CharSet.Ansi)]
+    public struct RDX_ParameterDesc
+    {
+        public ushort Pid;
+        public byte   PdlSize;
+        public byte   DataType;
+        public byte   CommandClass;
+        public byte   Type;
+        public byte   Unit;
+        public byte   Prefix;
+        public uint   MinValue;
+        public uint   MaxValue;
+        public uint   DefaultValue;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 33)]
+        public string Description;
+    }
+
+    [DllImport(Dll)]
+    public static extern bool RDX_ReadDeviceProfile(ulong uid,
+        out RDX_DeviceProfile profile);
+
+    [DllImport(Dll)]
+    public static extern int RDX_GetProfileSupported(
+        [Out] ushort[] pids, int max);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetProfilePersonality(int index,
+        out RDX_PersonalityDesc desc);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetProfileSensor(int index,
+        out RDX_SensorDef def);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetProfileParameter(int index,
+        out RDX_ParameterDesc desc);
+
+    // ── Configuration push ──────────────────────────────────────────────
+    public const int CONFIG_FW_DEFAULTS = 0;
+    public const int CONFIG_TEST        = 1;
+    public const int CONFIG_SHIPPING    = 2;
+
+    public const int PUSH_VERIFY         = 1;
+    public const int PUSH_SKIP_MATCHING  = 2;
+    public const int PUSH_USE_KNOWN      = 4;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_PushSummary
+    {
+        public int  ConfigSets;
+        public int  Fixtures;
+        public int  OkFixtures;
+        public int  Transactions;
+        public int  Sent;
+        public int  Skipped;
+        public int  Failed;
+        public int  Mismatched;
+        public int  Pending;
+        public long ElapsedUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_PushFixture
+    {
+        public ulong Uid;
+        public int   Port;
+        public int   Gets;
+        public int   Sets;
+        public int   Verifies;
+        public int   Skipped;
+        public int   Failed;
+        public int   Mismatched;
+        public int   Pending;
+        public long  ElapsedUs;
+    }
+
+    [DllImport(Dll)] public static extern int RDX_GetConfigCount(int column);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_PushConfig(int column, int flags,
+        out RDX_PushSummary summary);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetPushFixture(int index,
+        out RDX_PushFixture fixture);
+
+    [DllImport(Dll)] public static extern void RDX_ClearPushedValues();
+
+    // ── Broadcast SET ───────────────────────────────────────────────────
+    public const ulong BROADCAST_UID = 0xFFFFFFFFFFFFUL;
+
+    public static ulong VendorcastUid(ushort manufacturer) =>
+        ((ulong)manufacturer << 32) | 0xFFFFFFFFUL;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_BroadcastResult
+    {
+        public int  Ports;
+        public int  Sent;
+        public int  Addressed;
+        public int  Sampled;
+        public int  Confirmed;
+        public int  Mismatched;
+        public int  Unconfirmed;
+        public long ElapsedUs;
+    }
+
+    [DllImport(Dll)]
+    public static extern bool RDX_SendBroadcastSET(ulong destUid, ushort pid,
+        byte[] paramData, int paramLen, int verifySamples,
+        out RDX_BroadcastResult result);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetBroadcastFailedUID(int index,
+        out ulong uid);
+
+    // ── DMX address plan ────────────────────────────────────────────────
+    public const int ADDRESS_SET        = 1;
+    public const int ADDRESS_FAILED     = 2;
+    public const int ADDRESS_MISMATCHED = 3;
+    public const int ADDRESS_PENDING    = 4;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_AddressSummary
+    {
+        public int  Ports;
+        public int  Fixtures;
+        public int  Moves;
+        public int  Unplaced;
+        public int  Overlaps;
+        public int  Sent;
+        public int  Failed;
+        public int  Mismatched;
+        public long ElapsedUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_AddressSlot
+    {
+        public ulong  Uid;
+        public int    Port;
+        public ushort Footprint;
+        public ushort Current;
+        public ushort Planned;
+        public byte   Fixed;
+        public byte   Overlaps;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_AddressPatch
+    {
+        public ulong  Uid;
+        public int    Port;
+        public ushort From;
+        public ushort To;
+        public int    Outcome;
+        public ushort NackReason;
+        public ushort ReadBack;
+    }
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetAddressFixed(ulong uid,
+        [MarshalAs(UnmanagedType.U1)] bool fixedAddress);
+
+    [DllImport(Dll)] public static extern void RDX_ClearFixedAddresses();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_PlanAddresses(int firstAddress,
+        out RDX_AddressSummary summary);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetAddressSlot(int index,
+        out RDX_AddressSlot slot);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_ApplyAddressPlan(
+        [MarshalAs(UnmanagedType.U1)] bool verify,
+        out RDX_AddressSummary summary);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetAddressPatch(int index,
+        out RDX_AddressPatch patch);
+
+    // ── Fixture locator ─────────────────────────────────────────────────
+    public const int LOCATE_MAX_TARGETS = 32;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_LocateState
+    {
+        public int  Targets;
+        public int  Candidates;
+        public int  Steps;
+        public int  StepsLeft;
+        public int  Lit;
+        public int  Done;
+        public int  Transactions;
+        public int  Failed;
+        public long ElapsedUs;
+    }
+
+    [DllImport(Dll)]
+    public static extern bool RDX_StartLocate(int targets,
+        out RDX_LocateState state);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_LocateAnswer(byte[] lit, int count,
+        out RDX_LocateState state);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetLocateState(out RDX_LocateState state);
+
+    [DllImport(Dll)]
+    public static extern int RDX_GetLocateCandidates(int target,
+        [Out] ulong[] uids, int max);
+
+    [DllImport(Dll)] public static extern void RDX_StopLocate();
+
+    // ── Fleet validation ────────────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_FleetFixture
+    {
+        public ulong Uid;
+        public int   Port;
+        public int   Stolen;
+        public int   RowCount;
+        public int   Green;
+        public int   Yellow;
+        public int   Red;
+        public long  SweepUs;
+        public long  CompletedUs;
+        public int   Missing;
+        public long  PredictedUs;
+        public int   Aborted;
+        public long  FirstResultUs;
+        public int   Cached;
+        public int   Shared;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_ValidationPlan
+    {
+        public int  Supported;
+        public int  Gets;
+        public int  Missing;
+        public int  HaveSupported;
+        public long ProbeUs;
+        public long PredictedUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1, CharSet = CharSet.Ansi)]
+    public struct RDX_ValidationRow
+    {
+        public ushort Pid;
+        public byte   Status;
+        public byte   IsMandatory;
+        public int    Response;
+        [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 128)]
+        public string Value;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_StreamRow
+    {
+        public ulong Uid;
+        public int   Port;
+        public int   Index;
+        public long  TimeUs;
+        public RDX_ValidationRow Row;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_FleetProgress
+    {
+        public int  Fixtures;
+        public int  Completed;
+        public int  Stolen;
+        public int  Running;
+        public long ElapsedUs;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_DescriptorStats
+    {
+        public ulong Hits;
+        public ulong Misses;
+        public int   Models;
+        public int   Entries;
+    }
+
+    [DllImport(Dll)]
+    public static extern bool RDX_PlanValidation(ulong uid,
+        out RDX_ValidationPlan plan);
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetValidationPlanning(
+        [MarshalAs(UnmanagedType.U1)] bool enable);
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetSnapshotValidation(
+        [MarshalAs(UnmanagedType.U1)] bool enable);
+
+    [DllImport(Dll)] public static extern void RDX_ClearSnapshots();
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetDescriptorCaching(
+        [MarshalAs(UnmanagedType.U1)] bool enable);
+
+    [DllImport(Dll, CharSet = CharSet.Ansi)]
+    public static extern int RDX_LoadDescriptorCache(string path);
+
+    [DllImport(Dll, CharSet = CharSet.Ansi)]
+    public static extern bool RDX_SaveDescriptorCache(string path);
+
+    [DllImport(Dll)] public static extern void RDX_ClearDescriptorCache();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetDescriptorCacheStats(
+        out RDX_DescriptorStats stats);
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetFleetFailFast(
+        [MarshalAs(UnmanagedType.U1)] bool enable);
+
+    [DllImport(Dll)] public static extern int RDX_StartFleetValidation();
+
+    [DllImport(Dll)]
+    public static extern int RDX_ReadFleetRows([Out] RDX_StreamRow[] rows, int max);
+
+    [DllImport(Dll)] public static extern ulong RDX_GetFleetRowsDropped();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_NextFleetResult(out RDX_FleetFixture result);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetFleetResultRow(int index,
+        out RDX_ValidationRow row);
+
+    [DllImport(Dll)] public static extern ulong RDX_GetFleetResultBytes();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetFleetProgress(out RDX_FleetProgress progress);
+
+    [DllImport(Dll)] public static extern int RDX_GetFleetPortCompleted(int port);
+    [DllImport(Dll)] public static extern void RDX_CancelFleetValidation();
+
     // ── Logging ─────────────────────────────────────────────────────────
     [UnmanagedFunctionPointer(CallingConvention.StdCall)]
     public delegate void LogCallback(
@@ -91,6 +674,21 @@ public static class NativeInterop
     [DllImport(Dll)]
     public static extern void RDX_SetLogCallback(LogCallback? cb);
 
+    public const int LOG_OFF   = 0;
+    public const int LOG_ERROR = 1;
+    public const int LOG_INFO  = 2;
+    public const int LOG_DEBUG = 3;
+    public const int LOG_FRAME = 4;
+
+    [DllImport(Dll)]
+    public static extern void RDX_SetLogLevel(int level);
+
+    [DllImport(Dll)]
+    public static extern int RDX_GetLogLevel();
+
+    [DllImport(Dll)]
+    public static extern ulong RDX_GetLogDropped();
+
     // Keep a reference to prevent GC collection of the delegate
     private static LogCallback? _pinnedCallback;
     public static void SetLogCallback(LogCallback? cb)
@@ -98,4 +696,45 @@ public static class NativeInterop
         _pinnedCallback = cb;
         RDX_SetLogCallback(cb);
     }
+
+    // ── Performance trace (Chrome trace JSON) ───────────────────────────
+    [DllImport(Dll)] public static extern bool RDX_PerfTraceAvailable();
+    [DllImport(Dll)] public static extern bool RDX_PerfTraceStart();
+    [DllImport(Dll)] public static extern void RDX_PerfTraceStop();
+
+    [DllImport(Dll)]
+    public static extern int RDX_PerfTraceExport(
+        [MarshalAs(UnmanagedType.LPStr)] string jsonPath);
+
+    [DllImport(Dll)] public static extern ulong RDX_GetPerfTraceDropped();
+
+    // ── Capture / replay ────────────────────────────────────────────────
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct RDX_CaptureStats
+    {
+        public ulong Frames;
+        public ulong Dropped;
+        public ulong Bytes;
+    }
+
+    [DllImport(Dll)]
+    public static extern bool RDX_StartCapture(
+        [MarshalAs(UnmanagedType.LPStr)] string path);
+
+    [DllImport(Dll)] public static extern void RDX_StopCapture();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_GetCaptureStats(out RDX_CaptureStats stats);
+
+    [DllImport(Dll)]
+    public static extern bool RDX_OpenReplay(
+        [MarshalAs(UnmanagedType.LPStr)] string path, int port, double speed);
+
+    [DllImport(Dll)] public static extern ulong RDX_GetReplayMismatches();
+
+    [DllImport(Dll)]
+    public static extern bool RDX_OpenSimulator(
+        [MarshalAs(UnmanagedType.LPStr)] string mapCsv,
+        [MarshalAs(UnmanagedType.LPStr)] string attrCsv,
+        int fixtures, int ports);
 }
@@ -84,7 +84,7 @@ public partial class MainViewModel : ObservableObject
         if (value >= 0 && value < DriverTypes.Count)
         {
             NativeInterop.RDX_SetDriver(DriverTypes[value].Id);
-            RefreshDevices();
+            LoadDevices();
         }
     }
 
@@ -168,7 +168,7 @@ public partial class MainViewModel : ObservableObject
         _dmxTimer.Tick += (_, _) => SendDMXFrame();
         _dmxTimer.Start();
 
-        RefreshDevices();
+        LoadDevices();
         LoadParameters();
         RebuildDmxChannels(16);
     }
@@ -188,10 +188,14 @@ public partial class MainViewModel : ObservableObject
 
     // ── Device management ───────────────────────────────────────────────
     [RelayCommand]
-    private void RefreshDevices()
+    private void RefreshDevices() => PopulateDevices(NativeInterop.RDX_RefreshDevices());
+
+    // Driver switch / startup: the native side serves this from its cache
+    private void LoadDevices() => PopulateDevices(NativeInterop.RDX_ListDevices());
+
+    private void PopulateDevices(int count)
     {
         Devices.Clear();
-        int count = NativeInterop.RDX_ListDevices();
         for (int i = 0; i < count; i++)
             Devices.Add(new DeviceItem { Index = i });
     }
@@ -765,6 +769,7 @@ public partial class MainViewModel : ObservableObject
                 NativeInterop.STATUS_TIMEOUT => "TIMEOUT",
                 NativeInterop.STATUS_CHECKSUM_ERR => "CHECKSUM_ERR",
                 NativeInterop.STATUS_INVALID => "INVALID",
+                NativeInterop.STATUS_BUSY => "BUSY",
                 _ => "NOT_QUERIED"
             };
             string valEsc = p.Value.Replace("\"", "\"\"");
@@ -884,6 +889,10 @@ public partial class MainViewModel : ObservableObject
             {
                 pid.Value = "No response";
             }
+            else if (resp.Status == NativeInterop.STATUS_BUSY)
+            {
+                pid.Value = "Not sent — bus busy (DMX input / sniffer)";
+            }
             else
             {
                 pid.Value = "";
@@ -1204,6 +1213,17 @@ public partial class MainViewModel : ObservableObject
             RdmStressResult = $"PID {pidName} (0x{pid:X4}): {StressIterations} iterations\n" +
                               $"✅ ACK: {success} ({successPct:F1}%) | ❌ NACK: {nack} | ⏱ TO: {timeout} | ⚠ Err: {errors}\n" +
                               $"Latency — Avg: {avgUs:F0}µs | Min: {(minUs == long.MaxValue ? 0 : minUs)}µs | Max: {maxUs}µs";
+
+            // Responder turnaround percentiles from the core's histograms
+            var stats = new NativeInterop.RDX_LatencyStats[NativeInterop.RDX_GetLatencyStatCount()];
+            int n = NativeInterop.RDX_GetLatencyStats(stats, stats.Length, false);
+            for (int i = 0; i < n; i++)
+            {
+                var st = stats[i];
+                if (st.Uid != destUID || st.Pid != pid || st.CommandClass != 0x20) continue;
+                RdmStressResult += $"\nResponder — p50: {st.P50Us}µs | p90: {st.P90Us}µs | p99: {st.P99Us}µs | Max: {st.MaxUs}µs";
+                break;
+            }
         }
         catch (OperationCanceledException)
         {